@@ -94,6 +94,7 @@ void Chunk::reset() {
     }
     _delete_state = DEL_NOT_SATISFIED;
     _extra_data.reset();
+    _selection.reset();
 }
 
 void Chunk::swap_chunk(Chunk& other) {
@@ -103,9 +104,12 @@ void Chunk::swap_chunk(Chunk& other) {
     _slot_id_to_index.swap(other._slot_id_to_index);
     std::swap(_delete_state, other._delete_state);
     _extra_data.swap(other._extra_data);
+    _selection.swap(other._selection);
+    std::swap(_num_selected_rows, other._num_selected_rows);
 }
 
 void Chunk::set_num_rows(size_t count) {
+    _selection.reset();
     for (ColumnPtr& c : _columns) {
         c->resize(count);
     }
@@ -249,6 +253,10 @@ std::unique_ptr<Chunk> Chunk::clone_unique() const {
     }
     chunk->_owner_info = _owner_info;
     chunk->_extra_data = std::move(_extra_data);
+    if (_selection != nullptr) {
+        chunk->_selection = std::make_unique<Filter>(*_selection);
+        chunk->_num_selected_rows = _num_selected_rows;
+    }
     chunk->check_or_die();
     return chunk;
 }
@@ -271,6 +279,7 @@ void Chunk::rolling_append_selective(Chunk& src, const uint32_t* indexes, uint32
 }
 
 size_t Chunk::filter(const Buffer<uint8_t>& selection, bool force) {
+    DCHECK(!has_selection());
     if (!force && SIMD::count_zero(selection) == 0) {
         return num_rows();
     }
@@ -281,12 +290,40 @@ size_t Chunk::filter(const Buffer<uint8_t>& selection, bool force) {
 }
 
 size_t Chunk::filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    DCHECK(!has_selection());
     for (auto& column : _columns) {
         column->filter_range(selection, from, to);
     }
     return num_rows();
 }
 
+size_t Chunk::select(const Filter& filter, double min_density) {
+    DCHECK_EQ(filter.size(), num_rows());
+    if (_selection == nullptr) {
+        _selection = std::make_unique<Filter>(filter);
+    } else {
+        ColumnHelper::merge_two_filters(_selection.get(), filter.data());
+    }
+    size_t rows = num_rows();
+    _num_selected_rows = SIMD::count_nonzero(*_selection);
+    if (_num_selected_rows == rows) {
+        _selection.reset();
+    } else if (_num_selected_rows == 0) {
+        set_num_rows(0);
+    } else if (_num_selected_rows < rows * min_density) {
+        materialize_selection();
+    }
+    return num_selected_rows();
+}
+
+void Chunk::materialize_selection() {
+    if (_selection == nullptr) {
+        return;
+    }
+    auto selection = std::move(_selection);
+    filter(*selection, true);
+}
+
 DatumTuple Chunk::get(size_t n) const {
     DatumTuple res;
     res.reserve(_columns.size());
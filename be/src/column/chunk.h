@@ -204,6 +204,22 @@ public:
     // Return the number of rows after filter.
     size_t filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to);
 
+    // The selection vector of the rows. Instead of compacting the columns after every filter, the operators
+    // which accept it (see Operator::accept_chunk_selection()) mark the filtered rows in the selection, and
+    // the columns are compacted once by materialize_selection(). The chunk with a selection always has some
+    // row selected, and num_rows() is still the number of rows of the columns.
+    bool has_selection() const { return _selection != nullptr; }
+    const Filter* selection() const { return _selection.get(); }
+    size_t num_selected_rows() const { return _selection == nullptr ? num_rows() : _num_selected_rows; }
+
+    // Unselect the rows which are zero in |filter|, and materialize the selection if less than |min_density|
+    // of the rows are selected. The size of |filter| must be equal to the number of rows.
+    // @return the number of selected rows.
+    size_t select(const Filter& filter, double min_density);
+
+    // Remove the rows not selected and clear the selection.
+    void materialize_selection();
+
     // Return the data of n-th row.
     // This method is relatively slow and mainly used for unit tests now.
     DatumTuple get(size_t n) const;
@@ -299,6 +315,8 @@ private:
     query_cache::owner_info _owner_info;
     ChunkExtraDataPtr _extra_data;
     std::string _source_filename;
+    std::unique_ptr<Filter> _selection;
+    size_t _num_selected_rows = 0;
 };
 
 inline const ColumnPtr& Chunk::get_column_by_name(const std::string& column_name) const {
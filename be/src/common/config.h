@@ -235,6 +235,10 @@ CONF_mInt32(memory_limitation_per_thread_for_schema_change, "2");
 CONF_mDouble(memory_ratio_for_sorting_schema_change, "0.8");
 
 CONF_mInt32(update_cache_expire_sec, "360");
+// Persist the delete vectors of primary key tablets as a chain of deltas that only hold the rows deleted
+// by each version, with a full checkpoint written once the chain reaches delvec_delta_chain_max_length.
+CONF_mBool(enable_delvec_delta_chain, "false");
+CONF_mInt32(delvec_delta_chain_max_length, "16");
 CONF_mInt32(file_descriptor_cache_clean_interval, "3600");
 CONF_mInt32(disk_stat_monitor_interval, "5");
 CONF_mInt32(profile_report_interval, "30");
@@ -271,10 +275,32 @@ CONF_Int32(data_page_size, "65536");
 CONF_mString(storage_page_cache_limit, "20%");
 // whether to disable page cache feature in storage
 CONF_mBool(disable_storage_page_cache, "false");
+// Eviction policy of storage page cache, "lru", "slru" or "clock". With "slru" pages only enter the protected
+// segment when hit again, so a large scan can not flush the frequently used index and dictionary pages.
+// With "clock" lookups only take a read lock of the cache shard and set a reference bit of the page, so
+// concurrent hits do not serialize, pages are given a second chance when being evicted.
+CONF_String(page_cache_eviction_policy, "lru");
+// Data pages read by scans without pushed down predicates and limit on tablets with at least this many rows
+// are not inserted into storage page cache. 0 means never bypass.
+CONF_mInt64(page_cache_bypass_scan_min_rows, "0");
+// Max number of file names kept in the file id registry of storage page cache, the least recently used
+// names are evicted with their cached pages when it is exceeded.
+CONF_mInt64(page_cache_file_id_registry_max_size, "1000000");
+// Memory limit of the decoded page cache, which keeps the data pages hit in storage page cache decoded
+// into columns, so reading them again skips decompression and decoding. 0 means disabled.
+CONF_String(decoded_page_cache_limit, "0");
 // whether to enable the bitmap index memory cache
 CONF_mBool(enable_bitmap_index_memory_page_cache, "false");
 // whether to enable the zonemap index memory cache
 CONF_mBool(enable_zonemap_index_memory_page_cache, "false");
+// The number of rows of the row-block zone maps written for the numeric and date columns, in addition
+// to the page zone maps, so the rows can be pruned in a finer granularity than pages, e.g. 1024.
+// The zone maps are kept in the segment footer. `0` means not writing them.
+CONF_mInt32(zone_map_row_block_size, "0");
+// The maximal error in rows of the learned key index, which is written for the segments whose first
+// sort key column is an integer, date or datetime column, and used instead of the short key index to
+// locate the key ranges, e.g. 32. `0` means not writing it.
+CONF_mInt32(learned_key_index_max_error, "0");
 // whether to enable the ordinal index memory cache
 CONF_mBool(enable_ordinal_index_memory_page_cache, "false");
 // whether to disable column pool
@@ -316,6 +342,13 @@ CONF_mInt32(update_compaction_chunk_size_for_row_store, "0");
 CONF_mInt64(max_update_compaction_num_singleton_deltas, "1000");
 CONF_mInt64(update_compaction_size_threshold, "268435456");
 CONF_mInt64(update_compaction_result_bytes, "1073741824");
+// Column mode partial update rewrites the columns still served by older delta column groups of a segment
+// into the new delta column group once the segment reaches this many delta column groups, so reads only open
+// the newest `.cols` files and the older ones can be reclaimed without a full compaction. 0 means disabled.
+CONF_mInt32(partial_update_column_mode_dcg_consolidate_threshold, "0");
+// The max number of segments whose delta column groups are consolidated by one apply, which bounds the
+// extra apply latency of the tablet. The other segments are consolidated by the following updates of them.
+CONF_mInt32(partial_update_column_mode_dcg_consolidate_max_segments, "4");
 // This config controls the io amp ratio of delvec files.
 CONF_mInt32(update_compaction_delvec_file_io_amp_ratio, "2");
 // This config defines the maximum percentage of data allowed per compaction
@@ -348,6 +381,18 @@ CONF_mBool(enable_rowset_verify, "false");
 // If the number of schema columns is greater than this,
 // the columns will be divided into groups for vertical compaction.
 CONF_Int64(vertical_compaction_max_columns_per_group, "5");
+// Number of value column groups of a vertical compaction that are read and merged concurrently
+// while the previous group is being written. 1 means the column groups are processed one by one.
+CONF_mInt32(vertical_compaction_column_group_parallelism, "1");
+// Max number of merged chunks buffered for each column group being read in parallel, at least 1.
+CONF_mInt32(vertical_compaction_column_group_queue_size, "2");
+// Number of threads shared by all vertical compactions to read the value column groups in parallel.
+// `0` means the number of CPU cores.
+CONF_Int32(vertical_compaction_column_group_thread_num, "0");
+// Whether vertical compaction of duplicate key tables copies the encoded pages of the value columns to the
+// output segments without decoding them, if the rows of the input segments are neither merged nor deleted
+// and keep their order in the output.
+CONF_mBool(enable_vertical_compaction_page_copy, "false");
 
 CONF_Bool(enable_event_based_compaction_framework, "true");
 
@@ -358,6 +403,20 @@ CONF_mInt64(size_tiered_level_multiple, "5");
 CONF_mInt64(size_tiered_level_multiple_dupkey, "10");
 CONF_mInt64(size_tiered_level_num, "7");
 
+// If true, compaction candidates are ordered by the read amplification the compaction saves for
+// recent queries per byte of compaction IO instead of by the compaction score, and the compaction
+// input bytes started on each data dir are limited by `compaction_disk_bandwidth_budget_mb_per_sec`.
+CONF_mBool(enable_compaction_cost_based_scheduling, "false");
+// Half life of the scan heat of a tablet used by the cost based compaction scheduler.
+CONF_mInt64(compaction_scan_heat_half_life_sec, "3600");
+// Scan heat given to every tablet, so the read amplification of cold tablets is still reduced.
+CONF_mDouble(compaction_cold_tablet_weight, "0.1");
+// Compaction input bytes per second each data dir can start under cost based scheduling.
+// A non-positive value means no limit.
+CONF_mInt64(compaction_disk_bandwidth_budget_mb_per_sec, "200");
+// Max seconds of unused disk budget that can be accumulated.
+CONF_mInt64(compaction_disk_bandwidth_budget_burst_sec, "60");
+
 CONF_Bool(enable_check_string_lengths, "true");
 
 // Max row source mask memory bytes, default is 200M.
@@ -390,6 +449,10 @@ CONF_Int32(be_exit_after_disk_write_hang_second, "60");
 // turn off dictionary dictionary encoding. This only will detect first chunk
 // set to 1 means always use dictionary encoding
 CONF_Double(dictionary_encoding_ratio, "0.7");
+// Whether to compress the char/varchar columns with FSST encoding instead of plain encoding when the
+// dictionary encoding is turned off for high cardinality.
+// NOTE: segments written with this encoding can not be read by the older versions.
+CONF_mBool(enable_fsst_encoding, "false");
 
 // Some data types use dictionary encoding, and this configuration is used to control
 // the size of dictionary pages. If you want a higher compression ratio, please increase
@@ -401,6 +464,15 @@ CONF_Int32(dictionary_page_size, "1048576");
 // no-string column.
 CONF_Double(dictionary_encoding_ratio_for_non_string_column, "0");
 
+// Whether to encode FLOAT/DOUBLE columns with ALP (adaptive lossless floating-point) encoding by default.
+// Decimal-like values are stored as small integers, which are much smaller than bitshuffle.
+// NOTE: segments written with this encoding can not be read by the older versions.
+CONF_mBool(enable_alp_encoding, "false");
+// Whether to encode DATETIME columns with delta-of-delta encoding by default, which is suitable for
+// the timestamps increasing with nearly fixed intervals.
+// NOTE: segments written with this encoding can not be read by the older versions.
+CONF_mBool(enable_delta_of_delta_encoding, "false");
+
 // The minimum chunk size for dictionary encoding speculation
 CONF_Int32(dictionary_speculate_min_chunk_size, "10000");
 
@@ -612,6 +684,12 @@ CONF_mDouble(storage_high_usage_disk_protect_ratio, "0.1"); // 10%
 
 // Number of thread for flushing memtable per store.
 CONF_mInt32(flush_thread_num_per_store, "2");
+// Number of threads shared by all segment writers to encode and compress column pages in parallel.
+// 0 means the number of cpu cores.
+CONF_Int32(segment_encode_thread_num, "0");
+// A segment writer encodes its columns in parallel only if it writes at least this many columns,
+// narrow tables do not benefit from the extra scheduling. A non-positive value disables it.
+CONF_mInt32(segment_parallel_encode_min_columns, "64");
 
 // Config for tablet meta checkpoint.
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -663,6 +741,15 @@ CONF_Int32(late_materialization_ratio, "10");
 // `1000` will enable late materialization always select metric type.
 CONF_Int32(metric_late_materialization_ratio, "1000");
 
+// Whether to evaluate the range and equality predicates on the encoded data pages before reading the
+// columns, so the rows which do not satisfy them are not read, e.g. the frames of frame-of-reference
+// pages which are out of the range are skipped without being decoded.
+CONF_mBool(enable_encoded_page_predicate, "false");
+// The rows selected by the encoded page predicates are read only if they are in ranges of at least this many
+// rows on average, otherwise all the rows are read, since reading many short ranges costs more than
+// evaluating the predicates on the rows.
+CONF_mInt32(encoded_page_predicate_min_range_rows, "16");
+
 // Max batched bytes for each transmit request. (256KB)
 CONF_Int64(max_transmit_batched_bytes, "262144");
 
@@ -902,6 +989,15 @@ CONF_Int64(send_rpc_runtime_filter_timeout_ms, "1000");
 // if runtime filter size is larger than send_runtime_filter_via_http_rpc_min_size, be will transmit runtime filter via http protocol.
 // this is a default value, maybe changed by global_runtime_filter_rpc_http_min_size in session variable.
 CONF_Int64(send_runtime_filter_via_http_rpc_min_size, "67108864");
+// Choose the representation of a join runtime filter by the actual values of the build side instead of the number
+// of rows: the keys of few distinct values are pushed down to storage as an IN filter, the integers of a dense range
+// are kept in a membership bitmap, and the bloom filter is sized to the number of distinct values.
+CONF_mBool(enable_adaptive_runtime_filter, "false");
+// The max number of bits of the membership bitmap of a join runtime filter.
+CONF_mInt64(runtime_filter_membership_max_bits, "16777216");
+// Prune the pages of the probe side by the values of a late-arriving join runtime filter through the zone maps and
+// bloom filter indexes, in addition to its min/max.
+CONF_mBool(enable_runtime_filter_index_pruning, "false");
 
 CONF_Int64(rpc_connect_timeout_ms, "30000");
 
@@ -1280,6 +1376,13 @@ CONF_mInt32(json_flat_internal_column_min_limit, "5");
 // the maximum number of extracted JSON sub-field
 CONF_mInt32(json_flat_column_max, "20");
 
+// Prefer to flatten the JSON sub-fields accessed by the queries on the tablet, at memtable flush and compaction.
+CONF_mBool(enable_json_flat_access_feedback, "false");
+// extract the accessed flat json column when row_num * access_sparsity_factor < hit_row_num
+CONF_mDouble(json_flat_access_sparsity_factor, "0.3");
+// the maximum number of the JSON columns whose accessed sub-fields are counted
+CONF_mInt64(json_flat_access_stats_max_columns, "100000");
+
 // Allowable intervals for continuous generation of pk dumps
 // Disable when pk_dump_interval_seconds <= 0
 CONF_mInt64(pk_dump_interval_seconds, "3600"); // 1 hour
@@ -1298,6 +1401,37 @@ CONF_mInt32(olap_string_max_length, "1048576");
 // if mem_limit < 16 GB, disable JIT.
 // else it = min(mem_limit*0.01, 1GB)
 CONF_mInt64(jit_lru_cache_size, "0");
+// The directory of the object code compiled by JIT, which is reused by the queries and after restarts.
+CONF_String(jit_disk_cache_path, "${STARROCKS_HOME}/jit_cache");
+// The max total size in bytes of the object code on disk, 0 to disable the disk cache.
+CONF_mInt64(jit_disk_cache_capacity, "0");
+// Compile the exprs in the background, and evaluate them without JIT until the compilation finishes.
+CONF_mBool(jit_async_compile, "false");
+CONF_Int32(jit_async_compile_threads, "4");
+
+// Merge `c LIKE p1 OR c LIKE p2 ...` of the constant patterns on the same column into one predicate, which
+// matches all the patterns in one pass.
+CONF_mBool(enable_multi_like_predicate, "false");
+
+// Reorder the conjuncts of an operator by the selectivity and the cost measured at runtime, and evaluate the
+// conjuncts after the selective ones only on the selected rows.
+CONF_mBool(enable_adaptive_conjuncts_order, "false");
+// The number of chunks over which the statistics of a conjunct are collected before reordering.
+CONF_mInt32(adaptive_conjuncts_window_size, "8");
+// A conjunct is evaluated on the selected rows instead of the whole chunk if the ratio of the selected rows
+// is no more than this.
+CONF_mDouble(adaptive_conjuncts_selected_ratio, "0.5");
+
+// Mark the rows filtered by Select in the selection vector of the chunk instead of compacting the columns. Project
+// and hash join probe pass the selection through, and the columns are compacted once before the other operators,
+// e.g. exchange and sink.
+CONF_mBool(enable_chunk_selection, "false");
+// The selection is materialized once the selected rows are less than this ratio of the rows of the chunk.
+CONF_mDouble(chunk_selection_min_density, "0.5");
+
+// Extract the constant JSON path of get_json_* and json_query by a column-level kernel, which indexes the JSON text
+// with simdjson instead of parsing the whole document, and caches the position of the fields of the JSON objects.
+CONF_mBool(enable_json_path_extractor, "false");
 
 CONF_mInt64(arrow_io_coalesce_read_max_buffer_size, "8388608");
 CONF_mInt64(arrow_io_coalesce_read_max_distance_size, "1048576");
@@ -0,0 +1,175 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/adaptive_conjuncts_evaluator.h"
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "common/config.h"
+#include "exec/exec_node.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "runtime/current_thread.h"
+#include "simd/simd.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// A conjunct filtering nothing is still ranked by its cost, after all the others.
+static constexpr double kMinFilteredRatio = 1e-3;
+
+bool AdaptiveConjunctsEvaluator::Stats::update(size_t input, size_t output, size_t evaluated, int64_t ns) {
+    num_chunks++;
+    input_rows += input;
+    output_rows += output;
+    evaluated_rows += evaluated;
+    cost_ns += ns;
+    if (num_chunks < std::max<int32_t>(config::adaptive_conjuncts_window_size, 1)) {
+        return false;
+    }
+
+    double cost_per_row = evaluated_rows == 0 ? 0 : static_cast<double>(cost_ns) / evaluated_rows;
+    double filtered_ratio = input_rows == 0 ? 0 : 1 - static_cast<double>(output_rows) / input_rows;
+    rank = cost_per_row / std::max(filtered_ratio, kMinFilteredRatio);
+
+    num_chunks = 0;
+    input_rows = 0;
+    output_rows = 0;
+    evaluated_rows = 0;
+    cost_ns = 0;
+    return true;
+}
+
+void AdaptiveConjunctsEvaluator::_update_order(const std::vector<ExprContext*>& ctxs) {
+    if (_ctxs != ctxs) {
+        _ctxs = ctxs;
+        _order_changed = true;
+    }
+    if (!_order_changed) {
+        return;
+    }
+    _order = ctxs;
+    // the planner order is kept for the conjuncts without statistics
+    std::stable_sort(_order.begin(), _order.end(),
+                     [this](ExprContext* lhs, ExprContext* rhs) { return _stats[lhs].rank < _stats[rhs].rank; });
+    _order_changed = false;
+}
+
+Status AdaptiveConjunctsEvaluator::_eval_selected(ExprContext* ctx, const Stats& stats, Chunk* chunk,
+                                                  Filter* filter) {
+    auto selected_chunk = std::make_shared<Chunk>();
+    auto num_selected = static_cast<uint32_t>(_selection.size());
+    for (SlotId slot_id : stats.slot_ids) {
+        const ColumnPtr& column = chunk->get_column_by_slot_id(slot_id);
+        auto selected_column = column->clone_empty();
+        selected_column->append_selective(*column, _selection.data(), 0, num_selected);
+        selected_chunk->append_column(std::move(selected_column), slot_id);
+    }
+    ASSIGN_OR_RETURN(ColumnPtr column, ctx->evaluate(selected_chunk.get()));
+
+    _selected_filter.assign(num_selected, 1);
+    ColumnHelper::merge_two_filters(column, &_selected_filter);
+    uint8_t* data = filter->data();
+    for (uint32_t i = 0; i < num_selected; ++i) {
+        data[_selection[i]] = _selected_filter[i];
+    }
+    return Status::OK();
+}
+
+Status AdaptiveConjunctsEvaluator::eval(const std::vector<ExprContext*>& ctxs, Chunk* chunk, FilterPtr* filter_ptr,
+                                        bool apply_filter) {
+    if (!config::enable_adaptive_conjuncts_order || ctxs.size() <= 1) {
+        return ExecNode::eval_conjuncts(ctxs, chunk, filter_ptr, apply_filter);
+    }
+    DCHECK(chunk != nullptr);
+    // the eager pruning of a narrow chunk copies less than the selection
+    if (filter_ptr == nullptr && chunk->num_columns() <= ExecNode::kEagerPruneMaxColumnNumber) {
+        return ExecNode::eval_conjuncts(ctxs, chunk, filter_ptr, apply_filter);
+    }
+    // No need to do expression if none rows
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    if (!apply_filter) {
+        DCHECK(filter_ptr) << "Must provide a filter if not apply it directly";
+    }
+
+    TRY_CATCH_ALLOC_SCOPE_START()
+    _update_order(ctxs);
+
+    const size_t num_rows = chunk->num_rows();
+    FilterPtr filter(new Filter(num_rows, 1));
+    if (filter_ptr != nullptr) {
+        *filter_ptr = filter;
+    }
+    const auto max_selected_rows = static_cast<size_t>(num_rows * config::adaptive_conjuncts_selected_ratio);
+    size_t num_selected = num_rows;
+    bool selection_stale = true;
+
+    for (auto* ctx : _order) {
+        auto& stats = _stats[ctx];
+        if (!stats.slot_ids_inited) {
+            ctx->root()->get_slot_ids(&stats.slot_ids);
+            std::sort(stats.slot_ids.begin(), stats.slot_ids.end());
+            stats.slot_ids.erase(std::unique(stats.slot_ids.begin(), stats.slot_ids.end()), stats.slot_ids.end());
+            stats.slot_ids_inited = true;
+        }
+        // The slots of lambda arguments are not in the chunk, such conjuncts are evaluated on the whole chunk.
+        bool eval_selected = num_selected <= max_selected_rows && !stats.slot_ids.empty() &&
+                             std::all_of(stats.slot_ids.begin(), stats.slot_ids.end(),
+                                         [chunk](SlotId slot_id) { return chunk->is_slot_exist(slot_id); });
+
+        int64_t start_ns = MonotonicNanos();
+        if (eval_selected) {
+            if (selection_stale) {
+                _selection.clear();
+                for (uint32_t i = 0; i < num_rows; ++i) {
+                    if ((*filter)[i]) {
+                        _selection.push_back(i);
+                    }
+                }
+                selection_stale = false;
+            }
+            RETURN_IF_ERROR(_eval_selected(ctx, stats, chunk, filter.get()));
+        } else {
+            ASSIGN_OR_RETURN(ColumnPtr column, ctx->evaluate(chunk));
+            ColumnHelper::merge_two_filters(column, filter.get());
+        }
+        size_t num_output = SIMD::count_nonzero(*filter);
+        size_t num_evaluated = eval_selected ? num_selected : num_rows;
+        if (stats.update(num_selected, num_output, num_evaluated, MonotonicNanos() - start_ns)) {
+            _order_changed = true;
+        }
+
+        selection_stale |= num_output != num_selected;
+        num_selected = num_output;
+        if (num_selected == 0) {
+            break;
+        }
+    }
+
+    if (apply_filter && num_selected != num_rows) {
+        if (num_selected == 0) {
+            chunk->set_num_rows(0);
+        } else {
+            chunk->filter(*filter);
+        }
+    }
+    TRY_CATCH_ALLOC_SCOPE_END()
+    return Status::OK();
+}
+
+} // namespace starrocks
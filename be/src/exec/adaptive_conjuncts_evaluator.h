@@ -0,0 +1,83 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/global_types.h"
+#include "common/status.h"
+
+namespace starrocks {
+
+class ExprContext;
+
+// AdaptiveConjunctsEvaluator evaluates the conjuncts like ExecNode::eval_conjuncts, but in the order measured
+// at runtime instead of the planner order.
+//
+// The selectivity and the cost per row of every conjunct are collected over a window of chunks, and the conjuncts
+// are sorted by cost / (1 - selectivity) when the window is full, which minimizes the expected cost of evaluating
+// them with short-circuit. Once most rows are filtered, the following conjuncts are evaluated only on the selected
+// rows of the columns they reference, instead of on the whole chunk.
+//
+// The conjuncts are shared by the drivers of a pipeline while the statistics are not, so there should be one
+// evaluator per operator or scanner. It's not thread-safe.
+class AdaptiveConjunctsEvaluator {
+public:
+    // Same as ExecNode::eval_conjuncts, which is called directly if the adaptive order is disabled or there is
+    // only one conjunct.
+    Status eval(const std::vector<ExprContext*>& ctxs, Chunk* chunk, FilterPtr* filter_ptr = nullptr,
+                bool apply_filter = true);
+
+    // The order of the conjuncts of the last evaluation, for test.
+    const std::vector<ExprContext*>& order() const { return _order; }
+
+private:
+    struct Stats {
+        // the conjuncts of smaller rank are evaluated first, unknown before the first window is full
+        double rank = 0;
+        // referenced slots, empty if the conjunct can't be evaluated on the selected rows
+        std::vector<SlotId> slot_ids;
+        bool slot_ids_inited = false;
+
+        // the current window
+        size_t num_chunks = 0;
+        size_t input_rows = 0;
+        size_t output_rows = 0;
+        size_t evaluated_rows = 0;
+        int64_t cost_ns = 0;
+
+        // Return true if the window is full and |rank| is updated.
+        bool update(size_t input, size_t output, size_t evaluated, int64_t ns);
+    };
+
+    void _update_order(const std::vector<ExprContext*>& ctxs);
+
+    // Evaluate |ctx| on the rows of |_selection| and merge the result into |filter|.
+    Status _eval_selected(ExprContext* ctx, const Stats& stats, Chunk* chunk, Filter* filter);
+
+    std::unordered_map<ExprContext*, Stats> _stats;
+    // the conjuncts of the last evaluation, and their order
+    std::vector<ExprContext*> _ctxs;
+    std::vector<ExprContext*> _order;
+    // the order is stale if some window is full
+    bool _order_changed = true;
+
+    std::vector<uint32_t> _selection;
+    Filter _selected_filter;
+};
+
+} // namespace starrocks
@@ -25,15 +25,18 @@
 #include "common/config.h"
 #include "common/status.h"
 #include "exec/exec_node.h"
+#include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/operator.h"
 #include "exec/spill/spiller.hpp"
 #include "exprs/anyval_util.h"
+#include "exprs/jit/jit_engine.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "types/logical_type.h"
 #include "udf/java/utils.h"
 #include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -270,6 +273,10 @@ Status Aggregator::open(RuntimeState* state) {
         }
     }
 
+    if (!_group_by_expr_ctxs.empty() && !_is_only_group_by_columns && state->is_jit_enabled()) {
+        _compile_agg_update_function(state);
+    }
+
     // AggregateFunction::create needs to call create in JNI,
     // but prepare is executed in bthread, which will cause the JNI code to crash
 
@@ -765,10 +772,15 @@ Status Aggregator::compute_batch_agg_states(Chunk* chunk, size_t chunk_size) {
     SCOPED_TIMER(_agg_stat->agg_function_compute_timer);
     bool use_intermediate = _use_intermediate_as_input();
     auto& agg_expr_ctxs = use_intermediate ? _intermediate_agg_expr_ctxs : _agg_expr_ctxs;
+    // the fused functions are updated together after all the inputs are evaluated
+    const bool use_jit = _jit_agg_update_function != nullptr && !use_intermediate && chunk_size > 0;
 
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         // evaluate arguments at i-th agg function
         RETURN_IF_ERROR(evaluate_agg_input_column(chunk, agg_expr_ctxs[i], i));
+        if (use_jit && _is_jit_agg_update_funcs[i]) {
+            continue;
+        }
         // batch call update or merge
         if (!_is_merge_funcs[i] && !use_intermediate) {
             _agg_functions[i]->update_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
@@ -779,10 +791,100 @@ Status Aggregator::compute_batch_agg_states(Chunk* chunk, size_t chunk_size) {
                                            _agg_input_columns[i][0].get(), _tmp_agg_states.data());
         }
     }
+    if (use_jit && !_jit_update_batch(chunk_size)) {
+        for (size_t i : _jit_agg_update_funcs) {
+            _agg_functions[i]->update_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
+                                            _agg_input_raw_columns[i].data(), _tmp_agg_states.data());
+        }
+    }
     RETURN_IF_ERROR(check_has_error());
     return Status::OK();
 }
 
+// Fusing a single function saves little but costs a compilation.
+static constexpr size_t kMinJITAggUpdateFunctions = 2;
+
+void Aggregator::_compile_agg_update_function(RuntimeState* state) {
+    std::vector<AggStateUpdateLayout> layouts;
+    std::vector<size_t> funcs;
+    for (size_t i = 0; i < _agg_functions.size(); i++) {
+        AggStateUpdateLayout layout;
+        if (_is_merge_funcs[i] || _agg_expr_ctxs[i].size() > 1 || !_agg_functions[i]->get_update_layout(&layout)) {
+            continue;
+        }
+        if (_agg_expr_ctxs[i].empty() && (layout.input_type != TYPE_NULL || layout.skip_null)) {
+            continue;
+        }
+        // the offsets in the row of all the aggregate states
+        layout.value_offset += _agg_states_offsets[i];
+        layout.count_offset += _agg_states_offsets[i];
+        if (layout.null_flag_offset >= 0) {
+            layout.null_flag_offset += _agg_states_offsets[i];
+        }
+        layouts.push_back(layout);
+        funcs.push_back(i);
+    }
+    if (funcs.size() < kMinJITAggUpdateFunctions) {
+        return;
+    }
+
+    auto start = MonotonicNanos();
+    auto cache = std::make_shared<JitObjectCache>(JITEngine::agg_update_func_name(layouts),
+                                                  JITEngine::get_instance()->get_func_cache());
+    auto st = JITEngine::compile_agg_update_function(layouts, cache.get());
+    auto elapsed = MonotonicNanos() - start;
+    if (state->fragment_ctx() != nullptr) {
+        state->fragment_ctx()->update_jit_profile(elapsed);
+    }
+    if (!st.ok()) {
+        LOG(INFO) << "JIT: compile aggregate update failed, time cost: " << elapsed / 1000000.0 << " ms"
+                  << " Reason: " << st;
+        return;
+    }
+    _jit_agg_update_cache = std::move(cache);
+    _jit_agg_update_function = _jit_agg_update_cache->get_agg_update_func();
+    _is_jit_agg_update_funcs.assign(_agg_functions.size(), false);
+    for (size_t i : funcs) {
+        _is_jit_agg_update_funcs[i] = true;
+    }
+    _jit_agg_update_funcs = std::move(funcs);
+    _jit_agg_update_layouts = std::move(layouts);
+    _runtime_profile->add_info_string("JITAggUpdateFunctions", std::to_string(_jit_agg_update_funcs.size()));
+}
+
+bool Aggregator::_jit_update_batch(size_t chunk_size) {
+    std::vector<JITColumn> jit_columns(_jit_agg_update_funcs.size());
+    for (size_t k = 0; k < _jit_agg_update_funcs.size(); k++) {
+        const auto& inputs = _agg_input_raw_columns[_jit_agg_update_funcs[k]];
+        const auto& layout = _jit_agg_update_layouts[k];
+        if (inputs.empty()) {
+            // count(*)
+            continue;
+        }
+        const Column* data_column = inputs[0];
+        const uint8_t* null_flags = nullptr;
+        if (inputs[0]->is_nullable()) {
+            if (!layout.skip_null) {
+                return false;
+            }
+            const auto* nullable_column = down_cast<const NullableColumn*>(inputs[0]);
+            data_column = nullable_column->data_column().get();
+            null_flags = nullable_column->null_column()->raw_data();
+        } else if (layout.skip_null) {
+            if (_jit_zero_null_flags.size() < chunk_size) {
+                _jit_zero_null_flags.assign(chunk_size, 0);
+            }
+            null_flags = _jit_zero_null_flags.data();
+        }
+        if (layout.input_type != TYPE_NULL) {
+            jit_columns[k].datums = reinterpret_cast<const int8_t*>(data_column->raw_data());
+        }
+        jit_columns[k].null_flags = reinterpret_cast<const int8_t*>(null_flags);
+    }
+    _jit_agg_update_function(chunk_size, jit_columns.data(), _tmp_agg_states.data());
+    return true;
+}
+
 Status Aggregator::compute_batch_agg_states_with_selection(Chunk* chunk, size_t chunk_size) {
     SCOPED_TIMER(_agg_stat->agg_function_compute_timer);
     bool use_intermediate = _use_intermediate_as_input();
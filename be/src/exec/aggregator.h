@@ -48,6 +48,8 @@
 namespace starrocks {
 
 struct HashTableKeyAllocator;
+struct JITColumn;
+class JitObjectCache;
 
 struct RawHashTableIterator {
     RawHashTableIterator(HashTableKeyAllocator* alloc_, size_t x_, int y_) : alloc(alloc_), x(x_), y(y_) {}
@@ -466,6 +468,17 @@ protected:
     Buffer<AggDataPtr> _tmp_agg_states;
     std::vector<AggFunctionTypes> _agg_fn_types;
 
+    // The update functions whose state updates are fused into |_jit_agg_update_function|, see
+    // _compile_agg_update_function.
+    std::vector<bool> _is_jit_agg_update_funcs;
+    std::vector<size_t> _jit_agg_update_funcs;
+    std::vector<AggStateUpdateLayout> _jit_agg_update_layouts;
+    // holds the compiled code of |_jit_agg_update_function|
+    std::shared_ptr<JitObjectCache> _jit_agg_update_cache;
+    void (*_jit_agg_update_function)(int64_t, JITColumn*, AggDataPtr*) = nullptr;
+    // null flags of the non-nullable inputs of the fused functions which skip nulls
+    Buffer<uint8_t> _jit_zero_null_flags;
+
     // Exprs used to evaluate conjunct
     std::vector<ExprContext*> _conjunct_ctxs;
 
@@ -537,6 +550,12 @@ protected:
     // initial const columns for i'th FunctionContext.
     [[nodiscard]] Status _evaluate_const_columns(int i);
 
+    // Compile the state updates of the update functions with a fixed-width input into one loop over the
+    // chunk, to save the virtual calls and the separate passes of every function.
+    void _compile_agg_update_function(RuntimeState* state);
+    // Return false if the inputs are not the ones expected by the fused functions.
+    bool _jit_update_batch(size_t chunk_size);
+
     // Create new aggregate function result column by type
     Columns _create_agg_result_columns(size_t num_rows, bool use_intermediate);
     Columns _create_group_by_columns(size_t num_rows);
@@ -658,8 +658,7 @@ Status ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, Chunk* ch
     // TO BE NOTED, that there is no storng evidence that this has better performance.
     // It's just by intuition.
     TRY_CATCH_ALLOC_SCOPE_START()
-    const int eager_prune_max_column_number = 5;
-    if (filter_ptr == nullptr && chunk->num_columns() <= eager_prune_max_column_number) {
+    if (filter_ptr == nullptr && chunk->num_columns() <= kEagerPruneMaxColumnNumber) {
         return eager_prune_eval_conjuncts(ctxs, chunk);
     }
 
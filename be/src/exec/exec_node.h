@@ -165,6 +165,10 @@ public:
     // Collect all scan node types.
     void collect_scan_nodes(std::vector<ExecNode*>* nodes);
 
+    // eval_conjuncts prunes the chunk after each conjunct instead of building a filter, if the filter is not
+    // needed and the chunk has no more columns than this.
+    static constexpr size_t kEagerPruneMaxColumnNumber = 5;
+
     // evaluate exprs over chunk to get a filter
     // if filter_ptr is not null, save filter to filter_ptr.
     // then running filter on chunk.
@@ -14,6 +14,8 @@
 
 #include "exec/hash_join_components.h"
 
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
 #include "exec/hash_joiner.h"
 
@@ -24,6 +26,25 @@ Status HashJoinProber::push_probe_chunk(RuntimeState* state, ChunkPtr&& chunk) {
     _probe_chunk = std::move(chunk);
     _current_probe_has_remain = true;
     RETURN_IF_ERROR(_hash_joiner.prepare_probe_key_columns(&_key_columns, _probe_chunk));
+    if (_probe_chunk->has_selection()) {
+        // The keys of the rows not selected are null, so they never match. The rows of the output are
+        // copied from the matched rows of the probe chunk, which is never compacted.
+        const Filter& selection = *_probe_chunk->selection();
+        for (auto& column : _key_columns) {
+            auto null_column = NullColumn::create(selection.size());
+            auto& nulls = null_column->get_data();
+            for (size_t i = 0; i < selection.size(); ++i) {
+                nulls[i] = !selection[i];
+            }
+            if (column->is_nullable()) {
+                auto* nullable_column = down_cast<NullableColumn*>(column.get());
+                ColumnHelper::or_two_filters(&nulls, nullable_column->immutable_null_column_data().data());
+                column = NullableColumn::create(nullable_column->data_column(), std::move(null_column));
+            } else {
+                column = NullableColumn::create(column, std::move(null_column));
+            }
+        }
+    }
     return Status::OK();
 }
 
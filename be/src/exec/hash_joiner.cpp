@@ -16,6 +16,7 @@
 
 #include <runtime/runtime_state.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column_helper.h"
@@ -364,6 +365,19 @@ Status HashJoiner::reset_probe(starrocks::RuntimeState* state) {
     return Status::OK();
 }
 
+bool HashJoiner::accept_probe_selection() const {
+    if (_join_type != TJoinOp::INNER_JOIN && _join_type != TJoinOp::LEFT_SEMI_JOIN &&
+        _join_type != TJoinOp::RIGHT_SEMI_JOIN && _join_type != TJoinOp::RIGHT_OUTER_JOIN) {
+        return false;
+    }
+    if (std::any_of(_is_null_safes.begin(), _is_null_safes.end(), [](bool is_null_safe) { return is_null_safe; })) {
+        return false;
+    }
+    // the keys are evaluated on all the rows, so only slot refs
+    return std::all_of(_probe_expr_ctxs.begin(), _probe_expr_ctxs.end(),
+                       [](ExprContext* ctx) { return ctx->root()->is_slotref(); });
+}
+
 bool HashJoiner::_has_null(const ColumnPtr& column) {
     if (column->is_nullable()) {
         const auto& null_column = ColumnHelper::as_raw_column<NullableColumn>(column)->null_column();
@@ -514,7 +528,9 @@ Status HashJoiner::_create_runtime_in_filters(RuntimeState* state) {
     size_t ht_row_count = get_ht_row_count();
     auto& ht = _hash_join_builder->hash_table();
 
-    if (ht_row_count > config::max_pushdown_conditions_per_column) {
+    // the keys of many rows may still have few distinct values
+    bool check_distinct_values = ht_row_count > config::max_pushdown_conditions_per_column;
+    if (check_distinct_values && !config::enable_adaptive_runtime_filter) {
         return Status::OK();
     }
 
@@ -531,6 +547,13 @@ Status HashJoiner::_create_runtime_in_filters(RuntimeState* state) {
             if (!to_build[i]) continue;
             ColumnPtr column = ht.get_key_columns()[i];
             Expr* probe_expr = _probe_expr_ctxs[i]->root();
+            if (check_distinct_values &&
+                !RuntimeFilterHelper::has_few_distinct_values(column, probe_expr->type().type,
+                                                              kHashJoinKeyColumnOffset,
+                                                              config::max_pushdown_conditions_per_column)) {
+                _runtime_in_filters.push_back(nullptr);
+                continue;
+            }
             // create and fill runtime in filter.
             VectorizedInConstPredicateBuilder builder(state, _pool, probe_expr);
             builder.set_eq_null(_is_null_safes[i]);
@@ -579,9 +602,8 @@ Status HashJoiner::_create_runtime_bloom_filters(RuntimeState* state, int64_t li
                     RuntimeFilterHelper::create_runtime_bloom_filter(nullptr, build_type));
             if (filter == nullptr) continue;
             filter->set_join_mode(rf_desc->join_mode());
-            filter->init(ht.get_row_count());
-            RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter.get(),
-                                                                           kHashJoinKeyColumnOffset, eq_null));
+            RETURN_IF_ERROR(RuntimeFilterHelper::build_runtime_bloom_filter({column}, build_type, filter.get(),
+                                                                            kHashJoinKeyColumnOffset, eq_null));
         }
         _runtime_bloom_filter_build_params.emplace_back(pipeline::RuntimeBloomFilterBuildParam(
                 multi_partitioned, eq_null, std::move(column), std::move(filter)));
@@ -233,6 +233,10 @@ public:
     void decr_prober(RuntimeState* state);
     bool has_referenced_hash_table() const { return _has_referenced_hash_table; }
 
+    // Whether the probe chunk could have a selection. The keys of the rows not selected are taken as null and
+    // never match, which is only correct if the probe rows not matched are not output.
+    bool accept_probe_selection() const;
+
     Columns string_key_columns() { return _string_key_columns; }
     [[nodiscard]] Status reset_probe(RuntimeState* state);
 
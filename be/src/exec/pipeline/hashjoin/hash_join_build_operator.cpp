@@ -110,6 +110,8 @@ Status HashJoinBuildOperator::set_finishing(RuntimeState* state) {
     if (is_colocate_runtime_filter) {
         // init local colocate in/bloom filters
         RuntimeInFilterList in_filter_lists(partial_in_filters.begin(), partial_in_filters.end());
+        // the in-filters of the keys of many distinct values are nullptr
+        in_filter_lists.remove(nullptr);
         if (partial_bloom_filters.size() != partial_bloom_filter_build_params.size()) {
             // if in short-circuit mode, phase is EOS. partial_bloom_filter_build_params is empty.
             DCHECK(_join_builder->is_done());
@@ -50,6 +50,8 @@ public:
 
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    bool accept_chunk_selection() const override { return _join_prober->accept_probe_selection(); }
+
     Status reset_state(starrocks::RuntimeState* state, const std::vector<ChunkPtr>& refill_chunks) override;
 
 protected:
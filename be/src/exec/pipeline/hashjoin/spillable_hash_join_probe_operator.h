@@ -76,6 +76,9 @@ public:
 
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    // the probe chunks may be spilled
+    bool accept_chunk_selection() const override { return false; }
+
     void set_probe_spiller(std::shared_ptr<spill::Spiller> spiller) { _probe_spiller = std::move(spiller); }
 
 private:
@@ -186,8 +186,7 @@ Status Operator::eval_conjuncts_and_in_filters(const std::vector<ExprContext*>&
         SCOPED_TIMER(_conjuncts_timer);
         auto before = chunk->num_rows();
         _conjuncts_input_counter->update(before);
-        RETURN_IF_ERROR(
-                starrocks::ExecNode::eval_conjuncts(_cached_conjuncts_and_in_filters, chunk, filter, apply_filter));
+        RETURN_IF_ERROR(_conjuncts_evaluator.eval(_cached_conjuncts_and_in_filters, chunk, filter, apply_filter));
         auto after = chunk->num_rows();
         _conjuncts_output_counter->update(after);
     }
@@ -207,7 +206,7 @@ Status Operator::eval_conjuncts(const std::vector<ExprContext*>& conjuncts, Chun
         SCOPED_TIMER(_conjuncts_timer);
         size_t before = chunk->num_rows();
         _conjuncts_input_counter->update(before);
-        RETURN_IF_ERROR(starrocks::ExecNode::eval_conjuncts(conjuncts, chunk, filter));
+        RETURN_IF_ERROR(_conjuncts_evaluator.eval(conjuncts, chunk, filter));
         size_t after = chunk->num_rows();
         _conjuncts_output_counter->update(after);
     }
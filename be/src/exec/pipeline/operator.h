@@ -18,6 +18,7 @@
 
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
+#include "exec/adaptive_conjuncts_evaluator.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exec/spill/operator_mem_resource_manager.h"
 #include "exprs/runtime_filter_bank.h"
@@ -96,6 +97,10 @@ public:
     // return true if operator should ignore eos chunk
     virtual bool ignore_empty_eos() const { return true; }
 
+    // Whether the pushed chunk could have a selection, see Chunk::selection().
+    // Otherwise the selection is materialized before pushing the chunk to this operator.
+    virtual bool accept_chunk_selection() const { return false; }
+
     // Whether we could push chunk to this operator
     virtual bool need_input() const = 0;
 
@@ -170,6 +175,7 @@ public:
     const std::vector<SlotId>& filter_null_value_columns() const;
 
     // equal to ExecNode::eval_conjuncts(_conjunct_ctxs, chunk), is used to apply in-filters to Operators.
+    // The conjuncts are reordered by the statistics of this operator, see AdaptiveConjunctsEvaluator.
     Status eval_conjuncts_and_in_filters(const std::vector<ExprContext*>& conjuncts, Chunk* chunk,
                                          FilterPtr* filter = nullptr, bool apply_filter = true);
 
@@ -282,6 +288,7 @@ protected:
 
     bool _conjuncts_and_in_filters_is_cached = false;
     std::vector<ExprContext*> _cached_conjuncts_and_in_filters;
+    AdaptiveConjunctsEvaluator _conjuncts_evaluator;
 
     RuntimeBloomFilterEvalContext _bloom_filter_eval_context;
 
@@ -320,7 +320,10 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state, int w
                     if (maybe_chunk.value() &&
                         (maybe_chunk.value()->num_rows() > 0 ||
                          (maybe_chunk.value()->owner_info().is_last_chunk() && !next_op->ignore_empty_eos()))) {
-                        size_t row_num = maybe_chunk.value()->num_rows();
+                        if (maybe_chunk.value()->has_selection() && !next_op->accept_chunk_selection()) {
+                            maybe_chunk.value()->materialize_selection();
+                        }
+                        size_t row_num = maybe_chunk.value()->num_selected_rows();
                         if (UNLIKELY(row_num > runtime_state->chunk_size())) {
                             return Status::InternalError(
                                     fmt::format("Intermediate chunk size must not be greater than {}, actually {} "
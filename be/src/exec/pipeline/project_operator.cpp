@@ -14,6 +14,8 @@
 
 #include "exec/pipeline/project_operator.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
@@ -25,6 +27,17 @@ namespace starrocks::pipeline {
 Status ProjectOperator::prepare(RuntimeState* state) {
     _expr_compute_timer = ADD_TIMER(_unique_metrics, "ExprComputeTime");
     _common_sub_expr_compute_timer = ADD_TIMER(_unique_metrics, "CommonSubExprComputeTime");
+
+    _is_slot_ref_projection = _common_sub_expr_ctxs.empty();
+    for (auto* ctx : _expr_ctxs) {
+        ctx->root()->get_slot_ids(&_input_slot_ids);
+        _is_slot_ref_projection &= ctx->root()->is_slotref();
+    }
+    for (auto* ctx : _common_sub_expr_ctxs) {
+        ctx->root()->get_slot_ids(&_input_slot_ids);
+    }
+    std::sort(_input_slot_ids.begin(), _input_slot_ids.end());
+    _input_slot_ids.erase(std::unique(_input_slot_ids.begin(), _input_slot_ids.end()), _input_slot_ids.end());
     return Operator::prepare(state);
 }
 
@@ -37,13 +50,32 @@ StatusOr<ChunkPtr> ProjectOperator::pull_chunk(RuntimeState* state) {
     return std::move(_cur_chunk);
 }
 
-Status ProjectOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    if (chunk->is_empty()) {
-        DCHECK(chunk->owner_info().is_last_chunk());
-        _cur_chunk = chunk;
+Status ProjectOperator::push_chunk(RuntimeState* state, const ChunkPtr& input_chunk) {
+    if (input_chunk->is_empty()) {
+        DCHECK(input_chunk->owner_info().is_last_chunk());
+        _cur_chunk = input_chunk;
         return Status::OK();
     }
     TRY_CATCH_ALLOC_SCOPE_START();
+    ChunkPtr chunk = input_chunk;
+    if (chunk->has_selection() && !_is_slot_ref_projection) {
+        // The expressions are evaluated only on the selected rows, so materialize the selection, but only of
+        // the referenced columns, as the others are dropped by the projection anyway.
+        auto selected_chunk = std::make_shared<Chunk>();
+        for (SlotId slot_id : _input_slot_ids) {
+            if (input_chunk->is_slot_exist(slot_id)) {
+                selected_chunk->append_column(input_chunk->get_column_by_slot_id(slot_id), slot_id);
+            }
+        }
+        if (selected_chunk->num_columns() > 0) {
+            selected_chunk->owner_info() = input_chunk->owner_info();
+            selected_chunk->select(*input_chunk->selection(), 1);
+            chunk = std::move(selected_chunk);
+        } else {
+            chunk->materialize_selection();
+        }
+    }
+
     {
         SCOPED_TIMER(_common_sub_expr_compute_timer);
         for (size_t i = 0; i < _common_sub_column_ids.size(); ++i) {
@@ -86,6 +118,9 @@ Status ProjectOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
         _cur_chunk->append_column(result_columns[i], _column_ids[i]);
     }
     _cur_chunk->owner_info() = chunk->owner_info();
+    if (chunk->has_selection() && _cur_chunk->num_columns() > 0) {
+        _cur_chunk->select(*chunk->selection(), 0);
+    }
     TRY_CATCH_ALLOC_SCOPE_END()
     return Status::OK();
 }
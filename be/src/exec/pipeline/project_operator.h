@@ -47,6 +47,8 @@ public:
 
     bool ignore_empty_eos() const override { return false; }
 
+    bool accept_chunk_selection() const override { return true; }
+
     Status set_finishing(RuntimeState* state) override {
         _is_finished = true;
         return Status::OK();
@@ -69,6 +71,11 @@ private:
     bool _is_finished = false;
     ChunkPtr _cur_chunk = nullptr;
 
+    // the slots referenced by the expressions
+    std::vector<SlotId> _input_slot_ids;
+    // whether all the expressions are slot refs, which pass the selection of the input chunk through
+    bool _is_slot_ref_projection = false;
+
     RuntimeProfile::Counter* _expr_compute_timer = nullptr;
     RuntimeProfile::Counter* _common_sub_expr_compute_timer = nullptr;
 };
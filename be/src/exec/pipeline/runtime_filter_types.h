@@ -302,7 +302,6 @@ public:
 
     [[nodiscard]] Status merge_local_in_filters() {
         bool can_merge_in_filters = true;
-        size_t num_rows = 0;
         ssize_t k = -1;
         //squeeze _partial_in_filters and eliminate empty in-filter lists generated by empty hash tables.
         for (auto i = 0; i < _ht_row_counts.size(); ++i) {
@@ -311,7 +310,8 @@ public:
             if (_ht_row_counts[i] == 0) {
                 continue;
             }
-            // empty in-filter list is generated by non-empty hash tables(size>1024), in-filters can not be merged.
+            // empty in-filter list is generated by non-empty hash tables of many distinct keys, in-filters can not be
+            // merged.
             if (in_filters.empty()) {
                 can_merge_in_filters = false;
                 break;
@@ -321,10 +321,10 @@ public:
             if (k < i) {
                 _partial_in_filters[k] = std::move(_partial_in_filters[i]);
             }
-            num_rows = std::max(num_rows, _ht_row_counts[i]);
         }
 
-        can_merge_in_filters = can_merge_in_filters && (num_rows <= 1024) && k >= 0;
+        // the partial in-filters are only built for the keys of few distinct values, even if there are many rows
+        can_merge_in_filters = can_merge_in_filters && k >= 0;
         if (!can_merge_in_filters) {
             _partial_in_filters[0].clear();
             return Status::OK();
@@ -389,11 +389,7 @@ public:
             JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
             if (filter == nullptr) continue;
 
-            if (desc->has_remote_targets() && row_count > _global_rf_limit) {
-                filter->clear_bf();
-            } else {
-                filter->init(row_count);
-            }
+            // the bloom filter is inited when it's filled
             filter->set_join_mode(desc->join_mode());
             desc->set_runtime_filter(filter);
         }
@@ -433,6 +429,8 @@ public:
                 desc->set_runtime_filter(nullptr);
                 continue;
             }
+            Columns columns;
+            bool eq_null = false;
             for (auto& opt_params : _partial_bloom_filter_build_params) {
                 auto& opt_param = opt_params[i];
                 DCHECK(opt_param.has_value());
@@ -440,13 +438,16 @@ public:
                 if (param.column == nullptr || param.column->empty()) {
                     continue;
                 }
-                auto status = RuntimeFilterHelper::fill_runtime_bloom_filter(param.column, desc->build_expr_type(),
-                                                                             desc->runtime_filter(),
-                                                                             kHashJoinKeyColumnOffset, param.eq_null);
-                if (!status.ok()) {
-                    desc->set_runtime_filter(nullptr);
-                    break;
-                }
+                columns.push_back(param.column);
+                eq_null = param.eq_null;
+            }
+            // only min/max is kept if the bloom filter is too large to be sent
+            bool build_bf = !desc->has_remote_targets() || row_count <= _global_rf_limit;
+            auto status = RuntimeFilterHelper::build_runtime_bloom_filter(
+                    columns, desc->build_expr_type(), desc->runtime_filter(), kHashJoinKeyColumnOffset, eq_null,
+                    build_bf);
+            if (!status.ok()) {
+                desc->set_runtime_filter(nullptr);
             }
         }
         return Status::OK();
@@ -36,9 +36,11 @@
 #include "runtime/exec_env.h"
 #include "storage/chunk_helper.h"
 #include "storage/column_predicate_rewriter.h"
+#include "storage/json_path_access_stats.h"
 #include "storage/olap_runtime_range_pruner.hpp"
 #include "storage/predicate_parser.h"
 #include "storage/projection_iterator.h"
+#include "storage/rowset/vector_search_option.h"
 #include "storage/storage_engine.h"
 #include "types/logical_type.h"
 #include "util/runtime_profile.h"
@@ -132,6 +134,9 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _bf_filtered_counter = ADD_CHILD_COUNTER(_runtime_profile, "BloomFilterFilterRows", TUnit::UNIT, segment_init_name);
     _gin_filtered_counter = ADD_CHILD_COUNTER(_runtime_profile, "GinFilterRows", TUnit::UNIT, segment_init_name);
     _gin_filtered_timer = ADD_CHILD_TIMER(_runtime_profile, "GinFilter", segment_init_name);
+    _vector_index_filtered_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "VectorIndexFilterRows", TUnit::UNIT, segment_init_name);
+    _vector_index_filter_timer = ADD_CHILD_TIMER(_runtime_profile, "VectorIndexFilter", segment_init_name);
     _seg_zm_filtered_counter =
             ADD_CHILD_COUNTER_SKIP_MIN_MAX(_runtime_profile, "SegmentZoneMapFilterRows", TUnit::UNIT,
                                            _get_counter_min_max_type("SegmentZoneMapFilterRows"), segment_init_name);
@@ -225,6 +230,12 @@ Status OlapChunkSource::_init_reader_params(const std::vector<std::unique_ptr<Ol
                                     &pushdown_pred_root, &non_pushdown_pred_root);
     _params.pred_tree = PredicateTree::create(std::move(pushdown_pred_root));
     _non_pushdown_pred_tree = PredicateTree::create(std::move(non_pushdown_pred_root));
+    // A scan without pushed down predicates and limit reads every data page of the tablet sequentially,
+    // keep its pages out of page cache so that it doesn't evict the hot pages of other queries.
+    if (config::page_cache_bypass_scan_min_rows > 0 && _params.pred_tree.empty() && _limit == -1 &&
+        static_cast<int64_t>(_tablet->num_rows()) >= config::page_cache_bypass_scan_min_rows) {
+        _params.fill_page_cache = false;
+    }
 
     for (const auto& [_, col_nodes] : _non_pushdown_pred_tree.root().col_children_map()) {
         for (const auto& col_node : col_nodes) {
@@ -239,6 +250,30 @@ Status OlapChunkSource::_init_reader_params(const std::vector<std::unique_ptr<Ol
         RETURN_IF_ERROR(not_pushdown_predicate_rewriter.rewrite_predicate(&_obj_pool, _not_push_down_predicates));
     }
 
+    // Every segment returns only its k nearest rows of the vector search, which are the top-k of the scan only if
+    // no row is filtered or merged after being read: the rows of AGG_KEYS and UNIQUE_KEYS tablets are merged, and
+    // the conjuncts not pushed down and the runtime filters are evaluated on the chunks.
+    const auto* runtime_bloom_filters = _scan_op->runtime_bloom_filters();
+    const KeysType keys_type = _tablet_schema->keys_type();
+    if (thrift_olap_scan_node.__isset.vector_search_options && (keys_type == DUP_KEYS || keys_type == PRIMARY_KEYS) &&
+        _scan_ctx->not_push_down_conjuncts().empty() && _not_push_down_predicates.empty() &&
+        (runtime_bloom_filters == nullptr || runtime_bloom_filters->empty())) {
+        const auto& options = thrift_olap_scan_node.vector_search_options;
+        auto column_index = _tablet_schema->field_index(options.vector_column_name);
+        if (column_index == static_cast<size_t>(-1)) {
+            return Status::InternalError(
+                    fmt::format("vector column {} is not found in tablet schema", options.vector_column_name));
+        }
+        auto vector_search_option = std::make_shared<VectorSearchOption>();
+        vector_search_option->column_id = column_index;
+        vector_search_option->query_vector.assign(options.query_vector.begin(), options.query_vector.end());
+        vector_search_option->k = options.limit_k;
+        if (options.__isset.nprobe) {
+            vector_search_option->nprobe = options.nprobe;
+        }
+        _params.vector_search_option = std::move(vector_search_option);
+    }
+
     // Range
     for (const auto& key_range : key_ranges) {
         if (key_range->begin_scan_range.size() == 1 && key_range->begin_scan_range.get_value(0) == NEGATIVE_INFINITY) {
@@ -325,6 +360,14 @@ Status OlapChunkSource::_init_column_access_paths(Schema* schema) {
             auto res = path->convert_by_index(field.get(), index);
             // read whole data, doesn't effect query
             if (LIKELY(res.ok())) {
+                if (config::enable_json_flat_access_feedback && field->type()->type() == TYPE_JSON &&
+                    field->uid() >= 0) {
+                    std::vector<std::string> json_paths;
+                    for (const auto& child : res.value()->children()) {
+                        json_paths.emplace_back(child->path());
+                    }
+                    JsonPathAccessStats::instance()->record(_tablet->tablet_id(), field->uid(), json_paths);
+                }
                 _column_access_paths.emplace_back(std::move(res.value()));
                 leaf_size += path->leaf_size();
             } else {
@@ -409,6 +452,10 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     std::vector<uint32_t> reader_columns;
 
     RETURN_IF_ERROR(_get_tablet(_scan_range));
+    // the scan heat of tablets is used by the cost based compaction scheduler
+    if (config::enable_compaction_cost_based_scheduling) {
+        _tablet->record_scan();
+    }
 
     auto scope = IOProfiler::scope(IOProfiler::TAG_QUERY, _scan_range->tablet_id);
 
@@ -521,7 +568,7 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, Chunk* chu
         }
         if (!_scan_ctx->not_push_down_conjuncts().empty()) {
             SCOPED_TIMER(_expr_filter_timer);
-            RETURN_IF_ERROR(ExecNode::eval_conjuncts(_scan_ctx->not_push_down_conjuncts(), chunk));
+            RETURN_IF_ERROR(_conjuncts_evaluator.eval(_scan_ctx->not_push_down_conjuncts(), chunk));
             DCHECK_CHUNK(chunk);
         }
         TRY_CATCH_ALLOC_SCOPE_END()
@@ -607,6 +654,8 @@ void OlapChunkSource::_update_counter() {
     COUNTER_UPDATE(_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
     COUNTER_UPDATE(_gin_filtered_counter, _reader->stats().rows_gin_filtered);
     COUNTER_UPDATE(_gin_filtered_timer, _reader->stats().gin_index_filter_ns);
+    COUNTER_UPDATE(_vector_index_filtered_counter, _reader->stats().rows_vector_index_filtered);
+    COUNTER_UPDATE(_vector_index_filter_timer, _reader->stats().vector_index_filter_ns);
     COUNTER_UPDATE(_block_seek_counter, _reader->stats().block_seek_num);
 
     COUNTER_UPDATE(_rowsets_read_count, _reader->stats().rowsets_read_count);
@@ -16,6 +16,7 @@
 
 #include <utility>
 
+#include "exec/adaptive_conjuncts_evaluator.h"
 #include "exec/olap_common.h"
 #include "exec/olap_scan_prepare.h"
 #include "exec/olap_utils.h"
@@ -82,6 +83,7 @@ private:
     PredicateTree _non_pushdown_pred_tree;
     ConjunctivePredicates _not_push_down_predicates;
     std::vector<uint8_t> _selection;
+    AdaptiveConjunctsEvaluator _conjuncts_evaluator;
 
     ObjectPool _obj_pool;
     TabletSharedPtr _tablet;
@@ -151,6 +153,8 @@ private:
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _gin_filtered_counter = nullptr;
     RuntimeProfile::Counter* _gin_filtered_timer = nullptr;
+    RuntimeProfile::Counter* _vector_index_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _vector_index_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
     RuntimeProfile::Counter* _rowsets_read_count = nullptr;
     RuntimeProfile::Counter* _segments_read_count = nullptr;
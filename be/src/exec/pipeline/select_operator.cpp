@@ -15,6 +15,7 @@
 #include "exec/pipeline/select_operator.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exprs/expr.h"
 #include "runtime/runtime_state.h"
 
@@ -40,7 +41,7 @@ StatusOr<ChunkPtr> SelectOperator::pull_chunk(RuntimeState* state) {
      *      merge it into _pre_output_chunk.
      */
     if (!_pre_output_chunk) {
-        auto cur_size = _curr_chunk->num_rows();
+        auto cur_size = _curr_chunk->num_selected_rows();
         if (cur_size >= chunk_size / 2) {
             return std::move(_curr_chunk);
         } else {
@@ -58,12 +59,14 @@ StatusOr<ChunkPtr> SelectOperator::pull_chunk(RuntimeState* state) {
              *  else
              *      merge input chunk into _pre_output_chunk.
              */
-            auto cur_size = _curr_chunk->num_rows();
-            if (cur_size + _pre_output_chunk->num_rows() > chunk_size) {
+            auto cur_size = _curr_chunk->num_selected_rows();
+            if (cur_size + _pre_output_chunk->num_selected_rows() > chunk_size) {
                 auto output_chunk = _pre_output_chunk;
                 _pre_output_chunk = std::move(_curr_chunk);
                 return output_chunk;
             } else {
+                _pre_output_chunk->materialize_selection();
+                _curr_chunk->materialize_selection();
                 Columns& dest_columns = _pre_output_chunk->columns();
                 Columns& src_columns = _curr_chunk->columns();
                 size_t num_rows = cur_size;
@@ -85,7 +88,16 @@ bool SelectOperator::need_input() const {
 }
 
 Status SelectOperator::push_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get()));
+    if (config::enable_chunk_selection) {
+        // The filtered rows are unselected instead of being removed, unless most rows are filtered.
+        FilterPtr filter;
+        RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get(), &filter, false));
+        if (filter != nullptr && !chunk->is_empty()) {
+            chunk->select(*filter, config::chunk_selection_min_density);
+        }
+    } else {
+        RETURN_IF_ERROR(eval_conjuncts_and_in_filters(_conjunct_ctxs, chunk.get()));
+    }
     _curr_chunk = chunk;
     return Status::OK();
 }
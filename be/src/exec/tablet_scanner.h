@@ -21,6 +21,7 @@
 #include "column/chunk.h"
 #include "column/column_access_path.h"
 #include "common/status.h"
+#include "exec/adaptive_conjuncts_evaluator.h"
 #include "exec/olap_utils.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -86,6 +87,7 @@ private:
 
     ObjectPool _pool;
     std::vector<ExprContext*> _conjunct_ctxs;
+    AdaptiveConjunctsEvaluator _conjuncts_evaluator;
     PredicateTree _pred_tree;
     ConjunctivePredicates _predicates;
     std::vector<uint8_t> _selection;
@@ -18,6 +18,7 @@
 #include <type_traits>
 
 #include "column/column.h"
+#include "types/logical_type.h"
 
 namespace starrocks {
 class FunctionContext;
@@ -42,6 +43,30 @@ enum AggStateTableKind { RESULT = 0, INTERMEDIATE = 1, DETAIL_RESULT = 2, DETAIL
 using AggDataPtr = uint8_t*;
 using ConstAggDataPtr = const uint8_t*;
 
+// The layout of a state which is updated by a plain loop over a fixed-width input column, the updates
+// of such functions are fused into one JIT compiled loop over the chunk, see Aggregator::compute_batch_agg_states.
+struct AggStateUpdateLayout {
+    enum Kind { SUM, COUNT, MIN, MAX, AVG };
+
+    Kind kind = SUM;
+    // The type of the input values, TYPE_NULL if the input is not read, eg count(*).
+    LogicalType input_type = TYPE_NULL;
+    // The type of the accumulated value at |value_offset| of the state.
+    LogicalType value_type = TYPE_NULL;
+    size_t value_offset = 0;
+    // The offset of the row count of AVG.
+    size_t count_offset = 0;
+    // Null input rows are skipped, the other rows are counted by COUNT or reset |null_flag_offset|.
+    bool skip_null = false;
+    // The offset of the `is_null` flag of the nullable wrapper, -1 if the state has no such flag.
+    int64_t null_flag_offset = -1;
+};
+
+// The input types of the fused state update.
+template <LogicalType LT>
+inline constexpr bool IsJITAggInputType = LT == TYPE_TINYINT || LT == TYPE_SMALLINT || LT == TYPE_INT ||
+                                          LT == TYPE_BIGINT || LT == TYPE_FLOAT || LT == TYPE_DOUBLE;
+
 // Aggregate function interface
 // Aggregate function instances don't contain aggregation state, the aggregation state is stored in
 // other objects
@@ -214,6 +239,9 @@ public:
     virtual void merge_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column* column,
                                           size_t start, size_t size) const = 0;
 
+    // Return true and set |layout| if the update of this function can be fused by JIT.
+    virtual bool get_update_layout(AggStateUpdateLayout* layout) const { return false; }
+
     ///////////////// STREAM MV METHODS /////////////////
 
     // Return stream agg function's state table kind, see AggStateTableKind's description.
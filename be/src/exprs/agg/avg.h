@@ -123,6 +123,19 @@ public:
         return AggStateTableKind::INTERMEDIATE;
     }
 
+    bool get_update_layout(AggStateUpdateLayout* layout) const override {
+        if constexpr (IsJITAggInputType<LT>) {
+            layout->kind = AggStateUpdateLayout::AVG;
+            layout->input_type = LT;
+            layout->value_type = ImmediateLT;
+            layout->value_offset = offsetof(AvgAggregateState<ImmediateType>, sum);
+            layout->count_offset = offsetof(AvgAggregateState<ImmediateType>, count);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     void retract(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
                  size_t row_num) const override {
         do_update<false>(ctx, columns, state, row_num);
@@ -50,6 +50,17 @@ public:
 
     AggStateTableKind agg_state_table_kind(bool is_append_only) const override { return AggStateTableKind::RESULT; }
 
+    bool get_update_layout(AggStateUpdateLayout* layout) const override {
+        if constexpr (!IsWindowFunc) {
+            layout->kind = AggStateUpdateLayout::COUNT;
+            layout->value_type = TYPE_BIGINT;
+            layout->value_offset = offsetof(AggregateCountFunctionState<IsWindowFunc>, count);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     void retract(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
                  size_t row_num) const override {
         --this->data(state).count;
@@ -164,6 +175,18 @@ public:
         this->data(state).count += !columns[0]->is_null(row_num);
     }
 
+    bool get_update_layout(AggStateUpdateLayout* layout) const override {
+        if constexpr (!IsWindowFunc) {
+            layout->kind = AggStateUpdateLayout::COUNT;
+            layout->value_type = TYPE_BIGINT;
+            layout->value_offset = offsetof(AggregateCountFunctionState<IsWindowFunc>, count);
+            layout->skip_null = true;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     void update_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column** columns,
                       AggDataPtr* states) const override {
         if (columns[0]->has_null()) {
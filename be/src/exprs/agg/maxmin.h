@@ -151,6 +151,19 @@ public:
         OP()(this->data(state), value);
     }
 
+    bool get_update_layout(AggStateUpdateLayout* layout) const override {
+        if constexpr (IsJITAggInputType<LT>) {
+            layout->kind = std::is_same_v<OP, MaxElement<LT, State>> ? AggStateUpdateLayout::MAX
+                                                                      : AggStateUpdateLayout::MIN;
+            layout->input_type = LT;
+            layout->value_type = LT;
+            layout->value_offset = offsetof(State, result);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     void update_batch_single_state_with_frame(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
                                               int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                               int64_t frame_end) const override {
@@ -285,6 +285,22 @@ public:
         this->nested_function->update(ctx, data_columns, this->data(state).mutable_nest_state(), row_num);
     }
 
+    bool get_update_layout(AggStateUpdateLayout* layout) const override {
+        if constexpr (!IsWindowFunc && IgnoreNull && std::is_standard_layout_v<State>) {
+            if (!this->nested_function->get_update_layout(layout) || layout->null_flag_offset >= 0) {
+                return false;
+            }
+            const size_t nested_offset = offsetof(State, _nested_state);
+            layout->value_offset += nested_offset;
+            layout->count_offset += nested_offset;
+            layout->skip_null = true;
+            layout->null_flag_offset = offsetof(State, is_null);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     // TODO(kks): abstract the AVX2 filter process later
     void update_batch(FunctionContext* ctx, size_t chunk_size, size_t state_offset, const Column** columns,
                       AggDataPtr* states) const override {
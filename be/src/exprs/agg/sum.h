@@ -64,6 +64,18 @@ public:
 
     AggStateTableKind agg_state_table_kind(bool is_append_only) const override { return AggStateTableKind::RESULT; }
 
+    bool get_update_layout(AggStateUpdateLayout* layout) const override {
+        if constexpr (IsJITAggInputType<LT>) {
+            layout->kind = AggStateUpdateLayout::SUM;
+            layout->input_type = LT;
+            layout->value_type = ResultLT;
+            layout->value_offset = offsetof(SumAggregateState<ResultType>, sum);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     void retract(FunctionContext* ctx, const Column** columns, AggDataPtr __restrict state,
                  size_t row_num) const override {
         DCHECK(columns[0]->is_numeric() || columns[0]->is_decimal());
@@ -42,6 +42,7 @@
 #include <vector>
 
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "common/statusor.h"
@@ -74,6 +75,7 @@
 #include "exprs/map_element_expr.h"
 #include "exprs/map_expr.h"
 #include "exprs/match_expr.h"
+#include "exprs/multi_like_predicate.h"
 #include "exprs/placeholder_ref.h"
 #include "exprs/subfield_expr.h"
 #include "gutil/strings/substitute.h"
@@ -308,7 +310,11 @@ Status Expr::create_tree_from_thrift(ObjectPool* pool, const std::vector<TExprNo
                     "Failed to reconstruct expression tree from thrift. Invalid input root_expr or ctx");
         } else {
             *root_expr = expr;
-            *ctx = pool->add(new ExprContext(expr));
+            if (config::enable_multi_like_predicate) {
+                bool replaced = false;
+                RETURN_IF_ERROR(expr->merge_multi_like_predicates(root_expr, pool, replaced));
+            }
+            *ctx = pool->add(new ExprContext(*root_expr));
         }
     }
     return Status::OK();
@@ -462,6 +468,7 @@ Status Expr::create_vectorized_expr(starrocks::ObjectPool* pool, const starrocks
     case TExprNodeType::TUPLE_IS_NULL_PRED:
     case TExprNodeType::RUNTIME_FILTER_MIN_MAX_EXPR:
     case TExprNodeType::JIT_EXPR:
+    case TExprNodeType::MULTI_LIKE_PRED:
         break;
     }
     if (*expr == nullptr) {
@@ -806,6 +813,20 @@ Status Expr::replace_compilable_exprs(Expr** expr, ObjectPool* pool, RuntimeStat
     return Status::OK();
 }
 
+Status Expr::merge_multi_like_predicates(Expr** expr, ObjectPool* pool, bool& replaced) {
+    if (MultiLikePredicate::is_or_predicate(*expr)) {
+        ASSIGN_OR_RETURN(auto* merged, MultiLikePredicate::merge_or_predicate(pool, *expr));
+        if (merged != *expr) {
+            *expr = merged;
+            replaced = true;
+        }
+    }
+    for (auto& child : (*expr)->_children) {
+        RETURN_IF_ERROR(child->merge_multi_like_predicates(&child, pool, replaced));
+    }
+    return Status::OK();
+}
+
 JitScore Expr::compute_jit_score(RuntimeState* state) const {
     JitScore jit_score = {0, 0};
     if (!is_compilable(state)) {
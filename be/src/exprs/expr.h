@@ -239,6 +239,10 @@ public:
     // TODO(Yueyang): The algorithm is imperfect and may further be optimized in the future.
     Status replace_compilable_exprs(Expr** expr, ObjectPool* pool, RuntimeState* state, bool& replaced);
 
+    // Merge the LIKE/REGEXP predicates of the constant patterns on the same column under the OR predicates into
+    // MultiLikePredicates, which match all the patterns of a column in one pass.
+    Status merge_multi_like_predicates(Expr** expr, ObjectPool* pool, bool& replaced);
+
     // Establishes whether the current expression should undergo compilation.
     // if adaptive, the valuable expressions should take the majority, i.e., `jit_score_ratio` of all expressions,
     // but case_when expr is especial, refer to its `compute_jit_score()`.
@@ -23,6 +23,8 @@
 #include "exprs/anyval_util.h"
 #include "exprs/builtin_functions.h"
 #include "exprs/expr_context.h"
+#include "exprs/string_functions.h"
+#include "exprs/time_functions.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
 #include "runtime/user_function_cache.h"
@@ -38,7 +40,50 @@ DEFINE_FAIL_POINT(expr_prepare_failed);
 DEFINE_FAIL_POINT(expr_prepare_fragment_local_call_failed);
 DEFINE_FAIL_POINT(expr_prepare_fragment_thread_local_call_failed);
 
-VectorizedFunctionCallExpr::VectorizedFunctionCallExpr(const TExprNode& node) : Expr(node) {}
+static JITFunctionType get_jit_function_type(ScalarFunction function) {
+    static const std::unordered_map<ScalarFunction, JITFunctionType> jit_functions = {
+            {&TimeFunctions::year, JITFunctionType::YEAR},
+            {&TimeFunctions::yearV2, JITFunctionType::YEAR},
+            {&TimeFunctions::yearV3, JITFunctionType::YEAR},
+            {&TimeFunctions::quarter, JITFunctionType::QUARTER},
+            {&TimeFunctions::month, JITFunctionType::MONTH},
+            {&TimeFunctions::monthV2, JITFunctionType::MONTH},
+            {&TimeFunctions::monthV3, JITFunctionType::MONTH},
+            {&TimeFunctions::day, JITFunctionType::DAY},
+            {&TimeFunctions::dayV2, JITFunctionType::DAY},
+            {&TimeFunctions::dayV3, JITFunctionType::DAY},
+            {&TimeFunctions::hour, JITFunctionType::HOUR},
+            {&TimeFunctions::hourV2, JITFunctionType::HOUR},
+            {&TimeFunctions::minute, JITFunctionType::MINUTE},
+            {&TimeFunctions::minuteV2, JITFunctionType::MINUTE},
+            {&TimeFunctions::second, JITFunctionType::SECOND},
+            {&TimeFunctions::secondV2, JITFunctionType::SECOND},
+            {&TimeFunctions::to_days, JITFunctionType::TO_DAYS},
+            {&TimeFunctions::to_date, JITFunctionType::TO_DATE},
+            {&TimeFunctions::days_add, JITFunctionType::DAYS_ADD},
+            {&TimeFunctions::days_sub, JITFunctionType::DAYS_SUB},
+            {&TimeFunctions::hours_add, JITFunctionType::HOURS_ADD},
+            {&TimeFunctions::hours_sub, JITFunctionType::HOURS_SUB},
+            {&TimeFunctions::minutes_add, JITFunctionType::MINUTES_ADD},
+            {&TimeFunctions::minutes_sub, JITFunctionType::MINUTES_SUB},
+            {&TimeFunctions::seconds_add, JITFunctionType::SECONDS_ADD},
+            {&TimeFunctions::seconds_sub, JITFunctionType::SECONDS_SUB},
+            {&StringFunctions::length, JITFunctionType::LENGTH},
+            {&StringFunctions::starts_with, JITFunctionType::STARTS_WITH},
+            {&StringFunctions::ends_with, JITFunctionType::ENDS_WITH},
+    };
+    auto iter = jit_functions.find(function);
+    return iter == jit_functions.end() ? JITFunctionType::NONE : iter->second;
+}
+
+VectorizedFunctionCallExpr::VectorizedFunctionCallExpr(const TExprNode& node) : Expr(node) {
+    if (_fn.__isset.fid) {
+        const auto* fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
+        if (fn_desc != nullptr && fn_desc->scalar_function != nullptr) {
+            _jit_function_type = get_jit_function_type(fn_desc->scalar_function);
+        }
+    }
+}
 
 Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, starrocks::ExprContext* context) {
     RETURN_IF_ERROR(Expr::prepare(state, context));
@@ -155,6 +200,29 @@ bool VectorizedFunctionCallExpr::is_constant() const {
     return Expr::is_constant();
 }
 
+bool VectorizedFunctionCallExpr::is_compilable(RuntimeState* state) const {
+    return _jit_function_type != JITFunctionType::NONE && state->can_jit_expr(CompilableExprType::FUNCTION);
+}
+
+std::string VectorizedFunctionCallExpr::jit_func_name_impl(RuntimeState* state) const {
+    std::string name = "{" + _fn.name.function_name + "(";
+    for (size_t i = 0; i < _children.size(); i++) {
+        name += (i > 0 ? "," : "") + _children[i]->jit_func_name(state);
+    }
+    return name + ")}" + (is_constant() ? "c:" : "") + (is_nullable() ? "n:" : "") + type().debug_string();
+}
+
+StatusOr<LLVMDatum> VectorizedFunctionCallExpr::generate_ir_impl(ExprContext* context, JITContext* jit_ctx) {
+    std::vector<LogicalType> arg_types;
+    std::vector<LLVMDatum> args;
+    for (Expr* child : _children) {
+        arg_types.emplace_back(child->type().type);
+        ASSIGN_OR_RETURN(auto datum, child->generate_ir(context, jit_ctx));
+        args.emplace_back(datum);
+    }
+    return IRHelper::generate_function_ir(jit_ctx, _jit_function_type, arg_types, args, _type.type);
+}
+
 StatusOr<ColumnPtr> VectorizedFunctionCallExpr::evaluate_checked(starrocks::ExprContext* context, Chunk* ptr) {
     FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
 
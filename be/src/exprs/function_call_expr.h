@@ -17,6 +17,7 @@
 #include "common/object_pool.h"
 #include "exprs/builtin_functions.h"
 #include "exprs/expr.h"
+#include "exprs/jit/ir_helper.h"
 
 namespace starrocks {
 
@@ -36,6 +37,12 @@ public:
     bool ngram_bloom_filter(ExprContext* context, const BloomFilter* bf,
                             const NgramBloomFilterReaderOptions& reader_options) const override;
 
+    bool is_compilable(RuntimeState* state) const override;
+
+    std::string jit_func_name_impl(RuntimeState* state) const override;
+
+    StatusOr<LLVMDatum> generate_ir_impl(ExprContext* context, JITContext* jit_ctx) override;
+
 protected:
     [[nodiscard]] Status prepare(RuntimeState* state, ExprContext* context) override;
 
@@ -58,6 +65,10 @@ private:
     const FunctionDescriptor* _fn_desc{nullptr};
 
     bool _is_returning_random_value = false;
+
+    // The builtin function generated by IRHelper::generate_function_ir, it's resolved in the constructor,
+    // because the compilable exprs are replaced before prepare().
+    JITFunctionType _jit_function_type = JITFunctionType::NONE;
 };
 
 } // namespace starrocks
@@ -14,10 +14,14 @@
 
 #include "exprs/jit/ir_helper.h"
 
+#include <algorithm>
+
 #include "column/vectorized_fwd.h"
 #include "common/status.h"
 #include "common/statusor.h"
+#include "runtime/time_types.h"
 #include "types/logical_type.h"
+#include "util/slice.h"
 
 namespace starrocks {
 
@@ -50,11 +54,15 @@ StatusOr<llvm::Type*> IRHelper::logical_to_ir_type(llvm::IRBuilder<>& b, const L
         return b.getFloatTy();
     case TYPE_DOUBLE:
         return b.getDoubleTy();
+    case TYPE_DATE:
+        return b.getInt32Ty();
+    case TYPE_DATETIME:
+        return b.getInt64Ty();
     case TYPE_CHAR:
     case TYPE_VARCHAR:
+        // Same with Slice.
+        return llvm::StructType::get(b.getInt8PtrTy(), b.getInt64Ty());
     case TYPE_TIME:
-    case TYPE_DATE:
-    case TYPE_DATETIME:
     case TYPE_DECIMALV2:
     case TYPE_VARBINARY:
     default:
@@ -99,6 +107,14 @@ StatusOr<llvm::Value*> IRHelper::create_ir_number(llvm::IRBuilder<>& b, const Lo
     }
 }
 
+StatusOr<llvm::Value*> IRHelper::create_ir_string(llvm::Module& module, llvm::IRBuilder<>& b, const Slice& value) {
+    ASSIGN_OR_RETURN(auto* slice_type, logical_to_ir_type(b, TYPE_VARCHAR));
+    auto* data = b.CreateGlobalStringPtr(llvm::StringRef(value.data, value.size), "", 0, &module);
+    llvm::Value* slice = llvm::UndefValue::get(slice_type);
+    slice = b.CreateInsertValue(slice, data, {0});
+    return b.CreateInsertValue(slice, b.getInt64(value.size), {1});
+}
+
 StatusOr<llvm::Value*> IRHelper::load_ir_number(llvm::IRBuilder<>& b, const LogicalType& type, const uint8_t* value) {
     switch (type) {
     case TYPE_BOOLEAN:
@@ -204,4 +220,218 @@ llvm::Value* IRHelper::build_if_else(llvm::Value* condition, llvm::Type* return_
     return result_value;
 }
 
+// The same as date::to_date.
+static void julian_to_date(llvm::IRBuilder<>& b, llvm::Value* julian, llvm::Value** year, llvm::Value** month,
+                           llvm::Value** day) {
+    auto* is_zero_epoch = b.CreateICmpEQ(julian, b.getInt32(date::ZERO_EPOCH_JULIAN));
+
+    julian = b.CreateAdd(julian, b.getInt32(32044));
+    auto* quad = b.CreateSDiv(julian, b.getInt32(146097));
+    auto* extra =
+            b.CreateAdd(b.CreateMul(b.CreateSub(julian, b.CreateMul(quad, b.getInt32(146097))), b.getInt32(4)),
+                        b.getInt32(3));
+    julian = b.CreateAdd(julian, b.CreateAdd(b.getInt32(60), b.CreateAdd(b.CreateMul(quad, b.getInt32(3)),
+                                                                         b.CreateSDiv(extra, b.getInt32(146097)))));
+    quad = b.CreateSDiv(julian, b.getInt32(1461));
+    julian = b.CreateSub(julian, b.CreateMul(quad, b.getInt32(1461)));
+    auto* y = b.CreateSDiv(b.CreateMul(julian, b.getInt32(4)), b.getInt32(1461));
+    julian = b.CreateAdd(b.CreateSelect(b.CreateICmpNE(y, b.getInt32(0)),
+                                        b.CreateSRem(b.CreateAdd(julian, b.getInt32(305)), b.getInt32(365)),
+                                        b.CreateSRem(b.CreateAdd(julian, b.getInt32(306)), b.getInt32(366))),
+                         b.getInt32(123));
+    y = b.CreateAdd(y, b.CreateMul(quad, b.getInt32(4)));
+    quad = b.CreateSDiv(b.CreateMul(julian, b.getInt32(2141)), b.getInt32(65536));
+
+    auto* zero = b.getInt32(0);
+    *year = b.CreateSelect(is_zero_epoch, zero, b.CreateSub(y, b.getInt32(4800)));
+    *day = b.CreateSelect(is_zero_epoch, zero,
+                          b.CreateSub(julian, b.CreateSDiv(b.CreateMul(quad, b.getInt32(7834)), b.getInt32(256))));
+    *month = b.CreateSelect(
+            is_zero_epoch, zero,
+            b.CreateAdd(b.CreateSRem(b.CreateAdd(quad, b.getInt32(10)), b.getInt32(MONTHS_PER_YEAR)), b.getInt32(1)));
+}
+
+// The same as timestamp::to_julian.
+static llvm::Value* timestamp_to_julian(llvm::IRBuilder<>& b, llvm::Value* timestamp) {
+    return b.CreateTrunc(b.CreateLShr(timestamp, b.getInt64(TIMESTAMP_BITS)), b.getInt32Ty());
+}
+
+// The same as timestamp::to_time.
+static llvm::Value* timestamp_to_time(llvm::IRBuilder<>& b, llvm::Value* timestamp) {
+    return b.CreateAnd(timestamp, b.getInt64(TIMESTAMP_BITS_TIME));
+}
+
+// The same as timestamp::add<UNIT> of the units of a day or less, |usecs| is the number of microseconds to add.
+// Set |*invalid| to whether the result is out of the range of DATETIME.
+static llvm::Value* timestamp_add(llvm::IRBuilder<>& b, llvm::Value* timestamp, llvm::Value* days, llvm::Value* usecs,
+                                  llvm::Value** invalid) {
+    auto* julian = timestamp_to_julian(b, timestamp);
+    llvm::Value* time = timestamp_to_time(b, timestamp);
+    if (days != nullptr) {
+        julian = b.CreateAdd(julian, days);
+        julian = b.CreateSelect(b.CreateOr(b.CreateICmpSGT(julian, b.getInt32(date::MAX_DATE)),
+                                           b.CreateICmpSLT(julian, b.getInt32(date::MIN_DATE))),
+                                b.getInt32(date::INVALID_DATE), julian);
+    } else {
+        time = b.CreateAdd(time, usecs);
+        julian = b.CreateAdd(julian, b.CreateTrunc(b.CreateSDiv(time, b.getInt64(USECS_PER_DAY)), b.getInt32Ty()));
+        time = b.CreateSRem(time, b.getInt64(USECS_PER_DAY));
+        auto* negative = b.CreateICmpSLT(time, b.getInt64(0));
+        time = b.CreateSelect(negative, b.CreateAdd(time, b.getInt64(USECS_PER_DAY)), time);
+        julian = b.CreateSelect(negative, b.CreateSub(julian, b.getInt32(1)), julian);
+    }
+    auto* result = b.CreateOr(b.CreateShl(b.CreateSExt(julian, b.getInt64Ty()), b.getInt64(TIMESTAMP_BITS)), time);
+    // The same as TimestampValue::is_valid.
+    *invalid = b.CreateOr(b.CreateICmpSLT(result, b.getInt64(timestamp::MIN_TIMESTAMP)),
+                          b.CreateICmpSGT(result, b.getInt64(timestamp::MAX_TIMESTAMP)));
+    return result;
+}
+
+// Whether the |size| bytes of |lhs| and |rhs| are equal.
+static llvm::Value* bytes_equal(llvm::Module& module, llvm::IRBuilder<>& b, llvm::Value* lhs, llvm::Value* rhs,
+                                llvm::Value* size) {
+    // memcmp of a constant size, e.g. the prefix of a literal, is expanded into loads and compares by LLVM.
+    auto memcmp = module.getOrInsertFunction("memcmp", b.getInt32Ty(), b.getInt8PtrTy(), b.getInt8PtrTy(),
+                                             b.getInt64Ty());
+    return b.CreateICmpEQ(b.CreateCall(memcmp, {lhs, rhs, size}), b.getInt32(0));
+}
+
+StatusOr<LLVMDatum> IRHelper::generate_function_ir(JITContext* jit_ctx, JITFunctionType function,
+                                                   const std::vector<LogicalType>& arg_types,
+                                                   const std::vector<LLVMDatum>& args,
+                                                   const LogicalType& result_type) {
+    auto& b = jit_ctx->builder;
+    auto check_args = [&](std::initializer_list<LogicalType> types) {
+        if (arg_types.size() != types.size() || args.size() != types.size() ||
+            !std::equal(types.begin(), types.end(), arg_types.begin(), [](LogicalType lhs, LogicalType rhs) {
+                return lhs == rhs || (is_string_type(lhs) && is_string_type(rhs));
+            })) {
+            return Status::NotSupported("JIT function arguments not supported.");
+        }
+        return Status::OK();
+    };
+
+    LLVMDatum result(b);
+    for (const auto& arg : args) {
+        result.null_flag = b.CreateOr(result.null_flag, arg.null_flag);
+    }
+
+    switch (function) {
+    case JITFunctionType::YEAR:
+    case JITFunctionType::QUARTER:
+    case JITFunctionType::MONTH:
+    case JITFunctionType::DAY: {
+        llvm::Value* julian = nullptr;
+        if (check_args({TYPE_DATE}).ok()) {
+            julian = args[0].value;
+        } else {
+            RETURN_IF_ERROR(check_args({TYPE_DATETIME}));
+            julian = timestamp_to_julian(b, args[0].value);
+        }
+        llvm::Value *year, *month, *day;
+        julian_to_date(b, julian, &year, &month, &day);
+        if (function == JITFunctionType::YEAR) {
+            result.value = year;
+        } else if (function == JITFunctionType::QUARTER) {
+            result.value = b.CreateAdd(b.CreateSDiv(b.CreateSub(month, b.getInt32(1)), b.getInt32(3)), b.getInt32(1));
+        } else if (function == JITFunctionType::MONTH) {
+            result.value = month;
+        } else {
+            result.value = day;
+        }
+        break;
+    }
+    case JITFunctionType::HOUR:
+    case JITFunctionType::MINUTE:
+    case JITFunctionType::SECOND: {
+        RETURN_IF_ERROR(check_args({TYPE_DATETIME}));
+        auto* time = timestamp_to_time(b, args[0].value);
+        if (function == JITFunctionType::HOUR) {
+            result.value = b.CreateUDiv(time, b.getInt64(USECS_PER_HOUR));
+        } else if (function == JITFunctionType::MINUTE) {
+            result.value = b.CreateURem(b.CreateUDiv(time, b.getInt64(USECS_PER_MINUTE)), b.getInt64(MINS_PER_HOUR));
+        } else {
+            result.value = b.CreateURem(b.CreateUDiv(time, b.getInt64(USECS_PER_SEC)), b.getInt64(SECS_PER_MINUTE));
+        }
+        result.value = b.CreateTrunc(result.value, b.getInt32Ty());
+        break;
+    }
+    case JITFunctionType::TO_DAYS: {
+        RETURN_IF_ERROR(check_args({TYPE_DATE}));
+        result.value = b.CreateSub(args[0].value, b.getInt32(date::BC_EPOCH_JULIAN));
+        break;
+    }
+    case JITFunctionType::TO_DATE: {
+        RETURN_IF_ERROR(check_args({TYPE_DATETIME}));
+        result.value = timestamp_to_julian(b, args[0].value);
+        break;
+    }
+    case JITFunctionType::DAYS_ADD:
+    case JITFunctionType::DAYS_SUB:
+    case JITFunctionType::HOURS_ADD:
+    case JITFunctionType::HOURS_SUB:
+    case JITFunctionType::MINUTES_ADD:
+    case JITFunctionType::MINUTES_SUB:
+    case JITFunctionType::SECONDS_ADD:
+    case JITFunctionType::SECONDS_SUB: {
+        RETURN_IF_ERROR(check_args({TYPE_DATETIME, TYPE_INT}));
+        bool is_sub = function == JITFunctionType::DAYS_SUB || function == JITFunctionType::HOURS_SUB ||
+                      function == JITFunctionType::MINUTES_SUB || function == JITFunctionType::SECONDS_SUB;
+        auto* count = is_sub ? b.CreateNeg(args[1].value) : args[1].value;
+        llvm::Value* invalid = nullptr;
+        if (function == JITFunctionType::DAYS_ADD || function == JITFunctionType::DAYS_SUB) {
+            result.value = timestamp_add(b, args[0].value, count, nullptr, &invalid);
+        } else {
+            int64_t usecs_per_unit = USECS_PER_SEC;
+            if (function == JITFunctionType::HOURS_ADD || function == JITFunctionType::HOURS_SUB) {
+                usecs_per_unit = USECS_PER_HOUR;
+            } else if (function == JITFunctionType::MINUTES_ADD || function == JITFunctionType::MINUTES_SUB) {
+                usecs_per_unit = USECS_PER_MINUTE;
+            }
+            auto* usecs = b.CreateMul(b.CreateSExt(count, b.getInt64Ty()), b.getInt64(usecs_per_unit));
+            result.value = timestamp_add(b, args[0].value, nullptr, usecs, &invalid);
+        }
+        result.null_flag = b.CreateOr(result.null_flag, b.CreateZExt(invalid, b.getInt8Ty()));
+        break;
+    }
+    case JITFunctionType::LENGTH: {
+        RETURN_IF_ERROR(check_args({TYPE_VARCHAR}));
+        result.value = b.CreateTrunc(b.CreateExtractValue(args[0].value, {1}), b.getInt32Ty());
+        break;
+    }
+    case JITFunctionType::STARTS_WITH:
+    case JITFunctionType::ENDS_WITH: {
+        RETURN_IF_ERROR(check_args({TYPE_VARCHAR, TYPE_VARCHAR}));
+        auto* str = b.CreateExtractValue(args[0].value, {0});
+        auto* str_size = b.CreateExtractValue(args[0].value, {1});
+        auto* pattern = b.CreateExtractValue(args[1].value, {0});
+        auto* pattern_size = b.CreateExtractValue(args[1].value, {1});
+        auto* matched = build_if_else(
+                b.CreateICmpUGE(str_size, pattern_size), b.getInt1Ty(),
+                [&]() {
+                    auto* begin = str;
+                    if (function == JITFunctionType::ENDS_WITH) {
+                        begin = b.CreateInBoundsGEP(b.getInt8Ty(), str, b.CreateSub(str_size, pattern_size));
+                    }
+                    return bytes_equal(jit_ctx->module, b, begin, pattern, pattern_size);
+                },
+                [&]() { return b.getFalse(); }, &b);
+        result.value = b.CreateZExt(matched, b.getInt8Ty());
+        break;
+    }
+    default:
+        return Status::NotSupported("JIT function not supported.");
+    }
+
+    // The values are INT except the ones of DATETIME, DATE and BOOLEAN.
+    ASSIGN_OR_RETURN(auto* result_ir_type, logical_to_ir_type(b, result_type));
+    if (result.value->getType() != result_ir_type) {
+        if (!result_ir_type->isIntegerTy() || !is_integer_type(result_type)) {
+            return Status::NotSupported("JIT function result type not supported.");
+        }
+        result.value = b.CreateIntCast(result.value, result_ir_type, true);
+    }
+    return result;
+}
+
 } // namespace starrocks
\ No newline at end of file
@@ -24,6 +24,8 @@
 
 namespace starrocks {
 
+class Slice;
+
 /**
  * @brief The LLVMDatum struct is utilized to store the datum's value and nullity flag within LLVM IR.
  */
@@ -51,6 +53,14 @@ struct JITColumn {
  */
 using JITScalarFunction = void (*)(int64_t, JITColumn*);
 
+/**
+ * JITAggUpdateFunction is a function pointer to a JIT compiled update of aggregate states.
+ * @param int64_t: the number of rows.
+ * @param JITColumn*: the pointer to the input columns, one column per aggregate function.
+ * @param uint8_t**: the pointer to the aggregate states of the rows.
+ */
+using JITAggUpdateFunction = void (*)(int64_t, JITColumn*, uint8_t**);
+
 /**
  * @brief The LLVMDatum struct is utilized to store the column's values and nullity flags within LLVM IR.
  */
@@ -81,6 +91,39 @@ enum CompilableExprType : int32_t {
     LOGICAL = 32,
     DIV = 64,
     MOD = 128,
+    FUNCTION = 256, // builtin functions of JITFunctionType
+};
+
+// The builtin scalar functions whose IR is generated by IRHelper::generate_function_ir.
+enum class JITFunctionType : int32_t {
+    NONE = 0,
+    // DATE or DATETIME -> INT, date::to_date of the julian day.
+    YEAR,
+    QUARTER,
+    MONTH,
+    DAY,
+    // DATETIME -> INT
+    HOUR,
+    MINUTE,
+    SECOND,
+    // DATE -> INT
+    TO_DAYS,
+    // DATETIME -> DATE
+    TO_DATE,
+    // (DATETIME, INT) -> DATETIME, null if the result is out of the range of DATETIME.
+    DAYS_ADD,
+    DAYS_SUB,
+    HOURS_ADD,
+    HOURS_SUB,
+    MINUTES_ADD,
+    MINUTES_SUB,
+    SECONDS_ADD,
+    SECONDS_SUB,
+    // VARCHAR -> INT, the length in bytes.
+    LENGTH,
+    // (VARCHAR, VARCHAR) -> BOOLEAN
+    STARTS_WITH,
+    ENDS_WITH,
 };
 
 class IRHelper {
@@ -93,6 +136,7 @@ public:
     /**
      * @brief Convert a logical type to its corresponding LLVM IR type.
      * Since the kinds of LLVM IR types can change depending on the hardware we use, we need a flexible method that can adapt to these differences.
+     * DATE and DATETIME are their julian days and timestamps, and string types are the struct of Slice.
      */
     static StatusOr<llvm::Type*> logical_to_ir_type(llvm::IRBuilder<>& b, const LogicalType& type);
 
@@ -101,6 +145,11 @@ public:
      */
     static StatusOr<llvm::Value*> create_ir_number(llvm::IRBuilder<>& b, const LogicalType& type, int64_t value);
 
+    /**
+     * @brief Create a LLVM IR value of a string type from a C++ string, whose bytes are a constant of |module|.
+     */
+    static StatusOr<llvm::Value*> create_ir_string(llvm::Module& module, llvm::IRBuilder<>& b, const Slice& value);
+
     // cast bool of int8 to llvm bool int1
     static llvm::Value* bool_to_cond(llvm::IRBuilder<>& b, llvm::Value* int8) {
         return b.CreateICmpNE(int8, llvm::ConstantInt::get(int8->getType(), 0));
@@ -118,6 +167,14 @@ public:
                                       const std::function<llvm::Value*()>& then_func,
                                       const std::function<llvm::Value*()>& else_func, llvm::IRBuilder<>* builder);
 
+    /**
+     * @brief Generate the IR of a builtin scalar function on the IR of its arguments, which are the values of
+     * |arg_types|. The function is strict: the result is null if any argument is null.
+     */
+    static StatusOr<LLVMDatum> generate_function_ir(JITContext* jit_ctx, JITFunctionType function,
+                                                    const std::vector<LogicalType>& arg_types,
+                                                    const std::vector<LLVMDatum>& args, const LogicalType& result_type);
+
     static constexpr double jit_score_ratio = 0.88; // whether the expr can be jit
 };
 
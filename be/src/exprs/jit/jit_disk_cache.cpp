@@ -0,0 +1,209 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/jit/jit_disk_cache.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "fs/fs.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/slice.h"
+#include "util/xxh3.h"
+
+namespace starrocks {
+
+static constexpr std::string_view kObjectFileSuffix = ".o";
+static constexpr std::string_view kTmpFileSuffix = ".tmp";
+
+std::string JitDiskCache::_file_name(const std::string& key) const {
+    return fmt::format("{:016x}{}", XXH3_64bits(key.data(), key.size()), kObjectFileSuffix);
+}
+
+Status JitDiskCache::_load_index() {
+    if (_index_loaded) {
+        return Status::OK();
+    }
+    auto* fs = FileSystem::Default();
+    RETURN_IF_ERROR(fs->create_dir_recursive(_dir));
+    struct File {
+        std::string name;
+        int64_t mtime;
+        int64_t size;
+    };
+    std::vector<File> files;
+    std::vector<std::string> tmp_files;
+    RETURN_IF_ERROR(fs->iterate_dir2(_dir, [&](DirEntry entry) {
+        if (entry.is_dir.value_or(false)) {
+            return true;
+        }
+        if (entry.name.ends_with(kTmpFileSuffix)) {
+            // left by a crash while writing
+            tmp_files.emplace_back(entry.name);
+        } else if (entry.name.ends_with(kObjectFileSuffix)) {
+            files.push_back({std::string(entry.name), entry.mtime.value_or(0), entry.size.value_or(0)});
+        }
+        return true;
+    }));
+    for (const auto& name : tmp_files) {
+        WARN_IF_ERROR(fs->delete_file(_dir + "/" + name), "failed to delete the tmp file of JIT cache");
+    }
+    // the most recently written file is at the front
+    std::sort(files.begin(), files.end(), [](const File& lhs, const File& rhs) { return lhs.mtime > rhs.mtime; });
+    for (auto& file : files) {
+        _size += file.size;
+        _lru.push_back(file.name);
+        _entries[file.name] = Entry{std::prev(_lru.end()), file.size};
+    }
+    _index_loaded = true;
+    LOG(INFO) << "JIT disk cache loaded, dir = " << _dir << ", objects = " << _entries.size() << ", size = " << _size;
+    return Status::OK();
+}
+
+void JitDiskCache::_touch(const std::string& name) {
+    auto iter = _entries.find(name);
+    if (iter != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, iter->second.lru_pos);
+    }
+}
+
+void JitDiskCache::_evict() {
+    int64_t capacity = _capacity.load();
+    while (_size > capacity && !_lru.empty()) {
+        const auto& name = _lru.back();
+        WARN_IF_ERROR(FileSystem::Default()->delete_file(_dir + "/" + name), "failed to evict JIT cache file");
+        _size -= _entries[name].size;
+        _entries.erase(name);
+        _lru.pop_back();
+    }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> JitDiskCache::lookup(const std::string& key) {
+    auto name = _file_name(key);
+    {
+        std::lock_guard lock(_mutex);
+        auto st = _load_index();
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to load JIT disk cache: " << st;
+            return nullptr;
+        }
+        if (_entries.find(name) == _entries.end()) {
+            return nullptr;
+        }
+        _touch(name);
+    }
+
+    // The file may be evicted by another thread, which is a miss.
+    auto file = FileSystem::Default()->new_random_access_file(_dir + "/" + name);
+    if (!file.ok()) {
+        return nullptr;
+    }
+    auto content = (*file)->read_all();
+    if (!content.ok() || content->size() < sizeof(uint32_t)) {
+        return nullptr;
+    }
+    // [key size][key][checksum of the object][object]
+    uint32_t key_size = decode_fixed32_le(reinterpret_cast<const uint8_t*>(content->data()));
+    size_t offset = sizeof(uint32_t) + key_size + sizeof(uint32_t);
+    if (content->size() < offset || std::string_view(content->data() + sizeof(uint32_t), key_size) != key) {
+        return nullptr;
+    }
+    auto* checksum_pos = reinterpret_cast<const uint8_t*>(content->data()) + offset - sizeof(uint32_t);
+    uint32_t checksum = decode_fixed32_le(checksum_pos);
+    if (crc32c::Value(content->data() + offset, content->size() - offset) != checksum) {
+        LOG(WARNING) << "checksum mismatch of JIT cache file " << _dir << "/" << name;
+        return nullptr;
+    }
+    return llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(content->data() + offset, content->size() - offset),
+                                                name);
+}
+
+Status JitDiskCache::insert(const std::string& key, llvm::MemoryBufferRef obj_code) {
+    auto name = _file_name(key);
+    {
+        std::lock_guard lock(_mutex);
+        RETURN_IF_ERROR(_load_index());
+    }
+
+    // Write a tmp file and rename it, so a crash never leaves a partial object.
+    std::string path = _dir + "/" + name;
+    static std::atomic<uint64_t> tmp_file_seq{0};
+    std::string tmp_path = fmt::format("{}.{}{}", path, tmp_file_seq.fetch_add(1), kTmpFileSuffix);
+    std::string header;
+    put_fixed32_le(&header, static_cast<uint32_t>(key.size()));
+    header.append(key);
+    put_fixed32_le(&header, crc32c::Value(obj_code.getBufferStart(), obj_code.getBufferSize()));
+    auto* fs = FileSystem::Default();
+    {
+        ASSIGN_OR_RETURN(auto file, fs->new_writable_file(tmp_path));
+        Slice data[2] = {Slice(header), Slice(obj_code.getBufferStart(), obj_code.getBufferSize())};
+        auto st = file->appendv(data, 2);
+        if (st.ok()) {
+            // the object must be on disk before the rename makes it visible
+            st = file->sync();
+        }
+        if (st.ok()) {
+            st = file->close();
+        }
+        if (!st.ok()) {
+            WARN_IF_ERROR(fs->delete_file(tmp_path), "failed to delete the tmp file of JIT cache");
+            return st;
+        }
+    }
+    RETURN_IF_ERROR(fs->rename_file(tmp_path, path));
+
+    std::lock_guard lock(_mutex);
+    int64_t size = header.size() + obj_code.getBufferSize();
+    auto iter = _entries.find(name);
+    if (iter != _entries.end()) {
+        _size -= iter->second.size;
+        iter->second.size = size;
+        _touch(name);
+    } else {
+        _lru.push_front(name);
+        _entries[name] = Entry{_lru.begin(), size};
+    }
+    _size += size;
+    _evict();
+    return Status::OK();
+}
+
+void JitDiskCache::erase(const std::string& key) {
+    auto name = _file_name(key);
+    std::lock_guard lock(_mutex);
+    auto iter = _entries.find(name);
+    if (iter == _entries.end()) {
+        return;
+    }
+    WARN_IF_ERROR(FileSystem::Default()->delete_file(_dir + "/" + name), "failed to delete JIT cache file");
+    _size -= iter->second.size;
+    _lru.erase(iter->second.lru_pos);
+    _entries.erase(iter);
+}
+
+int64_t JitDiskCache::size() const {
+    std::lock_guard lock(_mutex);
+    return _size;
+}
+
+size_t JitDiskCache::num_objects() const {
+    std::lock_guard lock(_mutex);
+    return _entries.size();
+}
+
+} // namespace starrocks
@@ -0,0 +1,85 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+// JitDiskCache keeps the object code compiled by JITEngine in a local directory, so the functions compiled
+// once are shared by the queries, and survive the evictions of the LRU cache and the restarts of BE.
+//
+// Every object is a file named by the hash of its key:
+//     ObjectFile := KeySize(uint32), Key, Checksum(uint32), ObjectCode
+// The key is kept in the file to tell the objects of the same hash apart, and the crc32c of the object code
+// is checked on lookup, so a corrupted file is a miss.
+//
+// The files are indexed on the first access, and the least recently used ones are removed when the total
+// size exceeds the capacity.
+class JitDiskCache {
+public:
+    // |capacity| is the max total size in bytes of the files.
+    JitDiskCache(std::string dir, int64_t capacity) : _dir(std::move(dir)), _capacity(capacity) {}
+
+    // Return the object code of |key|, nullptr if not cached.
+    std::unique_ptr<llvm::MemoryBuffer> lookup(const std::string& key);
+
+    Status insert(const std::string& key, llvm::MemoryBufferRef obj_code);
+
+    void erase(const std::string& key);
+
+    // Remove the least recently used files beyond the new capacity at the next insert().
+    void set_capacity(int64_t capacity) { _capacity = capacity; }
+
+    int64_t size() const;
+
+    size_t num_objects() const;
+
+private:
+    struct Entry {
+        std::list<std::string>::iterator lru_pos;
+        int64_t size;
+    };
+
+    Status _load_index();
+
+    std::string _file_name(const std::string& key) const;
+
+    void _touch(const std::string& name);
+
+    void _evict();
+
+    const std::string _dir;
+    std::atomic<int64_t> _capacity;
+
+    mutable std::mutex _mutex;
+    bool _index_loaded = false;
+    // file names, the most recently used one is at the front
+    std::list<std::string> _lru;
+    std::unordered_map<std::string, Entry> _entries;
+    int64_t _size = 0;
+};
+
+} // namespace starrocks
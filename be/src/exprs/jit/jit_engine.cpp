@@ -15,10 +15,12 @@
 #include "exprs/jit/jit_engine.h"
 
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 #include <glog/logging.h>
 #include <llvm/Analysis/Passes.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
@@ -54,6 +56,7 @@
 #include <llvm/Transforms/Vectorize/LoopVectorize.h>
 #include <llvm/Transforms/Vectorize/SLPVectorizer.h>
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -61,19 +64,21 @@
 #include "common/compiler_util.h"
 #include "common/config.h"
 #include "common/status.h"
+#include "exprs/agg/aggregate.h"
 #include "exprs/expr.h"
+#include "exprs/jit/jit_disk_cache.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "util/defer_op.h"
 #include "util/mem_info.h"
+#include "util/xxh3.h"
 
 namespace starrocks {
 
 struct JitCacheEntry {
-    JitCacheEntry(std::shared_ptr<llvm::MemoryBuffer> buff, JITScalarFunction f)
-            : obj_buff(std::move(buff)), func(std::move(f)) {}
+    JitCacheEntry(std::shared_ptr<llvm::MemoryBuffer> buff, void* f) : obj_buff(std::move(buff)), func(f) {}
     std::shared_ptr<llvm::MemoryBuffer> obj_buff;
-    JITScalarFunction func;
+    void* func;
 };
 
 JitObjectCache::JitObjectCache(const std::string& expr_name, Cache* cache)
@@ -85,18 +90,17 @@ void JitObjectCache::notifyObjectCompiled(const llvm::Module* M, llvm::MemoryBuf
     _obj_code = std::move(obj_buffer);
 }
 
-Status JitObjectCache::register_func(JITScalarFunction func) {
+Status JitObjectCache::register_func(void* func) {
     bool cached = JITEngine::get_instance()->lookup_function(this);
     if (cached) {
         return Status::OK();
     }
-    _func = func;
     if (_obj_code == nullptr) {
         return Status::JitCompileError("JIT register must wait notifyObjectCompiled()");
     }
     auto cache_func_size = _obj_code->getBufferSize();
     // put into LRU cache
-    auto* cache = new JitCacheEntry(_obj_code, _func);
+    auto* cache = new JitCacheEntry(_obj_code, func);
     GlobalEnv::GetInstance()->jit_cache_mem_tracker()->consume(cache_func_size);
     auto* handle = _lru_cache->insert(_cache_key, (void*)cache, cache_func_size, [](const CacheKey& key, void* value) {
         auto* entry = ((JitCacheEntry*)value);
@@ -112,6 +116,8 @@ Status JitObjectCache::register_func(JITScalarFunction func) {
         // as caller holds the shared ptr of obj_buff, the function ptr is valid, so the handle can be released here.
         _lru_cache->release(handle);
     }
+    // publish the function after the object code is kept, it may be read by other threads
+    _func = func;
     return Status::OK();
 }
 
@@ -157,6 +163,30 @@ Status JITEngine::init() {
     llvm::InitializeNativeTargetAsmParser();
     llvm::InitializeNativeTargetDisassembler();
     llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+
+    // The object code is only reusable on the same CPU and by the same LLVM.
+    _host_key = fmt::format("{}|{}", llvm::sys::getHostCPUName().str(), LLVM_VERSION_STRING);
+    llvm::StringMap<bool> host_features;
+    if (llvm::sys::getHostCPUFeatures(host_features)) {
+        std::vector<std::string> features;
+        for (const auto& feature : host_features) {
+            features.emplace_back(fmt::format("{}{}", feature.second ? '+' : '-', feature.first().str()));
+        }
+        std::sort(features.begin(), features.end());
+        _host_key += fmt::format("|{}", fmt::join(features, ","));
+    }
+#ifndef BE_TEST
+    if (config::jit_disk_cache_capacity > 0 && !config::jit_disk_cache_path.empty()) {
+        _disk_cache = std::make_unique<JitDiskCache>(config::jit_disk_cache_path, config::jit_disk_cache_capacity);
+        LOG(INFO) << "JIT disk cache path = " << config::jit_disk_cache_path
+                  << ", capacity = " << config::jit_disk_cache_capacity;
+    }
+#endif
+    RETURN_IF_ERROR(ThreadPoolBuilder("jit_compile")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(1, config::jit_async_compile_threads))
+                            .set_max_queue_size(1024)
+                            .build(&_compile_pool));
     _initialized = true;
     _support_jit = true;
     return Status::OK();
@@ -178,17 +208,90 @@ Status JITEngine::compile_scalar_function(ExprContext* context, JitObjectCache*
     // TODO: check need set module?
     // generate ir to module
     RETURN_IF_ERROR(generate_scalar_function_ir(context, *engine->module(), expr, uncompilable_exprs, func_cache));
-    // optimize module and add module
-    RETURN_IF_ERROR(engine->optimize_and_finalize_module());
-    cached = instance->lookup_function(func_cache);
+    return compile_module(engine.get(), func_cache);
+}
+
+Status JITEngine::compile_scalar_function_async(ExprContext* context, std::shared_ptr<JitObjectCache> func_cache,
+                                                Expr* expr, const std::vector<Expr*>& uncompilable_exprs) {
+    auto* instance = JITEngine::get_instance();
+    if (UNLIKELY(!instance->initialized())) {
+        return Status::JitCompileError("JIT engine is not initialized");
+    }
+
+    auto cached = instance->lookup_function(func_cache.get());
+    if (cached) {
+        return Status::OK();
+    }
+
+    // The IR depends on the exprs, which may be released before the compilation, so it's generated here.
+    ASSIGN_OR_RETURN(auto created, Engine::create(*func_cache))
+    std::shared_ptr<Engine> engine = std::move(created);
+    RETURN_IF_ERROR(
+            generate_scalar_function_ir(context, *engine->module(), expr, uncompilable_exprs, func_cache.get()));
+    return instance->_compile_pool->submit_func([engine, func_cache]() {
+        auto st = compile_module(engine.get(), func_cache.get());
+        if (!st.ok()) {
+            LOG(WARNING) << "JIT async compile failed, func = " << func_cache->get_func_name() << ", error = " << st;
+        }
+    });
+}
+
+Status JITEngine::compile_module(Engine* engine, JitObjectCache* func_cache) {
+    auto* instance = JITEngine::get_instance();
+    auto* disk_cache = instance->_disk_cache.get();
+    std::string disk_key;
+    bool from_disk = false;
+    if (disk_cache != nullptr) {
+        disk_key = instance->disk_cache_key(*engine->module(), func_cache->get_func_name());
+        auto obj_code = disk_cache->lookup(disk_key);
+        if (obj_code != nullptr) {
+            func_cache->notifyObjectCompiled(nullptr, obj_code->getMemBufferRef());
+            auto st = engine->add_object(std::move(obj_code));
+            if (!st.ok()) {
+                LOG(WARNING) << "JIT failed to load object from disk cache, func = " << func_cache->get_func_name()
+                             << ", error = " << st;
+                disk_cache->erase(disk_key);
+                return st;
+            }
+            from_disk = true;
+        }
+    }
+    if (!from_disk) {
+        // optimize module and add module
+        RETURN_IF_ERROR(engine->optimize_and_finalize_module());
+    }
+    auto cached = instance->lookup_function(func_cache);
     if (cached) {
         return Status::OK();
     }
     ASSIGN_OR_RETURN(auto function, engine->get_compiled_func(func_cache->get_func_name()));
     RETURN_IF_ERROR(func_cache->register_func(function));
+    if (disk_cache != nullptr && !from_disk && func_cache->get_obj_code() != nullptr) {
+        disk_cache->set_capacity(config::jit_disk_cache_capacity);
+        auto st = disk_cache->insert(disk_key, func_cache->get_obj_code()->getMemBufferRef());
+        if (!st.ok()) {
+            LOG(WARNING) << "JIT failed to write disk cache, func = " << func_cache->get_func_name()
+                         << ", error = " << st;
+        }
+    }
     return Status::OK();
 }
 
+std::string JITEngine::disk_cache_key(const llvm::Module& module, const std::string& func_name) const {
+    // The module id is unique for every engine, so only the globals and the functions are hashed.
+    std::string ir;
+    llvm::raw_string_ostream stream(ir);
+    for (const auto& global : module.globals()) {
+        global.print(stream);
+        stream << "\n";
+    }
+    for (const auto& function : module.functions()) {
+        function.print(stream);
+    }
+    stream.flush();
+    return fmt::format("{}|{:016x}|{}", func_name, XXH3_64bits(ir.data(), ir.size()), _host_key);
+}
+
 std::string JITEngine::dump_module_ir(const llvm::Module& module) {
     std::string ir;
     llvm::raw_string_ostream stream(ir);
@@ -271,6 +374,167 @@ Status JITEngine::generate_scalar_function_ir(ExprContext* context, llvm::Module
     return Status::OK();
 }
 
+Status JITEngine::compile_agg_update_function(const std::vector<AggStateUpdateLayout>& layouts,
+                                              JitObjectCache* func_cache) {
+    auto* instance = JITEngine::get_instance();
+    if (UNLIKELY(!instance->initialized())) {
+        return Status::JitCompileError("JIT engine is not initialized");
+    }
+
+    auto cached = instance->lookup_function(func_cache);
+    if (cached) {
+        return Status::OK();
+    }
+
+    ASSIGN_OR_RETURN(auto engine, Engine::create(*func_cache))
+    RETURN_IF_ERROR(generate_agg_update_function_ir(*engine->module(), layouts, func_cache));
+    return compile_module(engine.get(), func_cache);
+}
+
+std::string JITEngine::agg_update_func_name(const std::vector<AggStateUpdateLayout>& layouts) {
+    std::string name = "agg_update";
+    for (const auto& layout : layouts) {
+        name += fmt::format("[{}:{}:{}:{}:{}:{}:{}]", static_cast<int>(layout.kind),
+                            static_cast<int>(layout.input_type), static_cast<int>(layout.value_type),
+                            layout.value_offset, layout.count_offset, layout.skip_null, layout.null_flag_offset);
+    }
+    return name;
+}
+
+// Generate the update of the state at |state| by the |row|-th value of |column|.
+static Status generate_state_update_ir(llvm::IRBuilder<>& b, const AggStateUpdateLayout& layout,
+                                       const LLVMColumn& column, llvm::Value* row, llvm::Value* state) {
+    if (layout.null_flag_offset >= 0) {
+        // Pseudo code: state->is_null = false;
+        b.CreateStore(b.getInt8(0), b.CreateConstInBoundsGEP1_64(b.getInt8Ty(), state, layout.null_flag_offset));
+    }
+    ASSIGN_OR_RETURN(auto* value_type, IRHelper::logical_to_ir_type(b, layout.value_type));
+    auto* value_ptr = b.CreateConstInBoundsGEP1_64(b.getInt8Ty(), state, layout.value_offset);
+    auto* current = b.CreateLoad(value_type, value_ptr);
+    llvm::Value* input = nullptr;
+    if (layout.input_type != TYPE_NULL) {
+        input = b.CreateLoad(column.value_type, b.CreateInBoundsGEP(column.value_type, column.values, row));
+    }
+
+    llvm::Value* result = nullptr;
+    switch (layout.kind) {
+    case AggStateUpdateLayout::COUNT:
+        // Pseudo code: state->count++;
+        result = b.CreateAdd(current, llvm::ConstantInt::get(value_type, 1));
+        break;
+    case AggStateUpdateLayout::SUM:
+    case AggStateUpdateLayout::AVG: {
+        // Pseudo code: state->sum += value;
+        ASSIGN_OR_RETURN(auto* value, IRHelper::cast_to_type(b, input, layout.input_type, layout.value_type));
+        result = value_type->isFloatingPointTy() ? b.CreateFAdd(current, value) : b.CreateAdd(current, value);
+        if (layout.kind == AggStateUpdateLayout::AVG) {
+            // Pseudo code: state->count++;
+            auto* count_ptr = b.CreateConstInBoundsGEP1_64(b.getInt8Ty(), state, layout.count_offset);
+            auto* count = b.CreateLoad(b.getInt64Ty(), count_ptr);
+            b.CreateStore(b.CreateAdd(count, b.getInt64(1)), count_ptr);
+        }
+        break;
+    }
+    case AggStateUpdateLayout::MAX: {
+        // Same with std::max, pseudo code: state->result = state->result < value ? value : state->result;
+        auto* less = value_type->isFloatingPointTy() ? b.CreateFCmpOLT(current, input) : b.CreateICmpSLT(current, input);
+        result = b.CreateSelect(less, input, current);
+        break;
+    }
+    case AggStateUpdateLayout::MIN: {
+        // Same with std::min, pseudo code: state->result = value < state->result ? value : state->result;
+        auto* less = value_type->isFloatingPointTy() ? b.CreateFCmpOLT(input, current) : b.CreateICmpSLT(input, current);
+        result = b.CreateSelect(less, input, current);
+        break;
+    }
+    }
+    b.CreateStore(result, value_ptr);
+    return Status::OK();
+}
+
+Status JITEngine::generate_agg_update_function_ir(llvm::Module& module,
+                                                  const std::vector<AggStateUpdateLayout>& layouts,
+                                                  JitObjectCache* obj) {
+    llvm::IRBuilder<> b(module.getContext());
+
+    /// Create function type.
+    auto* size_type = b.getInt64Ty();
+    // Same with JITColumn.
+    auto* data_type = llvm::StructType::get(b.getInt8PtrTy(), b.getInt8PtrTy());
+    auto* state_type = b.getInt8PtrTy();
+    // Same with JITAggUpdateFunction.
+    auto* func_type = llvm::FunctionType::get(
+            b.getVoidTy(), {size_type, data_type->getPointerTo(), state_type->getPointerTo()}, false);
+
+    /// Create function in module.
+    // Pseudo code: void "agg_update..."(int64_t rows_count, JITColumn* columns, AggDataPtr* states);
+    auto* func = llvm::Function::Create(func_type, llvm::Function::ExternalLinkage, obj->get_func_name(), module);
+    auto* func_args = func->args().begin();
+    llvm::Value* rows_count_arg = func_args++;
+    llvm::Value* columns_arg = func_args++;
+    llvm::Value* states_arg = func_args++;
+
+    auto* entry = llvm::BasicBlock::Create(b.getContext(), "entry", func);
+    b.SetInsertPoint(entry);
+
+    // Extract the input column of every function.
+    std::vector<LLVMColumn> columns(layouts.size());
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        auto* jit_column = b.CreateLoad(data_type, b.CreateConstInBoundsGEP1_64(data_type, columns_arg, i));
+        columns[i].values = b.CreateExtractValue(jit_column, {0});
+        columns[i].null_flags = b.CreateExtractValue(jit_column, {1});
+        if (layouts[i].input_type != TYPE_NULL) {
+            ASSIGN_OR_RETURN(columns[i].value_type, IRHelper::logical_to_ir_type(b, layouts[i].input_type));
+        }
+    }
+
+    /// Initialize loop.
+    auto* end = llvm::BasicBlock::Create(b.getContext(), "end", func);
+    auto* loop = llvm::BasicBlock::Create(b.getContext(), "loop", func);
+
+    b.CreateBr(loop);
+    b.SetInsertPoint(loop);
+    /// Loop.
+    // Pseudo code: for (int64_t counter = 0; counter < rows_count; counter++)
+    auto* counter_phi = b.CreatePHI(rows_count_arg->getType(), 2);
+    counter_phi->addIncoming(llvm::ConstantInt::get(size_type, 0), entry);
+
+    // Pseudo code: AggDataPtr state = states[counter];
+    auto* state = b.CreateLoad(state_type, b.CreateInBoundsGEP(state_type, states_arg, counter_phi));
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        llvm::BasicBlock* next = nullptr;
+        if (layouts[i].skip_null) {
+            // Pseudo code: if (null_flags[counter]) goto next;
+            auto* update = llvm::BasicBlock::Create(b.getContext(), "update", func);
+            next = llvm::BasicBlock::Create(b.getContext(), "next", func);
+            auto* null_flag =
+                    b.CreateLoad(b.getInt8Ty(), b.CreateInBoundsGEP(b.getInt8Ty(), columns[i].null_flags, counter_phi));
+            b.CreateCondBr(IRHelper::bool_to_cond(b, null_flag), next, update);
+            b.SetInsertPoint(update);
+        }
+        RETURN_IF_ERROR(generate_state_update_ir(b, layouts[i], columns[i], counter_phi, state));
+        if (next != nullptr) {
+            b.CreateBr(next);
+            b.SetInsertPoint(next);
+        }
+    }
+
+    /// End of loop.
+    auto* current_block = b.GetInsertBlock();
+    // Pseudo code: counter++;
+    auto* incremeted_counter = b.CreateAdd(counter_phi, llvm::ConstantInt::get(size_type, 1));
+    counter_phi->addIncoming(incremeted_counter, current_block);
+
+    // Pseudo code: if (counter == rows_count) goto end;
+    b.CreateCondBr(b.CreateICmpEQ(incremeted_counter, rows_count_arg), end, loop);
+
+    b.SetInsertPoint(end);
+    // Pseudo code: return;
+    b.CreateRetVoid();
+
+    return Status::OK();
+}
+
 bool JITEngine::lookup_function(JitObjectCache* const obj) {
     auto* handle = _func_cache->lookup(obj->get_func_name());
     if (handle == nullptr) {
@@ -441,7 +705,17 @@ Status JITEngine::Engine::optimize_and_finalize_module() {
     return Status::OK();
 }
 
-StatusOr<JITScalarFunction> JITEngine::Engine::get_compiled_func(const std::string& function) {
+Status JITEngine::Engine::add_object(std::unique_ptr<llvm::MemoryBuffer> obj_code) {
+    auto err = _lljit->addObjectFile(std::move(obj_code));
+    if (err) {
+        return Status::JitCompileError("Failed to add object to LLJIT: " + llvm::toString(std::move(err)));
+    }
+    _module.reset();
+    _module_finalized = true;
+    return Status::OK();
+}
+
+StatusOr<void*> JITEngine::Engine::get_compiled_func(const std::string& function) {
     if (!_module_finalized) {
         return Status::JitCompileError("module must be finalized before getting compiled function");
     }
@@ -450,7 +724,7 @@ StatusOr<JITScalarFunction> JITEngine::Engine::get_compiled_func(const std::stri
         return Status::JitCompileError("Failed to look up function: " + function +
                                        " error: " + llvm::toString(sym.takeError()));
     }
-    JITScalarFunction fn_ptr = sym->toPtr<JITScalarFunction>();
+    void* fn_ptr = sym->toPtr<void*>();
     if (fn_ptr == nullptr) {
         return Status::JitCompileError("Failed to get address for function: " + function);
     }
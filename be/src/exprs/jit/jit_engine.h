@@ -21,6 +21,7 @@
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -31,9 +32,13 @@
 #include "exprs/expr_context.h"
 #include "exprs/jit/ir_helper.h"
 #include "util/lru_cache.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
+struct AggStateUpdateLayout;
+class JitDiskCache;
+
 // cache the compiled code, and register to the LRU cache
 class JitObjectCache : public llvm::ObjectCache {
 public:
@@ -45,21 +50,27 @@ public:
 
     std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* M) override;
 
-    Status register_func(JITScalarFunction func);
+    // |func| is the address of the compiled function, which is a JITScalarFunction or a JITAggUpdateFunction.
+    Status register_func(void* func);
 
     const std::string& get_func_name() const { return _cache_key; };
 
-    void set_cache(std::shared_ptr<llvm::MemoryBuffer> obj_code, JITScalarFunction func) {
+    void set_cache(std::shared_ptr<llvm::MemoryBuffer> obj_code, void* func) {
         _obj_code = std::move(obj_code);
         _func = func;
     }
-    JITScalarFunction get_func() const { return _func; }
+    // The function is set by another thread if it's compiled asynchronously, nullptr until it's ready.
+    JITScalarFunction get_func() const { return reinterpret_cast<JITScalarFunction>(_func.load()); }
+
+    JITAggUpdateFunction get_agg_update_func() const { return reinterpret_cast<JITAggUpdateFunction>(_func.load()); }
 
     size_t get_code_size() const { return _obj_code == nullptr ? 0 : _obj_code->getBufferSize(); }
 
+    const std::shared_ptr<llvm::MemoryBuffer>& get_obj_code() const { return _obj_code; }
+
 private:
     const std::string _cache_key;
-    JITScalarFunction _func = nullptr;
+    std::atomic<void*> _func = nullptr;
     Cache* _lru_cache = nullptr;
     std::shared_ptr<llvm::MemoryBuffer> _obj_code = nullptr;
 };
@@ -90,6 +101,19 @@ public:
     static Status compile_scalar_function(ExprContext* context, JitObjectCache* obj, Expr* expr,
                                           const std::vector<Expr*>& uncompilable_exprs);
 
+    // Compile the expr like compile_scalar_function(), but only the IR is generated by the caller, the
+    // optimization and the code generation run in the background, and the function of |obj| is set when
+    // it's ready.
+    static Status compile_scalar_function_async(ExprContext* context, std::shared_ptr<JitObjectCache> obj, Expr* expr,
+                                                const std::vector<Expr*>& uncompilable_exprs);
+
+    // Compile the state updates of the aggregate functions of |layouts| into one loop over the chunk, and
+    // register the compiled function into LRU cache.
+    static Status compile_agg_update_function(const std::vector<AggStateUpdateLayout>& layouts, JitObjectCache* obj);
+
+    // The name of the compiled update of |layouts|, which is the key of LRU cache.
+    static std::string agg_update_func_name(const std::vector<AggStateUpdateLayout>& layouts);
+
     bool lookup_function(JitObjectCache* const obj);
 
     Cache* get_func_cache() const { return _func_cache; }
@@ -102,8 +126,14 @@ public:
         return _func_cache->get_memory_usage();
     }
 
+    static Status generate_agg_update_function_ir(llvm::Module& module, const std::vector<AggStateUpdateLayout>& layouts,
+                                                  JitObjectCache* obj);
+
     static std::string dump_module_ir(const llvm::Module& module);
 
+    // The persistent cache of the object code, nullptr if disabled.
+    JitDiskCache* get_disk_cache() const { return _disk_cache.get(); }
+
 private:
     // make an engine instance for each time of JIT
     class Engine {
@@ -120,7 +150,10 @@ private:
 
         Status optimize_and_finalize_module();
 
-        StatusOr<JITScalarFunction> get_compiled_func(const std::string& function);
+        StatusOr<void*> get_compiled_func(const std::string& function);
+
+        // Add the object code compiled from the module before, instead of the module.
+        Status add_object(std::unique_ptr<llvm::MemoryBuffer> obj_code);
 
     private:
         Engine(std::unique_ptr<llvm::orc::LLJIT> lljit, std::unique_ptr<llvm::TargetMachine> target_machine);
@@ -134,9 +167,20 @@ private:
         std::unique_ptr<llvm::TargetMachine> _target_machine;
     };
 
+    // Optimize and compile the module of |engine|, or load the object code of the same module from the disk
+    // cache, and register the compiled function of |obj| into LRU cache.
+    static Status compile_module(Engine* engine, JitObjectCache* obj);
+
+    // The key of the object code in the disk cache: the function name, the hash of the IR, and the CPU and the
+    // LLVM version which the code is generated for.
+    std::string disk_cache_key(const llvm::Module& module, const std::string& func_name) const;
+
     bool _initialized = false;
     bool _support_jit = false;
     Cache* _func_cache;
+    std::unique_ptr<JitDiskCache> _disk_cache;
+    std::string _host_key;
+    std::unique_ptr<ThreadPool> _compile_pool;
 };
 
 } // namespace starrocks
@@ -22,6 +22,7 @@
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exprs/anyval_util.h"
@@ -57,7 +58,8 @@ Status JITExpr::prepare(RuntimeState* state, ExprContext* context) {
         _children.clear();
         _children.push_back(_expr);
         // jitExpr becomes an empty node, fallback to original expr, which are prepared again in case of jit
-        // complex expressions later.
+        // complex expressions later. If the expr is compiled asynchronously, the original expr is evaluated until
+        // the function is ready.
         RETURN_IF_ERROR(Expr::prepare(state, context));
     }
     return Status::OK();
@@ -68,6 +70,7 @@ Status JITExpr::prepare_impl(RuntimeState* state, ExprContext* context) {
         return Status::OK();
     }
     _is_prepared = true;
+    _inputs = _children;
 
     if (!is_constant()) {
         auto start = MonotonicNanos();
@@ -78,7 +81,22 @@ Status JITExpr::prepare_impl(RuntimeState* state, ExprContext* context) {
             return Status::JitCompileError("JIT is not supported");
         }
         auto expr_name = _expr->jit_func_name(state);
-        _jit_obj_cache = std::make_unique<JitObjectCache>(expr_name, JITEngine::get_instance()->get_func_cache());
+        _jit_obj_cache = std::make_shared<JitObjectCache>(expr_name, JITEngine::get_instance()->get_func_cache());
+
+        if (config::jit_async_compile) {
+            auto st = jit_engine->compile_scalar_function_async(context, _jit_obj_cache, _expr, _children);
+            if (!st.ok()) {
+                LOG(INFO) << "JIT: JIT async compile failed, Reason: " << st;
+                return Status::OK();
+            }
+            // the function may be found in the LRU cache
+            _jit_function = _jit_obj_cache->get_func();
+            _is_async_compiling = _jit_function == nullptr;
+            if (state->fragment_ctx() != nullptr) {
+                state->fragment_ctx()->update_jit_profile(MonotonicNanos() - start);
+            }
+            return Status::OK();
+        }
 
         auto st = jit_engine->compile_scalar_function(context, _jit_obj_cache.get(), _expr, _children);
         auto elapsed = MonotonicNanos() - start;
@@ -102,15 +120,16 @@ Status JITExpr::prepare_impl(RuntimeState* state, ExprContext* context) {
 }
 
 StatusOr<ColumnPtr> JITExpr::evaluate_checked(starrocks::ExprContext* context, Chunk* ptr) {
-    // If the expr fails to compile, evaluate using the original expr.
-    if (UNLIKELY(_jit_function == nullptr)) {
+    // If the expr fails to compile or it's still being compiled, evaluate using the original expr.
+    auto jit_function = get_jit_function();
+    if (UNLIKELY(jit_function == nullptr)) {
         return _expr->evaluate_checked(context, ptr);
     }
 
     std::vector<JITColumn> jit_columns;
-    jit_columns.reserve(_children.size() + 1);
+    jit_columns.reserve(_inputs.size() + 1);
     Columns args;
-    args.reserve(_children.size() + 1);
+    args.reserve(_inputs.size() + 1);
     auto unfold_ptr = [&](const ColumnPtr& column) {
         DCHECK(!column->is_constant());
         auto [un_col, un_col_null] = ColumnHelper::unpack_nullable_column(column);
@@ -122,7 +141,7 @@ StatusOr<ColumnPtr> JITExpr::evaluate_checked(starrocks::ExprContext* context, C
         jit_columns.emplace_back(JITColumn{data_col_ptr, null_flags_ptr});
     };
     size_t num_rows = 0;
-    for (Expr* child : _children) {
+    for (Expr* child : _inputs) {
         ColumnPtr column = EVALUATE_NULL_IF_ERROR(context, child, ptr);
         num_rows = std::max<size_t>(num_rows, column->size());
         args.emplace_back(column);
@@ -135,10 +154,10 @@ StatusOr<ColumnPtr> JITExpr::evaluate_checked(starrocks::ExprContext* context, C
         return result_column;
     }
     Columns backup_args;
-    backup_args.reserve(_children.size() + 1);
-    for (auto i = 0; i < _children.size(); i++) {
+    backup_args.reserve(_inputs.size() + 1);
+    for (auto i = 0; i < _inputs.size(); i++) {
         auto column = args[i];
-        auto child = _children[i];
+        auto child = _inputs[i];
         if (UNLIKELY((column->is_constant() ^ child->is_constant()) ||
                      (column->is_nullable() ^ child->is_nullable()))) {
             VLOG_QUERY << "[JIT INPUT] expr const = " << child->is_constant() << " null= " << child->is_nullable()
@@ -167,7 +186,7 @@ StatusOr<ColumnPtr> JITExpr::evaluate_checked(starrocks::ExprContext* context, C
 
     unfold_ptr(result_column);
     // inputs are not empty.
-    _jit_function(num_rows, jit_columns.data());
+    jit_function(num_rows, jit_columns.data());
     //TODO: _jit_function return has_null
     if (is_nullable()) {
         down_cast<NullableColumn*>(result_column.get())->update_has_null();
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -36,7 +38,7 @@ public:
 
     Expr* clone(ObjectPool* pool) const override { return JITExpr::create(pool, _expr); }
 
-    bool is_jit_compiled() { return _jit_function != nullptr; }
+    bool is_jit_compiled() { return get_jit_function() != nullptr; }
 
     void set_uncompilable_children(RuntimeState* state);
 
@@ -51,11 +53,22 @@ protected:
     StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override;
 
 private:
+    // The compiled function, nullptr if it's not compiled or it's being compiled asynchronously.
+    JITScalarFunction get_jit_function() const {
+        if (_jit_function == nullptr && _is_async_compiling) {
+            return _jit_obj_cache->get_func();
+        }
+        return _jit_function;
+    }
+
     // The original expression.
     Expr* _expr;
+    // The uncompilable exprs, whose results are the inputs of the compiled function.
+    std::vector<Expr*> _inputs;
     bool _is_prepared = false;
+    bool _is_async_compiling = false;
     JITScalarFunction _jit_function = nullptr;
-    std::unique_ptr<JitObjectCache> _jit_obj_cache;
+    std::shared_ptr<JitObjectCache> _jit_obj_cache;
 };
 
 } // namespace starrocks
@@ -31,6 +31,7 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "common/statusor.h"
@@ -38,6 +39,7 @@
 #include "exprs/column_ref.h"
 #include "exprs/function_context.h"
 #include "exprs/function_helper.h"
+#include "exprs/json_path_extractor.h"
 #include "exprs/jsonpath.h"
 #include "glog/logging.h"
 #include "gutil/casts.h"
@@ -375,13 +377,6 @@ StatusOr<ColumnPtr> _string_json(FunctionContext* context, const Columns& column
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
-template <LogicalType ResultType>
-StatusOr<ColumnPtr> JsonFunctions::_get_json_value(FunctionContext* context, const Columns& columns) {
-    ASSIGN_OR_RETURN(auto jsons, _string_json(context, columns));
-    const auto& paths = columns[1];
-    return _full_json_query_impl<ResultType>(context, Columns{jsons, paths});
-}
-
 //////////////////////////// User visiable functions /////////////////////////////////
 struct NativeJsonState {
 public:
@@ -416,8 +411,44 @@ static StatusOr<JsonPath*> get_prepared_or_parse(FunctionContext* context, Slice
     return out;
 }
 
+// The prepared path if it can be extracted by JsonPathExtractor.
+static const JsonPath* get_extractable_path(FunctionContext* context) {
+    if (!config::enable_json_path_extractor) {
+        return nullptr;
+    }
+    auto* state = get_native_json_state(context);
+    if (state == nullptr || state->json_path.is_empty() || !JsonPathExtractor::is_supported(state->json_path)) {
+        return nullptr;
+    }
+    return &state->json_path;
+}
+
+// The extractor of the prepared path, created in native_json_path_prepare.
+static JsonPathExtractor* get_path_extractor(FunctionContext* context) {
+    if (!config::enable_json_path_extractor) {
+        return nullptr;
+    }
+    return reinterpret_cast<JsonPathExtractor*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+}
+
+template <LogicalType ResultType>
+StatusOr<ColumnPtr> JsonFunctions::_get_json_value(FunctionContext* context, const Columns& columns) {
+    if (JsonPathExtractor* extractor = get_path_extractor(context); extractor != nullptr) {
+        ColumnBuilder<ResultType> result(columns[0]->size());
+        extractor->extract_text<ResultType>(columns[0], {&result});
+        return result.build(ColumnHelper::is_all_const(columns));
+    }
+    ASSIGN_OR_RETURN(auto jsons, _string_json(context, columns));
+    const auto& paths = columns[1];
+    return _full_json_query_impl<ResultType>(context, Columns{jsons, paths});
+}
+
 Status JsonFunctions::native_json_path_prepare(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
-    if (scope != FunctionContext::FRAGMENT_LOCAL) {
+    if (scope == FunctionContext::THREAD_LOCAL) {
+        // the extractor keeps the parser and the positions of the fields of the last row, so every thread has its own
+        if (const JsonPath* path = get_extractable_path(context); path != nullptr) {
+            context->set_function_state(scope, new JsonPathExtractor({path}));
+        }
         return Status::OK();
     }
 
@@ -440,6 +471,9 @@ Status JsonFunctions::native_json_path_close(FunctionContext* context, FunctionC
     if (scope == FunctionContext::FRAGMENT_LOCAL) {
         auto* state = reinterpret_cast<NativeJsonState*>(context->get_function_state(scope));
         delete state;
+    } else if (scope == FunctionContext::THREAD_LOCAL) {
+        auto* extractor = reinterpret_cast<JsonPathExtractor*>(context->get_function_state(scope));
+        delete extractor;
     }
     return Status::OK();
 }
@@ -598,6 +632,11 @@ StatusOr<ColumnPtr> JsonFunctions::_flat_json_query_impl(FunctionContext* contex
 template <LogicalType ResultType>
 StatusOr<ColumnPtr> JsonFunctions::_full_json_query_impl(FunctionContext* context, const Columns& columns) {
     auto num_rows = columns[0]->size();
+    if (JsonPathExtractor* extractor = get_path_extractor(context); extractor != nullptr) {
+        ColumnBuilder<ResultType> result(num_rows);
+        extractor->extract_json<ResultType>(columns[0], {&result});
+        return result.build(ColumnHelper::is_all_const(columns));
+    }
     auto json_viewer = ColumnViewer<TYPE_JSON>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
     ColumnBuilder<ResultType> result(num_rows);
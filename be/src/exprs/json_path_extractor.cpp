@@ -0,0 +1,339 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/json_path_extractor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "column/column_viewer.h"
+#include "gutil/casts.h"
+#include "util/json_converter.h"
+
+namespace starrocks {
+
+bool JsonPathExtractor::_compile(const JsonPath& path, std::vector<Step>* steps) {
+    steps->clear();
+    // The first piece is the root, which is skipped by JsonPath::extract.
+    for (size_t i = 1; i < path.paths.size(); ++i) {
+        const auto& piece = path.paths[i];
+        if (piece.key == "$") {
+            // JsonPath::extract restarts from the root
+            steps->clear();
+        } else if (!piece.key.empty()) {
+            // simdjson compares the keys without unescaping them
+            bool need_escape = std::any_of(piece.key.begin(), piece.key.end(), [](char ch) {
+                return ch == '"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20;
+            });
+            if (need_escape) {
+                return false;
+            }
+            steps->emplace_back().key = piece.key;
+        }
+
+        switch (piece.array_selector->type) {
+        case NONE:
+            break;
+        case SINGLE:
+            steps->emplace_back().index = down_cast<const ArraySelectorSingle*>(piece.array_selector.get())->index;
+            break;
+        default:
+            return false;
+        }
+    }
+    // extracting the whole document is not worth it
+    return !steps->empty();
+}
+
+bool JsonPathExtractor::is_supported(const JsonPath& path) {
+    std::vector<Step> steps;
+    return _compile(path, &steps);
+}
+
+JsonPathExtractor::JsonPathExtractor(const std::vector<const JsonPath*>& paths) : _paths(paths) {
+    _steps.resize(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        bool supported = _compile(*paths[i], &_steps[i]);
+        DCHECK(supported) << "unsupported json path";
+    }
+}
+
+// The whitespaces skipped by JsonValue::parse before the first character, i.e. std::isspace of the C locale,
+// without being undefined for the negative chars.
+static bool is_ascii_space(char ch) {
+    return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+static void validate_value(simdjson::ondemand::value value);
+
+static void validate_object(simdjson::ondemand::object object) {
+    for (auto field : object) {
+        field.unescaped_key().value();
+        validate_value(field.value().value());
+    }
+}
+
+static void validate_array(simdjson::ondemand::array array) {
+    for (auto element : array) {
+        validate_value(element.value());
+    }
+}
+
+static void validate_value(simdjson::ondemand::value value) {
+    switch (value.type()) {
+    case simdjson::ondemand::json_type::object:
+        validate_object(value.get_object().value());
+        break;
+    case simdjson::ondemand::json_type::array:
+        validate_array(value.get_array().value());
+        break;
+    case simdjson::ondemand::json_type::number:
+        value.get_number().value();
+        break;
+    case simdjson::ondemand::json_type::string:
+        value.get_string().value();
+        break;
+    case simdjson::ondemand::json_type::boolean:
+        value.get_bool().value();
+        break;
+    case simdjson::ondemand::json_type::null:
+        if (!value.is_null()) {
+            throw simdjson::simdjson_error(simdjson::N_ATOM_ERROR);
+        }
+        break;
+    }
+}
+
+bool JsonPathExtractor::_validate(simdjson::ondemand::document& doc) {
+    try {
+        doc.rewind();
+        if (doc.type() == simdjson::ondemand::json_type::object) {
+            validate_object(doc.get_object().value());
+        } else {
+            validate_array(doc.get_array().value());
+        }
+        return doc.at_end();
+    } catch (const simdjson::simdjson_error& e) {
+        return false;
+    }
+}
+
+JsonPathExtractor::Result JsonPathExtractor::_extract_text(simdjson::ondemand::document& doc,
+                                                           const std::vector<Step>& steps, bool has_escape,
+                                                           JsonValue* output) {
+    doc.rewind();
+    simdjson::ondemand::value value;
+    simdjson::ondemand::array array;
+    simdjson::error_code error;
+    // The document is not a value, so the first step is taken on the document.
+    if (steps[0].index < 0) {
+        error = doc.find_field_unordered(steps[0].key).get(value);
+    } else {
+        error = doc.get_array().get(array);
+        if (error == simdjson::SUCCESS) {
+            error = array.at(steps[0].index).get(value);
+        }
+    }
+    for (size_t i = 1; i < steps.size() && error == simdjson::SUCCESS; ++i) {
+        if (steps[i].index < 0) {
+            error = value.find_field_unordered(steps[i].key).get(value);
+        } else {
+            error = value.get_array().get(array);
+            if (error == simdjson::SUCCESS) {
+                error = array.at(steps[i].index).get(value);
+            }
+        }
+    }
+
+    switch (error) {
+    case simdjson::SUCCESS:
+        break;
+    // simdjson compares the keys as they are written, so a key with escapes, e.g. "\u0061", may be the field
+    case simdjson::NO_SUCH_FIELD:
+        return has_escape ? Result::FALLBACK : Result::NOT_FOUND;
+    // JsonPath::extract returns none for an index out of bounds, or a value of another type
+    case simdjson::INDEX_OUT_OF_BOUNDS:
+    case simdjson::INCORRECT_TYPE:
+        return Result::NOT_FOUND;
+    default:
+        return Result::FALLBACK;
+    }
+
+    auto json = convert_from_simdjson(value);
+    if (!json.ok()) {
+        return Result::FALLBACK;
+    }
+    *output = std::move(json.value());
+    return Result::FOUND;
+}
+
+template <LogicalType ResultType>
+void JsonPathExtractor::extract_text(const ColumnPtr& column, const std::vector<ColumnBuilder<ResultType>*>& results) {
+    DCHECK_EQ(_steps.size(), results.size());
+    ColumnViewer<TYPE_VARCHAR> viewer(column);
+    JsonValue value;
+    JsonValue document;
+    for (size_t row = 0; row < column->size(); ++row) {
+        if (viewer.is_null(row)) {
+            for (auto* result : results) {
+                result->append_null();
+            }
+            continue;
+        }
+
+        // JsonValue::parse takes the text which isn't an object or array as a string, where nothing is found.
+        Slice text = viewer.value(row);
+        const char* end = text.data + text.size;
+        const char* start = std::find_if_not(text.data, end, is_ascii_space);
+        if (text.size > kJSONLengthLimit || start == end || (*start != '{' && *start != '[')) {
+            for (auto* result : results) {
+                result->append_null();
+            }
+            continue;
+        }
+
+        _buffer.assign(text.data, text.size);
+        _buffer.reserve(text.size + simdjson::SIMDJSON_PADDING);
+        simdjson::ondemand::document doc;
+        bool indexed = _parser.iterate(_buffer).get(doc) == simdjson::SUCCESS;
+        bool has_escape = std::memchr(text.data, '\\', text.size) != nullptr;
+        // simdjson on-demand only validates the values it visits, so the document is validated once before
+        // returning the first value found, which is NULL for a malformed document.
+        bool validated = false;
+        // the whole document is parsed at most once for the paths falling back
+        bool parsed = false;
+        bool parse_ok = false;
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            Result res = indexed ? _extract_text(doc, _steps[i], has_escape, &value) : Result::FALLBACK;
+            if (res == Result::FOUND && !validated) {
+                indexed = _validate(doc);
+                validated = true;
+                if (!indexed) {
+                    res = Result::FALLBACK;
+                }
+            }
+            vpack::Slice slice = noneJsonSlice();
+            if (res == Result::FOUND) {
+                slice = value.to_vslice();
+            } else if (res == Result::FALLBACK) {
+                if (!parsed) {
+                    parse_ok = JsonValue::parse(text, &document).ok();
+                    parsed = true;
+                }
+                if (parse_ok) {
+                    _builder.clear();
+                    slice = JsonPath::extract(&document, *_paths[i], &_builder);
+                }
+            }
+            if (!cast_vpjson_to<ResultType, false>(slice, *results[i]).ok()) {
+                results[i]->append_null();
+            }
+        }
+    }
+}
+
+JsonPathExtractor::Result JsonPathExtractor::_extract_json(vpack::Slice root, std::vector<Step>* steps,
+                                                           vpack::Slice* output) {
+    try {
+        vpack::Slice current = root;
+        for (auto& step : *steps) {
+            if (step.index >= 0) {
+                if (!current.isArray() || static_cast<vpack::ValueLength>(step.index) >= current.length()) {
+                    return Result::NOT_FOUND;
+                }
+                current = current.at(step.index);
+                continue;
+            }
+
+            if (!current.isObject()) {
+                return Result::NOT_FOUND;
+            }
+            vpack::ValueLength length = current.length();
+            if (step.position < length) {
+                vpack::Slice key = current.keyAt(step.position, false);
+                if (key.isString() && key.stringView() == step.key) {
+                    current = current.valueAt(step.position);
+                    continue;
+                }
+            }
+            // The key layout is different from the last row, search the keys and remember the position.
+            bool found = false;
+            for (vpack::ValueLength i = 0; i < length; ++i) {
+                vpack::Slice key = current.keyAt(i, false);
+                if (!key.isString()) {
+                    // the translated keys are only resolved by vpack::Slice::get
+                    return Result::FALLBACK;
+                }
+                if (key.stringView() == step.key) {
+                    step.position = i;
+                    current = current.valueAt(i);
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                return Result::NOT_FOUND;
+            }
+        }
+        *output = current;
+        return Result::FOUND;
+    } catch (const vpack::Exception& e) {
+        return Result::FALLBACK;
+    }
+}
+
+template <LogicalType ResultType>
+void JsonPathExtractor::extract_json(const ColumnPtr& column, const std::vector<ColumnBuilder<ResultType>*>& results) {
+    DCHECK_EQ(_steps.size(), results.size());
+    ColumnViewer<TYPE_JSON> viewer(column);
+    for (size_t row = 0; row < column->size(); ++row) {
+        if (viewer.is_null(row)) {
+            for (auto* result : results) {
+                result->append_null();
+            }
+            continue;
+        }
+
+        JsonValue* json = viewer.value(row);
+        vpack::Slice root = json->to_vslice();
+        for (size_t i = 0; i < _steps.size(); ++i) {
+            vpack::Slice slice = noneJsonSlice();
+            Result res = _extract_json(root, &_steps[i], &slice);
+            if (res == Result::FALLBACK) {
+                _builder.clear();
+                slice = JsonPath::extract(json, *_paths[i], &_builder);
+            }
+            if (!cast_vpjson_to<ResultType, false>(slice, *results[i]).ok()) {
+                results[i]->append_null();
+            }
+        }
+    }
+}
+
+#define INSTANTIATE_EXTRACT(ResultType)                                                                     \
+    template void JsonPathExtractor::extract_text<ResultType>(const ColumnPtr&,                             \
+                                                              const std::vector<ColumnBuilder<ResultType>*>&); \
+    template void JsonPathExtractor::extract_json<ResultType>(const ColumnPtr&,                             \
+                                                              const std::vector<ColumnBuilder<ResultType>*>&);
+
+INSTANTIATE_EXTRACT(TYPE_BOOLEAN)
+INSTANTIATE_EXTRACT(TYPE_INT)
+INSTANTIATE_EXTRACT(TYPE_BIGINT)
+INSTANTIATE_EXTRACT(TYPE_DOUBLE)
+INSTANTIATE_EXTRACT(TYPE_VARCHAR)
+INSTANTIATE_EXTRACT(TYPE_JSON)
+
+#undef INSTANTIATE_EXTRACT
+
+} // namespace starrocks
@@ -0,0 +1,86 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <simdjson.h>
+
+#include <string>
+#include <vector>
+
+#include "column/column_builder.h"
+#include "column/vectorized_fwd.h"
+#include "exprs/jsonpath.h"
+#include "util/json.h"
+
+namespace starrocks {
+
+// JsonPathExtractor extracts the values of JSON paths from a whole column, instead of parsing the document into
+// a JsonValue and walking the path for every row. The JSON functions extract the single path of the call, the
+// paths given together share the index of every document.
+//
+// The paths are compiled once into steps of object fields and array indexes.
+// - For the JSON text of a VARCHAR column, every document is indexed by the SIMD structural scanner of simdjson
+//   on-demand, and only the values on the paths are converted, instead of the whole document. The document is
+//   still walked once to validate it before a value is returned.
+// - For a JSON column, the position of every field in its object is cached, so the rows of the same key layout
+//   resolve the path without searching the keys.
+//
+// The result is the same as JsonPath::extract, which is used for the rows the kernel can't handle, e.g. the
+// missing keys of a document with escapes. It's not thread-safe.
+class JsonPathExtractor {
+public:
+    // Only the paths of object fields and single array indexes are supported, e.g. `$.a.b[1].c`.
+    static bool is_supported(const JsonPath& path);
+
+    // |paths| must be supported, and outlive the extractor.
+    explicit JsonPathExtractor(const std::vector<const JsonPath*>& paths);
+
+    // Append the value of the i-th path of every row of the VARCHAR column |column| to |results[i]|.
+    template <LogicalType ResultType>
+    void extract_text(const ColumnPtr& column, const std::vector<ColumnBuilder<ResultType>*>& results);
+
+    // Same as extract_text, but for a JSON column.
+    template <LogicalType ResultType>
+    void extract_json(const ColumnPtr& column, const std::vector<ColumnBuilder<ResultType>*>& results);
+
+private:
+    struct Step {
+        // the field of an object, or the index of an array if |index| >= 0
+        std::string key;
+        int index = -1;
+        // the position of the field in the object of the last row
+        vpack::ValueLength position = 0;
+    };
+
+    enum class Result { FOUND, NOT_FOUND, FALLBACK };
+
+    static bool _compile(const JsonPath& path, std::vector<Step>* steps);
+
+    // |has_escape| is whether the document has any escape.
+    Result _extract_text(simdjson::ondemand::document& doc, const std::vector<Step>& steps, bool has_escape,
+                         JsonValue* output);
+    // Whether the whole document is well-formed.
+    static bool _validate(simdjson::ondemand::document& doc);
+    Result _extract_json(vpack::Slice root, std::vector<Step>* steps, vpack::Slice* output);
+
+    std::vector<const JsonPath*> _paths;
+    std::vector<std::vector<Step>> _steps;
+
+    simdjson::ondemand::parser _parser;
+    std::string _buffer;
+    vpack::Builder _builder;
+};
+
+} // namespace starrocks
@@ -545,13 +545,16 @@ StatusOr<ColumnPtr> LikePredicate::regex_match_partial(FunctionContext* context,
 
 template <bool fullMatch>
 std::string LikePredicate::convert_like_pattern(FunctionContext* context, const Slice& pattern) {
-    std::string re_pattern;
-    re_pattern.clear();
-
     auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    return convert_like_pattern<fullMatch>(pattern, state->escape_char);
+}
+
+template <bool full_match>
+std::string LikePredicate::convert_like_pattern(const Slice& pattern, char escape_char) {
+    std::string re_pattern;
     bool is_escaped = false;
 
-    if constexpr (fullMatch) {
+    if constexpr (full_match) {
         re_pattern.append("^");
     }
 
@@ -561,7 +564,7 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
         } else if (!is_escaped && pattern.data[i] == '_') {
             re_pattern.append(".");
             // check for escape char before checking for regex special chars, they might overlap
-        } else if (!is_escaped && pattern.data[i] == state->escape_char) {
+        } else if (!is_escaped && pattern.data[i] == escape_char) {
             is_escaped = true;
         } else if (pattern.data[i] == '.' || pattern.data[i] == '[' || pattern.data[i] == ']' ||
                    pattern.data[i] == '{' || pattern.data[i] == '}' || pattern.data[i] == '(' ||
@@ -579,13 +582,16 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
         }
     }
 
-    if constexpr (fullMatch) {
+    if constexpr (full_match) {
         re_pattern.append("$");
     }
 
     return re_pattern;
 }
 
+template std::string LikePredicate::convert_like_pattern<true>(const Slice& pattern, char escape_char);
+template std::string LikePredicate::convert_like_pattern<false>(const Slice& pattern, char escape_char);
+
 void LikePredicate::remove_escape_character(std::string* search_string) {
     std::string tmp_search_string;
     tmp_search_string.swap(*search_string);
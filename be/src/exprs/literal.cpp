@@ -166,7 +166,9 @@ StatusOr<ColumnPtr> VectorizedLiteral::evaluate_checked(ExprContext* context, Ch
 }
 
 bool VectorizedLiteral::is_compilable(RuntimeState* state) const {
-    return IRHelper::support_jit(_type.type);
+    // string literals are compiled as the arguments of the compilable functions.
+    return IRHelper::support_jit(_type.type) ||
+           (is_string_type(_type.type) && state->can_jit_expr(CompilableExprType::FUNCTION));
 }
 
 JitScore VectorizedLiteral::compute_jit_score(RuntimeState* state) const {
@@ -174,13 +176,21 @@ JitScore VectorizedLiteral::compute_jit_score(RuntimeState* state) const {
 }
 
 std::string VectorizedLiteral::jit_func_name_impl(RuntimeState* state) const {
+    if (is_string_type(_type.type) && !_value->only_null()) {
+        // the size makes the name unambiguous whatever the bytes are.
+        auto value = ColumnHelper::get_const_value<TYPE_VARCHAR>(_value);
+        return "{" + type().debug_string() + "[" + std::to_string(value.size) + ":" + value.to_string() + "]}";
+    }
     return "{" + type().debug_string() + "[" + _value->debug_string() + "]}";
 }
 
 StatusOr<LLVMDatum> VectorizedLiteral::generate_ir_impl(ExprContext* context, JITContext* jit_ctx) {
     bool only_null = _value->only_null();
     LLVMDatum datum(jit_ctx->builder, only_null);
-    if (only_null) {
+    if (is_string_type(_type.type)) {
+        auto value = only_null ? Slice() : ColumnHelper::get_const_value<TYPE_VARCHAR>(_value);
+        ASSIGN_OR_RETURN(datum.value, IRHelper::create_ir_string(jit_ctx->module, jit_ctx->builder, value));
+    } else if (only_null) {
         ASSIGN_OR_RETURN(datum.value, IRHelper::create_ir_number(jit_ctx->builder, _type.type, 0));
     } else {
         ASSIGN_OR_RETURN(datum.value, IRHelper::load_ir_number(jit_ctx->builder, _type.type, _value->raw_data()));
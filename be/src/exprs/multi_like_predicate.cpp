@@ -0,0 +1,437 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/multi_like_predicate.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+#include "column/column_helper.h"
+#include "column/column_viewer.h"
+#include "column/nullable_column.h"
+#include "exprs/column_ref.h"
+#include "exprs/like_predicate.h"
+#include "glog/logging.h"
+#include "util/defer_op.h"
+
+namespace starrocks {
+
+// the names of LikePredicate::like and LikePredicate::regex
+static constexpr std::string_view LIKE_FUNCTION = "like";
+static constexpr std::string_view REGEXP_FUNCTION = "regexp";
+
+static constexpr unsigned PATTERN_FLAGS = HS_FLAG_ALLOWEMPTY | HS_FLAG_DOTALL | HS_FLAG_UTF8 | HS_FLAG_SINGLEMATCH;
+
+// Same with LikePredicate::_DUMMY_STRING_FOR_EMPTY_PATTERN, hs_scan crashes with nullptr.
+static char DUMMY_STRING_FOR_EMPTY_VALUE = 'A';
+
+// The longest literal substring required by the LIKE pattern, empty if none. |exact| is set if the pattern
+// is '%literal%', whose matches are the values containing the literal.
+static std::string like_required_literal(const std::string& pattern, bool* exact) {
+    std::vector<std::string> literals(1);
+    bool has_underscore = false;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '\\') {
+            if (i + 1 == pattern.size()) {
+                return "";
+            }
+            literals.back().push_back(pattern[++i]);
+        } else if (c == '%' || c == '_') {
+            has_underscore |= c == '_';
+            if (!literals.back().empty()) {
+                literals.emplace_back();
+            }
+        } else {
+            literals.back().push_back(c);
+        }
+    }
+    if (literals.back().empty()) {
+        literals.pop_back();
+    }
+    *exact = literals.size() == 1 && !has_underscore && pattern.size() >= literals[0].size() + 2 &&
+             pattern.front() == '%' && pattern.back() == '%' && pattern[pattern.size() - 2] != '\\';
+    std::string longest;
+    for (auto& literal : literals) {
+        if (literal.size() > longest.size()) {
+            longest = std::move(literal);
+        }
+    }
+    return longest;
+}
+
+// The regex pattern itself if it has no special chars, which matches the values containing it.
+static std::string regex_required_literal(const std::string& pattern, bool* exact) {
+    *exact = pattern.find_first_of(".^$|()[]{}*+?\\") == std::string::npos;
+    return *exact ? pattern : "";
+}
+
+MultiLikePredicate::Matcher::~Matcher() {
+    if (scratch != nullptr) {
+        hs_free_scratch(scratch);
+    }
+    if (patterns != nullptr) {
+        hs_free_database(patterns);
+    }
+    if (literals != nullptr) {
+        hs_free_database(literals);
+    }
+}
+
+MultiLikePredicate* MultiLikePredicate::create(ObjectPool* pool, Expr* column, std::vector<Pattern> patterns) {
+    TExprNode node;
+    node.node_type = TExprNodeType::MULTI_LIKE_PRED;
+    node.type = TypeDescriptor(TYPE_BOOLEAN).to_thrift();
+    node.is_nullable = column->is_nullable();
+    node.num_children = 1;
+    auto* expr = pool->add(new MultiLikePredicate(node, std::move(patterns)));
+    expr->add_child(column);
+    return expr;
+}
+
+MultiLikePredicate::MultiLikePredicate(const TExprNode& node, std::vector<Pattern> patterns)
+        : Predicate(node), _patterns(std::move(patterns)) {}
+
+bool MultiLikePredicate::is_or_predicate(const Expr* expr) {
+    return expr->node_type() == TExprNodeType::COMPOUND_PRED && expr->op() == TExprOpcode::COMPOUND_OR;
+}
+
+static void collect_or_operands(Expr* expr, std::vector<Expr*>* or_exprs, std::vector<Expr*>* operands) {
+    if (MultiLikePredicate::is_or_predicate(expr)) {
+        or_exprs->emplace_back(expr);
+        for (auto* child : expr->children()) {
+            collect_or_operands(child, or_exprs, operands);
+        }
+    } else {
+        operands->emplace_back(expr);
+    }
+}
+
+StatusOr<Expr*> MultiLikePredicate::merge_or_predicate(ObjectPool* pool, Expr* expr) {
+    DCHECK(is_or_predicate(expr));
+    std::vector<Expr*> or_exprs;
+    std::vector<Expr*> operands;
+    collect_or_operands(expr, &or_exprs, &operands);
+
+    // The operands of `slot LIKE 'literal'` or `slot REGEXP 'literal'` are grouped by the slot.
+    std::unordered_map<SlotId, size_t> slot_to_group;
+    std::vector<std::vector<size_t>> groups;
+    for (size_t i = 0; i < operands.size(); ++i) {
+        auto* operand = operands[i];
+        if (operand->node_type() != TExprNodeType::FUNCTION_CALL || operand->get_num_children() != 2) {
+            continue;
+        }
+        const auto& function_name = operand->fn().name.function_name;
+        if (function_name != LIKE_FUNCTION && function_name != REGEXP_FUNCTION) {
+            continue;
+        }
+        auto* column = operand->get_child(0);
+        auto* pattern = operand->get_child(1);
+        if (!column->is_slotref() || pattern->node_type() != TExprNodeType::STRING_LITERAL) {
+            continue;
+        }
+        auto slot_id = down_cast<ColumnRef*>(column)->slot_id();
+        auto [iter, inserted] = slot_to_group.emplace(slot_id, groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[iter->second].emplace_back(i);
+    }
+
+    std::vector<Expr*> merged_operands = operands;
+    size_t num_merged = 0;
+    for (const auto& group : groups) {
+        if (group.size() < 2) {
+            continue;
+        }
+        std::vector<Pattern> patterns;
+        for (size_t i : group) {
+            ASSIGN_OR_RETURN(auto pattern_column, operands[i]->get_child(1)->evaluate_checked(nullptr, nullptr));
+            ColumnViewer<TYPE_VARCHAR> viewer(pattern_column);
+            if (viewer.is_null(0)) {
+                return expr;
+            }
+            bool is_like = operands[i]->fn().name.function_name == LIKE_FUNCTION;
+            patterns.push_back(Pattern{viewer.value(0).to_string(), is_like});
+        }
+        merged_operands[group[0]] = create(pool, operands[group[0]]->get_child(0), std::move(patterns));
+        for (size_t k = 1; k < group.size(); ++k) {
+            merged_operands[group[k]] = nullptr;
+        }
+        num_merged += group.size() - 1;
+    }
+    if (num_merged == 0) {
+        return expr;
+    }
+    merged_operands.erase(std::remove(merged_operands.begin(), merged_operands.end(), nullptr),
+                          merged_operands.end());
+
+    // Rebuild the OR predicates of the remaining operands, the redundant OR predicates are dropped.
+    Expr* root = merged_operands[0];
+    for (size_t i = 1; i < merged_operands.size(); ++i) {
+        auto* or_expr = or_exprs[i - 1];
+        or_expr->clear_children();
+        or_expr->add_child(root);
+        or_expr->add_child(merged_operands[i]);
+        root = or_expr;
+    }
+    return root;
+}
+
+Status MultiLikePredicate::_compile_patterns(Matcher* matcher) const {
+    std::vector<std::string> regexes;
+    for (const auto& pattern : _patterns) {
+        if (pattern.is_like) {
+            regexes.emplace_back(LikePredicate::convert_like_pattern<true>(Slice(pattern.pattern), '\\'));
+        } else {
+            regexes.emplace_back(pattern.pattern);
+        }
+    }
+    std::vector<const char*> expressions;
+    std::vector<unsigned> flags(regexes.size(), PATTERN_FLAGS);
+    std::vector<unsigned> ids;
+    for (size_t i = 0; i < regexes.size(); ++i) {
+        expressions.emplace_back(regexes[i].c_str());
+        ids.emplace_back(i);
+    }
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile_multi(expressions.data(), flags.data(), ids.data(), regexes.size(), HS_MODE_BLOCK, nullptr,
+                         &matcher->patterns, &compile_err) == HS_SUCCESS) {
+        return Status::OK();
+    }
+    LOG(WARNING) << "Invalid hyperscan expression of multiple patterns: " << compile_err->message
+                 << ", so we switch to use re2.";
+    hs_free_compile_error(compile_err);
+    matcher->patterns = nullptr;
+
+    RE2::Options opts;
+    opts.set_never_nl(false);
+    opts.set_dot_nl(true);
+    opts.set_log_errors(false);
+    for (const auto& regex : regexes) {
+        auto re2 = std::make_unique<re2::RE2>(regex, opts);
+        if (!re2->ok()) {
+            return Status::InvalidArgument(fmt::format("Invalid re2 expression: {}", regex));
+        }
+        matcher->re2s.emplace_back(std::move(re2));
+    }
+    return Status::OK();
+}
+
+Status MultiLikePredicate::_compile_literals(Matcher* matcher) const {
+    std::vector<std::string> literals;
+    for (const auto& pattern : _patterns) {
+        bool exact = false;
+        auto literal = pattern.is_like ? like_required_literal(pattern.pattern, &exact)
+                                       : regex_required_literal(pattern.pattern, &exact);
+        if (literal.empty()) {
+            // the rows can't be filtered by the literals
+            matcher->literal_sizes.clear();
+            matcher->literal_exact.clear();
+            return Status::OK();
+        }
+        auto iter = std::find(literals.begin(), literals.end(), literal);
+        if (iter == literals.end()) {
+            literals.emplace_back(std::move(literal));
+            matcher->literal_sizes.emplace_back(literals.back().size());
+            matcher->literal_exact.emplace_back(exact);
+        } else {
+            matcher->literal_exact[iter - literals.begin()] |= exact;
+        }
+    }
+
+    std::vector<const char*> expressions;
+    std::vector<unsigned> flags(literals.size(), 0);
+    std::vector<unsigned> ids;
+    for (size_t i = 0; i < literals.size(); ++i) {
+        expressions.emplace_back(literals[i].data());
+        ids.emplace_back(i);
+    }
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile_lit_multi(expressions.data(), flags.data(), ids.data(), matcher->literal_sizes.data(),
+                             literals.size(), HS_MODE_BLOCK, nullptr, &matcher->literals,
+                             &compile_err) != HS_SUCCESS) {
+        // not an error, the rows are scanned by the patterns directly
+        LOG(WARNING) << "Failed to compile the literals of multiple patterns: " << compile_err->message;
+        hs_free_compile_error(compile_err);
+        matcher->literals = nullptr;
+    }
+    return Status::OK();
+}
+
+Status MultiLikePredicate::prepare(RuntimeState* state, ExprContext* context) {
+    RETURN_IF_ERROR(Expr::prepare(state, context));
+    if (_matcher != nullptr) {
+        return Status::OK();
+    }
+    auto matcher = std::make_shared<Matcher>();
+    RETURN_IF_ERROR(_compile_patterns(matcher.get()));
+    RETURN_IF_ERROR(_compile_literals(matcher.get()));
+    for (auto* database : {matcher->patterns, matcher->literals}) {
+        if (database != nullptr && hs_alloc_scratch(database, &matcher->scratch) != HS_SUCCESS) {
+            return Status::InternalError("unable to allocate scratch space of hyperscan");
+        }
+    }
+    _matcher = std::move(matcher);
+    return Status::OK();
+}
+
+static int on_pattern_match(unsigned int id, unsigned long long from, unsigned long long to, unsigned int flags,
+                            void* ctx) {
+    *reinterpret_cast<bool*>(ctx) = true;
+    // stop scanning
+    return 1;
+}
+
+bool MultiLikePredicate::_match(const Slice& value, hs_scratch_t* scratch) const {
+    if (_matcher->patterns == nullptr) {
+        re2::StringPiece piece(value.data, value.size);
+        return std::any_of(_matcher->re2s.begin(), _matcher->re2s.end(),
+                           [&](const auto& re2) { return RE2::PartialMatch(piece, *re2); });
+    }
+    bool matched = false;
+    [[maybe_unused]] auto status =
+            hs_scan(_matcher->patterns, value.size > 0 ? value.data : &DUMMY_STRING_FOR_EMPTY_VALUE, value.size, 0,
+                    scratch, on_pattern_match, &matched);
+    DCHECK(status == HS_SUCCESS || status == HS_SCAN_TERMINATED) << " status: " << status;
+    return matched;
+}
+
+namespace {
+struct LiteralScanContext {
+    const uint32_t* offsets;
+    size_t num_rows;
+    const size_t* literal_sizes;
+    const uint8_t* literal_exact;
+    // the row of the last match
+    size_t row = 0;
+    // 1 if the row contains some literal
+    uint8_t* candidates;
+    uint8_t* result;
+};
+} // namespace
+
+// The matches are reported in the order of the end offsets, so the row of a match is searched from the row of
+// the last one. A match crossing the boundary of rows is ignored.
+static int on_literal_match(unsigned int id, unsigned long long from, unsigned long long to, unsigned int flags,
+                            void* ctx) {
+    auto* scan = reinterpret_cast<LiteralScanContext*>(ctx);
+    const uint32_t* offsets = scan->offsets;
+    // the row containing the last byte
+    uint64_t last = to - 1;
+    size_t row = scan->row;
+    if (offsets[row] > last) {
+        row = std::upper_bound(offsets, offsets + scan->num_rows + 1, last) - offsets - 1;
+    }
+    while (offsets[row + 1] <= last) {
+        ++row;
+    }
+    scan->row = row;
+    if (to - scan->literal_sizes[id] >= offsets[row]) {
+        scan->candidates[row] = 1;
+        scan->result[row] |= scan->literal_exact[id];
+    }
+    return 0;
+}
+
+Status MultiLikePredicate::_match_rows(const BinaryColumn& column, const uint8_t* nulls, hs_scratch_t* scratch,
+                                       uint8_t* result) const {
+    size_t num_rows = column.size();
+    std::vector<uint8_t> candidates;
+    const auto& bytes = column.get_bytes();
+    if (_matcher->literals != nullptr) {
+        candidates.resize(num_rows, 0);
+        if (!bytes.empty()) {
+            LiteralScanContext scan{column.get_offset().data(),
+                                    num_rows,
+                                    _matcher->literal_sizes.data(),
+                                    _matcher->literal_exact.data(),
+                                    0,
+                                    candidates.data(),
+                                    result};
+            auto status = hs_scan(_matcher->literals, reinterpret_cast<const char*>(bytes.data()), bytes.size(), 0,
+                                  scratch, on_literal_match, &scan);
+            if (status != HS_SUCCESS) {
+                return Status::InternalError(fmt::format("failed to scan the literals, status: {}", status));
+            }
+        }
+    }
+
+    for (size_t i = 0; i < num_rows; ++i) {
+        if ((nulls != nullptr && nulls[i]) || result[i] || (!candidates.empty() && !candidates[i])) {
+            continue;
+        }
+        result[i] = _match(column.get_slice(i), scratch);
+    }
+    if (nulls != nullptr) {
+        // the values of null rows are undefined
+        for (size_t i = 0; i < num_rows; ++i) {
+            result[i] &= !nulls[i];
+        }
+    }
+    return Status::OK();
+}
+
+StatusOr<ColumnPtr> MultiLikePredicate::evaluate_checked(ExprContext* context, Chunk* ptr) {
+    ASSIGN_OR_RETURN(ColumnPtr column, _children[0]->evaluate_checked(context, ptr));
+    if (column->only_null()) {
+        return ColumnHelper::create_const_null_column(column->size());
+    }
+
+    hs_scratch_t* scratch = nullptr;
+    if (_matcher->scratch != nullptr) {
+        hs_error_t status;
+        if ((status = hs_clone_scratch(_matcher->scratch, &scratch)) != HS_SUCCESS) {
+            return Status::InternalError(fmt::format("unable to clone scratch space, status: {}", status));
+        }
+    }
+    DeferOp op([&] {
+        if (scratch != nullptr) {
+            hs_free_scratch(scratch);
+        }
+    });
+
+    if (column->is_constant()) {
+        ColumnViewer<TYPE_VARCHAR> viewer(column);
+        return ColumnHelper::create_const_column<TYPE_BOOLEAN>(_match(viewer.value(0), scratch), column->size());
+    }
+
+    auto result = BooleanColumn::create(column->size(), 0);
+    if (column->is_nullable()) {
+        auto* nullable = down_cast<NullableColumn*>(column.get());
+        const uint8_t* nulls = nullable->has_null() ? nullable->null_column()->get_data().data() : nullptr;
+        RETURN_IF_ERROR(_match_rows(*down_cast<const BinaryColumn*>(nullable->data_column().get()), nulls, scratch,
+                                    result->get_data().data()));
+        return NullableColumn::create(std::move(result), nullable->null_column());
+    }
+    RETURN_IF_ERROR(_match_rows(*down_cast<const BinaryColumn*>(column.get()), nullptr, scratch,
+                                result->get_data().data()));
+    return result;
+}
+
+std::string MultiLikePredicate::debug_string() const {
+    std::stringstream out;
+    out << "MultiLikePredicate (patterns=[";
+    for (size_t i = 0; i < _patterns.size(); ++i) {
+        out << (i > 0 ? ", " : "") << (_patterns[i].is_like ? "LIKE '" : "REGEXP '") << _patterns[i].pattern << "'";
+    }
+    out << "], expr (" << Expr::debug_string() << ") )";
+    return out.str();
+}
+
+} // namespace starrocks
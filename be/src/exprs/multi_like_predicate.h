@@ -0,0 +1,102 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <hs/hs.h>
+#include <re2/re2.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "common/object_pool.h"
+#include "exprs/predicate.h"
+
+namespace starrocks {
+
+// MultiLikePredicate evaluates `c LIKE p1 OR c REGEXP p2 OR ...` of the constant patterns on the same column
+// in one pass, it's created by merge_or_predicate() instead of the OR predicates.
+//
+// All the patterns are compiled into one hyperscan database, so a row is scanned once instead of once per
+// pattern. If every pattern requires a literal substring, the literals are searched in the contiguous bytes
+// of the column together first, and only the rows containing some literal are scanned by the database. The
+// rows containing the literal of a pattern like '%abc%' match without being scanned.
+class MultiLikePredicate final : public Predicate {
+public:
+    struct Pattern {
+        std::string pattern;
+        // LIKE if true, otherwise REGEXP
+        bool is_like;
+    };
+
+    static MultiLikePredicate* create(ObjectPool* pool, Expr* column, std::vector<Pattern> patterns);
+
+    static bool is_or_predicate(const Expr* expr);
+
+    // Merge the LIKE/REGEXP predicates on the same column under the OR predicate |expr|, and return the
+    // new root, which is |expr| if nothing is merged.
+    static StatusOr<Expr*> merge_or_predicate(ObjectPool* pool, Expr* expr);
+
+    MultiLikePredicate(const TExprNode& node, std::vector<Pattern> patterns);
+
+    ~MultiLikePredicate() override = default;
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new MultiLikePredicate(*this)); }
+
+    Status prepare(RuntimeState* state, ExprContext* context) override;
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* ptr) override;
+
+    std::string debug_string() const override;
+
+    const std::vector<Pattern>& patterns() const { return _patterns; }
+
+    // Whether the literals are searched before scanning the rows, for test.
+    bool has_literal_filter() const { return _matcher != nullptr && _matcher->literals != nullptr; }
+
+private:
+    struct Matcher {
+        ~Matcher();
+
+        // nullptr if some pattern is not supported by hyperscan, the patterns are matched by |re2s| instead
+        hs_database_t* patterns = nullptr;
+        std::vector<std::unique_ptr<re2::RE2>> re2s;
+
+        // the literal required by every pattern, nullptr if some pattern doesn't have one
+        hs_database_t* literals = nullptr;
+        std::vector<size_t> literal_sizes;
+        // whether containing the literal means matching the pattern
+        std::vector<uint8_t> literal_exact;
+
+        // cloned for every evaluation, a scratch can't be used concurrently
+        hs_scratch_t* scratch = nullptr;
+    };
+
+    Status _compile_patterns(Matcher* matcher) const;
+    Status _compile_literals(Matcher* matcher) const;
+
+    bool _match(const Slice& value, hs_scratch_t* scratch) const;
+
+    // Set |result[i]| for the not null rows of |column|.
+    Status _match_rows(const BinaryColumn& column, const uint8_t* nulls, hs_scratch_t* scratch,
+                       uint8_t* result) const;
+
+    std::vector<Pattern> _patterns;
+    // shared by the clones
+    std::shared_ptr<Matcher> _matcher;
+};
+
+} // namespace starrocks
@@ -529,6 +529,12 @@ public:
             size_t hash = compute_hash(value);
             _bf.insert_hash(hash);
         }
+        if constexpr (can_use_membership()) {
+            if (!_membership.empty()) {
+                uint64_t offset = _membership_offset(value);
+                _membership[offset >> 6] |= 1ULL << (offset & 63);
+            }
+        }
 
         _min = std::min(value, _min);
         _max = std::max(value, _max);
@@ -536,6 +542,95 @@ public:
 
     void insert_null() { _has_null = true; }
 
+    // The integers of a dense range can be kept in a membership bitmap of one bit per value of the range.
+    static constexpr bool can_use_membership() {
+        return std::is_integral_v<CppType> && sizeof(CppType) <= sizeof(int64_t);
+    }
+
+    // Keep the values in [min_value, max_value] inserted afterwards in a membership bitmap besides the bloom filter,
+    // which is exact and cheaper to probe. The bitmap is only used by the local filter, and is dropped once the filter
+    // is merged with or concatenated to others, which only have the bloom filter.
+    void init_membership(CppType min_value, CppType max_value) {
+        static_assert(can_use_membership());
+        DCHECK(min_value <= max_value);
+        _membership_base = min_value;
+        _membership.assign(_membership_offset(max_value) / 64 + 1, 0);
+    }
+
+    bool has_membership() const { return !_membership.empty(); }
+
+    // The number of bits of the membership bitmap, 0 if there is no bitmap.
+    size_t membership_bits() const { return _membership.size() * 64; }
+
+    // Append the values of the membership bitmap in [min_value(), max_value()] to |values|, return false if there is
+    // no bitmap or there are more than |limit| values.
+    bool get_membership_values(size_t limit, std::vector<CppType>* values) const {
+        if constexpr (can_use_membership()) {
+            if (_membership.empty()) {
+                return false;
+            }
+            for (size_t word = 0; word < _membership.size(); ++word) {
+                for (uint64_t bits = _membership[word]; bits != 0; bits &= bits - 1) {
+                    uint64_t offset = word * 64 + __builtin_ctzll(bits);
+                    auto value = static_cast<CppType>(static_cast<uint64_t>(_membership_base) + offset);
+                    if (value < _min || value > _max) {
+                        continue;
+                    }
+                    if (values->size() >= limit) {
+                        return false;
+                    }
+                    values->push_back(value);
+                }
+            }
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    // Whether some value in [lower, upper] may pass the filter, used to prune the zone maps. Besides min/max, the
+    // membership bitmap is checked if there is one, otherwise the bloom filter is probed with every integer of the
+    // range if there are at most |max_probes| integers.
+    bool test_range(CppType lower, CppType upper, size_t max_probes) const {
+        lower = std::max(lower, _min);
+        upper = std::min(upper, _max);
+        if (upper < lower) {
+            return false;
+        }
+        if (_always_true) {
+            return true;
+        }
+        if constexpr (can_use_membership()) {
+            uint64_t span = static_cast<uint64_t>(upper) - static_cast<uint64_t>(lower);
+            if (!_membership.empty()) {
+                uint64_t begin = _membership_offset(lower);
+                uint64_t end = begin + span;
+                for (uint64_t word = begin >> 6; word <= end >> 6; ++word) {
+                    uint64_t bits = _membership[word];
+                    if (word == begin >> 6) {
+                        bits &= ~0ULL << (begin & 63);
+                    }
+                    if (word == end >> 6) {
+                        bits &= ~0ULL >> (63 - (end & 63));
+                    }
+                    if (bits != 0) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            if (_hash_partition_bf.empty() && _bf.can_use() && span < max_probes) {
+                for (uint64_t i = 0; i <= span; ++i) {
+                    if (_test_data(static_cast<CppType>(static_cast<uint64_t>(lower) + i))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
     CppType min_value() const { return _min; }
 
     CppType max_value() const { return _max; }
@@ -547,6 +642,8 @@ public:
         if (!_hash_partition_bf.empty()) {
             return _hash_partition_bf[0].can_use() ? _t_evaluate<true, true>(input_column, ctx)
                                                    : _t_evaluate<true, false>(input_column, ctx);
+        } else if (!_membership.empty()) {
+            return _t_evaluate<false, true, true>(input_column, ctx);
         } else {
             return _bf.can_use() ? _t_evaluate<false, true>(input_column, ctx)
                                  : _t_evaluate<false, false>(input_column, ctx);
@@ -556,6 +653,7 @@ public:
     // this->max = std::max(other->max, this->max)
     void merge(const JoinRuntimeFilter* rf) override {
         JoinRuntimeFilter::merge(rf);
+        _membership.clear();
         _merge_min_max(down_cast<const RuntimeBloomFilter*>(rf));
     }
 
@@ -570,6 +668,7 @@ public:
 
     void concat(JoinRuntimeFilter* rf) override {
         JoinRuntimeFilter::concat(rf);
+        _membership.clear();
         _merge_min_max(down_cast<const RuntimeBloomFilter*>(rf));
     }
 
@@ -588,6 +687,9 @@ public:
         } else if constexpr (IsDate<CppType> || IsTimestamp<CppType> || IsDecimal<CppType>) {
             ss << ", _min = " << _min.to_string() << ", _max = " << _max.to_string();
         }
+        if (!_membership.empty()) {
+            ss << ", membership_bits = " << membership_bits();
+        }
         ss << ")";
         return ss.str();
     }
@@ -831,6 +933,21 @@ private:
         }
     }
 
+    uint64_t _membership_offset(CppType value) const {
+        // wraps around for the negative values
+        return static_cast<uint64_t>(value) - static_cast<uint64_t>(_membership_base);
+    }
+
+    // |value| must be in [_min, _max], which is within the range of the membership bitmap.
+    bool _test_member(CppType value) const {
+        if constexpr (can_use_membership()) {
+            uint64_t offset = _membership_offset(value);
+            return (_membership[offset >> 6] >> (offset & 63)) & 1;
+        } else {
+            return true;
+        }
+    }
+
     bool _test_data(CppType value) const {
         DCHECK(_bf.can_use());
         size_t hash = compute_hash(value);
@@ -849,11 +966,13 @@ private:
     }
 
     using HashValues = std::vector<uint32_t>;
-    template <bool hash_partition>
+    template <bool hash_partition, bool use_membership = false>
     void _rf_test_data(uint8_t* selection, const ContainerType& input_data, const HashValues& hash_values,
                        int idx) const {
         if (selection[idx]) {
-            if constexpr (hash_partition) {
+            if constexpr (use_membership) {
+                selection[idx] = _test_member(input_data[idx]);
+            } else if constexpr (hash_partition) {
                 selection[idx] = _test_data_with_hash(input_data[idx], hash_values[idx]);
             } else {
                 selection[idx] = _test_data(input_data[idx]);
@@ -866,7 +985,8 @@ private:
     // and for global runtime filter, since it concates multiple runtime filters from partitions
     // so it has multiple `simd-block-filter` and `multi_partition` is true.
     // For more information, you can refers to doc `shuffle-aware runtime filter`.
-    template <bool multi_partition = false, bool can_use_bf = true>
+    // `use_membership` means the membership bitmap is probed instead of the bloom filter.
+    template <bool multi_partition = false, bool can_use_bf = true, bool use_membership = false>
     void _t_evaluate(Column* input_column, RunningContext* ctx) const {
         size_t size = input_column->size();
         Filter& _selection_filter = ctx->use_merged_selection ? ctx->merged_selection : ctx->selection;
@@ -886,7 +1006,7 @@ private:
                 const auto& input_data = GetContainer<Type>().get_data(const_column->data_column());
                 _evaluate_min_max(input_data, _selection, 1);
                 if constexpr (can_use_bf) {
-                    _rf_test_data<multi_partition>(_selection, input_data, _hash_values, 0);
+                    _rf_test_data<multi_partition, use_membership>(_selection, input_data, _hash_values, 0);
                 }
             }
             uint8_t sel = _selection[0];
@@ -902,14 +1022,14 @@ private:
                         _selection[i] = _has_null;
                     } else {
                         if constexpr (can_use_bf) {
-                            _rf_test_data<multi_partition>(_selection, input_data, _hash_values, i);
+                            _rf_test_data<multi_partition, use_membership>(_selection, input_data, _hash_values, i);
                         }
                     }
                 }
             } else {
                 if constexpr (can_use_bf) {
                     for (int i = 0; i < size; ++i) {
-                        _rf_test_data<multi_partition>(_selection, input_data, _hash_values, i);
+                        _rf_test_data<multi_partition, use_membership>(_selection, input_data, _hash_values, i);
                     }
                 }
             }
@@ -918,7 +1038,7 @@ private:
             _evaluate_min_max(input_data, _selection, size);
             if constexpr (can_use_bf) {
                 for (int i = 0; i < size; ++i) {
-                    _rf_test_data<multi_partition>(_selection, input_data, _hash_values, i);
+                    _rf_test_data<multi_partition, use_membership>(_selection, input_data, _hash_values, i);
                 }
             }
         }
@@ -932,6 +1052,9 @@ private:
     bool _has_min_max = true;
     bool _left_close_interval = true;
     bool _right_close_interval = true;
+    // the bit of offset i is set if _membership_base + i is inserted
+    CppType _membership_base{};
+    std::vector<uint64_t> _membership;
 };
 
 } // namespace starrocks
@@ -18,6 +18,7 @@
 #include <thread>
 
 #include "column/column.h"
+#include "common/config.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exprs/in_const_predicate.hpp"
 #include "exprs/literal.h"
@@ -30,8 +31,10 @@
 #include "runtime/runtime_filter_cache.h"
 #include "runtime/runtime_state.h"
 #include "simd/simd.h"
+#include "types/hll.h"
 #include "types/logical_type.h"
 #include "types/logical_type_infra.h"
+#include "util/hash_util.hpp"
 #include "util/time.h"
 
 namespace starrocks {
@@ -154,6 +157,136 @@ Status RuntimeFilterHelper::fill_runtime_bloom_filter(const ColumnPtr& column, L
     return Status::OK();
 }
 
+// The bloom filter of the small builds is small anyway, so it's not worth estimating their distinct values.
+static constexpr size_t kMinRowsToEstimateNdv = 4096;
+
+struct AdaptiveFilterBuilder {
+    template <LogicalType ltype>
+    auto operator()(const Columns& columns, size_t column_offset, JoinRuntimeFilter* expr, bool eq_null,
+                    bool build_bf) {
+        using CppType = RunTimeCppType<ltype>;
+        auto* filter = down_cast<RuntimeBloomFilter<ltype>*>(expr);
+
+        auto for_each_value = [&](auto&& fn) {
+            for (const auto& column : columns) {
+                if (column->is_nullable()) {
+                    auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
+                    const auto& data_array = GetContainer<ltype>().get_data(nullable_column->data_column().get());
+                    for (size_t j = column_offset; j < data_array.size(); j++) {
+                        if (!nullable_column->is_null(j)) {
+                            fn(data_array[j]);
+                        }
+                    }
+                } else {
+                    const auto& data_array = GetContainer<ltype>().get_data(column.get());
+                    for (size_t j = column_offset; j < data_array.size(); j++) {
+                        fn(data_array[j]);
+                    }
+                }
+            }
+        };
+
+        size_t num_rows = 0;
+        for (const auto& column : columns) {
+            num_rows += column->size() > column_offset ? column->size() - column_offset : 0;
+        }
+
+        // the planner sizes the bloom filter by the number of rows, which may be far more than the distinct values
+        size_t bf_size = num_rows;
+        if (config::enable_adaptive_runtime_filter && num_rows > 0) {
+            bool use_membership = false;
+            if constexpr (RuntimeBloomFilter<ltype>::can_use_membership()) {
+                CppType min_value = std::numeric_limits<CppType>::max();
+                CppType max_value = std::numeric_limits<CppType>::lowest();
+                for_each_value([&](CppType value) {
+                    min_value = std::min(min_value, value);
+                    max_value = std::max(max_value, value);
+                });
+                if (min_value <= max_value) {
+                    // the number of distinct values is at most the size of the range
+                    uint64_t max_offset = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+                    if (max_offset < bf_size) {
+                        bf_size = max_offset + 1;
+                    }
+                    // a bitmap no larger than a bloom filter of one byte per row
+                    if (max_offset < static_cast<uint64_t>(config::runtime_filter_membership_max_bits) &&
+                        max_offset < num_rows * 8) {
+                        filter->init_membership(min_value, max_value);
+                        use_membership = true;
+                    }
+                }
+            }
+            if constexpr (!std::is_pointer_v<CppType>) {
+                if (build_bf && !use_membership && bf_size >= kMinRowsToEstimateNdv) {
+                    HyperLogLog hll;
+                    for_each_value([&](const CppType& value) {
+                        if constexpr (IsSlice<CppType>) {
+                            hll.update(HashUtil::murmur_hash64A(value.data, value.size, HashUtil::MURMUR_SEED));
+                        } else {
+                            hll.update(HashUtil::murmur_hash64A(&value, sizeof(value), HashUtil::MURMUR_SEED));
+                        }
+                    });
+                    // leave some room for the error of the estimation
+                    auto ndv = static_cast<size_t>(hll.estimate_cardinality() * 1.25) + 1;
+                    bf_size = std::min(bf_size, ndv);
+                }
+            }
+        }
+
+        if (build_bf) {
+            filter->init(bf_size);
+        }
+        for (const auto& column : columns) {
+            FilterIniter().template operator()<ltype>(column, column_offset, expr, eq_null);
+        }
+        return nullptr;
+    }
+};
+
+Status RuntimeFilterHelper::build_runtime_bloom_filter(const Columns& columns, LogicalType type,
+                                                       JoinRuntimeFilter* filter, size_t column_offset, bool eq_null,
+                                                       bool build_bf) {
+    for (const auto& column : columns) {
+        if (column->has_large_column()) {
+            return Status::NotSupported("unsupported build runtime filter for large binary column");
+        }
+    }
+    type_dispatch_filter(type, nullptr, AdaptiveFilterBuilder(), columns, column_offset, filter, eq_null, build_bf);
+    return Status::OK();
+}
+
+struct FewDistinctValuesChecker {
+    template <LogicalType ltype>
+    bool operator()(const ColumnPtr& column, size_t column_offset, size_t limit) {
+        const Column* data_column = column.get();
+        const NullableColumn* nullable_column = nullptr;
+        if (column->is_nullable()) {
+            nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
+            data_column = nullable_column->data_column().get();
+        }
+        const auto& data_array = GetContainer<ltype>().get_data(data_column);
+        in_const_pred_detail::LHashSetType<ltype> values;
+        for (size_t j = column_offset; j < data_array.size(); j++) {
+            if (nullable_column != nullptr && nullable_column->is_null(j)) {
+                continue;
+            }
+            values.emplace(data_array[j]);
+            if (values.size() > limit) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+bool RuntimeFilterHelper::has_few_distinct_values(const ColumnPtr& column, LogicalType type, size_t column_offset,
+                                                  size_t limit) {
+    if (column->has_large_column()) {
+        return false;
+    }
+    return type_dispatch_filter(type, false, FewDistinctValuesChecker(), column, column_offset, limit);
+}
+
 StatusOr<ExprContext*> RuntimeFilterHelper::rewrite_runtime_filter_in_cross_join_node(ObjectPool* pool,
                                                                                       ExprContext* conjunct,
                                                                                       Chunk* chunk) {
@@ -57,6 +57,16 @@ public:
     static JoinRuntimeFilter* create_runtime_bloom_filter(ObjectPool* pool, LogicalType type);
     static Status fill_runtime_bloom_filter(const ColumnPtr& column, LogicalType type, JoinRuntimeFilter* filter,
                                             size_t column_offset, bool eq_null);
+    // Init |filter| and fill it with the values of |columns| from |column_offset|, the bloom filter is not built
+    // if |build_bf| is false. If config::enable_adaptive_runtime_filter is true, the representation is chosen by the
+    // actual values instead of the number of rows: the integers of a dense range are also kept in a membership
+    // bitmap, and the bloom filter is sized to the number of distinct values.
+    static Status build_runtime_bloom_filter(const Columns& columns, LogicalType type, JoinRuntimeFilter* filter,
+                                             size_t column_offset, bool eq_null, bool build_bf = true);
+    // Whether the non-null values of |column| from |column_offset| have at most |limit| distinct values, it stops as
+    // soon as more values are seen.
+    static bool has_few_distinct_values(const ColumnPtr& column, LogicalType type, size_t column_offset,
+                                        size_t limit);
 
     static StatusOr<ExprContext*> rewrite_runtime_filter_in_cross_join_node(ObjectPool* pool, ExprContext* conjunct,
                                                                             Chunk* chunk);
@@ -77,6 +77,7 @@
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/stream_load/transaction_mgr.h"
+#include "storage/decoded_page_cache.h"
 #include "storage/lake/fixed_location_provider.h"
 #include "storage/lake/replication_txn_manager.h"
 #include "storage/lake/starlet_location_provider.h"
@@ -222,6 +223,7 @@ Status GlobalEnv::_init_mem_tracker() {
     _ordinal_index_mem_tracker = regist_tracker(-1, "ordinal_index", _column_metadata_mem_tracker.get());
     _bitmap_index_mem_tracker = regist_tracker(-1, "bitmap_index", _column_metadata_mem_tracker.get());
     _bloom_filter_index_mem_tracker = regist_tracker(-1, "bloom_filter_index", _column_metadata_mem_tracker.get());
+    _vector_index_mem_tracker = regist_tracker(-1, "vector_index", _column_metadata_mem_tracker.get());
 
     int64_t compaction_mem_limit = calc_max_compaction_memory(_process_mem_tracker->limit());
     _compaction_mem_tracker = regist_tracker(compaction_mem_limit, "compaction", _process_mem_tracker.get());
@@ -246,6 +248,13 @@ Status GlobalEnv::_init_mem_tracker() {
     return Status::OK();
 }
 
+void GlobalEnv::stop() {
+    _is_init = false;
+    // the decoded pages are charged to the page cache tracker
+    DecodedPageCache::release_global_cache();
+    _reset_tracker();
+}
+
 void GlobalEnv::_reset_tracker() {
     for (auto iter = _mem_trackers.rbegin(); iter != _mem_trackers.rend(); ++iter) {
         iter->reset();
@@ -256,6 +265,15 @@ void GlobalEnv::_init_storage_page_cache() {
     int64_t storage_cache_limit = get_storage_page_cache_size();
     storage_cache_limit = check_storage_page_cache_size(storage_cache_limit);
     StoragePageCache::create_global_cache(page_cache_mem_tracker(), storage_cache_limit);
+
+    int64_t mem_limit = MemInfo::physical_mem();
+    if (process_mem_tracker()->has_limit()) {
+        mem_limit = process_mem_tracker()->limit();
+    }
+    int64_t decoded_page_cache_limit = ParseUtil::parse_mem_spec(config::decoded_page_cache_limit, mem_limit);
+    if (!config::disable_storage_page_cache && decoded_page_cache_limit > 0) {
+        DecodedPageCache::create_global_cache(page_cache_mem_tracker(), decoded_page_cache_limit);
+    }
 }
 
 int64_t GlobalEnv::get_storage_page_cache_size() {
@@ -391,6 +409,28 @@ Status ExecEnv::init(const std::vector<StorePath>& store_paths, bool as_cn) {
                             .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
                             .build(&_dictionary_cache_pool));
 
+    int num_segment_encode_threads = config::segment_encode_thread_num;
+    if (num_segment_encode_threads <= 0) {
+        num_segment_encode_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("segment_encode") // thread pool for encoding column pages of segments
+                            .set_min_threads(0)
+                            .set_max_threads(num_segment_encode_threads)
+                            .set_max_queue_size(INT32_MAX) // unlimit queue size
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_segment_encode_pool));
+
+    int num_vertical_compaction_threads = config::vertical_compaction_column_group_thread_num;
+    if (num_vertical_compaction_threads <= 0) {
+        num_vertical_compaction_threads = CpuInfo::num_cores();
+    }
+    RETURN_IF_ERROR(ThreadPoolBuilder("vcompact_group") // thread pool for reading column groups of vertical compaction
+                            .set_min_threads(0)
+                            .set_max_threads(num_vertical_compaction_threads)
+                            .set_max_queue_size(INT32_MAX) // unlimit queue size
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&_vertical_compaction_pool));
+
     std::unique_ptr<ThreadPool> driver_executor_thread_pool;
     _max_executor_threads = CpuInfo::num_cores();
     if (config::pipeline_exec_thread_pool_thread_num > 0) {
@@ -657,6 +697,14 @@ void ExecEnv::stop() {
         _dictionary_cache_pool->shutdown();
     }
 
+    if (_segment_encode_pool) {
+        _segment_encode_pool->shutdown();
+    }
+
+    if (_vertical_compaction_pool) {
+        _vertical_compaction_pool->shutdown();
+    }
+
 #ifndef BE_TEST
     close_s3_clients();
 #endif
@@ -714,6 +762,8 @@ void ExecEnv::destroy() {
     SAFE_DELETE(_lake_replication_txn_manager);
     SAFE_DELETE(_cache_mgr);
     _dictionary_cache_pool.reset();
+    _segment_encode_pool.reset();
+    _vertical_compaction_pool.reset();
     _automatic_partition_pool.reset();
     _metrics = nullptr;
 }
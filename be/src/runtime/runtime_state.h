@@ -496,6 +496,7 @@ public:
     // logical -> 32
     // div -> 64
     // mod -> 128
+    // function -> 256
     bool can_jit_expr(const int jit_label) {
         return (_query_options.jit_level == 1) || ((_query_options.jit_level & jit_label));
     }
@@ -47,6 +47,7 @@ class ExprContext;
 class RuntimeState;
 class SlotDescriptor;
 class BitmapIndexIterator;
+class JoinRuntimeFilter;
 struct NgramBloomFilterReaderOptions;
 } // namespace starrocks
 
@@ -253,4 +254,9 @@ ColumnPredicate* new_column_null_predicate(const TypeInfoPtr& type, ColumnId, bo
 ColumnPredicate* new_column_dict_conjuct_predicate(const TypeInfoPtr& type_info, ColumnId id,
                                                    std::vector<uint8_t> dict_mapping);
 
+// An index-only predicate pruning the zone maps and bloom filter indexes by the values of |filter|, which must be
+// a RuntimeBloomFilter of the same type. Return nullptr if the type is not supported.
+ColumnPredicate* new_column_runtime_filter_predicate(const TypeInfoPtr& type_info, ColumnId id,
+                                                     const JoinRuntimeFilter* filter);
+
 } //namespace starrocks
@@ -0,0 +1,123 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <sstream>
+
+#include "common/config.h"
+#include "exprs/runtime_filter.h"
+#include "gutil/casts.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/bloom_filter.h"
+#include "storage/zone_map_detail.h"
+
+namespace starrocks {
+
+// ColumnRuntimeFilterPredicate prunes the pages by the values of a join runtime filter, beyond the min/max range
+// which is pushed down as comparison predicates:
+// - A page is skipped if no value in the [min, max] of its zone map may pass the filter, which is exact for the
+//   membership bitmap of dense integers, and probes the bloom filter for the narrow zone maps.
+// - A page is skipped if none of the values of the membership bitmap is in the bloom filter index of the page, if
+//   the build side has few values.
+// It's only used to filter the indexes, the rows are still filtered by the runtime filter itself.
+template <LogicalType field_type>
+class ColumnRuntimeFilterPredicate final : public ColumnPredicate {
+    using ValueType = typename CppTypeTraits<field_type>::CppType;
+    using RuntimeFilterType = RuntimeBloomFilter<field_type>;
+
+    // a zone map of more values than this almost always contains a value of the build side
+    static constexpr size_t kMaxProbesPerZoneMap = 64;
+
+public:
+    ColumnRuntimeFilterPredicate(const TypeInfoPtr& type_info, ColumnId id, const JoinRuntimeFilter* filter)
+            : ColumnPredicate(type_info, id), _filter(down_cast<const RuntimeFilterType*>(filter)) {
+        _is_index_filter_only = true;
+        if (!_filter->get_membership_values(config::max_pushdown_conditions_per_column, &_values)) {
+            _values.clear();
+        }
+    }
+
+    Status evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        memset(selection + from, 1, to - from);
+        return Status::OK();
+    }
+
+    Status evaluate_and(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        return Status::OK();
+    }
+
+    Status evaluate_or(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        memset(selection + from, 1, to - from);
+        return Status::OK();
+    }
+
+    bool zone_map_filter(const ZoneMapDetail& detail) const override {
+        const auto& min = detail.min_value();
+        const auto& max = detail.max_value();
+        if (min.is_null() || max.is_null()) {
+            return true;
+        }
+        return _filter->test_range(min.get<ValueType>(), max.get<ValueType>(), kMaxProbesPerZoneMap);
+    }
+
+    bool support_bloom_filter() const override { return !_values.empty(); }
+
+    bool bloom_filter(const BloomFilter* bf) const override {
+        for (const ValueType& value : _values) {
+            if (bf->test_bytes(reinterpret_cast<const char*>(&value), sizeof(value))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    PredicateType type() const override { return PredicateType::kUnknown; }
+
+    bool can_vectorized() const override { return false; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override {
+        *output = this;
+        return Status::OK();
+    }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "(columnId(" << _column_id << ") IN runtime filter " << _filter->debug_string() << ")";
+        return ss.str();
+    }
+
+private:
+    const RuntimeFilterType* _filter;
+    // the values of the build side if there are few, to probe the bloom filter index
+    std::vector<ValueType> _values;
+};
+
+ColumnPredicate* new_column_runtime_filter_predicate(const TypeInfoPtr& type_info, ColumnId id,
+                                                     const JoinRuntimeFilter* filter) {
+    switch (type_info->type()) {
+    case TYPE_TINYINT:
+        return new ColumnRuntimeFilterPredicate<TYPE_TINYINT>(type_info, id, filter);
+    case TYPE_SMALLINT:
+        return new ColumnRuntimeFilterPredicate<TYPE_SMALLINT>(type_info, id, filter);
+    case TYPE_INT:
+        return new ColumnRuntimeFilterPredicate<TYPE_INT>(type_info, id, filter);
+    case TYPE_BIGINT:
+        return new ColumnRuntimeFilterPredicate<TYPE_BIGINT>(type_info, id, filter);
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace starrocks
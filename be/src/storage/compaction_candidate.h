@@ -28,6 +28,12 @@ struct CompactionCandidate {
     TabletSharedPtr tablet;
     CompactionType type;
     double score = 0;
+    // candidates are ordered by priority before score, see CompactionManager::update_tablet
+    double priority = 0;
+    // estimated bytes read by the compaction, only set by cost based scheduling
+    int64_t input_bytes = 0;
+    // bytes taken from the disk budget when the candidate is picked
+    int64_t disk_budget_bytes = 0;
 
     CompactionCandidate() : tablet(nullptr), type(INVALID_COMPACTION) {}
 
@@ -40,12 +46,18 @@ struct CompactionCandidate {
         tablet = other.tablet;
         type = other.type;
         score = other.score;
+        priority = other.priority;
+        input_bytes = other.input_bytes;
+        disk_budget_bytes = other.disk_budget_bytes;
     }
 
     CompactionCandidate& operator=(const CompactionCandidate& rhs) {
         tablet = rhs.tablet;
         type = rhs.type;
         score = rhs.score;
+        priority = rhs.priority;
+        input_bytes = rhs.input_bytes;
+        disk_budget_bytes = rhs.disk_budget_bytes;
         return *this;
     }
 
@@ -53,12 +65,18 @@ struct CompactionCandidate {
         tablet = std::move(other.tablet);
         type = other.type;
         score = other.score;
+        priority = other.priority;
+        input_bytes = other.input_bytes;
+        disk_budget_bytes = other.disk_budget_bytes;
     }
 
     CompactionCandidate& operator=(CompactionCandidate&& rhs) {
         tablet = std::move(rhs.tablet);
         type = rhs.type;
         score = rhs.score;
+        priority = rhs.priority;
+        input_bytes = rhs.input_bytes;
+        disk_budget_bytes = rhs.disk_budget_bytes;
         return *this;
     }
 
@@ -71,15 +89,19 @@ struct CompactionCandidate {
         }
         ss << ", type:" << starrocks::to_string(type);
         ss << ", score:" << score;
+        ss << ", priority:" << priority;
         return ss.str();
     }
 };
 
-// Comparator should compare tablet by compaction score in descending order
+// Comparator should compare tablet by priority and then compaction score in descending order
 // When compaction scores are equal, put smaller level ahead
 // when compaction score and level are equal, use tablet id(to be unique) instead(ascending)
 struct CompactionCandidateComparator {
     bool operator()(const CompactionCandidate& left, const CompactionCandidate& right) const {
+        if (left.priority != right.priority) {
+            return left.priority > right.priority;
+        }
         return left.score > right.score || (left.score == right.score && left.type > right.type) ||
                (left.score == right.score && left.type == right.type &&
                 left.tablet->tablet_id() < right.tablet->tablet_id());
@@ -0,0 +1,109 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/compaction_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/config.h"
+#include "storage/rowset/rowset.h"
+#include "storage/tablet.h"
+#include "storage/tablet_updates.h"
+
+namespace starrocks {
+
+int64_t CompactionCostModel::num_sorted_runs(const std::vector<RowsetSharedPtr>& rowsets) {
+    int64_t runs = 0;
+    for (const auto& rowset : rowsets) {
+        if (rowset->num_segments() == 0) {
+            continue;
+        }
+        runs += rowset->rowset_meta()->is_segments_overlapping() ? rowset->num_segments() : 1;
+    }
+    return runs;
+}
+
+double CompactionCostModel::priority(double scan_heat, int64_t read_amp_reduction, int64_t input_bytes) {
+    if (read_amp_reduction <= 0) {
+        return 0;
+    }
+    double weight = std::max(0.0, scan_heat) + config::compaction_cold_tablet_weight;
+    double input_mb = std::max(1.0, static_cast<double>(input_bytes) / (1024 * 1024));
+    return weight * static_cast<double>(read_amp_reduction) / input_mb;
+}
+
+double CompactionCostModel::decay_scan_heat(double heat, int64_t elapsed_ms, int64_t half_life_sec) {
+    if (elapsed_ms <= 0 || half_life_sec <= 0) {
+        return heat;
+    }
+    return heat * std::exp2(-static_cast<double>(elapsed_ms) / (half_life_sec * 1000.0));
+}
+
+CompactionCost CompactionCostModel::estimate(const TabletSharedPtr& tablet, CompactionType type) {
+    CompactionCost cost;
+    if (tablet->keys_type() == PRIMARY_KEYS) {
+        // The rowsets of a primary key tablet are kept by TabletUpdates, and every rowset is a sorted
+        // run. The rowsets the compaction picks are not known until it runs, so estimate it by all of
+        // them, to put the primary key tablets on the same scale as the others.
+        auto* updates = tablet->updates();
+        cost.input_bytes = static_cast<int64_t>(updates->data_size());
+        cost.read_amp_reduction = std::max<int64_t>(0, static_cast<int64_t>(updates->num_rowsets()) - 1);
+    } else {
+        std::vector<RowsetSharedPtr> rowsets;
+        if (config::enable_size_tiered_compaction_strategy) {
+            tablet->pick_all_candicate_rowsets(&rowsets);
+        } else if (type == BASE_COMPACTION) {
+            tablet->pick_candicate_rowsets_to_base_compaction(&rowsets);
+        } else {
+            tablet->pick_candicate_rowsets_to_cumulative_compaction(&rowsets);
+        }
+        for (const auto& rowset : rowsets) {
+            cost.input_bytes += rowset->data_disk_size();
+        }
+        // the output of the compaction is a single sorted run
+        cost.read_amp_reduction = std::max<int64_t>(0, num_sorted_runs(rowsets) - 1);
+    }
+    cost.scan_heat = tablet->scan_heat();
+    cost.priority = priority(cost.scan_heat, cost.read_amp_reduction, cost.input_bytes);
+    if (tablet->version_count() * 2 >= static_cast<size_t>(config::tablet_max_versions)) {
+        cost.priority += kUrgentPriority;
+    }
+    return cost;
+}
+
+void CompactionDiskBudget::release(int64_t bytes) {
+    _available += static_cast<double>(bytes);
+}
+
+bool CompactionDiskBudget::try_acquire(int64_t bytes, int64_t now_ms, int64_t rate_bytes_per_sec,
+                                       int64_t burst_bytes) {
+    if (rate_bytes_per_sec <= 0) {
+        return true;
+    }
+    if (_last_refill_ms < 0) {
+        _available = static_cast<double>(burst_bytes);
+    } else if (now_ms > _last_refill_ms) {
+        _available += static_cast<double>(rate_bytes_per_sec) * (now_ms - _last_refill_ms) / 1000;
+        _available = std::min(_available, static_cast<double>(burst_bytes));
+    }
+    _last_refill_ms = now_ms;
+    if (_available <= 0) {
+        return false;
+    }
+    _available -= static_cast<double>(bytes);
+    return true;
+}
+
+} // namespace starrocks
@@ -0,0 +1,80 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+class Rowset;
+class Tablet;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
+using TabletSharedPtr = std::shared_ptr<Tablet>;
+
+struct CompactionCost {
+    // bytes read (and roughly written) by the compaction
+    int64_t input_bytes = 0;
+    // number of sorted runs every scan of the tablet has to merge that the compaction removes
+    int64_t read_amp_reduction = 0;
+    // decayed number of recent scans of the tablet
+    double scan_heat = 0;
+    // larger is more worth to run
+    double priority = 0;
+};
+
+// Estimates the benefit of a compaction candidate as the read amplification it saves for the
+// recent query traffic of the tablet, weighed against the IO the compaction costs.
+class CompactionCostModel {
+public:
+    // Candidates of tablets close to `config::tablet_max_versions` get this priority added,
+    // so they are scheduled before loads start to fail, no matter how cold they are.
+    static constexpr double kUrgentPriority = 1e12;
+
+    static CompactionCost estimate(const TabletSharedPtr& tablet, CompactionType type);
+
+    // Number of sorted runs a reader has to merge for |rowsets|.
+    static int64_t num_sorted_runs(const std::vector<RowsetSharedPtr>& rowsets);
+
+    static double priority(double scan_heat, int64_t read_amp_reduction, int64_t input_bytes);
+
+    // Exponentially decays |heat| which was last updated |elapsed_ms| ago.
+    static double decay_scan_heat(double heat, int64_t elapsed_ms, int64_t half_life_sec);
+};
+
+// Token bucket that limits the compaction input bytes started per second on one data dir.
+// Not thread safe.
+class CompactionDiskBudget {
+public:
+    // Refills the budget for the time elapsed since the last call and takes |bytes| from it.
+    // A task larger than the remaining budget is still admitted as long as the budget is not
+    // overdrawn, so large base compactions are delayed instead of starved.
+    bool try_acquire(int64_t bytes, int64_t now_ms, int64_t rate_bytes_per_sec, int64_t burst_bytes);
+
+    // Gives back |bytes| taken by try_acquire for a task which never ran. The budget is capped to
+    // the burst again on the next refill.
+    void release(int64_t bytes);
+
+    double available() const { return _available; }
+
+private:
+    double _available = 0;
+    int64_t _last_refill_ms = -1;
+};
+
+} // namespace starrocks
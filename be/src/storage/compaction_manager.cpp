@@ -17,6 +17,7 @@
 #include <chrono>
 #include <thread>
 
+#include "storage/compaction_cost_model.h"
 #include "storage/data_dir.h"
 #include "util/starrocks_metrics.h"
 #include "util/thread.h"
@@ -89,16 +90,21 @@ void CompactionManager::_schedule() {
                       << ", compaction_type:" << starrocks::to_string(compaction_candidate.type)
                       << ", compaction_score:" << compaction_candidate.score << " for round:" << _round
                       << ", candidates_size:" << candidates_size();
-            auto st = _compaction_pool->submit_func([compaction_candidate, task_id] {
+            auto st = _compaction_pool->submit_func([this, compaction_candidate, task_id] {
                 auto compaction_task = compaction_candidate.tablet->create_compaction_task();
                 if (compaction_task != nullptr) {
                     compaction_task->set_task_id(task_id);
+                    compaction_task->set_disk_budget_bytes(compaction_candidate.disk_budget_bytes);
                     compaction_task->start();
+                } else {
+                    release_disk_budget(compaction_candidate.tablet->data_dir(),
+                                        compaction_candidate.disk_budget_bytes);
                 }
             });
             if (!st.ok()) {
                 LOG(WARNING) << "submit compaction task " << task_id
                              << " to compaction pool failed. status:" << st.to_string();
+                release_disk_budget(compaction_candidate.tablet->data_dir(), compaction_candidate.disk_budget_bytes);
                 update_tablet_async(compaction_candidate.tablet);
             }
         }
@@ -129,6 +135,11 @@ std::shared_ptr<CompactionTask> CompactionManager::_try_get_next_compaction_task
 
     if (pick_candidate(&compaction_candidate)) {
         compaction_task = compaction_candidate.tablet->create_compaction_task();
+        if (compaction_task != nullptr) {
+            compaction_task->set_disk_budget_bytes(compaction_candidate.disk_budget_bytes);
+        } else {
+            release_disk_budget(compaction_candidate.tablet->data_dir(), compaction_candidate.disk_budget_bytes);
+        }
     }
 
     return compaction_task;
@@ -269,6 +280,34 @@ bool CompactionManager::_check_precondition(const CompactionCandidate& candidate
     return true;
 }
 
+bool CompactionManager::_try_acquire_disk_budget(const CompactionCandidate& candidate, int64_t* acquired_bytes) {
+    *acquired_bytes = 0;
+    if (!config::enable_compaction_cost_based_scheduling || candidate.input_bytes <= 0) {
+        return true;
+    }
+    DataDir* data_dir = candidate.tablet->data_dir();
+    int64_t rate = config::compaction_disk_bandwidth_budget_mb_per_sec * 1024 * 1024;
+    int64_t burst = rate * std::max<int64_t>(1, config::compaction_disk_bandwidth_budget_burst_sec);
+    if (rate <= 0) {
+        return true;
+    }
+    if (!_disk_budgets[data_dir].try_acquire(candidate.input_bytes, UnixMillis(), rate, burst)) {
+        VLOG(2) << "skip tablet:" << candidate.tablet->tablet_id()
+                << " for compaction disk budget exhausted. disk path:" << data_dir->path();
+        return false;
+    }
+    *acquired_bytes = candidate.input_bytes;
+    return true;
+}
+
+void CompactionManager::release_disk_budget(DataDir* data_dir, int64_t bytes) {
+    if (bytes <= 0) {
+        return;
+    }
+    std::lock_guard lg(_candidates_mutex);
+    _disk_budgets[data_dir].release(bytes);
+}
+
 bool CompactionManager::pick_candidate(CompactionCandidate* candidate) {
     std::lock_guard lg(_candidates_mutex);
     if (_compaction_candidates.empty()) {
@@ -277,8 +316,10 @@ bool CompactionManager::pick_candidate(CompactionCandidate* candidate) {
 
     auto iter = _compaction_candidates.begin();
     while (iter != _compaction_candidates.end()) {
-        if (_check_precondition(*iter)) {
+        int64_t acquired_bytes = 0;
+        if (_check_precondition(*iter) && _try_acquire_disk_budget(*iter, &acquired_bytes)) {
             *candidate = *iter;
+            candidate->disk_budget_bytes = acquired_bytes;
             _compaction_candidates.erase(iter);
             _last_score = candidate->score;
             if (candidate->type == CompactionType::BASE_COMPACTION) {
@@ -346,6 +387,15 @@ void CompactionManager::update_tablet(const TabletSharedPtr& tablet) {
         candidate.tablet = tablet;
         candidate.score = tablet->compaction_score();
         candidate.type = tablet->compaction_type();
+        candidate.priority = candidate.score;
+        if (config::enable_compaction_cost_based_scheduling) {
+            auto cost = CompactionCostModel::estimate(tablet, candidate.type);
+            candidate.priority = cost.priority;
+            candidate.input_bytes = cost.input_bytes;
+            VLOG(1) << "tablet " << tablet->tablet_id() << " compaction cost, input_bytes:" << cost.input_bytes
+                    << ", read_amp_reduction:" << cost.read_amp_reduction << ", scan_heat:" << cost.scan_heat
+                    << ", priority:" << cost.priority;
+        }
         update_candidates({candidate});
     }
 }
@@ -571,11 +621,12 @@ Status CompactionManager::update_max_threads(int max_threads) {
 
 double CompactionManager::max_score() {
     std::lock_guard lg(_candidates_mutex);
-    if (_compaction_candidates.empty()) {
-        return 0;
+    // the candidates are ordered by the priority first, so the first one may not have the max score
+    double score = 0;
+    for (const auto& candidate : _compaction_candidates) {
+        score = std::max(score, candidate.score);
     }
-
-    return _compaction_candidates.begin()->score;
+    return score;
 }
 
 double CompactionManager::last_score() {
@@ -23,6 +23,7 @@
 
 #include "common/config.h"
 #include "storage/compaction_candidate.h"
+#include "storage/compaction_cost_model.h"
 #include "storage/compaction_task.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset.h"
@@ -55,6 +56,9 @@ public:
 
     bool pick_candidate(CompactionCandidate* candidate);
 
+    // Gives back the disk budget taken by a picked candidate whose compaction never ran.
+    void release_disk_budget(DataDir* data_dir, int64_t bytes);
+
     void update_tablet_async(const TabletSharedPtr& tablet);
 
     void update_tablet(const TabletSharedPtr& tablet);
@@ -136,6 +140,9 @@ private:
 
     void _dispatch_worker();
     bool _check_precondition(const CompactionCandidate& candidate);
+    // Takes the input bytes of |candidate| from the disk budget of its data dir if cost based
+    // scheduling is on, |acquired_bytes| is what must be released if the task never runs.
+    bool _try_acquire_disk_budget(const CompactionCandidate& candidate, int64_t* acquired_bytes);
     void _schedule();
     void _notify();
     // wait until current running tasks are below max_concurrent_num
@@ -146,6 +153,8 @@ private:
     std::mutex _candidates_mutex;
     // protect by _mutex
     std::set<CompactionCandidate, CompactionCandidateComparator> _compaction_candidates;
+    // protect by _candidates_mutex, used by cost based scheduling only
+    std::unordered_map<DataDir*, CompactionDiskBudget> _disk_budgets;
 
     std::mutex _tasks_mutex;
     std::atomic<uint64_t> _next_task_id;
@@ -73,8 +73,13 @@ void CompactionTask::run() {
     SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
 
     bool is_finished = false;
+    bool is_started = false;
     DeferOp op([&] {
         TRACE("[Compaction] do compaction callback.");
+        if (!is_started) {
+            StorageEngine::instance()->compaction_manager()->release_disk_budget(_tablet->data_dir(),
+                                                                                 _disk_budget_bytes);
+        }
         if (!is_finished) {
             set_compaction_task_state(COMPACTION_FAILED);
         }
@@ -123,6 +128,7 @@ void CompactionTask::run() {
     }
     TRACE("[Compaction] got compaction lock");
 
+    is_started = true;
     Status status = run_impl();
     if (status.ok()) {
         _success_callback();
@@ -144,6 +144,9 @@ public:
 
     void set_compaction_task_state(CompactionTaskState state) { _task_info.state = state; }
 
+    // The bytes taken from the compaction disk budget, released if the task returns before compacting.
+    void set_disk_budget_bytes(int64_t bytes) { _disk_budget_bytes = bytes; }
+
     CompactionTaskState compaction_task_state() { return _task_info.state; }
 
     bool is_compaction_finished() const {
@@ -307,6 +310,7 @@ protected:
     std::shared_lock<std::shared_mutex> _compaction_lock;
     MonotonicStopWatch _watch;
     MemTracker* _mem_tracker{nullptr};
+    int64_t _disk_budget_bytes{0};
 };
 
 } // namespace starrocks
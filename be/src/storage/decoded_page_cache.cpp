@@ -0,0 +1,120 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/decoded_page_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "runtime/current_thread.h"
+#include "runtime/mem_tracker.h"
+#include "util/metrics.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+METRIC_DEFINE_UINT_GAUGE(decoded_page_cache_lookup_count, MetricUnit::OPERATIONS);
+METRIC_DEFINE_UINT_GAUGE(decoded_page_cache_hit_count, MetricUnit::OPERATIONS);
+METRIC_DEFINE_UINT_GAUGE(decoded_page_cache_usage, MetricUnit::BYTES);
+
+DecodedPageCache* DecodedPageCache::_s_instance = nullptr;
+
+void DecodedPageCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+static void init_metrics() {
+    StarRocksMetrics::instance()->metrics()->register_metric("decoded_page_cache_lookup_count",
+                                                             &decoded_page_cache_lookup_count);
+    StarRocksMetrics::instance()->metrics()->register_hook("decoded_page_cache_lookup_count", []() {
+        auto* cache = DecodedPageCache::instance();
+        decoded_page_cache_lookup_count.set_value(cache != nullptr ? cache->get_lookup_count() : 0);
+    });
+
+    StarRocksMetrics::instance()->metrics()->register_metric("decoded_page_cache_hit_count",
+                                                             &decoded_page_cache_hit_count);
+    StarRocksMetrics::instance()->metrics()->register_hook("decoded_page_cache_hit_count", []() {
+        auto* cache = DecodedPageCache::instance();
+        decoded_page_cache_hit_count.set_value(cache != nullptr ? cache->get_hit_count() : 0);
+    });
+
+    StarRocksMetrics::instance()->metrics()->register_metric("decoded_page_cache_usage", &decoded_page_cache_usage);
+    StarRocksMetrics::instance()->metrics()->register_hook("decoded_page_cache_usage", []() {
+        auto* cache = DecodedPageCache::instance();
+        decoded_page_cache_usage.set_value(cache != nullptr ? cache->memory_usage() : 0);
+    });
+}
+
+void DecodedPageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr) {
+        _s_instance = new DecodedPageCache(mem_tracker, capacity);
+        // the hooks read the instance, which may be released and created again
+        static std::once_flag metrics_once;
+        std::call_once(metrics_once, init_metrics);
+    }
+}
+
+DecodedPageCache::DecodedPageCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _max_capacity(capacity), _cache(new_lru_cache(capacity)) {}
+
+bool DecodedPageCache::adjust_capacity(int64_t delta, size_t min_capacity) {
+#ifndef BE_TEST
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+#endif
+    return _cache->adjust_capacity(delta, min_capacity);
+}
+
+void DecodedPageCache::erase_files(const std::vector<uint64_t>& sorted_file_ids) {
+#ifndef BE_TEST
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+#endif
+    _cache->prune_if([&](const CacheKey& key) {
+        if (key.size() != sizeof(StoragePageCache::CacheKey)) {
+            return false;
+        }
+        uint64_t file_id;
+        memcpy(&file_id, key.data(), sizeof(file_id));
+        return std::binary_search(sorted_file_ids.begin(), sorted_file_ids.end(), file_id);
+    });
+}
+
+bool DecodedPageCache::lookup(const StoragePageCache::CacheKey& key, DecodedPageCacheHandle* handle) {
+    auto* lru_handle = _cache->lookup(key.encode());
+    if (lru_handle == nullptr) {
+        return false;
+    }
+    *handle = DecodedPageCacheHandle(_cache.get(), lru_handle);
+    return true;
+}
+
+void DecodedPageCache::insert(const StoragePageCache::CacheKey& key, std::unique_ptr<DecodedPage> page,
+                              DecodedPageCacheHandle* handle) {
+    int64_t mem_size = page->column->memory_usage();
+#ifndef BE_TEST
+    // the column was built by the reading thread, its memory is owned by the cache from now on
+    tls_thread_status.mem_release(mem_size);
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+    tls_thread_status.mem_consume(mem_size);
+#endif
+
+    auto deleter = [](const starrocks::CacheKey& key, void* value) { delete (DecodedPage*)value; };
+    auto* lru_handle = _cache->insert(key.encode(), page.release(), mem_size, deleter);
+    *handle = DecodedPageCacheHandle(_cache.get(), lru_handle);
+}
+
+} // namespace starrocks
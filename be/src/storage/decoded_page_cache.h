@@ -0,0 +1,127 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "column/column.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/common.h"
+#include "util/defer_op.h"
+#include "util/lru_cache.h"
+
+namespace starrocks {
+
+class DecodedPageCacheHandle;
+class MemTracker;
+
+// A data page decoded into a column, ready to be appended to the column being read.
+struct DecodedPage {
+    ColumnPtr column;
+    ordinal_t first_ordinal = 0;
+    ordinal_t corresponding_element_ordinal = 0;
+};
+
+// The second tier of StoragePageCache, with its own memory budget. It keeps the hot data pages
+// decoded, so reading them again skips decompression, null map and page decoding.
+// Pages are keyed the same way as StoragePageCache.
+class DecodedPageCache {
+public:
+    // Create global instance of this class
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if decoded page cache is disabled.
+    static DecodedPageCache* instance() { return _s_instance; }
+
+    DecodedPageCache(MemTracker* mem_tracker, size_t capacity);
+
+    // Return true if the page is found, the cache entry is released when handle destructs.
+    bool lookup(const StoragePageCache::CacheKey& key, DecodedPageCacheHandle* handle);
+
+    // Insert a decoded page into this cache, the given handle will be set to valid reference.
+    void insert(const StoragePageCache::CacheKey& key, std::unique_ptr<DecodedPage> page,
+                DecodedPageCacheHandle* handle);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    size_t get_capacity() const { return _cache->get_capacity(); }
+
+    // The capacity the cache is created with, which the capacity is restored to after memory pressure.
+    size_t max_capacity() const { return _max_capacity; }
+
+    // Like StoragePageCache::adjust_capacity, shrinks the cache under memory pressure and grows it back.
+    bool adjust_capacity(int64_t delta, size_t min_capacity = 0);
+
+    uint64_t get_lookup_count() const { return _cache->get_lookup_count(); }
+
+    uint64_t get_hit_count() const { return _cache->get_hit_count(); }
+
+    void prune() { _cache->prune(); }
+
+    // Like StoragePageCache::erase_files.
+    void erase_files(const std::vector<uint64_t>& sorted_file_ids);
+
+private:
+    static DecodedPageCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    size_t _max_capacity = 0;
+    std::unique_ptr<Cache> _cache = nullptr;
+};
+
+// Like PageCacheHandle, releases the cache entry when it is destroyed.
+class DecodedPageCacheHandle {
+public:
+    DecodedPageCacheHandle() = default;
+    DecodedPageCacheHandle(Cache* cache, Cache::Handle* handle) : _cache(cache), _handle(handle) {}
+    ~DecodedPageCacheHandle() {
+        if (_handle != nullptr) {
+#ifndef BE_TEST
+            MemTracker* prev_tracker =
+                    tls_thread_status.set_mem_tracker(GlobalEnv::GetInstance()->page_cache_mem_tracker());
+            DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
+#endif
+            _cache->release(_handle);
+        }
+    }
+
+    DecodedPageCacheHandle(DecodedPageCacheHandle&& other) noexcept {
+        std::swap(_cache, other._cache);
+        std::swap(_handle, other._handle);
+    }
+
+    DecodedPageCacheHandle& operator=(DecodedPageCacheHandle&& other) noexcept {
+        std::swap(_cache, other._cache);
+        std::swap(_handle, other._handle);
+        return *this;
+    }
+
+    const DecodedPage* page() const { return reinterpret_cast<const DecodedPage*>(_cache->value(_handle)); }
+
+private:
+    Cache* _cache = nullptr;
+    Cache::Handle* _handle = nullptr;
+
+    DecodedPageCacheHandle(const DecodedPageCacheHandle&) = delete;
+    const DecodedPageCacheHandle& operator=(const DecodedPageCacheHandle&) = delete;
+};
+
+} // namespace starrocks
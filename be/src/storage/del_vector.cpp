@@ -16,11 +16,18 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "util/coding.h"
 #include "util/raw_container.h"
 
 namespace starrocks {
 
+static constexpr char kFullFormat = 0x01;
+static constexpr char kDeltaFormat = 0x02;
+// flag + base version + chain length + cardinality
+static constexpr size_t kDeltaHeaderSize = 1 + sizeof(int64_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
 DelVector::DelVector() = default;
 
 DelVector::~DelVector() = default;
@@ -31,6 +38,10 @@ void DelVector::set_empty() {
     _cardinality = 0;
     _memory_usage = 0;
     _roaring.reset();
+    _base_version = -1;
+    _chain_length = 0;
+    _delta.reset();
+    _pending_base_version = -1;
 }
 
 void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
@@ -45,12 +56,21 @@ void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
 void DelVector::add_dels_as_new_version(const std::vector<uint32_t>& dels, int64_t version,
                                         std::shared_ptr<DelVector>* pdelvec) const {
     DCHECK(this != pdelvec->get());
+    DCHECK(!has_pending_base());
     DelVectorPtr tmp(new DelVector());
     if (_roaring) {
         tmp->_roaring = std::make_unique<Roaring>(*_roaring);
     }
     tmp->_version = version;
     tmp->_loaded = true;
+    // An empty delvec may have never been persisted, so the chain always starts from a non-empty one.
+    if (config::enable_delvec_delta_chain && _roaring != nullptr && _version < version &&
+        _chain_length + 1 < config::delvec_delta_chain_max_length) {
+        tmp->_base_version = _version;
+        tmp->_chain_length = _chain_length + 1;
+        tmp->_delta = std::make_unique<Roaring>(dels.size(), dels.data());
+        tmp->_delta->runOptimize();
+    }
     tmp->_add_dels(dels);
     tmp.swap(*pdelvec);
 }
@@ -59,7 +79,33 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     if (length < 1) {
         return Status::Corruption("zero length");
     }
-    if (*data != 0x01) {
+    if (*data == kDeltaFormat) {
+        if (length < kDeltaHeaderSize) {
+            return Status::Corruption("invalid delta delvec header");
+        }
+        auto header = reinterpret_cast<const uint8_t*>(data + 1);
+        int64_t base_version = decode_fixed64_le(header);
+        uint32_t chain_length = decode_fixed32_le(header + sizeof(int64_t));
+        size_t cardinality = decode_fixed64_le(header + sizeof(int64_t) + sizeof(uint32_t));
+        if (base_version >= version) {
+            return Status::Corruption(
+                    strings::Substitute("invalid delta delvec base version:$0 version:$1", base_version, version));
+        }
+        data += kDeltaHeaderSize;
+        length -= kDeltaHeaderSize;
+        _loaded = true;
+        _version = version;
+        _roaring = std::make_unique<Roaring>(length > 0 ? Roaring::readSafe(data, length) : Roaring());
+        _base_version = -1;
+        _chain_length = chain_length;
+        _delta.reset();
+        _pending_base_version = base_version;
+        _update_stats();
+        // report the cardinality of the whole chain so callers only interested in stats never need to merge
+        _cardinality = cardinality;
+        return Status::OK();
+    }
+    if (*data != kFullFormat) {
         return Status::Corruption("invalid flag");
     }
     data += 1;
@@ -73,6 +119,36 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     return Status::OK();
 }
 
+Status DelVector::merge_base(const DelVector& base) {
+    if (!has_pending_base() || base.version() != _pending_base_version) {
+        return Status::Corruption(strings::Substitute("delvec version:$0 expect base version:$1 but got $2", _version,
+                                                      _pending_base_version, base.version()));
+    }
+    size_t cardinality = _cardinality;
+    if (base._roaring) {
+        *_roaring |= *base._roaring;
+    }
+    _pending_base_version = base._pending_base_version;
+    _update_stats();
+    if (has_pending_base()) {
+        _cardinality = cardinality;
+    } else {
+        _roaring->shrinkToFit();
+        if (_cardinality != cardinality) {
+            return Status::Corruption(strings::Substitute("delvec version:$0 expect cardinality:$1 but got $2",
+                                                          _version, cardinality, _cardinality));
+        }
+    }
+    return Status::OK();
+}
+
+int64_t DelVector::parse_base_version(const char* data, size_t length) {
+    if (length < kDeltaHeaderSize || *data != kDeltaFormat) {
+        return -1;
+    }
+    return decode_fixed64_le(reinterpret_cast<const uint8_t*>(data + 1));
+}
+
 void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
     _loaded = true;
     _version = version;
@@ -83,10 +159,11 @@ void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
 }
 
 string DelVector::save() const {
+    DCHECK(!has_pending_base());
     string ret;
     auto roaring_size = _roaring ? _roaring->getSizeInBytes() : 0;
     ret.resize(roaring_size + 1);
-    ret[0] = 0x01; // one byte flag.
+    ret[0] = kFullFormat; // one byte flag.
     if (roaring_size > 0) {
         _roaring->write(ret.data() + 1);
     }
@@ -94,14 +171,31 @@ string DelVector::save() const {
 }
 
 void DelVector::save_to(std::string* str) const {
+    DCHECK(!has_pending_base());
     auto roaring_size = _roaring ? _roaring->getSizeInBytes() : 0;
     str->resize(roaring_size + 1);
-    str->at(0) = 0x01; // one byte flag.
+    str->at(0) = kFullFormat; // one byte flag.
     if (roaring_size > 0) {
         _roaring->write(str->data() + 1);
     }
 }
 
+string DelVector::save_incremental() const {
+    if (_delta == nullptr) {
+        return save();
+    }
+    string ret;
+    auto delta_size = _delta->getSizeInBytes();
+    ret.resize(kDeltaHeaderSize + delta_size);
+    auto header = reinterpret_cast<uint8_t*>(ret.data());
+    header[0] = kDeltaFormat;
+    encode_fixed64_le(header + 1, _base_version);
+    encode_fixed32_le(header + 1 + sizeof(int64_t), _chain_length);
+    encode_fixed64_le(header + 1 + sizeof(int64_t) + sizeof(uint32_t), _cardinality);
+    _delta->write(ret.data() + kDeltaHeaderSize);
+    return ret;
+}
+
 string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
@@ -118,6 +212,9 @@ void DelVector::_update_stats() {
         _memory_usage = 0;
         _cardinality = 0;
     }
+    if (_delta) {
+        _memory_usage += _delta->getSizeInBytes(false);
+    }
 }
 
 void DelVector::copy_from(const DelVector& delvec) {
@@ -130,6 +227,14 @@ void DelVector::copy_from(const DelVector& delvec) {
     } else {
         _roaring.reset();
     }
+    _base_version = delvec._base_version;
+    _chain_length = delvec._chain_length;
+    if (delvec._delta) {
+        _delta = std::make_unique<Roaring>(*delvec._delta);
+    } else {
+        _delta.reset();
+    }
+    _pending_base_version = delvec._pending_base_version;
 }
 
 } // namespace starrocks
@@ -27,6 +27,10 @@ using Roaring = roaring::Roaring;
 // Each DelVector is associated with a version, which is EditVersion's majar version.
 // Serialization format:
 // |<format version (currently 0x01)> 1 byte|serialized roaring bitmap|
+// Delta format, written to the meta store by save_incremental() only:
+// |0x02 1 byte|base version 8 bytes|chain length 4 bytes|cardinality 8 bytes|serialized roaring bitmap|
+// where the bitmap only holds the rows deleted since the base version, and cardinality is the number of
+// deleted rows after merging the whole chain.
 class DelVector {
 public:
     DelVector();
@@ -55,6 +59,21 @@ public:
 
     void save_to(std::string* str) const;
 
+    // Serialize as a delta against the version this delvec was derived from if it was created by
+    // add_dels_as_new_version with delta chain enabled, otherwise same as save().
+    std::string save_incremental() const;
+
+    // A delvec loaded from a delta record only holds the rows of that delta until all its bases
+    // are merged by merge_base().
+    bool has_pending_base() const { return _pending_base_version >= 0; }
+
+    int64_t pending_base_version() const { return _pending_base_version; }
+
+    Status merge_base(const DelVector& base);
+
+    // Return the version a serialized delvec is a delta of, or -1 if it is a full checkpoint.
+    static int64_t parse_base_version(const char* data, size_t length);
+
     std::string to_string() const;
 
     bool empty() const { return !_roaring; }
@@ -73,6 +92,14 @@ private:
     size_t _cardinality = 0;
     size_t _memory_usage = 0;
     std::unique_ptr<Roaring> _roaring;
+    // version this delvec is a delta of, -1 if it should be saved as a full checkpoint
+    int64_t _base_version = -1;
+    // number of deltas written since the last full checkpoint
+    uint32_t _chain_length = 0;
+    // rows deleted since `_base_version`
+    std::unique_ptr<Roaring> _delta;
+    // base version still to be merged into a delvec loaded from a delta record, -1 if complete
+    int64_t _pending_base_version = -1;
 };
 
 typedef std::shared_ptr<DelVector> DelVectorPtr;
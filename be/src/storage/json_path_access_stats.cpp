@@ -0,0 +1,106 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/json_path_access_stats.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+// halve the counts of a column once it's accessed this many times
+static constexpr uint64_t kDecayAccesses = 1024;
+// the fields of a column beyond this aren't counted
+static constexpr size_t kMaxPathsPerColumn = 1024;
+
+JsonPathAccessStats* JsonPathAccessStats::instance() {
+    static JsonPathAccessStats s_stats;
+    return &s_stats;
+}
+
+void JsonPathAccessStats::record(int64_t tablet_id, ColumnUID column_unique_id,
+                                 const std::vector<std::string>& paths) {
+    if (paths.empty()) {
+        return;
+    }
+    std::lock_guard l(_mutex);
+    Key key(tablet_id, column_unique_id);
+    auto [column_iter, inserted] = _columns.try_emplace(key);
+    auto& stats = column_iter->second;
+    if (inserted) {
+        stats.lru_iter = _lru.insert(_lru.begin(), key);
+    } else {
+        _lru.splice(_lru.begin(), _lru, stats.lru_iter);
+    }
+    for (const auto& path : paths) {
+        auto iter = stats.counts.find(path);
+        if (iter != stats.counts.end()) {
+            iter->second++;
+        } else if (stats.counts.size() < kMaxPathsPerColumn) {
+            stats.counts.emplace(path, 1);
+        }
+    }
+
+    stats.total++;
+    if (stats.total >= kDecayAccesses) {
+        for (auto iter = stats.counts.begin(); iter != stats.counts.end();) {
+            iter->second /= 2;
+            iter = iter->second == 0 ? stats.counts.erase(iter) : std::next(iter);
+        }
+        stats.total /= 2;
+    }
+
+    // evict the least recently accessed columns
+    const size_t max_columns = std::max<int64_t>(config::json_flat_access_stats_max_columns, 1);
+    while (_columns.size() > max_columns) {
+        _columns.erase(_lru.back());
+        _lru.pop_back();
+    }
+}
+
+std::vector<std::string> JsonPathAccessStats::hot_paths(int64_t tablet_id, ColumnUID column_unique_id) const {
+    std::vector<std::pair<std::string, uint64_t>> counts;
+    {
+        std::lock_guard l(_mutex);
+        auto iter = _columns.find(Key(tablet_id, column_unique_id));
+        if (iter == _columns.end()) {
+            return {};
+        }
+        counts.assign(iter->second.counts.begin(), iter->second.counts.end());
+    }
+    // sort by name for the same counts, just for stable order
+    std::sort(counts.begin(), counts.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+    });
+    std::vector<std::string> paths;
+    paths.reserve(counts.size());
+    for (auto& [path, count] : counts) {
+        paths.emplace_back(std::move(path));
+    }
+    return paths;
+}
+
+size_t JsonPathAccessStats::num_columns() const {
+    std::lock_guard l(_mutex);
+    return _columns.size();
+}
+
+void JsonPathAccessStats::clear() {
+    std::lock_guard l(_mutex);
+    _columns.clear();
+    _lru.clear();
+}
+
+} // namespace starrocks
@@ -0,0 +1,69 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+// Counts the fields of the JSON columns accessed by the scans, per tablet and column, so that the flat JSON writer
+// flattens the fields which queries actually read at memtable flush and compaction.
+//
+// The counts are halved once a column has been accessed many times, so the recent accesses weigh more, and the
+// least recently accessed columns are evicted once the number of the columns exceeds
+// `config::json_flat_access_stats_max_columns`.
+//
+// Only the scans of the local tablets record the accesses, as the lake scans don't push the column access paths
+// down to the storage, so the writers of the lake tablets flatten the fields by their sparsity alone.
+class JsonPathAccessStats {
+public:
+    static JsonPathAccessStats* instance();
+
+    // Record the access of the top-level fields |paths| of the JSON column |column_unique_id| of |tablet_id|.
+    void record(int64_t tablet_id, ColumnUID column_unique_id, const std::vector<std::string>& paths);
+
+    // The accessed fields of the column, the most accessed first.
+    std::vector<std::string> hot_paths(int64_t tablet_id, ColumnUID column_unique_id) const;
+
+    size_t num_columns() const;
+
+    void clear();
+
+private:
+    using Key = std::pair<int64_t, ColumnUID>;
+
+    struct ColumnStats {
+        std::unordered_map<std::string, uint64_t> counts;
+        uint64_t total = 0;
+        // the position of the column in |_lru|
+        std::list<Key>::iterator lru_iter;
+    };
+
+    mutable std::mutex _mutex;
+    std::map<Key, ColumnStats> _columns;
+    // the keys of |_columns|, the most recently accessed first
+    std::list<Key> _lru;
+};
+
+} // namespace starrocks
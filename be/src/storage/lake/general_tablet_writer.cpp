@@ -20,6 +20,7 @@
 #include "common/config.h"
 #include "fs/fs_util.h"
 #include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "serde/column_array_serde.h"
 #include "storage/lake/filenames.h"
 #include "storage/lake/tablet_manager.h"
@@ -82,6 +83,8 @@ Status HorizontalGeneralTabletWriter::reset_segment_writer() {
     auto name = gen_segment_filename(_txn_id);
     ASSIGN_OR_RETURN(auto of, fs::new_writable_file(_tablet_mgr->segment_location(_tablet_id, name)));
     SegmentWriterOptions opts;
+    opts.encode_pool = ExecEnv::GetInstance()->segment_encode_pool();
+    opts.tablet_id = _tablet_id;
     auto w = std::make_unique<SegmentWriter>(std::move(of), _seg_id++, _schema, opts);
     RETURN_IF_ERROR(w->init());
     _seg_writer = std::move(w);
@@ -260,6 +263,8 @@ StatusOr<std::shared_ptr<SegmentWriter>> VerticalGeneralTabletWriter::create_seg
     auto name = gen_segment_filename(_txn_id);
     ASSIGN_OR_RETURN(auto of, fs::new_writable_file(_tablet_mgr->segment_location(_tablet_id, name)));
     SegmentWriterOptions opts;
+    opts.encode_pool = ExecEnv::GetInstance()->segment_encode_pool();
+    opts.tablet_id = _tablet_id;
     auto w = std::make_shared<SegmentWriter>(std::move(of), _seg_id++, _schema, opts);
     RETURN_IF_ERROR(w->init(column_indexes, is_key));
     return w;
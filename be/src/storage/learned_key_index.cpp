@@ -0,0 +1,254 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/learned_key_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "column/column.h"
+#include "column/column_helper.h"
+#include "column/type_traits.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+
+namespace starrocks {
+
+// The distance between two keys, which may overflow int64_t.
+static inline double key_distance(int64_t from, int64_t to) {
+    return static_cast<double>(static_cast<__int128>(to) - from);
+}
+
+bool LearnedKeyIndexBuilder::is_supported(LogicalType key_type) {
+    switch (key_type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void LearnedKeyIndexBuilder::add_keys(const Column& keys) {
+    if (_abandoned) {
+        return;
+    }
+    if (keys.has_null()) {
+        _abandoned = true;
+        return;
+    }
+    const Column* data = ColumnHelper::get_data_column(&keys);
+    switch (_key_type) {
+    case TYPE_TINYINT:
+        return _add_keys<TYPE_TINYINT>(*data);
+    case TYPE_SMALLINT:
+        return _add_keys<TYPE_SMALLINT>(*data);
+    case TYPE_INT:
+        return _add_keys<TYPE_INT>(*data);
+    case TYPE_BIGINT:
+        return _add_keys<TYPE_BIGINT>(*data);
+    case TYPE_DATE:
+        return _add_keys<TYPE_DATE>(*data);
+    case TYPE_DATETIME:
+        return _add_keys<TYPE_DATETIME>(*data);
+    default:
+        _abandoned = true;
+    }
+}
+
+template <LogicalType Type>
+void LearnedKeyIndexBuilder::_add_keys(const Column& keys) {
+    const auto& values = down_cast<const RunTimeColumnType<Type>&>(keys).get_data();
+    for (size_t i = 0; i < values.size() && !_abandoned; i++) {
+        if constexpr (Type == TYPE_DATE) {
+            _add_key(values[i].julian());
+        } else if constexpr (Type == TYPE_DATETIME) {
+            _add_key(values[i].timestamp());
+        } else {
+            _add_key(values[i]);
+        }
+    }
+}
+
+void LearnedKeyIndexBuilder::_add_key(int64_t key) {
+    if (!_has_key) {
+        _has_key = true;
+        _add_point(key, 0);
+    } else if (key < _last_key) {
+        // not sorted by the first sort key column
+        _abandoned = true;
+        return;
+    } else if (key > _last_key) {
+        // LB(k) is _num_rows for all k in (_last_key, key]
+        if (key - 1 > _last_key) {
+            _add_point(_last_key + 1, _num_rows);
+        }
+        _add_point(key, _num_rows);
+    }
+    _last_key = key;
+    _num_rows++;
+}
+
+// The greedy shrinking cone: a piece starts at its first point, and every point narrows the range of
+// slopes with which the piece passes within |_max_error| of all points, the piece ends when the range
+// becomes empty. The slopes are not negative, so the pieces are monotone.
+void LearnedKeyIndexBuilder::_add_point(int64_t x, uint32_t y) {
+    if (_has_piece) {
+        double dx = key_distance(_origin_x, x);
+        double dy = static_cast<double>(y) - _origin_y;
+        double lo = std::max(_slope_lo, (dy - _max_error) / dx);
+        double hi = std::min(_slope_hi, (dy + _max_error) / dx);
+        if (lo <= hi) {
+            _slope_lo = lo;
+            _slope_hi = hi;
+            _last_x = x;
+            return;
+        }
+        _close_piece();
+        size_t max_pieces = std::max<size_t>(kMinPieces, _num_rows / std::max<uint32_t>(_num_rows_per_block, 1));
+        if (_first_keys.size() > max_pieces) {
+            _abandoned = true;
+            return;
+        }
+    }
+    _has_piece = true;
+    _origin_x = x;
+    _origin_y = y;
+    _last_x = x;
+    _slope_lo = 0;
+    _slope_hi = std::numeric_limits<double>::infinity();
+}
+
+void LearnedKeyIndexBuilder::_close_piece() {
+    _first_keys.push_back(_origin_x);
+    _last_keys.push_back(_last_x);
+    _intercepts.push_back(_origin_y);
+    // a piece with only one point
+    _slopes.push_back(std::isinf(_slope_hi) ? 0 : (_slope_lo + _slope_hi) / 2);
+    _has_piece = false;
+}
+
+bool LearnedKeyIndexBuilder::finish(LearnedKeyIndexPB* index) {
+    if (_abandoned || !_has_key) {
+        return false;
+    }
+    if (_last_key < std::numeric_limits<int64_t>::max()) {
+        _add_point(_last_key + 1, _num_rows);
+    }
+    if (_abandoned) {
+        return false;
+    }
+    _close_piece();
+    index->set_key_type(_key_type);
+    index->set_max_error(_max_error);
+    index->mutable_first_keys()->Add(_first_keys.begin(), _first_keys.end());
+    index->mutable_last_keys()->Add(_last_keys.begin(), _last_keys.end());
+    index->mutable_intercepts()->Add(_intercepts.begin(), _intercepts.end());
+    index->mutable_slopes()->Add(_slopes.begin(), _slopes.end());
+    return true;
+}
+
+Status LearnedKeyIndex::parse(const LearnedKeyIndexPB& index, uint32_t num_rows) {
+    const int num_pieces = index.first_keys_size();
+    if (num_pieces == 0 || index.last_keys_size() != num_pieces || index.intercepts_size() != num_pieces ||
+        index.slopes_size() != num_pieces) {
+        return Status::Corruption(strings::Substitute("invalid learned key index, pieces=$0/$1/$2/$3", num_pieces,
+                                                      index.last_keys_size(), index.intercepts_size(),
+                                                      index.slopes_size()));
+    }
+    if (!LearnedKeyIndexBuilder::is_supported(static_cast<LogicalType>(index.key_type()))) {
+        return Status::Corruption(strings::Substitute("invalid learned key index, key_type=$0", index.key_type()));
+    }
+    for (int i = 0; i < num_pieces; i++) {
+        if (index.first_keys(i) > index.last_keys(i) || (i > 0 && index.first_keys(i) <= index.last_keys(i - 1)) ||
+            index.intercepts(i) > num_rows || !(index.slopes(i) >= 0)) {
+            return Status::Corruption(strings::Substitute("invalid learned key index, piece=$0", i));
+        }
+    }
+    _key_type = static_cast<LogicalType>(index.key_type());
+    _max_error = index.max_error();
+    _num_rows = num_rows;
+    _first_keys.assign(index.first_keys().begin(), index.first_keys().end());
+    _last_keys.assign(index.last_keys().begin(), index.last_keys().end());
+    _intercepts.assign(index.intercepts().begin(), index.intercepts().end());
+    _slopes.assign(index.slopes().begin(), index.slopes().end());
+    return Status::OK();
+}
+
+bool LearnedKeyIndex::to_key(LogicalType type, const Datum& value, int64_t* key) const {
+    if (type != _key_type || value.is_null()) {
+        return false;
+    }
+    switch (type) {
+    case TYPE_TINYINT:
+        *key = value.get_int8();
+        return true;
+    case TYPE_SMALLINT:
+        *key = value.get_int16();
+        return true;
+    case TYPE_INT:
+        *key = value.get_int32();
+        return true;
+    case TYPE_BIGINT:
+        *key = value.get_int64();
+        return true;
+    case TYPE_DATE:
+        *key = value.get_date().julian();
+        return true;
+    case TYPE_DATETIME:
+        *key = value.get_timestamp().timestamp();
+        return true;
+    default:
+        return false;
+    }
+}
+
+void LearnedKeyIndex::_lower_bound(int64_t key, int64_t* lo, int64_t* hi) const {
+    if (key < _first_keys.front()) {
+        *lo = *hi = 0;
+        return;
+    }
+    size_t i = std::upper_bound(_first_keys.begin(), _first_keys.end(), key) - _first_keys.begin() - 1;
+    if (key > _last_keys[i]) {
+        // LB(k) is constant between two consecutive points, i.e. the last point of this piece
+        // and the first point of the next piece
+        *lo = *hi = i + 1 < _first_keys.size() ? _intercepts[i + 1] : _num_rows;
+        return;
+    }
+    double predicted = _intercepts[i] + _slopes[i] * key_distance(_first_keys[i], key);
+    // one more row for the rounding errors
+    *lo = static_cast<int64_t>(std::floor(predicted)) - _max_error - 1;
+    *hi = static_cast<int64_t>(std::ceil(predicted)) + _max_error + 1;
+}
+
+void LearnedKeyIndex::locate(int64_t key, uint32_t* from, uint32_t* to) const {
+    int64_t lo;
+    int64_t hi;
+    _lower_bound(key, &lo, &hi);
+    if (key < std::numeric_limits<int64_t>::max()) {
+        int64_t unused;
+        _lower_bound(key + 1, &unused, &hi);
+    } else {
+        hi = _num_rows;
+    }
+    *from = std::clamp<int64_t>(lo, 0, _num_rows);
+    *to = std::clamp<int64_t>(hi, 0, _num_rows);
+}
+
+} // namespace starrocks
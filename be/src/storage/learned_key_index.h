@@ -0,0 +1,123 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "column/datum.h"
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+class Column;
+
+// The learned key index of a segment is a piecewise linear model of LB(k), the number of rows
+// whose first sort key column is less than k, with a bounded error. It predicts the ordinals of a
+// key with a few arithmetic operations instead of the binary search over the short key index, and
+// the rows to search are bounded by the error instead of the short key block, see LearnedKeyIndex::locate().
+//
+// LB(k) is a step function, which is approximated at the points (d, LB(d)) and (d + 1, LB(d + 1))
+// of every distinct key d. Since LB(k) is constant between two consecutive points, a model which
+// is monotone and accurate at the points is accurate at any key between them as well.
+class LearnedKeyIndexBuilder {
+public:
+    // |max_error| is the maximal error in rows of the model, the index is abandoned if it needs
+    // more pieces than the short key index with |num_rows_per_block| rows per item needs items.
+    LearnedKeyIndexBuilder(LogicalType key_type, uint32_t max_error, uint32_t num_rows_per_block)
+            : _key_type(key_type), _max_error(max_error), _num_rows_per_block(num_rows_per_block) {}
+
+    static bool is_supported(LogicalType key_type);
+
+    // Add the keys of the next rows, |keys| is a column of the first sort key column.
+    void add_keys(const Column& keys);
+
+    // Return false if the index is not built, e.g. the keys contain null.
+    bool finish(LearnedKeyIndexPB* index);
+
+private:
+    template <LogicalType Type>
+    void _add_keys(const Column& keys);
+
+    void _add_key(int64_t key);
+
+    void _add_point(int64_t x, uint32_t y);
+
+    void _close_piece();
+
+    // more pieces than this are allowed when the segment is small
+    static constexpr size_t kMinPieces = 16;
+
+    const LogicalType _key_type;
+    const uint32_t _max_error;
+    const uint32_t _num_rows_per_block;
+
+    bool _abandoned = false;
+    bool _has_key = false;
+    int64_t _last_key = 0;
+    uint32_t _num_rows = 0;
+
+    // the current piece passes through (_origin_x, _origin_y) with slope in [_slope_lo, _slope_hi]
+    bool _has_piece = false;
+    int64_t _origin_x = 0;
+    uint32_t _origin_y = 0;
+    int64_t _last_x = 0;
+    double _slope_lo = 0;
+    double _slope_hi = 0;
+
+    std::vector<int64_t> _first_keys;
+    std::vector<int64_t> _last_keys;
+    std::vector<uint32_t> _intercepts;
+    std::vector<double> _slopes;
+};
+
+class LearnedKeyIndex {
+public:
+    Status parse(const LearnedKeyIndexPB& index, uint32_t num_rows);
+
+    LogicalType key_type() const { return _key_type; }
+
+    // Convert the value of the first sort key column to the key of the model, return false if
+    // it is null or not of the type |key_type()|.
+    bool to_key(LogicalType type, const Datum& value, int64_t* key) const;
+
+    // Set [*from, *to] to the range of ordinals which contains both the ordinal of the first row whose
+    // first sort key column is not less than |key| and that of the first row whose first sort key column
+    // is greater than |key|. So the lower bound and upper bound of any key whose first column is |key|
+    // are in this range.
+    void locate(int64_t key, uint32_t* from, uint32_t* to) const;
+
+    size_t num_pieces() const { return _first_keys.size(); }
+
+    int64_t mem_usage() const {
+        return sizeof(LearnedKeyIndex) + _first_keys.size() * (2 * sizeof(int64_t) + sizeof(uint32_t) + sizeof(double));
+    }
+
+private:
+    // Set [*lo, *hi] to the range of ordinals which contains LB(key).
+    void _lower_bound(int64_t key, int64_t* lo, int64_t* hi) const;
+
+    LogicalType _key_type = TYPE_UNKNOWN;
+    uint32_t _max_error = 0;
+    uint32_t _num_rows = 0;
+    std::vector<int64_t> _first_keys;
+    std::vector<int64_t> _last_keys;
+    std::vector<uint32_t> _intercepts;
+    std::vector<double> _slopes;
+};
+
+} // namespace starrocks
@@ -57,6 +57,9 @@ public:
 
     void set_predicate_parser(PredicateParser* parser) { _parser = parser; }
 
+    // Whether there is no runtime filter which may arrive to prune the ranges.
+    bool empty() const { return _unarrived_runtime_filters.empty(); }
+
     Status update_range_if_arrived(const ColumnIdToGlobalDictMap* global_dictmaps,
                                    RuntimeFilterArrivedCallBack&& updater, size_t raw_read_rows) {
         if (_arrived_runtime_filters_masks.empty()) return Status::OK();
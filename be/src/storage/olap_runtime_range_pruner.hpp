@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 
+#include "common/config.h"
 #include "exec/olap_common.h"
 #include "exprs/runtime_filter_bank.h"
 #include "runtime/global_dict/config.h"
@@ -92,6 +93,15 @@ struct RuntimeColumnPredicateBuilder {
                 preds.emplace_back(std::move(p));
             }
 
+            // the values of the filter beyond its min/max prune the zone maps and bloom filter indexes
+            if (config::enable_runtime_filter_index_pruning) {
+                std::unique_ptr<ColumnPredicate> p(parser->parse_runtime_filter(*slot, rf));
+                if (p != nullptr) {
+                    VLOG(1) << "build runtime predicate:" << p->debug_string();
+                    preds.emplace_back(std::move(p));
+                }
+            }
+
             return preds;
         }
     }
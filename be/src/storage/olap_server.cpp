@@ -47,10 +47,12 @@
 #include "fs/fs_util.h"
 #include "storage/compaction.h"
 #include "storage/compaction_manager.h"
+#include "storage/decoded_page_cache.h"
 #include "storage/lake/local_pk_index_manager.h"
 #include "storage/lake/update_manager.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
+#include "storage/page_cache.h"
 #include "storage/persistent_index_compaction_manager.h"
 #include "storage/publish_version_manager.h"
 #include "storage/replication_txn_manager.h"
@@ -275,6 +277,19 @@ void evict_pagecache(StoragePageCache* cache, int64_t bytes_to_dec, std::atomic<
     }
 }
 
+// The decoded pages are rebuilt from the pages, so the decoded page cache gives up its memory first.
+// Returns the bytes left to be given up by the page cache.
+static int64_t shrink_decoded_page_cache(DecodedPageCache* cache, int64_t bytes_to_dec) {
+    if (cache == nullptr || bytes_to_dec <= 0) {
+        return bytes_to_dec;
+    }
+    int64_t bytes = std::min(bytes_to_dec, static_cast<int64_t>(cache->get_capacity()));
+    if (bytes > 0) {
+        cache->adjust_capacity(-bytes);
+    }
+    return bytes_to_dec - bytes;
+}
+
 void* StorageEngine::_adjust_pagecache_callback(void* arg_this) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
@@ -284,8 +299,10 @@ void* StorageEngine::_adjust_pagecache_callback(void* arg_this) {
     std::unique_ptr<GCHelper> dec_advisor = std::make_unique<GCHelper>(cur_period, cur_interval, MonoTime::Now());
     std::unique_ptr<GCHelper> inc_advisor = std::make_unique<GCHelper>(cur_period, cur_interval, MonoTime::Now());
     auto cache = StoragePageCache::instance();
+    auto decoded_cache = DecodedPageCache::instance();
     while (!_bg_worker_stopped.load(std::memory_order_consume)) {
         SLEEP_IN_BG_WORKER(cur_interval);
+        PageCacheFileIdRegistry::instance()->erase_evicted_pages();
         if (!config::enable_auto_adjust_pagecache) {
             continue;
         }
@@ -321,20 +338,31 @@ void* StorageEngine::_adjust_pagecache_callback(void* arg_this) {
         int64_t memory_high = memtracker->limit() * memory_high_level / 100;
         if (delta_urgent > 0) {
             // Memory usage exceeds memory_urgent_level, reduce size immediately.
-            cache->adjust_capacity(-delta_urgent, kcacheMinSize);
+            cache->adjust_capacity(-shrink_decoded_page_cache(decoded_cache, delta_urgent), kcacheMinSize);
             size_t bytes_to_dec = dec_advisor->bytes_should_gc(MonoTime::Now(), memory_urgent - memory_high);
-            evict_pagecache(cache, static_cast<int64_t>(bytes_to_dec), _bg_worker_stopped);
+            evict_pagecache(cache, shrink_decoded_page_cache(decoded_cache, static_cast<int64_t>(bytes_to_dec)),
+                            _bg_worker_stopped);
             continue;
         }
 
         int64_t delta_high = memtracker->consumption() - memory_high;
         if (delta_high > 0) {
             size_t bytes_to_dec = dec_advisor->bytes_should_gc(MonoTime::Now(), delta_high);
-            evict_pagecache(cache, static_cast<int64_t>(bytes_to_dec), _bg_worker_stopped);
+            evict_pagecache(cache, shrink_decoded_page_cache(decoded_cache, static_cast<int64_t>(bytes_to_dec)),
+                            _bg_worker_stopped);
         } else {
             int64_t max_cache_size = std::max(GlobalEnv::GetInstance()->get_storage_page_cache_size(), kcacheMinSize);
             int64_t cur_cache_size = cache->get_capacity();
             if (cur_cache_size >= max_cache_size) {
+                // the decoded page cache grows back after the page cache
+                if (decoded_cache != nullptr && decoded_cache->get_capacity() < decoded_cache->max_capacity()) {
+                    int64_t delta_cache = std::min<int64_t>(
+                            decoded_cache->max_capacity() - decoded_cache->get_capacity(), std::abs(delta_high));
+                    size_t bytes_to_inc = inc_advisor->bytes_should_gc(MonoTime::Now(), delta_cache);
+                    if (bytes_to_inc > 0) {
+                        decoded_cache->adjust_capacity(bytes_to_inc);
+                    }
+                }
                 continue;
             }
             int64_t delta_cache = std::min(max_cache_size - cur_cache_size, std::abs(delta_high));
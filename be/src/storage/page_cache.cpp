@@ -36,8 +36,13 @@
 
 #include <malloc.h>
 
+#include <algorithm>
+#include <cstring>
+
+#include "common/config.h"
 #include "runtime/current_thread.h"
 #include "runtime/mem_tracker.h"
+#include "storage/decoded_page_cache.h"
 #include "util/defer_op.h"
 #include "util/lru_cache.h"
 #include "util/metrics.h"
@@ -49,8 +54,125 @@ METRIC_DEFINE_UINT_GAUGE(page_cache_lookup_count, MetricUnit::OPERATIONS);
 METRIC_DEFINE_UINT_GAUGE(page_cache_hit_count, MetricUnit::OPERATIONS);
 METRIC_DEFINE_UINT_GAUGE(page_cache_capacity, MetricUnit::BYTES);
 
+struct PageTypeCacheMetrics {
+    METRIC_DEFINE_UINT_COUNTER(lookup_count, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_UINT_COUNTER(hit_count, MetricUnit::OPERATIONS);
+};
+// indexed by PageTypePB
+static constexpr int kNumPageTypes = PageTypePB_MAX + 1;
+static PageTypeCacheMetrics page_type_cache_metrics[kNumPageTypes];
+
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
+PageCacheFileIdRegistry* PageCacheFileIdRegistry::instance() {
+    static PageCacheFileIdRegistry s_registry;
+    return &s_registry;
+}
+
+uint64_t PageCacheFileIdRegistry::get_or_register(const std::string& fname) {
+    uint64_t id = 0;
+    if (_ids.if_contains(fname, [&](const auto& kv) {
+            id = kv.second.id;
+            if (!kv.second.referenced.load(std::memory_order_relaxed)) {
+                kv.second.referenced.store(true, std::memory_order_relaxed);
+            }
+        })) {
+        return id;
+    }
+
+    bool inserted = false;
+    _ids.lazy_emplace_l(
+            fname, [&](const auto& kv) { id = kv.second.id; },
+            [&](const auto& ctor) {
+                id = _next_id.fetch_add(1, std::memory_order_relaxed);
+                inserted = true;
+                ctor(fname, Entry(id));
+            });
+    if (!inserted) {
+        return id;
+    }
+
+    std::vector<uint64_t> evicted_ids;
+    {
+        std::lock_guard l(_queue_mutex);
+        _queue.push_back(fname);
+        const auto max_size = static_cast<size_t>(std::max<int64_t>(config::page_cache_file_id_registry_max_size, 1));
+        // names of the files deleted without going through remove() pile up here
+        if (_ids.size() > max_size) {
+            evicted_ids = _evict(max_size);
+        } else if (_queue.size() > 2 * max_size) {
+            // drop the removed names
+            std::deque<std::string> queue;
+            for (auto& name : _queue) {
+                if (_ids.contains(name)) {
+                    queue.push_back(std::move(name));
+                }
+            }
+            _queue.swap(queue);
+        }
+    }
+    if (!evicted_ids.empty()) {
+        // the pages cached under the evicted ids can't be hit any more, pruning every shard of the caches is
+        // too slow for the read path, so they are erased in the background
+        const auto max_size = static_cast<size_t>(std::max<int64_t>(config::page_cache_file_id_registry_max_size, 1));
+        std::lock_guard l(_evicted_mutex);
+        // if nobody erases them, they just age out of the caches
+        if (_evicted_ids.size() < max_size) {
+            _evicted_ids.insert(_evicted_ids.end(), evicted_ids.begin(), evicted_ids.end());
+        }
+    }
+    return id;
+}
+
+void PageCacheFileIdRegistry::erase_evicted_pages() {
+    std::vector<uint64_t> evicted_ids;
+    {
+        std::lock_guard l(_evicted_mutex);
+        evicted_ids.swap(_evicted_ids);
+    }
+    if (evicted_ids.empty()) {
+        return;
+    }
+    std::sort(evicted_ids.begin(), evicted_ids.end());
+    if (StoragePageCache::instance() != nullptr) {
+        StoragePageCache::instance()->erase_files(evicted_ids);
+    }
+    if (DecodedPageCache::instance() != nullptr) {
+        DecodedPageCache::instance()->erase_files(evicted_ids);
+    }
+    VLOG(1) << "erase the pages of " << evicted_ids.size() << " files evicted from page cache file id registry";
+}
+
+std::vector<uint64_t> PageCacheFileIdRegistry::_evict(size_t max_size) {
+    // a batch is evicted at once, so the pages of the evicted files are erased from the caches once per batch
+    const size_t target_size = max_size - std::min(max_size, std::max<size_t>(max_size / 16, 1));
+    std::vector<uint64_t> evicted_ids;
+    // every name is passed at most twice, once to clear its reference bit and once to evict it
+    size_t steps = 2 * _queue.size();
+    for (; _ids.size() > target_size && !_queue.empty() && steps > 0; --steps) {
+        std::string fname = std::move(_queue.front());
+        _queue.pop_front();
+        bool present = false;
+        bool erased = _ids.erase_if(fname, [&](Entry& entry) {
+            present = true;
+            if (entry.referenced.exchange(false, std::memory_order_relaxed)) {
+                return false;
+            }
+            evicted_ids.push_back(entry.id);
+            return true;
+        });
+        if (present && !erased) {
+            // referenced since the last pass, give it a second chance
+            _queue.push_back(std::move(fname));
+        }
+    }
+    return evicted_ids;
+}
+
+void PageCacheFileIdRegistry::remove(const std::string& fname) {
+    _ids.erase(fname);
+}
+
 void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
     if (_s_instance == nullptr) {
         _s_instance = new StoragePageCache(mem_tracker, capacity);
@@ -68,6 +190,20 @@ void StoragePageCache::prune() {
     _cache->prune();
 }
 
+void StoragePageCache::erase_files(const std::vector<uint64_t>& sorted_file_ids) {
+#ifndef BE_TEST
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+#endif
+    _cache->prune_if([&](const starrocks::CacheKey& key) {
+        if (key.size() != sizeof(CacheKey)) {
+            return false;
+        }
+        uint64_t file_id;
+        memcpy(&file_id, key.data(), sizeof(file_id));
+        return std::binary_search(sorted_file_ids.begin(), sorted_file_ids.end(), file_id);
+    });
+}
+
 static void init_metrics() {
     StarRocksMetrics::instance()->metrics()->register_metric("page_cache_lookup_count", &page_cache_lookup_count);
     StarRocksMetrics::instance()->metrics()->register_hook("page_cache_lookup_count", []() {
@@ -83,10 +219,37 @@ static void init_metrics() {
     StarRocksMetrics::instance()->metrics()->register_hook("page_cache_capacity", []() {
         page_cache_capacity.set_value(StoragePageCache::instance()->get_capacity());
     });
+
+    const std::pair<PageTypePB, const char*> page_types[] = {{DATA_PAGE, "data"},
+                                                             {INDEX_PAGE, "index"},
+                                                             {DICTIONARY_PAGE, "dictionary"},
+                                                             {SHORT_KEY_PAGE, "short_key"},
+                                                             {VECTOR_INDEX_PAGE, "vector_index"}};
+    for (const auto& [type, name] : page_types) {
+        StarRocksMetrics::instance()->metrics()->register_metric("page_cache_page_type_lookup_count",
+                                                                 MetricLabels().add("type", name),
+                                                                 &page_type_cache_metrics[type].lookup_count);
+        StarRocksMetrics::instance()->metrics()->register_metric("page_cache_page_type_hit_count",
+                                                                 MetricLabels().add("type", name),
+                                                                 &page_type_cache_metrics[type].hit_count);
+    }
+}
+
+static EvictionPolicy page_cache_eviction_policy() {
+    if (config::page_cache_eviction_policy == "slru") {
+        return EvictionPolicy::SLRU;
+    }
+    if (config::page_cache_eviction_policy == "clock") {
+        return EvictionPolicy::CLOCK;
+    }
+    LOG_IF(WARNING, config::page_cache_eviction_policy != "lru")
+            << "unknown page_cache_eviction_policy: " << config::page_cache_eviction_policy << ", use lru";
+    return EvictionPolicy::LRU;
 }
 
 StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity, ChargeMode::MEMSIZE)) {
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, ChargeMode::MEMSIZE, page_cache_eviction_policy())) {
     init_metrics();
 }
 
@@ -118,6 +281,16 @@ bool StoragePageCache::adjust_capacity(int64_t delta, size_t min_capacity) {
     return _cache->adjust_capacity(delta, min_capacity);
 }
 
+void StoragePageCache::record_lookup(PageTypePB page_type, bool hit) {
+    if (page_type < 0 || page_type >= kNumPageTypes) {
+        return;
+    }
+    page_type_cache_metrics[page_type].lookup_count.increment(1);
+    if (hit) {
+        page_type_cache_metrics[page_type].hit_count.increment(1);
+    }
+}
+
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
     auto* lru_handle = _cache->lookup(key.encode());
     if (lru_handle == nullptr) {
@@ -34,15 +34,22 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "gen_cpp/segment.pb.h"
 #include "gutil/macros.h" // for DISALLOW_COPY
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "util/defer_op.h"
 #include "util/lru_cache.h"
+#include "util/phmap/phmap.h"
 
 namespace starrocks {
 
@@ -52,6 +59,64 @@ class MemTracker;
 // Page cache min size is 256MB
 static constexpr int64_t kcacheMinSize = 268435456;
 
+// Maps file names to 64-bit ids, so that page cache keys are fixed 16-byte (file id, offset) pairs
+// instead of a copy of the file name plus offset built on every lookup.
+// Ids are never reused: a file registered again after being removed gets a new id, and the pages
+// cached under its old id just age out of the cache.
+// The registry keeps at most config::page_cache_file_id_registry_max_size names, the least recently used
+// ones are evicted in batches by a second chance sweep in registration order. Their pages are erased
+// from the page caches later by erase_evicted_pages(), off the read path.
+class PageCacheFileIdRegistry {
+public:
+    static PageCacheFileIdRegistry* instance();
+
+    // Return the id of `fname`, register it if absent.
+    uint64_t get_or_register(const std::string& fname);
+
+    // Called when the file is deleted.
+    void remove(const std::string& fname);
+
+    // Erases the pages cached under the ids evicted since the last call, called by a background thread.
+    void erase_evicted_pages();
+
+    size_t size() const { return _ids.size(); }
+
+private:
+    struct Entry {
+        explicit Entry(uint64_t id_) : id(id_) {}
+        Entry(const Entry& other) : id(other.id), referenced(other.referenced.load(std::memory_order_relaxed)) {}
+        Entry& operator=(const Entry& other) {
+            id = other.id;
+            referenced.store(other.referenced.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        uint64_t id;
+        // set by the lookups under the read lock, cleared by the eviction sweep
+        mutable std::atomic<bool> referenced{false};
+    };
+
+    // Evicts entries until there are no more than `max_size` minus a batch. Returns the ids of the evicted ones.
+    // REQUIRES: _queue_mutex is held
+    std::vector<uint64_t> _evict(size_t max_size);
+
+    // read lock on hit, so that concurrent lookups of the same file do not serialize
+    using IdMap = phmap::parallel_flat_hash_map<std::string, Entry, phmap::Hash<std::string>,
+                                                phmap::EqualTo<std::string>,
+                                                std::allocator<std::pair<const std::string, Entry>>, 4,
+                                                std::shared_mutex>;
+    IdMap _ids;
+    std::atomic<uint64_t> _next_id{1};
+
+    std::mutex _queue_mutex;
+    // the names in registration order, swept by the eviction, may contain removed names
+    std::deque<std::string> _queue;
+
+    std::mutex _evicted_mutex;
+    // the evicted ids whose pages are not erased yet
+    std::vector<uint64_t> _evicted_ids;
+};
+
 // Warpper around Cache, and used for cache page of column datas
 // in Segment.
 // TODO(zc): We should add some metric to see cache hit/miss rate.
@@ -60,22 +125,18 @@ public:
     virtual ~StoragePageCache();
     // The unique key identifying entries in the page cache.
     // Each cached page corresponds to a specific offset within
-    // a file.
-    //
-    // TODO(zc): Now we use file name(std::string) as a part of
-    // key, which is not efficient. We should make it better later
+    // a file, the file is identified by its id in PageCacheFileIdRegistry.
     struct CacheKey {
-        CacheKey(std::string fname_, int64_t offset_) : fname(std::move(fname_)), offset(offset_) {}
-        std::string fname;
+        CacheKey(uint64_t file_id_, int64_t offset_) : file_id(file_id_), offset(offset_) {}
+        CacheKey(const std::string& fname, int64_t offset_)
+                : CacheKey(PageCacheFileIdRegistry::instance()->get_or_register(fname), offset_) {}
+        uint64_t file_id;
         int64_t offset;
 
-        // Encode to a flat binary which can be used as LRUCache's key
-        std::string encode() const {
-            std::string key_buf(fname);
-            key_buf.append((char*)&offset, sizeof(offset));
-            return key_buf;
-        }
+        // The fixed size binary used as LRUCache's key, refers to this object.
+        starrocks::CacheKey encode() const { return {reinterpret_cast<const char*>(this), sizeof(*this)}; }
     };
+    static_assert(sizeof(CacheKey) == 16);
 
     // Create global instance of this class
     static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
@@ -106,6 +167,9 @@ public:
 
     size_t memory_usage() const { return _cache->get_memory_usage(); }
 
+    // Record a lookup of a page of `page_type`, for the per page type hit ratio metrics.
+    void record_lookup(PageTypePB page_type, bool hit);
+
     void set_capacity(size_t capacity);
 
     size_t get_capacity();
@@ -118,6 +182,9 @@ public:
 
     void prune();
 
+    // Erase the pages of the files whose ids are in `sorted_file_ids`, except the ones in use.
+    void erase_files(const std::vector<uint64_t>& sorted_file_ids);
+
 private:
     static StoragePageCache* _s_instance;
 
@@ -114,6 +114,17 @@ StatusOr<ColumnPredicate*> PredicateParser::parse_expr_ctx(const SlotDescriptor&
     return ColumnExprPredicate::make_column_expr_predicate(type_info, column_id, state, expr_ctx, &slot_desc);
 }
 
+ColumnPredicate* PredicateParser::parse_runtime_filter(const SlotDescriptor& slot_desc,
+                                                       const JoinRuntimeFilter* filter) const {
+    const size_t column_id = _schema->field_index(slot_desc.col_name());
+    RETURN_IF(column_id >= _schema->num_columns(), nullptr);
+    const TabletColumn& col = _schema->column(column_id);
+    // the values of the runtime filter are compared with the values in the index as they are
+    RETURN_IF(col.type() != slot_desc.type().type, nullptr);
+    auto&& type_info = get_type_info(col.type(), col.precision(), col.scale());
+    return new_column_runtime_filter_predicate(type_info, column_id, filter);
+}
+
 uint32_t PredicateParser::column_id(const SlotDescriptor& slot_desc) {
     return _schema->field_index(slot_desc.col_name());
 }
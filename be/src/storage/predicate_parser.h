@@ -28,6 +28,7 @@ class TCondition;
 class ExprContext;
 class SlotDescriptor;
 class RuntimeState;
+class JoinRuntimeFilter;
 
 class ColumnPredicate;
 
@@ -49,6 +50,10 @@ public:
     StatusOr<ColumnPredicate*> parse_expr_ctx(const SlotDescriptor& slot_desc, RuntimeState*,
                                               ExprContext* expr_ctx) const;
 
+    // Parse the runtime filter |filter| on |slot_desc| into an index-only predicate pruning the zone maps and bloom
+    // filter indexes, return nullptr if it can't be pushed down.
+    ColumnPredicate* parse_runtime_filter(const SlotDescriptor& slot_desc, const JoinRuntimeFilter* filter) const;
+
     uint32_t column_id(const SlotDescriptor& slot_desc);
 
 private:
@@ -87,6 +87,10 @@ public:
     Status flip_to_read();
     Status flush();
 
+    // Returns a new buffer that reads the masks written to this buffer from the beginning,
+    // independently of the read position of this buffer. Must be called after flush().
+    StatusOr<std::unique_ptr<RowSourceMaskBuffer>> clone_for_read() const;
+
 private:
     void _reset_mask_column() { _mask_column->reset_column(); }
     Status _create_tmp_file();
@@ -97,6 +101,8 @@ private:
 
     // for read
     uint64_t _current_index = 0;
+    // read offset of the temporary file
+    off_t _read_offset = 0;
 
     // temporary file for persistence
     int _tmp_file_fd = -1;
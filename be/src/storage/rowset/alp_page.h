@@ -0,0 +1,368 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "column/column.h"
+#include "storage/rowset/encoded_predicate.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "storage/type_traits.h"
+#include "util/coding.h"
+#include "util/frame_of_reference_coding.h"
+
+namespace starrocks {
+
+namespace alp {
+
+inline constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+inline constexpr double kInvPow10[] = {1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+                                       1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+
+template <typename T>
+inline constexpr int kMaxExponent = std::is_same_v<T, float> ? 10 : 18;
+
+// `exponent` in page header marking the values are stored as is, used when ALP does not pay off.
+inline constexpr uint8_t kRawExponent = 0xFF;
+
+// Header: count(4) + exponent(1) + factor(1) + for_size(4) + exception_count(4)
+inline constexpr size_t kHeaderSize = 14;
+
+// Values are sampled to choose exponent and factor of a page.
+inline constexpr size_t kSampleSize = 64;
+
+template <typename T>
+inline T decode(int64_t encoded, int exponent, int factor) {
+    return static_cast<T>(static_cast<double>(encoded) * kPow10[factor] * kInvPow10[exponent]);
+}
+
+// Return false if `value` can not be restored exactly from an integer with the exponent and factor.
+template <typename T>
+inline bool encode(T value, int exponent, int factor, int64_t* encoded) {
+    double scaled = static_cast<double>(value) * kPow10[exponent] * kInvPow10[factor];
+    // also rejects NaN and infinity
+    if (!(std::abs(scaled) < 4.6e18)) {
+        return false;
+    }
+    int64_t v = static_cast<int64_t>(std::nearbyint(scaled));
+    T restored = decode<T>(v, exponent, factor);
+    // compare bits, -0.0 is not restored from 0
+    if (memcmp(&restored, &value, sizeof(T)) != 0) {
+        return false;
+    }
+    *encoded = v;
+    return true;
+}
+
+} // namespace alp
+
+// Encode page use ALP (adaptive lossless floating-point) coding. Floating-point values with few
+// significant decimal digits, e.g. metrics, are multiplied by 10^exponent / 10^factor to integers,
+// the integers are stored with frame-of-reference coding. The values which can not be restored
+// exactly are stored as exceptions. The exponent and factor are chosen per page from samples.
+//
+// The layout of page:
+// | count(4) | exponent(1) | factor(1) | for_size(4) | exception_count(4) | integers(for_size) |
+// | exception positions(4 * exception_count) | exception values(sizeof(CppType) * exception_count) |
+// If exponent is kRawExponent, the values follow the header as is.
+template <LogicalType Type>
+class AlpPageBuilder final : public PageBuilder {
+public:
+    explicit AlpPageBuilder(const PageBuilderOptions& options) : _options(options) {}
+
+    ~AlpPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() * sizeof(CppType) >= _options.data_page_size; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + count);
+        return count;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _encode();
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _finished = false;
+        _buf.clear();
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * sizeof(CppType); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    static_assert(std::is_floating_point_v<CppType>, "ALP only encodes floating-point values");
+
+    // Choose the exponent and factor which minimize the estimated size of samples.
+    void _choose_exponent_and_factor(int* best_exponent, int* best_factor) const {
+        const size_t step = std::max<size_t>(1, _values.size() / alp::kSampleSize);
+        uint64_t best_cost = std::numeric_limits<uint64_t>::max();
+        *best_exponent = 0;
+        *best_factor = 0;
+        for (int e = 0; e <= alp::kMaxExponent<CppType>; e++) {
+            for (int f = 0; f <= e; f++) {
+                uint64_t exceptions = 0;
+                uint64_t samples = 0;
+                int64_t min_value = std::numeric_limits<int64_t>::max();
+                int64_t max_value = std::numeric_limits<int64_t>::min();
+                for (size_t i = 0; i < _values.size(); i += step) {
+                    int64_t v;
+                    samples++;
+                    if (alp::encode(_values[i], e, f, &v)) {
+                        min_value = std::min(min_value, v);
+                        max_value = std::max(max_value, v);
+                    } else {
+                        exceptions++;
+                    }
+                }
+                uint64_t width = exceptions == samples
+                                         ? 0
+                                         : bits(static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value));
+                uint64_t cost = samples * width + exceptions * (sizeof(uint32_t) + sizeof(CppType)) * 8;
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    *best_exponent = e;
+                    *best_factor = f;
+                }
+            }
+        }
+    }
+
+    void _encode() {
+        _buf.clear();
+        const uint32_t count = _values.size();
+        int exponent = 0;
+        int factor = 0;
+        if (count > 0) {
+            _choose_exponent_and_factor(&exponent, &factor);
+        }
+
+        std::vector<int64_t> encoded(count);
+        std::vector<uint32_t> exception_positions;
+        bool has_placeholder = false;
+        int64_t placeholder = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (alp::encode(_values[i], exponent, factor, &encoded[i])) {
+                if (!has_placeholder) {
+                    has_placeholder = true;
+                    placeholder = encoded[i];
+                }
+            } else {
+                exception_positions.push_back(i);
+            }
+        }
+        // exceptions take the value of the first encoded one, to not widen the frames
+        for (uint32_t pos : exception_positions) {
+            encoded[pos] = placeholder;
+        }
+
+        faststring for_buf;
+        if (count > 0) {
+            ForEncoder<int64_t> encoder(&for_buf);
+            encoder.put_batch(encoded.data(), count);
+            encoder.flush();
+        }
+        const size_t encoded_size =
+                for_buf.size() + exception_positions.size() * (sizeof(uint32_t) + sizeof(CppType));
+        if (encoded_size >= count * sizeof(CppType)) {
+            _put_header(count, alp::kRawExponent, 0, 0, 0);
+            _buf.append(_values.data(), count * sizeof(CppType));
+            return;
+        }
+
+        _put_header(count, exponent, factor, for_buf.size(), exception_positions.size());
+        _buf.append(for_buf.data(), for_buf.size());
+        for (uint32_t pos : exception_positions) {
+            put_fixed32_le(&_buf, pos);
+        }
+        for (uint32_t pos : exception_positions) {
+            _buf.append(&_values[pos], sizeof(CppType));
+        }
+    }
+
+    void _put_header(uint32_t count, uint8_t exponent, uint8_t factor, uint32_t for_size, uint32_t exception_count) {
+        put_fixed32_le(&_buf, count);
+        _buf.push_back(exponent);
+        _buf.push_back(factor);
+        put_fixed32_le(&_buf, for_size);
+        put_fixed32_le(&_buf, exception_count);
+    }
+
+    PageBuilderOptions _options;
+    bool _finished{false};
+    std::vector<CppType> _values;
+    faststring _buf;
+};
+
+// The whole page is decoded in init(), like the bitshuffle pages which are decompressed before being
+// parsed, so seeking is free and reading is a copy.
+template <LogicalType Type>
+class AlpPageDecoder final : public PageDecoder {
+public:
+    AlpPageDecoder(Slice data) : _data(data) {}
+
+    ~AlpPageDecoder() override = default;
+
+    [[nodiscard]] Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < alp::kHeaderSize) {
+            return Status::Corruption("The ALP page is too small");
+        }
+        const auto* p = reinterpret_cast<const uint8_t*>(_data.data);
+        const uint32_t count = decode_fixed32_le(p);
+        const uint8_t exponent = p[4];
+        const uint8_t factor = p[5];
+        const uint32_t for_size = decode_fixed32_le(p + 6);
+        const uint32_t exception_count = decode_fixed32_le(p + 10);
+        p += alp::kHeaderSize;
+        const size_t body_size = _data.size - alp::kHeaderSize;
+        _values.resize(count);
+
+        if (exponent == alp::kRawExponent) {
+            if (body_size != count * sizeof(CppType)) {
+                return Status::Corruption("The ALP page size does not match");
+            }
+            memcpy(_values.data(), p, body_size);
+            _parsed = true;
+            return Status::OK();
+        }
+        if (exponent > alp::kMaxExponent<CppType> || factor > exponent ||
+            body_size != for_size + exception_count * (sizeof(uint32_t) + sizeof(CppType))) {
+            return Status::Corruption("The ALP page metadata maybe broken");
+        }
+        if (count > 0) {
+            std::vector<int64_t> encoded(count);
+            ForDecoder<int64_t> decoder(p, for_size);
+            if (!decoder.init() || decoder.count() != count || !decoder.get_batch(encoded.data(), count)) {
+                return Status::Corruption("The ALP page integers maybe broken");
+            }
+            // same expression as alp::decode, kept simple so that it is vectorized
+            const double pow10_factor = alp::kPow10[factor];
+            const double inv_pow10_exponent = alp::kInvPow10[exponent];
+            CppType* __restrict out = _values.data();
+            const int64_t* __restrict in = encoded.data();
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = static_cast<CppType>(static_cast<double>(in[i]) * pow10_factor * inv_pow10_exponent);
+            }
+        }
+        const uint8_t* positions = p + for_size;
+        const uint8_t* exceptions = positions + exception_count * sizeof(uint32_t);
+        for (uint32_t i = 0; i < exception_count; i++) {
+            uint32_t pos = decode_fixed32_le(positions + i * sizeof(uint32_t));
+            if (pos >= count) {
+                return Status::Corruption("The ALP page exceptions maybe broken");
+            }
+            memcpy(&_values[pos], exceptions + i * sizeof(CppType), sizeof(CppType));
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _values.size()) << "Tried to seek to " << pos << " which is > number of elements ("
+                                       << _values.size() << ") in the block!";
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(size_t* n, Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        size_t to_read = std::min(*n, static_cast<size_t>(_values.size() - _cur_index));
+        size_t appended = dst->append_numbers(_values.data() + _cur_index, to_read * sizeof(CppType));
+        DCHECK_EQ(to_read, appended);
+        _cur_index += to_read;
+        *n = to_read;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        SparseRangeIterator<> iter = range.new_iterator();
+        size_t to_read = std::min(static_cast<size_t>(range.span_size()),
+                                  static_cast<size_t>(_values.size() - _cur_index));
+        while (to_read > 0) {
+            _cur_index = iter.begin();
+            Range<> r = iter.next(to_read);
+            size_t appended = dst->append_numbers(_values.data() + _cur_index, r.span_size() * sizeof(CppType));
+            DCHECK_EQ(r.span_size(), appended);
+            _cur_index += r.span_size();
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                              uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if constexpr (!is_encoded_value_type<Type>()) {
+            return Status::NotSupported("next_batch_selection() not supported");
+        } else {
+            size_t to_read = std::min(*n, static_cast<size_t>(_values.size() - _cur_index));
+            EncodedValueRange<Type>(predicates).evaluate(_values.data() + _cur_index, to_read, selection);
+            _cur_index += to_read;
+            *n = to_read;
+            return Status::OK();
+        }
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint32_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return ALP_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    bool _parsed{false};
+    Slice _data;
+    uint32_t _cur_index{0};
+    std::vector<CppType> _values;
+};
+
+} // namespace starrocks
@@ -17,6 +17,7 @@
 #include "common/status.h"
 #include "gutil/casts.h"
 #include "storage/rowset/column_writer.h"
+#include "storage/rowset/vector_index.h"
 
 namespace starrocks {
 
@@ -25,7 +26,7 @@ public:
     explicit ArrayColumnWriter(const ColumnWriterOptions& opts, TypeInfoPtr type_info,
                                std::unique_ptr<ScalarColumnWriter> null_writer,
                                std::unique_ptr<ScalarColumnWriter> offset_writer,
-                               std::unique_ptr<ColumnWriter> element_writer);
+                               std::unique_ptr<ColumnWriter> element_writer, WritableFile* wfile);
     ~ArrayColumnWriter() override = default;
 
     Status init() override;
@@ -46,6 +47,8 @@ public:
 
     Status write_bloom_filter_index() override { return Status::OK(); }
 
+    Status write_vector_index() override;
+
     ordinal_t get_next_rowid() const override { return _array_size_writer->get_next_rowid(); }
 
     uint64_t total_mem_footprint() const override;
@@ -56,6 +59,8 @@ private:
     std::unique_ptr<ScalarColumnWriter> _null_writer;
     std::unique_ptr<ScalarColumnWriter> _array_size_writer;
     std::unique_ptr<ColumnWriter> _element_writer;
+    WritableFile* _wfile;
+    std::unique_ptr<VectorIndexWriter> _vector_index_writer;
 };
 
 StatusOr<std::unique_ptr<ColumnWriter>> create_array_column_writer(const ColumnWriterOptions& opts,
@@ -111,18 +116,19 @@ StatusOr<std::unique_ptr<ColumnWriter>> create_array_column_writer(const ColumnW
     std::unique_ptr<ScalarColumnWriter> offset_writer =
             std::make_unique<ScalarColumnWriter>(array_size_options, std::move(int_type_info), wfile);
     return std::make_unique<ArrayColumnWriter>(opts, std::move(type_info), std::move(null_writer),
-                                               std::move(offset_writer), std::move(element_writer));
+                                               std::move(offset_writer), std::move(element_writer), wfile);
 }
 
 ArrayColumnWriter::ArrayColumnWriter(const ColumnWriterOptions& opts, TypeInfoPtr type_info,
                                      std::unique_ptr<ScalarColumnWriter> null_writer,
                                      std::unique_ptr<ScalarColumnWriter> offset_writer,
-                                     std::unique_ptr<ColumnWriter> element_writer)
+                                     std::unique_ptr<ColumnWriter> element_writer, WritableFile* wfile)
         : ColumnWriter(std::move(type_info), opts.meta->length(), opts.meta->is_nullable()),
           _opts(opts),
           _null_writer(std::move(null_writer)),
           _array_size_writer(std::move(offset_writer)),
-          _element_writer(std::move(element_writer)) {}
+          _element_writer(std::move(element_writer)),
+          _wfile(wfile) {}
 
 Status ArrayColumnWriter::init() {
     if (is_nullable()) {
@@ -131,6 +137,13 @@ Status ArrayColumnWriter::init() {
     RETURN_IF_ERROR(_array_size_writer->init());
     RETURN_IF_ERROR(_element_writer->init());
 
+    if (_opts.need_vector_index) {
+        if (_element_writer->type_info()->type() != TYPE_FLOAT) {
+            return Status::NotSupported("Vector index is only supported for array of float");
+        }
+        ASSIGN_OR_RETURN(auto options, VectorIndexOptions::create(_opts.tablet_index.at(VECTOR)));
+        _vector_index_writer = std::make_unique<VectorIndexWriter>(options);
+    }
     return Status::OK();
 }
 
@@ -156,6 +169,10 @@ Status ArrayColumnWriter::append(const Column& column) {
     // 3. writer elements column recursively
     RETURN_IF_ERROR(_element_writer->append(array_column->elements()));
 
+    if (_vector_index_writer != nullptr) {
+        RETURN_IF_ERROR(_vector_index_writer->add_values(
+                *array_column, null_column != nullptr ? null_column->get_data().data() : nullptr));
+    }
     return Status::OK();
 }
 
@@ -164,6 +181,9 @@ uint64_t ArrayColumnWriter::estimate_buffer_size() {
     if (is_nullable()) {
         estimate_size += _null_writer->estimate_buffer_size();
     }
+    if (_vector_index_writer != nullptr) {
+        estimate_size += _vector_index_writer->size();
+    }
     return estimate_size;
 }
 
@@ -207,6 +227,13 @@ Status ArrayColumnWriter::write_ordinal_index() {
     return Status::OK();
 }
 
+Status ArrayColumnWriter::write_vector_index() {
+    if (_vector_index_writer != nullptr) {
+        RETURN_IF_ERROR(_vector_index_writer->finish(_wfile, _opts.meta->add_indexes()));
+    }
+    return Status::OK();
+}
+
 Status ArrayColumnWriter::finish_current_page() {
     if (is_nullable()) {
         RETURN_IF_ERROR(_null_writer->finish_current_page());
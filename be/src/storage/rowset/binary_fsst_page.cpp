@@ -0,0 +1,233 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/binary_fsst_page.h"
+
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "storage/rowset/encoded_predicate.h"
+
+namespace starrocks {
+
+faststring* BinaryFsstPageBuilder::finish() {
+    DCHECK(!_finished);
+    const size_t num_elems = _offsets.size();
+    const size_t raw_size = _raw.size();
+
+    // sample the strings evenly across the page
+    std::vector<Slice> samples;
+    const size_t step = raw_size / kSampleBytes + 1;
+    for (size_t i = 0; i < num_elems; i += step) {
+        samples.emplace_back(get_value(i));
+    }
+    FsstSymbolTable table;
+    table.build(samples);
+
+    faststring strings;
+    std::vector<uint32_t> offsets(num_elems);
+    strings.resize(FsstSymbolTable::max_compressed_size(raw_size));
+    size_t strings_size = 0;
+    for (size_t i = 0; i < num_elems; i++) {
+        offsets[i] = strings_size;
+        strings_size += table.compress(get_value(i), strings.data() + strings_size);
+    }
+    strings.resize(strings_size);
+
+    faststring table_buf;
+    if (strings_size >= raw_size) {
+        // not compressible, store the raw strings with an empty symbol table
+        table.clear();
+        table.serialize(&table_buf);
+        _buffer.reserve(sizeof(uint32_t) + table_buf.size() + raw_size + (num_elems + 2) * sizeof(uint32_t));
+        put_fixed32_le(&_buffer, table_buf.size());
+        _buffer.append(table_buf.data(), table_buf.size());
+        _buffer.append(_raw.data(), raw_size);
+        for (uint32_t offset : _offsets) {
+            put_fixed32_le(&_buffer, offset);
+        }
+    } else {
+        table.serialize(&table_buf);
+        _buffer.reserve(sizeof(uint32_t) + table_buf.size() + strings_size + (num_elems + 2) * sizeof(uint32_t));
+        put_fixed32_le(&_buffer, table_buf.size());
+        _buffer.append(table_buf.data(), table_buf.size());
+        _buffer.append(strings.data(), strings_size);
+        for (uint32_t offset : offsets) {
+            put_fixed32_le(&_buffer, offset);
+        }
+    }
+    put_fixed32_le(&_buffer, raw_size);
+    put_fixed32_le(&_buffer, num_elems);
+    _finished = true;
+    return &_buffer;
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::init() {
+    RETURN_IF(_parsed, Status::OK());
+    const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+    const size_t size = _data.size;
+    if (size < 3 * sizeof(uint32_t)) {
+        return Status::Corruption("file corruption: not enough bytes for header and trailer in BinaryFsstPageDecoder");
+    }
+    _num_elems = decode_fixed32_le(data + size - sizeof(uint32_t));
+    _decompressed_size = decode_fixed32_le(data + size - 2 * sizeof(uint32_t));
+    const uint32_t table_size = decode_fixed32_le(data);
+    const size_t trailer_size = (static_cast<size_t>(_num_elems) + 2) * sizeof(uint32_t);
+    if (sizeof(uint32_t) + table_size + trailer_size > size) {
+        return Status::Corruption("file corruption: invalid header or trailer in BinaryFsstPageDecoder");
+    }
+    auto table_bytes = _table.deserialize(data + sizeof(uint32_t), table_size);
+    if (!table_bytes.ok() || table_bytes.value() != table_size) {
+        return Status::Corruption("file corruption: invalid symbol table in BinaryFsstPageDecoder");
+    }
+    _strings = data + sizeof(uint32_t) + table_size;
+    _strings_size = size - sizeof(uint32_t) - table_size - trailer_size;
+    _offsets_ptr = data + size - trailer_size;
+    if (_table.empty() && _strings_size != _decompressed_size) {
+        return Status::Corruption("file corruption: invalid strings size in BinaryFsstPageDecoder");
+    }
+    // compressed_at() relies on the offsets
+    uint32_t prev_offset = 0;
+    for (uint32_t i = 0; i < _num_elems; i++) {
+        uint32_t offset = _offset(i);
+        if (offset < prev_offset || offset > _strings_size) {
+            return Status::Corruption("file corruption: invalid offsets in BinaryFsstPageDecoder");
+        }
+        prev_offset = offset;
+    }
+    _parsed = true;
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::next_batch(size_t* count, Column* dst) {
+    SparseRange<> read_range;
+    uint32_t begin = current_index();
+    read_range.add(Range<>(begin, begin + *count));
+    RETURN_IF_ERROR(next_batch(read_range, dst));
+    *count = current_index() - begin;
+    return Status::OK();
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::next_batch(const SparseRange<>& range, Column* dst) {
+    DCHECK(_parsed);
+    if (PREDICT_FALSE(_cur_idx >= _num_elems)) {
+        return Status::OK();
+    }
+
+    size_t to_read = std::min(range.span_size(), _num_elems - _cur_idx);
+    auto* binary = down_cast<BinaryColumn*>(ColumnHelper::get_data_column(dst));
+    auto& bytes = binary->get_bytes();
+    auto& offsets = binary->get_offset();
+    const size_t old_rows = offsets.size();
+    offsets.reserve(old_rows + to_read);
+    // The values read are a part of this page, so the decompressed size of the page is enough.
+    const size_t old_bytes_size = bytes.size();
+    size_t bytes_size = old_bytes_size;
+    const size_t bytes_end = bytes_size + _decompressed_size;
+    bytes.resize(bytes_end + FsstSymbolTable::kDecompressPadding);
+
+    SparseRangeIterator<> iter = range.new_iterator();
+    while (to_read > 0) {
+        _cur_idx = iter.begin();
+        Range<> r = iter.next(to_read);
+        size_t end = _cur_idx + r.span_size();
+        for (; _cur_idx < end; _cur_idx++) {
+            Slice compressed = compressed_at(_cur_idx);
+            uint8_t* out = bytes.data() + bytes_size;
+            size_t len;
+            if (_table.empty()) {
+                // the raw strings, whose size is the decompressed size
+                memcpy(out, compressed.data, compressed.size);
+                len = compressed.size;
+            } else {
+                auto res = _table.decompress(reinterpret_cast<const uint8_t*>(compressed.data), compressed.size, out,
+                                             bytes_end - bytes_size);
+                if (!res.ok()) {
+                    bytes.resize(old_bytes_size);
+                    offsets.resize(old_rows);
+                    return res.status();
+                }
+                len = res.value();
+            }
+            if constexpr (Type == TYPE_CHAR) {
+                len = strnlen(reinterpret_cast<const char*>(out), len);
+            }
+            bytes_size += len;
+            offsets.push_back(bytes_size);
+        }
+        to_read -= r.span_size();
+    }
+    bytes.resize(bytes_size);
+    binary->invalidate_slice_cache();
+
+    if (dst->is_nullable()) {
+        auto& null_data = down_cast<NullableColumn*>(dst)->null_column_data();
+        null_data.resize(null_data.size() + offsets.size() - old_rows, 0);
+    }
+#ifndef NDEBUG
+    dst->check_or_die();
+#endif
+    return Status::OK();
+}
+
+template <LogicalType Type>
+void BinaryFsstPageDecoder<Type>::compress(const Slice& value, std::string* out) const {
+    if (_table.empty()) {
+        out->assign(value.data, value.size);
+        return;
+    }
+    out->resize(FsstSymbolTable::max_compressed_size(value.size));
+    size_t size = _table.compress(value, reinterpret_cast<uint8_t*>(out->data()));
+    out->resize(size);
+}
+
+template <LogicalType Type>
+void BinaryFsstPageDecoder<Type>::match_equal(const Slice& value, uint32_t from, uint32_t to,
+                                              uint8_t* selection) const {
+    DCHECK(_parsed);
+    DCHECK_LE(to, _num_elems);
+    std::string compressed;
+    compress(value, &compressed);
+    const Slice target(compressed);
+    for (uint32_t i = from; i < to; i++) {
+        selection[i - from] = compressed_at(i) == target;
+    }
+}
+
+template <LogicalType Type>
+Status BinaryFsstPageDecoder<Type>::next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                                         uint8_t* selection) {
+    DCHECK(_parsed);
+    Datum value;
+    // the values of CHAR are padded with zeros, they are not comparable with the compressed predicate value
+    if (Type != TYPE_VARCHAR || !predicates.is_equality(&value)) {
+        return Status::NotSupported("next_batch_selection() not supported");
+    }
+    size_t to_read = _cur_idx < _num_elems ? std::min<size_t>(*n, _num_elems - _cur_idx) : 0;
+    match_equal(value.get_slice(), _cur_idx, _cur_idx + to_read, selection);
+    _cur_idx += to_read;
+    *n = to_read;
+    return Status::OK();
+}
+
+template class BinaryFsstPageDecoder<TYPE_CHAR>;
+template class BinaryFsstPageDecoder<TYPE_VARCHAR>;
+
+} // namespace starrocks
@@ -0,0 +1,200 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// FSST compressed page encoding for strings, for the high cardinality strings which are not
+// dictionary encoded, e.g. URLs and log messages. Every string is compressed independently with
+// the symbol table of the page, so a single value can be read without decompressing the page.
+//
+// The page consists of:
+// Header
+//   symbol table size (32-bit fixed)
+//   symbol table, see FsstSymbolTable::serialize()
+// Strings:
+//   compressed strings, or the raw strings if the symbol table is empty
+// Trailer
+//   Offsets:
+//     offsets pointing to the beginning of each compressed string, relative to the first string
+//   decompressed size of all strings (32-bit fixed)
+//   num_elems (32-bit fixed)
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/logging.h"
+#include "storage/range.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+#include "storage/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/fsst.h"
+
+namespace starrocks {
+class Column;
+}
+
+namespace starrocks {
+
+class BinaryFsstPageBuilder final : public PageBuilder {
+public:
+    explicit BinaryFsstPageBuilder(const PageBuilderOptions& options) : _options(options) { reset(); }
+
+    bool is_page_full() override {
+        // data_page_size is 0, do not limit the page size
+        return (_options.data_page_size != 0) & (_size_estimate > _options.data_page_size);
+    }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        const auto* slices = reinterpret_cast<const Slice*>(vals);
+        for (auto i = 0; i < count; i++) {
+            if (!add_slice(slices[i])) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    bool add_slice(const Slice& s) {
+        if (is_page_full()) {
+            return false;
+        }
+        _offsets.push_back(_raw.size());
+        _raw.append(s.data, s.size);
+        _size_estimate += s.size;
+        _size_estimate += sizeof(uint32_t);
+        return true;
+    }
+
+    faststring* finish() override;
+
+    void reset() override {
+        _offsets.clear();
+        _raw.clear();
+        _buffer.clear();
+        _size_estimate = 2 * sizeof(uint32_t);
+        _finished = false;
+    }
+
+    uint32_t count() const override { return _offsets.size(); }
+
+    uint64_t size() const override { return _finished ? _buffer.size() : _size_estimate; }
+
+    Status get_first_value(void* value) const override {
+        DCHECK(_finished);
+        if (_offsets.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = get_value(0);
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        DCHECK(_finished);
+        if (_offsets.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        *reinterpret_cast<Slice*>(value) = get_value(_offsets.size() - 1);
+        return Status::OK();
+    }
+
+    Slice get_value(size_t idx) const {
+        DCHECK_LT(idx, _offsets.size());
+        size_t end = (idx + 1) < _offsets.size() ? _offsets[idx + 1] : _raw.size();
+        return {&_raw[_offsets[idx]], end - _offsets[idx]};
+    }
+
+private:
+    // At most this many bytes of strings are sampled to build the symbol table.
+    static constexpr size_t kSampleBytes = 16 * 1024;
+
+    PageBuilderOptions _options;
+    size_t _size_estimate{0};
+    // the raw strings are kept until finish(), to build the symbol table from all of the page
+    faststring _raw;
+    std::vector<uint32_t> _offsets;
+    faststring _buffer;
+    bool _finished{false};
+};
+
+template <LogicalType Type>
+class BinaryFsstPageDecoder final : public PageDecoder {
+public:
+    explicit BinaryFsstPageDecoder(Slice data) : _data(data) {}
+
+    [[nodiscard]] Status init() override;
+
+    [[nodiscard]] Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK_LE(pos, _num_elems);
+        _cur_idx = pos;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(size_t* count, Column* dst) override;
+
+    [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override;
+
+    // Only equality predicates are evaluated, on the compressed strings.
+    [[nodiscard]] Status next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                              uint8_t* selection) override;
+
+    uint32_t count() const override {
+        DCHECK(_parsed);
+        return _num_elems;
+    }
+
+    uint32_t current_index() const override {
+        DCHECK(_parsed);
+        return _cur_idx;
+    }
+
+    EncodingTypePB encoding_type() const override { return FSST_ENCODING; }
+
+    // Return the compressed form of the value with index |idx|.
+    Slice compressed_at(uint32_t idx) const {
+        DCHECK_LT(idx, _num_elems);
+        uint32_t begin = _offset(idx);
+        uint32_t end = idx + 1 < _num_elems ? _offset(idx + 1) : _strings_size;
+        return {_strings + begin, end - begin};
+    }
+
+    // Compress |value| with the symbol table of this page, to be compared with compressed_at().
+    void compress(const Slice& value, std::string* out) const;
+
+    // Evaluate `value == x` for the values in [from, to) on their compressed forms without
+    // decompressing them, set selection[i - from] to 1 if the value with index i matches.
+    void match_equal(const Slice& value, uint32_t from, uint32_t to, uint8_t* selection) const;
+
+private:
+    uint32_t _offset(uint32_t idx) const { return decode_fixed32_le(_offsets_ptr + idx * sizeof(uint32_t)); }
+
+    Slice _data;
+    bool _parsed{false};
+
+    FsstSymbolTable _table;
+    const uint8_t* _strings = nullptr;
+    uint32_t _strings_size{0};
+    const uint8_t* _offsets_ptr = nullptr;
+    uint32_t _decompressed_size{0};
+    uint32_t _num_elems{0};
+
+    // Index of the currently seeked element in the page.
+    uint32_t _cur_idx{0};
+};
+
+} // namespace starrocks
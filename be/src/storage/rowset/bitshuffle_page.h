@@ -48,6 +48,7 @@
 #include "storage/olap_common.h"
 #include "storage/rowset/bitshuffle_wrapper.h"
 #include "storage/rowset/common.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/page_builder.h"
 #include "storage/rowset/page_decoder.h"
@@ -358,6 +359,9 @@ public:
 
     [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override;
 
+    [[nodiscard]] Status next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                              uint8_t* selection) override;
+
     uint32_t count() const override { return _num_elements; }
 
     uint32_t current_index() const override { return _cur_index; }
@@ -411,4 +415,20 @@ inline Status BitShufflePageDecoder<Type>::next_batch(const SparseRange<>& range
     return Status::OK();
 }
 
+template <LogicalType Type>
+inline Status BitShufflePageDecoder<Type>::next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                                                uint8_t* selection) {
+    DCHECK(_parsed);
+    if constexpr (!is_encoded_value_type<Type>()) {
+        return Status::NotSupported("next_batch_selection() not supported");
+    } else {
+        // the values are evaluated in the decompressed buffer, without being copied into a column
+        size_t to_read = _cur_index < _num_elements ? std::min(*n, _num_elements - _cur_index) : 0;
+        EncodedValueRange<Type>(predicates).evaluate(get_data(_cur_index * SIZE_OF_TYPE), to_read, selection);
+        _cur_index += to_read;
+        *n = to_read;
+        return Status::OK();
+    }
+}
+
 } // namespace starrocks
@@ -49,6 +49,7 @@ namespace starrocks {
 class Column;
 class ColumnAccessPath;
 class ColumnPredicate;
+class EncodedPredicates;
 
 class ColumnReader;
 class RandomAccessFile;
@@ -60,6 +61,8 @@ struct ColumnIteratorOptions {
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    // whether to insert the data pages missed in page cache into it
+    bool fill_page_cache = true;
     LakeIOOptions lake_io_opts{.fill_data_cache = true};
 
     // check whether column pages are all dictionary encoding.
@@ -193,6 +196,16 @@ public:
 
     virtual Status next_dict_codes(const SparseRange<>& range, Column* dst) { return Status::NotSupported(""); }
 
+    // Evaluate |predicates| on the rows in |range| on the encoded pages, without reading them into a column.
+    // selection[i] is set to 0 only if the i-th row in |range| does not satisfy the predicates, the rows in
+    // the pages which can not evaluate the predicates are all selected.
+    // The position of this iterator is undefined after this call, seek_to_ordinal() must be called before
+    // the next read.
+    virtual Status next_batch_selection(const EncodedPredicates& predicates, const SparseRange<>& range,
+                                        uint8_t* selection) {
+        return Status::NotSupported("");
+    }
+
     // given a list of dictionary codes, fill |dst| column with the decoded values.
     // |codes| pointer to the array of dictionary codes.
     // |size| size of dictionary code array.
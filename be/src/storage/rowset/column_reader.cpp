@@ -53,6 +53,7 @@
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/bloom_filter_index_reader.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/encoding_info.h"
 #include "storage/rowset/json_column_iterator.h"
 #include "storage/rowset/map_column_iterator.h"
@@ -106,6 +107,11 @@ ColumnReader::~ColumnReader() {
                                  _bloom_filter_index_meta->SpaceUsedLong());
         _bloom_filter_index_meta.reset(nullptr);
     }
+    if (_vector_index_meta != nullptr) {
+        MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->vector_index_mem_tracker(),
+                                 _vector_index_meta->SpaceUsedLong());
+        _vector_index_meta.reset(nullptr);
+    }
     MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->column_metadata_mem_tracker(), sizeof(ColumnReader));
 }
 
@@ -176,6 +182,8 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
                 _meta_mem_usage.fetch_add(_bloom_filter_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
                 _bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
                 break;
+            case VECTOR_INDEX:
+                return Status::Corruption(fmt::format("Bad file {}: vector index of scalar column", file_name()));
             case UNKNOWN_INDEX_TYPE:
                 return Status::Corruption(fmt::format("Bad file {}: unknown index type", file_name()));
             }
@@ -196,6 +204,16 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
         }
         return Status::OK();
     } else if (_column_type == LogicalType::TYPE_ARRAY) {
+        for (int i = 0; i < meta->indexes_size(); i++) {
+            auto* index_meta = meta->mutable_indexes(i);
+            if (index_meta->type() == VECTOR_INDEX) {
+                _vector_index_meta.reset(index_meta->release_vector_index());
+                MEM_TRACKER_SAFE_CONSUME(GlobalEnv::GetInstance()->vector_index_mem_tracker(),
+                                         _vector_index_meta->SpaceUsedLong());
+                _meta_mem_usage.fetch_add(_vector_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
+                _vector_index = std::make_unique<VectorIndexReader>();
+            }
+        }
         _sub_readers = std::make_unique<SubReaderList>();
         if (meta->is_nullable()) {
             if (meta->children_columns_size() != 3) {
@@ -312,6 +330,7 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     opts.stats = iter_opts.stats;
     opts.verify_checksum = true;
     opts.use_page_cache = iter_opts.use_page_cache;
+    opts.fill_page_cache = iter_opts.fill_page_cache;
     opts.encoding_type = _encoding_info->encoding();
     opts.kept_in_memory = false;
 
@@ -362,16 +381,30 @@ Status ColumnReader::bloom_filter(const std::vector<const ColumnPredicate*>& pre
         }
     }
 
+    // the reader options depend on the index properties of the tablet schema only, parse them once
+    const NgramBloomFilterReaderOptions ngram_options = _get_reader_options_for_ngram();
+    // the bloom filters of a column with ngram bloom filter index contain the n-grams of the values
+    // instead of the values, so they can only be probed by the predicates supporting ngram bloom filter
+    const bool is_ngram_index = ngram_options.index_gram_num > 0;
     for (const auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        // |predicates| are conjunctive, so the page can be skipped as soon as one of them
+        // is not satisfied, e.g. `c LIKE '%abc%' AND c LIKE '%xyz%'`.
+        bool may_match = true;
         for (const auto* pred : predicates) {
-            if ((pred->support_bloom_filter() && pred->bloom_filter(bf.get())) ||
-                (pred->support_ngram_bloom_filter() &&
-                 pred->ngram_bloom_filter(bf.get(), _get_reader_options_for_ngram()))) {
-                bf_row_ranges.add(
-                        Range<>(_ordinal_index->get_first_ordinal(pid), _ordinal_index->get_last_ordinal(pid) + 1));
+            if (is_ngram_index) {
+                may_match = !pred->support_ngram_bloom_filter() || pred->ngram_bloom_filter(bf.get(), ngram_options);
+            } else {
+                may_match = !pred->support_bloom_filter() || pred->bloom_filter(bf.get());
             }
+            if (!may_match) {
+                break;
+            }
+        }
+        if (may_match) {
+            bf_row_ranges.add(
+                    Range<>(_ordinal_index->get_first_ordinal(pid), _ordinal_index->get_last_ordinal(pid) + 1));
         }
     }
     *row_ranges = row_ranges->intersection(bf_row_ranges);
@@ -394,6 +427,14 @@ Status ColumnReader::load_ordinal_index(const IndexReadOptions& opts) {
     return Status::OK();
 }
 
+StatusOr<const std::vector<ZoneMapPB>*> ColumnReader::load_page_zone_maps(const IndexReadOptions& opts) {
+    if (_zonemap_index == nullptr) {
+        return nullptr;
+    }
+    RETURN_IF_ERROR(_load_zonemap_index(opts));
+    return &_zonemap_index->page_zone_maps();
+}
+
 Status ColumnReader::_load_zonemap_index(const IndexReadOptions& opts) {
     if (_zonemap_index == nullptr || _zonemap_index->loaded()) return Status::OK();
     SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
@@ -426,6 +467,22 @@ Status ColumnReader::_load_bitmap_index(const IndexReadOptions& opts) {
     return Status::OK();
 }
 
+Status ColumnReader::load_vector_index(const IndexReadOptions& opts) {
+    if (_vector_index == nullptr || _vector_index->loaded()) return Status::OK();
+    SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+    auto meta = _vector_index_meta.get();
+    ASSIGN_OR_RETURN(auto first_load, _vector_index->load(opts, *meta));
+    if (UNLIKELY(first_load)) {
+        MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->vector_index_mem_tracker(),
+                                 _vector_index_meta->SpaceUsedLong());
+        _meta_mem_usage.fetch_sub(_vector_index_meta->SpaceUsedLong(), std::memory_order_relaxed);
+        _meta_mem_usage.fetch_add(_vector_index->mem_usage(), std::memory_order_relaxed);
+        _vector_index_meta.reset();
+        _segment->update_cache_size();
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::_load_bloom_filter_index(const IndexReadOptions& opts) {
     if (_bloom_filter_index == nullptr || _bloom_filter_index->loaded()) return Status::OK();
     SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
@@ -511,6 +568,17 @@ Status ColumnReader::zone_map_filter(const std::vector<const ColumnPredicate*>&
     std::vector<uint32_t> page_indexes;
     RETURN_IF_ERROR(_zone_map_filter(predicates, del_predicate, del_partial_filtered_pages, &page_indexes));
     RETURN_IF_ERROR(_calculate_row_ranges(page_indexes, row_ranges));
+    if (_zonemap_index->has_row_block_zone_maps() && !row_ranges->empty()) {
+        EncodedPredicates block_predicates;
+        for (const ColumnPredicate* pred : predicates) {
+            if (EncodedPredicates::is_supported(pred, _column_type)) {
+                block_predicates.add(pred);
+            }
+        }
+        if (!block_predicates.empty()) {
+            _zonemap_index->filter_row_blocks(_column_type, block_predicates, row_ranges);
+        }
+    }
     return Status::OK();
 }
 
@@ -55,6 +55,7 @@
 #include "storage/rowset/ordinal_page_index.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/segment.h"
+#include "storage/rowset/vector_index.h"
 #include "storage/rowset/zone_map_index.h"
 #include "util/once.h"
 
@@ -123,9 +124,12 @@ public:
 
     const EncodingInfo* encoding_info() const { return _encoding_info; }
 
+    const BlockCompressionCodec* compress_codec() const { return _compress_codec; }
+
     bool has_zone_map() const { return _zonemap_index != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index != nullptr; }
     bool has_bloom_filter_index() const { return _bloom_filter_index != nullptr; }
+    bool has_vector_index() const { return _vector_index != nullptr; }
 
     ZoneMapPB* segment_zone_map() const { return _segment_zone_map.get(); }
 
@@ -155,6 +159,14 @@ public:
 
     Status load_ordinal_index(const IndexReadOptions& opts);
 
+    // Loads the zone map index and returns the zone maps of the data pages, or nullptr if there is no zone map.
+    StatusOr<const std::vector<ZoneMapPB>*> load_page_zone_maps(const IndexReadOptions& opts);
+
+    Status load_vector_index(const IndexReadOptions& opts);
+
+    // REQUIRES: the vector index has been successfully loaded by `load_vector_index()`.
+    const VectorIndexReader* vector_index() const { return _vector_index.get(); }
+
     Status new_inverted_index_iterator(const std::shared_ptr<TabletIndex>& index_meta, InvertedIndexIterator** iterator,
                                        const SegmentReadOptions& opts);
 
@@ -215,11 +227,13 @@ private:
     std::unique_ptr<OrdinalIndexPB> _ordinal_index_meta;
     std::unique_ptr<BitmapIndexPB> _bitmap_index_meta;
     std::unique_ptr<BloomFilterIndexPB> _bloom_filter_index_meta;
+    std::unique_ptr<VectorIndexPB> _vector_index_meta;
 
     std::unique_ptr<ZoneMapIndexReader> _zonemap_index;
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<VectorIndexReader> _vector_index;
     std::unique_ptr<InvertedReader> _inverted_index;
 
     std::unique_ptr<ZoneMapPB> _segment_zone_map;
@@ -678,6 +678,49 @@ Status ScalarColumnWriter::finish_current_page() {
     return Status::OK();
 }
 
+bool ScalarColumnWriter::can_append_encoded_page(EncodingTypePB encoding, const BlockCompressionCodec* codec) const {
+    // the dictionary page, the bitmap index and the bloom filter index are built from the values
+    if (_encoding_info == nullptr || _encoding_info->encoding() != encoding || encoding == DICT_ENCODING ||
+        _compress_codec != codec) {
+        return false;
+    }
+    if (_bitmap_index_builder != nullptr || _bloom_filter_index_builder != nullptr ||
+        _inverted_index_builder != nullptr) {
+        return false;
+    }
+    return _zone_map_index_builder == nullptr || _zone_map_index_builder->support_page_zone_map();
+}
+
+Status ScalarColumnWriter::append_encoded_page(const Slice& body, const PageFooterPB& footer,
+                                               const ZoneMapPB* zone_map) {
+    DCHECK(_encoding_info != nullptr);
+    if (footer.type() != DATA_PAGE || !footer.has_data_page_footer()) {
+        return Status::InvalidArgument("not a data page");
+    }
+    if (_next_rowid > _first_rowid) {
+        RETURN_IF_ERROR(finish_current_page());
+    }
+    if (_zone_map_index_builder != nullptr) {
+        if (zone_map == nullptr) {
+            return Status::InvalidArgument("zone map of the encoded page is missing");
+        }
+        RETURN_IF_ERROR(_zone_map_index_builder->add_page_zone_map(*zone_map));
+    }
+
+    std::unique_ptr<Page> page(new Page());
+    page->footer = footer;
+    page->footer.mutable_data_page_footer()->set_first_ordinal(_next_rowid);
+    faststring data;
+    data.append(body.data, body.size);
+    page->data.emplace_back(data.build());
+    _push_back_page(page.release());
+
+    _next_rowid += footer.data_page_footer().num_values();
+    _first_rowid = _next_rowid;
+    _total_mem_footprint += footer.uncompressed_size();
+    return Status::OK();
+}
+
 Status ScalarColumnWriter::append(const Column& column) {
     _total_mem_footprint += column.byte_size();
 
@@ -875,7 +918,7 @@ inline EncodingTypePB StringColumnWriter::speculate_string_encoding(const Binary
             size_t hash = SliceHash()(bin_col.get_slice(i));
             hash_set.insert(hash);
             if (hash_set.size() > max_card) {
-                return PLAIN_ENCODING;
+                return config::enable_fsst_encoding ? FSST_ENCODING : PLAIN_ENCODING;
             }
         }
     }
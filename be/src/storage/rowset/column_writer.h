@@ -73,6 +73,7 @@ struct ColumnWriterOptions {
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
     bool need_inverted_index = false;
+    bool need_vector_index = false;
     std::unordered_map<IndexType, std::string> standalone_index_file_paths;
     std::unordered_map<IndexType, TabletIndex> tablet_index;
 
@@ -85,6 +86,8 @@ struct ColumnWriterOptions {
     GlobalDictMap* global_dict = nullptr;
 
     bool need_flat = false;
+    // the tablet of the column, to flatten the JSON sub-fields accessed by the queries on it, 0 if unknown
+    int64_t tablet_id = 0;
 
     std::string field_name;
 };
@@ -132,8 +135,23 @@ public:
 
     virtual Status write_inverted_index() { return Status::OK(); }
 
+    virtual Status write_vector_index() { return Status::OK(); }
+
     virtual ordinal_t get_next_rowid() const = 0;
 
+    // Whether a data page encoded by |encoding| and compressed by |codec| can be appended by append_encoded_page(),
+    // i.e. the writer doesn't need the values of the page to build its dictionary and indexes.
+    virtual bool can_append_encoded_page(EncodingTypePB encoding, const BlockCompressionCodec* codec) const {
+        return false;
+    }
+
+    // Appends a data page of the same column type read from another segment without decoding it, see
+    // PageIO::read_encoded_page(). |zone_map| is the zone map of the page, required if the zone map is written.
+    // REQUIRES: can_append_encoded_page() for the encoding and the compression of the page.
+    virtual Status append_encoded_page(const Slice& body, const PageFooterPB& footer, const ZoneMapPB* zone_map) {
+        return Status::NotSupported("append_encoded_page");
+    }
+
     // only invalid in the case of global_dict is not nullptr
     // column is not encoding by dict or append new words that
     // not in global_dict, it will return false
@@ -175,6 +193,10 @@ public:
 
     Status finish_current_page() override;
 
+    bool can_append_encoded_page(EncodingTypePB encoding, const BlockCompressionCodec* codec) const override;
+
+    Status append_encoded_page(const Slice& body, const PageFooterPB& footer, const ZoneMapPB* zone_map) override;
+
     uint64_t estimate_buffer_size() override;
 
     // finish append data
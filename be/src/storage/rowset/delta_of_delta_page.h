@@ -0,0 +1,251 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "column/column.h"
+#include "storage/rowset/encoded_predicate.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "storage/type_traits.h"
+#include "util/coding.h"
+#include "util/frame_of_reference_coding.h"
+
+namespace starrocks {
+
+// Encode page use delta-of-delta coding, for the 64-bit timestamps which increase with nearly fixed
+// intervals, e.g. the sampling time of metrics. The differences between adjacent deltas are mostly 0
+// or small, they are stored with frame-of-reference coding.
+//
+// The layout of page:
+// | count(4) | first value(8) | first delta(8) | for_size(4) | delta of deltas(for_size) |
+template <LogicalType Type>
+class DeltaOfDeltaPageBuilder final : public PageBuilder {
+public:
+    explicit DeltaOfDeltaPageBuilder(const PageBuilderOptions& options) : _options(options) {}
+
+    ~DeltaOfDeltaPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() * sizeof(int64_t) >= _options.data_page_size; }
+
+    uint32_t add(const uint8_t* vals, uint32_t count) override {
+        DCHECK(!_finished);
+        size_t old_size = _values.size();
+        _values.resize(old_size + count);
+        memcpy(_values.data() + old_size, vals, count * sizeof(int64_t));
+        return count;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _encode();
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _finished = false;
+        _buf.clear();
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * sizeof(int64_t); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    static_assert(sizeof(CppType) == sizeof(int64_t), "delta-of-delta only encodes 64-bit values");
+
+    void _encode() {
+        _buf.clear();
+        const uint32_t count = _values.size();
+        // computed in unsigned integers, overflow wraps around and is restored by the decoder
+        const auto* v = reinterpret_cast<const uint64_t*>(_values.data());
+        uint64_t first_value = count > 0 ? v[0] : 0;
+        uint64_t first_delta = count > 1 ? v[1] - v[0] : 0;
+        faststring for_buf;
+        if (count > 2) {
+            std::vector<int64_t> dods(count - 2);
+            for (uint32_t i = 2; i < count; i++) {
+                dods[i - 2] = static_cast<int64_t>((v[i] - v[i - 1]) - (v[i - 1] - v[i - 2]));
+            }
+            ForEncoder<int64_t> encoder(&for_buf);
+            encoder.put_batch(dods.data(), dods.size());
+            encoder.flush();
+        }
+        put_fixed32_le(&_buf, count);
+        put_fixed64_le(&_buf, first_value);
+        put_fixed64_le(&_buf, first_delta);
+        put_fixed32_le(&_buf, for_buf.size());
+        _buf.append(for_buf.data(), for_buf.size());
+    }
+
+    PageBuilderOptions _options;
+    bool _finished{false};
+    std::vector<int64_t> _values;
+    faststring _buf;
+};
+
+// The whole page is decoded in init(), like the bitshuffle pages which are decompressed before being
+// parsed, so seeking is free and reading is a copy.
+template <LogicalType Type>
+class DeltaOfDeltaPageDecoder final : public PageDecoder {
+public:
+    DeltaOfDeltaPageDecoder(Slice data) : _data(data) {}
+
+    ~DeltaOfDeltaPageDecoder() override = default;
+
+    // count(4) + first value(8) + first delta(8) + for_size(4)
+    static constexpr size_t kHeaderSize = 24;
+
+    [[nodiscard]] Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < kHeaderSize) {
+            return Status::Corruption("The delta-of-delta page is too small");
+        }
+        const auto* p = reinterpret_cast<const uint8_t*>(_data.data);
+        const uint32_t count = decode_fixed32_le(p);
+        const uint64_t first_value = decode_fixed64_le(p + 4);
+        const uint64_t first_delta = decode_fixed64_le(p + 12);
+        const uint32_t for_size = decode_fixed32_le(p + 20);
+        if (_data.size != kHeaderSize + for_size) {
+            return Status::Corruption("The delta-of-delta page size does not match");
+        }
+        _values.resize(count);
+        auto* out = reinterpret_cast<uint64_t*>(_values.data());
+        if (count > 0) {
+            out[0] = first_value;
+        }
+        if (count > 1) {
+            out[1] = first_value + first_delta;
+        }
+        if (count > 2) {
+            // decode the delta of deltas into the output in place, then restore deltas and values
+            // by two prefix sums
+            ForDecoder<int64_t> decoder(p + kHeaderSize, for_size);
+            if (!decoder.init() || decoder.count() != count - 2 ||
+                !decoder.get_batch(reinterpret_cast<int64_t*>(out + 2), count - 2)) {
+                return Status::Corruption("The delta-of-delta page metadata maybe broken");
+            }
+            uint64_t delta = first_delta;
+            for (uint32_t i = 2; i < count; i++) {
+                delta += out[i];
+                out[i] = out[i - 1] + delta;
+            }
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status seek_to_position_in_page(uint32_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _values.size()) << "Tried to seek to " << pos << " which is > number of elements ("
+                                       << _values.size() << ") in the block!";
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    // The values must be sorted in page, which is true for key columns.
+    [[nodiscard]] Status seek_at_or_after_value(const void* value, bool* exact_match) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        int64_t target;
+        memcpy(&target, value, sizeof(target));
+        auto it = std::lower_bound(_values.begin(), _values.end(), target);
+        if (it == _values.end()) {
+            return Status::NotFound("not found");
+        }
+        _cur_index = it - _values.begin();
+        *exact_match = *it == target;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(size_t* n, Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        size_t to_read = std::min(*n, static_cast<size_t>(_values.size() - _cur_index));
+        size_t appended = dst->append_numbers(_values.data() + _cur_index, to_read * sizeof(CppType));
+        DCHECK_EQ(to_read, appended);
+        _cur_index += to_read;
+        *n = to_read;
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch(const SparseRange<>& range, Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        SparseRangeIterator<> iter = range.new_iterator();
+        size_t to_read = std::min(static_cast<size_t>(range.span_size()),
+                                  static_cast<size_t>(_values.size() - _cur_index));
+        while (to_read > 0) {
+            _cur_index = iter.begin();
+            Range<> r = iter.next(to_read);
+            size_t appended = dst->append_numbers(_values.data() + _cur_index, r.span_size() * sizeof(CppType));
+            DCHECK_EQ(r.span_size(), appended);
+            _cur_index += r.span_size();
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    [[nodiscard]] Status next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                              uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if constexpr (!is_encoded_value_type<Type>()) {
+            return Status::NotSupported("next_batch_selection() not supported");
+        } else {
+            size_t to_read = std::min(*n, static_cast<size_t>(_values.size() - _cur_index));
+            EncodedValueRange<Type>(predicates).evaluate(_values.data() + _cur_index, to_read, selection);
+            _cur_index += to_read;
+            *n = to_read;
+            return Status::OK();
+        }
+    }
+
+    uint32_t count() const override { return _values.size(); }
+
+    uint32_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return DELTA_OF_DELTA_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    static_assert(sizeof(CppType) == sizeof(int64_t), "delta-of-delta only decodes 64-bit values");
+
+    bool _parsed{false};
+    Slice _data;
+    uint32_t _cur_index{0};
+    std::vector<int64_t> _values;
+};
+
+} // namespace starrocks
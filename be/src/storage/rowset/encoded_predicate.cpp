@@ -0,0 +1,108 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/encoded_predicate.h"
+
+#include "storage/column_predicate.h"
+
+namespace starrocks {
+
+bool EncodedPredicates::is_supported(const ColumnPredicate* pred, LogicalType column_type) {
+    switch (pred->type()) {
+    case PredicateType::kEQ:
+    case PredicateType::kGT:
+    case PredicateType::kGE:
+    case PredicateType::kLT:
+    case PredicateType::kLE:
+        break;
+    default:
+        return false;
+    }
+    if (pred->type_info()->type() != column_type) {
+        return false;
+    }
+    switch (column_type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+        return true;
+    case TYPE_VARCHAR:
+        // only equality is evaluated on the compressed strings
+        return pred->type() == PredicateType::kEQ;
+    default:
+        return false;
+    }
+}
+
+bool EncodedPredicates::is_supported_encoding(EncodingTypePB encoding) {
+    switch (encoding) {
+    case BIT_SHUFFLE:
+    case FOR_ENCODING:
+    case ALP_ENCODING:
+    case DELTA_OF_DELTA_ENCODING:
+    case FSST_ENCODING:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void EncodedPredicates::add(const ColumnPredicate* pred) {
+    Datum value = pred->value();
+    switch (pred->type()) {
+    case PredicateType::kEQ:
+        _bounds.push_back({value, true, true});
+        _bounds.push_back({value, false, true});
+        break;
+    case PredicateType::kGT:
+        _bounds.push_back({value, true, false});
+        break;
+    case PredicateType::kGE:
+        _bounds.push_back({value, true, true});
+        break;
+    case PredicateType::kLT:
+        _bounds.push_back({value, false, false});
+        break;
+    case PredicateType::kLE:
+        _bounds.push_back({value, false, true});
+        break;
+    default:
+        DCHECK(false) << "unsupported predicate " << pred->debug_string();
+    }
+}
+
+bool EncodedPredicates::is_equality(Datum* value) const {
+    if (_bounds.empty()) {
+        return false;
+    }
+    const DatumKey key = _bounds[0].value.convert2DatumKey();
+    for (const auto& bound : _bounds) {
+        if (!bound.inclusive || !bound.value.equal_datum_key(key)) {
+            return false;
+        }
+    }
+    *value = _bounds[0].value;
+    return true;
+}
+
+} // namespace starrocks
@@ -0,0 +1,167 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "column/datum.h"
+#include "gen_cpp/segment.pb.h"
+#include "storage/type_traits.h"
+#include "types/logical_type.h"
+
+namespace starrocks {
+
+class ColumnPredicate;
+
+// The range and equality predicates of a column, which are evaluated by the page decoders on the
+// encoded values directly, e.g. on the frames of frame-of-reference pages, so the values which do
+// not satisfy them are not decoded into a column at all. See PageDecoder::next_batch_selection().
+class EncodedPredicates {
+public:
+    // A predicate is kept as the lower or upper bound of the values, an equality predicate is
+    // kept as both.
+    struct Bound {
+        Datum value;
+        bool is_lower;
+        bool inclusive;
+    };
+
+    // Whether |pred| is a range or equality predicate which can be evaluated on the encoded values
+    // of a column of |column_type|.
+    static bool is_supported(const ColumnPredicate* pred, LogicalType column_type);
+
+    // Whether the page decoders of |encoding| may evaluate the predicates. The dictionary, plain, prefix and
+    // RLE pages never do: the RLE pages only store BOOLEAN columns, on which no predicate is supported, and
+    // the others have to decode the values to evaluate them anyway.
+    static bool is_supported_encoding(EncodingTypePB encoding);
+
+    // |pred| must be supported.
+    void add(const ColumnPredicate* pred);
+
+    bool empty() const { return _bounds.empty(); }
+
+    const std::vector<Bound>& bounds() const { return _bounds; }
+
+    // Whether all of the predicates are equality predicates with the same value, which is returned in |value|.
+    bool is_equality(Datum* value) const;
+
+private:
+    std::vector<Bound> _bounds;
+};
+
+// Whether the values of |Type| can be evaluated by EncodedValueRange.
+template <LogicalType Type>
+constexpr bool is_encoded_value_type() {
+    return Type == TYPE_TINYINT || Type == TYPE_SMALLINT || Type == TYPE_INT || Type == TYPE_BIGINT ||
+           Type == TYPE_LARGEINT || Type == TYPE_FLOAT || Type == TYPE_DOUBLE || Type == TYPE_DATE ||
+           Type == TYPE_DATETIME || Type == TYPE_DECIMAL32 || Type == TYPE_DECIMAL64 || Type == TYPE_DECIMAL128;
+}
+
+// EncodedPredicates of a column of |Type| folded into one interval of the storage values.
+template <LogicalType Type>
+class EncodedValueRange {
+public:
+    using CppType = typename CppTypeTraits<Type>::CppType;
+
+    explicit EncodedValueRange(const EncodedPredicates& predicates) {
+        for (const auto& bound : predicates.bounds()) {
+            CppType value = _storage_value(bound.value);
+            if (bound.is_lower) {
+                _add_lower(value, bound.inclusive);
+            } else {
+                _add_upper(value, bound.inclusive);
+            }
+        }
+    }
+
+    bool contains(const CppType& v) const {
+        bool ge_lower = !_has_lower || (_lower_inclusive ? v >= _lower : v > _lower);
+        bool le_upper = !_has_upper || (_upper_inclusive ? v <= _upper : v < _upper);
+        return ge_lower & le_upper;
+    }
+
+    // Whether no value in [min, max] is contained, |max| is nullptr if unknown.
+    bool excludes(const CppType& min, const CppType* max) const {
+        if (_has_upper && (_upper_inclusive ? min > _upper : min >= _upper)) {
+            return true;
+        }
+        return max != nullptr && _has_lower && (_lower_inclusive ? *max < _lower : *max <= _lower);
+    }
+
+    // Whether all values in [min, max] are contained.
+    bool covers(const CppType& min, const CppType& max) const { return contains(min) && contains(max); }
+
+    // Set selection[i] to whether values[i] is contained, |values| may be unaligned.
+    void evaluate(const void* values, size_t n, uint8_t* selection) const {
+        const auto* p = reinterpret_cast<const uint8_t*>(values);
+        for (size_t i = 0; i < n; i++) {
+            CppType v;
+            memcpy(&v, p + i * sizeof(CppType), sizeof(CppType));
+            selection[i] = contains(v);
+        }
+    }
+
+    // Set selection[i] to whether any value in [mins[i], maxs[i]] may be contained, |mins| and |maxs|
+    // may be unaligned.
+    void evaluate_zone_maps(const void* mins, const void* maxs, size_t n, uint8_t* selection) const {
+        const auto* pmin = reinterpret_cast<const uint8_t*>(mins);
+        const auto* pmax = reinterpret_cast<const uint8_t*>(maxs);
+        for (size_t i = 0; i < n; i++) {
+            CppType min;
+            CppType max;
+            memcpy(&min, pmin + i * sizeof(CppType), sizeof(CppType));
+            memcpy(&max, pmax + i * sizeof(CppType), sizeof(CppType));
+            selection[i] = !excludes(min, &max);
+        }
+    }
+
+private:
+    static CppType _storage_value(const Datum& datum) {
+        if constexpr (Type == TYPE_DATE) {
+            return datum.get_date().julian();
+        } else if constexpr (Type == TYPE_DATETIME) {
+            return datum.get_timestamp().timestamp();
+        } else {
+            return datum.get<CppType>();
+        }
+    }
+
+    void _add_lower(const CppType& value, bool inclusive) {
+        if (!_has_lower || value > _lower || (value == _lower && !inclusive)) {
+            _has_lower = true;
+            _lower = value;
+            _lower_inclusive = inclusive;
+        }
+    }
+
+    void _add_upper(const CppType& value, bool inclusive) {
+        if (!_has_upper || value < _upper || (value == _upper && !inclusive)) {
+            _has_upper = true;
+            _upper = value;
+            _upper_inclusive = inclusive;
+        }
+    }
+
+    bool _has_lower = false;
+    bool _lower_inclusive = true;
+    CppType _lower{};
+    bool _has_upper = false;
+    bool _upper_inclusive = true;
+    CppType _upper{};
+};
+
+} // namespace starrocks
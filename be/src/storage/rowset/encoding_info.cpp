@@ -38,10 +38,13 @@
 
 #include "gutil/strings/substitute.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/alp_page.h"
 #include "storage/rowset/binary_dict_page.h"
+#include "storage/rowset/binary_fsst_page.h"
 #include "storage/rowset/binary_plain_page.h"
 #include "storage/rowset/binary_prefix_page.h"
 #include "storage/rowset/bitshuffle_page.h"
+#include "storage/rowset/delta_of_delta_page.h"
 #include "storage/rowset/dict_page.h"
 #include "storage/rowset/frame_of_reference_page.h"
 #include "storage/rowset/plain_page.h"
@@ -168,6 +171,44 @@ struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     }
 };
 
+template <LogicalType type>
+struct TypeEncodingTraits<type, FSST_ENCODING, Slice> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new BinaryFsstPageBuilder(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new BinaryFsstPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, ALP_ENCODING, CppType,
+                          typename std::enable_if<std::is_floating_point<CppType>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new AlpPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new AlpPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
+template <LogicalType type, typename CppType>
+struct TypeEncodingTraits<type, DELTA_OF_DELTA_ENCODING, CppType,
+                          typename std::enable_if<sizeof(CppType) == sizeof(int64_t)>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaOfDeltaPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, PageDecoder** decoder) {
+        *decoder = new DeltaOfDeltaPageDecoder<type>(data);
+        return Status::OK();
+    }
+};
+
 template <LogicalType field_type, EncodingTypePB encoding_type>
 struct EncodingTraits : TypeEncodingTraits<field_type, encoding_type, typename CppTypeTraits<field_type>::CppType> {
     static const LogicalType type = field_type;
@@ -184,12 +225,23 @@ public:
     // 1. If the user has enabled dictionary encoding for number types, the field supports dictionary encoding,
     //    and it is not for optimizing value seek, return DICT_ENCODING.
     // 2. If optimization for value seek is required, retrieve the encoding method from _value_seek_encoding_map.
-    // 3. In the last scenario, directly retrieve it from _default_encoding_type_map.
+    // 3. If ALP or delta-of-delta encoding is enabled for the field type, and it is not for optimizing
+    //    value seek, return ALP_ENCODING or DELTA_OF_DELTA_ENCODING.
+    // 4. In the last scenario, directly retrieve it from _default_encoding_type_map.
     EncodingTypePB get_default_encoding(LogicalType type, bool optimize_value_seek) const {
         if (enable_non_string_column_dict_encoding() && numeric_types_support_dict_encoding(delegate_type(type)) &&
             !optimize_value_seek) {
             return DICT_ENCODING;
         }
+        if (!optimize_value_seek) {
+            LogicalType dtype = delegate_type(type);
+            if (config::enable_alp_encoding && (dtype == TYPE_FLOAT || dtype == TYPE_DOUBLE)) {
+                return ALP_ENCODING;
+            }
+            if (config::enable_delta_of_delta_encoding && dtype == TYPE_DATETIME) {
+                return DELTA_OF_DELTA_ENCODING;
+            }
+        }
         auto& encoding_map = optimize_value_seek ? _value_seek_encoding_map : _default_encoding_type_map;
         auto it = encoding_map.find(delegate_type(type));
         if (it != encoding_map.end()) {
@@ -309,6 +361,15 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<TYPE_DATE, DICT_ENCODING>();
     _add_map<TYPE_DATETIME, DICT_ENCODING>();
     _add_map<TYPE_DECIMALV2, DICT_ENCODING>();
+
+    // Segments written with these encodings can not be read by the older versions, so they are
+    // only used as default encoding when enabled by config.
+    _add_map<TYPE_FLOAT, ALP_ENCODING>();
+    _add_map<TYPE_DOUBLE, ALP_ENCODING>();
+    _add_map<TYPE_BIGINT, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_DATETIME, DELTA_OF_DELTA_ENCODING>();
+    _add_map<TYPE_CHAR, FSST_ENCODING>();
+    _add_map<TYPE_VARCHAR, FSST_ENCODING>();
 }
 
 EncodingInfoResolver::~EncodingInfoResolver() {
@@ -35,6 +35,7 @@
 #pragma once
 
 #include "column/column.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "storage/rowset/page_builder.h" // for PageBuilder
 #include "storage/rowset/page_decoder.h" // for PageDecoder
@@ -140,7 +141,8 @@ public:
             return Status::OK();
         }
 
-        int32_t skip_num = pos - _cur_index;
+        // _decoder may be behind _cur_index after next_batch_selection()
+        int32_t skip_num = pos - _decoder.current_index();
         _decoder.skip(skip_num);
         _cur_index = pos;
         return Status::OK();
@@ -204,6 +206,48 @@ public:
         return Status::OK();
     }
 
+    // The frames whose bounds in the frame header do not overlap the predicates are skipped, and the
+    // frames whose bounds are covered by the predicates are selected, without decoding.
+    [[nodiscard]] Status next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                              uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if constexpr (!is_encoded_value_type<Type>()) {
+            return Status::NotSupported("next_batch_selection() not supported");
+        } else {
+            size_t to_read = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+            *n = to_read;
+            if (to_read == 0) {
+                return Status::OK();
+            }
+            EncodedValueRange<Type> value_range(predicates);
+            const uint32_t max_frame_size = _decoder.max_frame_size();
+            std::vector<CppType> buffer;
+            while (to_read > 0) {
+                uint32_t frame = _cur_index / max_frame_size;
+                uint32_t frame_end = frame * max_frame_size + _decoder.frame_size(frame);
+                size_t len = std::min(to_read, static_cast<size_t>(frame_end - _cur_index));
+                CppType min;
+                CppType max;
+                bool has_max = _decoder.frame_bounds(frame, &min, &max);
+                if (value_range.excludes(min, has_max ? &max : nullptr)) {
+                    memset(selection, 0, len);
+                } else if (has_max && value_range.covers(min, max)) {
+                    memset(selection, 1, len);
+                } else {
+                    _decoder.skip(static_cast<int32_t>(_cur_index) - static_cast<int32_t>(_decoder.current_index()));
+                    buffer.resize(len);
+                    bool res = _decoder.get_batch(buffer.data(), len);
+                    DCHECK(res);
+                    value_range.evaluate(buffer.data(), len, selection);
+                }
+                _cur_index += len;
+                selection += len;
+                to_read -= len;
+            }
+            return Status::OK();
+        }
+    }
+
     uint32_t count() const override { return _num_elements; }
 
     uint32_t current_index() const override { return _cur_index; }
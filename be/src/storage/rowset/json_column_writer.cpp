@@ -21,6 +21,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "column/column.h"
@@ -33,6 +34,7 @@
 #include "common/status.h"
 #include "gen_cpp/segment.pb.h"
 #include "gutil/casts.h"
+#include "storage/json_path_access_stats.h"
 #include "storage/rowset/column_writer.h"
 #include "types/logical_type.h"
 #include "util/json_flattener.h"
@@ -81,6 +83,8 @@ private:
     std::vector<std::unique_ptr<ColumnWriter>> _flat_writers;
     std::vector<std::string> _flat_paths;
     std::vector<ColumnPtr> _flat_columns;
+
+    int64_t _tablet_id;
 };
 
 FlatJsonColumnWriter::FlatJsonColumnWriter(const ColumnWriterOptions& opts, const TypeInfoPtr& type_info,
@@ -88,7 +92,8 @@ FlatJsonColumnWriter::FlatJsonColumnWriter(const ColumnWriterOptions& opts, cons
         : ColumnWriter(std::move(type_info), opts.meta->length(), opts.meta->is_nullable()),
           _json_column_writer(std::move(json_writer)),
           _json_meta(opts.meta),
-          _wfile(wfile) {}
+          _wfile(wfile),
+          _tablet_id(opts.tablet_id) {}
 
 Status FlatJsonColumnWriter::append(const Column& column) {
     RETURN_IF_ERROR(_json_column_writer->append(column));
@@ -157,12 +162,46 @@ void FlatJsonColumnWriter::_flat_column(std::vector<ColumnPtr>& json_datas) {
         }
     }
 
-    if (hit_maps.size() <= config::json_flat_internal_column_min_limit) {
+    // the fields accessed by the queries on the tablet, the most accessed first
+    std::vector<std::string> accessed_names;
+    if (config::enable_json_flat_access_feedback && _tablet_id > 0) {
+        for (const auto& path : JsonPathAccessStats::instance()->hot_paths(_tablet_id, _json_meta->unique_id())) {
+            // remove escape
+            bool escaped = path.size() >= 2 && path.front() == '"' && path.back() == '"';
+            std::string name = escaped ? path.substr(1, path.size() - 2) : path;
+            auto iter = hit_maps.find(name);
+            if (iter != hit_maps.end() && iter->second >= total_rows * config::json_flat_access_sparsity_factor) {
+                accessed_names.emplace_back(std::move(name));
+            }
+        }
+    }
+
+    // the accessed fields are flattened even if there are few fields
+    if (accessed_names.empty() && hit_maps.size() <= config::json_flat_internal_column_min_limit) {
         VLOG(8) << "flat json, internal column too less: " << hit_maps.size()
                 << ", at least: " << config::json_flat_internal_column_min_limit;
         return;
     }
 
+    std::unordered_set<std::string> flat_names;
+    auto add_flat_path = [&](const std::string& name) {
+        flat_names.insert(name);
+        if (name.find('.') != std::string::npos) {
+            // add escape
+            _flat_paths.emplace_back(fmt::format("\"{}\"", name));
+        } else {
+            _flat_paths.emplace_back(name);
+        }
+    };
+
+    for (const auto& name : accessed_names) {
+        if (_flat_paths.size() >= config::json_flat_column_max) {
+            break;
+        }
+        add_flat_path(name);
+        VLOG(8) << "flat json[" << name << "], accessed, hit[" << hit_maps[name] << "], row[" << total_rows << "]";
+    }
+
     // sort by hit
     std::vector<pair<std::string, std::uint64_t>> top_hits(hit_maps.begin(), hit_maps.end());
     std::sort(top_hits.begin(), top_hits.end(),
@@ -170,16 +209,16 @@ void FlatJsonColumnWriter::_flat_column(std::vector<ColumnPtr>& json_datas) {
                   return a.second > b.second;
               });
 
-    for (int i = 0; i < top_hits.size() && i < config::json_flat_column_max; i++) {
-        const auto& [name, hit] = top_hits[i];
+    for (const auto& [name, hit] : top_hits) {
+        if (_flat_paths.size() >= config::json_flat_column_max) {
+            break;
+        }
+        if (flat_names.count(name) > 0) {
+            continue;
+        }
         // check sparsity
         if (hit >= total_rows * config::json_flat_sparsity_factor) {
-            if (name.find('.') != std::string::npos) {
-                // add escape
-                _flat_paths.emplace_back(fmt::format("\"{}\"", name));
-            } else {
-                _flat_paths.emplace_back(name);
-            }
+            add_flat_path(name);
         }
         VLOG(8) << "flat json[" << name << "], hit[" << hit << "], row[" << total_rows << "]";
     }
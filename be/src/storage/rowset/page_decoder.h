@@ -42,6 +42,7 @@
 
 namespace starrocks {
 class Column;
+class EncodedPredicates;
 }
 
 namespace starrocks {
@@ -91,6 +92,14 @@ public:
         return Status::NotSupported("PageDecoder Not Support");
     }
 
+    // Evaluate |predicates| on the next |*n| values without decoding them into a column, and advance
+    // the decoder like next_batch(). selection[i] is set to 1 iff the i-th value satisfies all of
+    // the predicates.
+    [[nodiscard]] virtual Status next_batch_selection(const EncodedPredicates& predicates, size_t* n,
+                                                      uint8_t* selection) {
+        return Status::NotSupported("next_batch_selection() not supported");
+    }
+
     // Return the number of elements in this page.
     virtual uint32_t count() const = 0;
 
@@ -47,6 +47,7 @@
 #include "util/compression/block_compression.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "util/raw_container.h"
 #include "util/runtime_profile.h"
 #include "util/scoped_cleanup.h"
 
@@ -102,6 +103,8 @@ Status PageIO::write_page(WritableFile* wfile, const std::vector<Slice>& body, c
     case SHORT_KEY_PAGE:
         CHECK(footer.has_short_key_page_footer());
         break;
+    case VECTOR_INDEX_PAGE:
+        break;
     default:
         CHECK(false) << "Invalid page footer type: " << footer.type();
         break;
@@ -139,7 +142,9 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
-    StoragePageCache::CacheKey cache_key(opts.read_file->filename(), opts.page_pointer.offset);
+    StoragePageCache::CacheKey cache_key(
+            opts.use_page_cache ? PageCacheFileIdRegistry::instance()->get_or_register(opts.read_file->filename()) : 0,
+            opts.page_pointer.offset);
     if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle)) {
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
@@ -153,6 +158,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
                     strings::Substitute("Bad page: invalid footer, read from page cache, file=$0, footer_size=$1",
                                         opts.read_file->filename(), footer_size));
         }
+        cache->record_lookup(footer->type(), true);
         *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
         return Status::OK();
     }
@@ -200,6 +206,9 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
                 strings::Substitute("Bad page: invalid footer, read from disk, file=$0, footer_size=$1",
                                     opts.read_file->filename(), footer_size));
     }
+    if (opts.use_page_cache) {
+        cache->record_lookup(footer->type(), false);
+    }
 
     uint32_t body_size = page_slice.size - 4 - footer_size;
     if (body_size != footer->uncompressed_size()) { // need decompress body
@@ -234,7 +243,8 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     RETURN_IF_ERROR(StoragePageDecoder::decode_page(footer, footer_size + 4, opts.encoding_type, &page, &page_slice));
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache) {
+    // index and dictionary pages are always admitted, only data pages of large scans bypass page cache
+    if (opts.use_page_cache && (opts.fill_page_cache || footer->type() != DATA_PAGE)) {
         // insert this page into cache and return the cache handle
         cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
@@ -245,4 +255,31 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     return Status::OK();
 }
 
+Status PageIO::read_encoded_page(io::SeekableInputStream* read_file, const PagePointer& page_pointer,
+                                 std::string* body, PageFooterPB* footer) {
+    // every page contains 4 bytes footer length and 4 bytes checksum
+    const uint32_t page_size = page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption(
+                strings::Substitute("Bad page: too small size ($0), file($1)", page_size, read_file->filename()));
+    }
+    raw::stl_string_resize_uninitialized(body, page_size);
+    RETURN_IF_ERROR(read_file->read_at_fully(page_pointer.offset, body->data(), page_size));
+
+    uint32_t expect = decode_fixed32_le((uint8_t*)body->data() + page_size - 4);
+    uint32_t actual = crc32c::Value(body->data(), page_size - 4);
+    if (expect != actual) {
+        return Status::Corruption(strings::Substitute("Bad page: checksum mismatch (actual=$0 vs expect=$1), file=$2",
+                                                      actual, expect, read_file->filename()));
+    }
+    uint32_t footer_size = decode_fixed32_le((uint8_t*)body->data() + page_size - 8);
+    if (footer_size > page_size - 8 ||
+        !footer->ParseFromArray(body->data() + page_size - 8 - footer_size, footer_size)) {
+        return Status::Corruption(strings::Substitute("Bad page: invalid footer, file=$0, footer_size=$1",
+                                                      read_file->filename(), footer_size));
+    }
+    body->resize(page_size - 8 - footer_size);
+    return Status::OK();
+}
+
 } // namespace starrocks
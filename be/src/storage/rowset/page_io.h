@@ -64,6 +64,8 @@ struct PageReadOptions {
     bool verify_checksum = true;
     // whether to use page cache in read path
     bool use_page_cache = true;
+    // whether to insert the page into page cache if it's not found in page cache
+    bool fill_page_cache = true;
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
@@ -118,6 +120,12 @@ public:
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle, Slice* body,
                                            PageFooterPB* footer);
+
+    // Read a page as it's stored in `read_file', i.e. without decompressing and decoding the body, so that it
+    // can be written to another file as it is. The checksum of the page is verified.
+    // On success `body' stores the page body and `footer' stores the page footer.
+    static Status read_encoded_page(io::SeekableInputStream* read_file, const PagePointer& page_pointer,
+                                    std::string* body, PageFooterPB* footer);
 };
 
 } // namespace starrocks
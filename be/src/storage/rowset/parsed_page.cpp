@@ -41,6 +41,7 @@
 #include "column/nullable_column.h"
 #include "common/status.h"
 #include "gutil/strings/substitute.h"
+#include "storage/decoded_page_cache.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/bitshuffle_page.h"
 #include "storage/rowset/encoding_info.h"
@@ -154,6 +155,17 @@ public:
         return Status::OK();
     }
 
+    Status read_selection(const EncodedPredicates& predicates, size_t* count, uint8_t* selection) override {
+        // the positions of records in the data decoder are not the same as in the page if there are nulls
+        if (_has_null) {
+            return Status::NotSupported("read_selection() not supported");
+        }
+        *count = std::min(*count, remaining());
+        RETURN_IF_ERROR(_data_decoder->next_batch_selection(predicates, count, selection));
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
     Status read_dict_codes(Column* column, size_t* count) override {
         *count = std::min(*count, remaining());
         size_t nrows_to_read = *count;
@@ -302,6 +314,19 @@ public:
         return Status::OK();
     }
 
+    Status read_selection(const EncodedPredicates& predicates, size_t* count, uint8_t* selection) override {
+        DCHECK_EQ(_offset_in_page, _data_decoder->current_index());
+        RETURN_IF_ERROR(_data_decoder->next_batch_selection(predicates, count, selection));
+        if (_null_flags.size() > 0) {
+            const uint8_t* null_flags = _null_flags.data() + _offset_in_page;
+            for (size_t i = 0; i < *count; i++) {
+                selection[i] &= !null_flags[i];
+            }
+        }
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
 private:
     friend Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -311,6 +336,56 @@ private:
     PageHandle _page_handle;
 };
 
+// Reads from a page decoded into a column, kept in DecodedPageCache.
+class DecodedParsedPage : public ParsedPage {
+public:
+    Status seek(ordinal_t offset) override {
+        _offset_in_page = offset;
+        return Status::OK();
+    }
+
+    Status read(Column* column, size_t* count) override {
+        *count = std::min(*count, remaining());
+        _append(column, _offset_in_page, *count);
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
+    Status read(Column* column, const SparseRange<>& range) override {
+        DCHECK_LE(range.span_size(), remaining());
+        for (size_t i = 0; i < range.size(); i++) {
+            _append(column, range[i].begin(), range[i].span_size());
+        }
+        _offset_in_page = range.end();
+        return Status::OK();
+    }
+
+    Status read_dict_codes(Column* column, size_t* count) override {
+        return Status::NotSupported("read dict codes from decoded page");
+    }
+
+    Status read_dict_codes(Column* column, const SparseRange<>& range) override {
+        return Status::NotSupported("read dict codes from decoded page");
+    }
+
+private:
+    friend Status parse_decoded_page(std::unique_ptr<ParsedPage>* result, DecodedPageCacheHandle handle,
+                                     const PagePointer& page_pointer, uint32_t page_index);
+
+    void _append(Column* column, size_t offset, size_t count) const {
+        if (column->is_nullable() || !_column->is_nullable()) {
+            // NullableColumn accepts both nullable and non-nullable source
+            column->append(*_column, offset, count);
+        } else {
+            DCHECK(!down_cast<const NullableColumn*>(_column)->has_null());
+            column->append(*down_cast<const NullableColumn*>(_column)->data_column(), offset, count);
+        }
+    }
+
+    DecodedPageCacheHandle _cache_handle;
+    const Column* _column = nullptr;
+};
+
 Status parse_page_v1(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                      const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                      uint32_t page_index) {
@@ -395,6 +470,22 @@ Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, con
     return Status::OK();
 }
 
+Status parse_decoded_page(std::unique_ptr<ParsedPage>* result, DecodedPageCacheHandle handle,
+                          const PagePointer& page_pointer, uint32_t page_index) {
+    auto page = std::make_unique<DecodedParsedPage>();
+    const DecodedPage* decoded = handle.page();
+    page->_column = decoded->column.get();
+    page->_cache_handle = std::move(handle);
+    page->_first_ordinal = decoded->first_ordinal;
+    page->_num_rows = page->_column->size();
+    page->_page_pointer = page_pointer;
+    page->_page_index = page_index;
+    page->_corresponding_element_ordinal = decoded->corresponding_element_ordinal;
+
+    *result = std::move(page);
+    return Status::OK();
+}
+
 Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index) {
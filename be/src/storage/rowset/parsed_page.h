@@ -46,6 +46,7 @@ class Slice;
 class Status;
 class Column;
 class DataPageFooterPB;
+class DecodedPageCacheHandle;
 class EncodingInfo;
 class PageHandle;
 class PagePointer;
@@ -112,6 +113,14 @@ public:
 
     virtual Status read_dict_codes(Column* column, const SparseRange<>& range) = 0;
 
+    // Evaluate |predicates| on the next |*count| records of this page without reading them into a
+    // column, see PageDecoder::next_batch_selection(). selection[i] is set to 0 for NULL records.
+    // The number of records evaluated is updated to |count|, and the page offset is advanced by this
+    // number too. Return NotSupported without advancing if the page can not evaluate the predicates.
+    virtual Status read_selection(const EncodedPredicates& predicates, size_t* count, uint8_t* selection) {
+        return Status::NotSupported("read_selection() not supported");
+    }
+
 protected:
     uint32_t _page_index{0};
     uint64_t _num_rows{0};
@@ -130,4 +139,8 @@ Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index);
 
+// Create a page reading from a page kept in DecodedPageCache, which does not support reading dictionary codes.
+Status parse_decoded_page(std::unique_ptr<ParsedPage>* result, DecodedPageCacheHandle handle,
+                          const PagePointer& page_pointer, uint32_t page_index);
+
 } // namespace starrocks
@@ -50,6 +50,7 @@
 #include "storage/empty_iterator.h"
 #include "storage/inverted/index_descriptor.hpp"
 #include "storage/merge_iterator.h"
+#include "storage/page_cache.h"
 #include "storage/projection_iterator.h"
 #include "storage/rowset/rowid_range_option.h"
 #include "storage/rowset/short_key_range_option.h"
@@ -301,6 +302,7 @@ Status Rowset::remove() {
         auto st = fs->delete_file(path);
         LOG_IF(WARNING, !st.ok()) << "Fail to delete " << path << ": " << st;
         merge_status(st);
+        PageCacheFileIdRegistry::instance()->remove(path);
 
         // delete index
         for (const auto& index : *(_schema->indexes())) {
@@ -662,6 +664,7 @@ Status Rowset::get_segment_iterators(const Schema& schema, const RowsetReadOptio
     seg_options.pred_tree = options.pred_tree;
     seg_options.predicates_for_zone_map = options.predicates_for_zone_map;
     seg_options.use_page_cache = options.use_page_cache;
+    seg_options.fill_page_cache = options.fill_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
@@ -691,6 +694,7 @@ Status Rowset::get_segment_iterators(const Schema& schema, const RowsetReadOptio
         seg_options.is_cancelled = &options.runtime_state->cancelled_ref();
     }
     seg_options.prune_column_after_index_filter = options.prune_column_after_index_filter;
+    seg_options.vector_search_option = options.vector_search_option;
 
     auto segment_schema = schema;
     // Append the columns with delete condition to segment schema.
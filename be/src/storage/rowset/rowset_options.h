@@ -41,10 +41,12 @@ class DeletePredicates;
 class ChunkPredicate;
 struct RowidRangeOption;
 struct ShortKeyRangesOption;
+struct VectorSearchOption;
 
 class RowsetReadOptions {
     using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
     using ShortKeyRangesOptionPtr = std::shared_ptr<ShortKeyRangesOption>;
+    using VectorSearchOptionPtr = std::shared_ptr<VectorSearchOption>;
     using PredicateList = std::vector<const ColumnPredicate*>;
 
 public:
@@ -71,6 +73,7 @@ public:
     RuntimeState* runtime_state = nullptr;
     RuntimeProfile* profile = nullptr;
     bool use_page_cache = false;
+    bool fill_page_cache = true;
     LakeIOOptions lake_io_opts;
 
     ColumnIdToGlobalDictMap* global_dictmaps = &EMPTY_GLOBAL_DICTMAPS;
@@ -86,6 +89,8 @@ public:
     bool asc_hint = true;
 
     bool prune_column_after_index_filter = false;
+
+    VectorSearchOptionPtr vector_search_option = nullptr;
 };
 
 } // namespace starrocks
@@ -121,6 +121,8 @@ Status RowsetWriter::init() {
 
     _writer_options.global_dicts = _context.global_dicts != nullptr ? _context.global_dicts : nullptr;
     _writer_options.referenced_column_ids = _context.referenced_column_ids;
+    _writer_options.encode_pool = ExecEnv::GetInstance()->segment_encode_pool();
+    _writer_options.tablet_id = _context.tablet_id;
 
     if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS &&
         (_context.is_partial_update || !_context.merge_condition.empty() || _context.miss_auto_increment_column)) {
@@ -1145,6 +1147,30 @@ Status VerticalRowsetWriter::add_columns(const Chunk& chunk, const std::vector<u
     return Status::OK();
 }
 
+Status VerticalRowsetWriter::append_columns(const std::vector<uint32_t>& column_indexes,
+                                            const AppendColumnRowsFunc& append_rows) {
+    if (_segment_writers.empty()) {
+        return Status::OK();
+    }
+    int64_t first_row = 0;
+    for (size_t i = 0; i < _segment_writers.size(); ++i) {
+        if (i > 0) {
+            RETURN_IF_ERROR(_flush_columns(&_segment_writers[_current_writer_index]));
+        }
+        _current_writer_index = i;
+        auto& segment_writer = _segment_writers[i];
+        DCHECK_EQ(0, segment_writer->num_rows_written());
+        RETURN_IF_ERROR(segment_writer->init(column_indexes, false));
+        const size_t num_rows = segment_writer->num_rows();
+        RETURN_IF_ERROR(segment_writer->append_columns(num_rows, [&](size_t index, ColumnWriter* writer) {
+            return append_rows(index, first_row, num_rows, writer);
+        }));
+        first_row += static_cast<int64_t>(num_rows);
+    }
+    // the last segment is flushed by flush_columns()
+    return Status::OK();
+}
+
 Status VerticalRowsetWriter::flush_columns() {
     if (_segment_writers.empty()) {
         return Status::OK();
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -57,6 +58,7 @@ class IOBuf;
 
 namespace starrocks {
 
+class ColumnWriter;
 class SegmentWriter;
 class WritableFile;
 
@@ -115,6 +117,18 @@ public:
         return Status::NotSupported("RowsetWriter::add_columns");
     }
 
+    // Appends the rows [first_row, first_row + num_rows) of the column at |index| of |column_indexes| to |writer|.
+    using AppendColumnRowsFunc =
+            std::function<Status(size_t index, int64_t first_row, size_t num_rows, ColumnWriter* writer)>;
+
+    // Used for vertical compaction
+    // Writes the non-key |column_indexes| of all the rows written by the key columns through |append_rows|,
+    // which is called with each column writer of each segment, instead of add_columns().
+    virtual Status append_columns(const std::vector<uint32_t>& column_indexes,
+                                  const AppendColumnRowsFunc& append_rows) {
+        return Status::NotSupported("RowsetWriter::append_columns");
+    }
+
     virtual Status flush_chunk(const Chunk& chunk, SegmentPB* seg_info = nullptr) {
         return Status::NotSupported("RowsetWriter::flush_chunk");
     }
@@ -247,6 +261,9 @@ public:
 
     Status add_columns(const Chunk& chunk, const std::vector<uint32_t>& column_indexes, bool is_key) override;
 
+    Status append_columns(const std::vector<uint32_t>& column_indexes,
+                          const AppendColumnRowsFunc& append_rows) override;
+
     Status flush_columns() override;
 
     Status final_flush() override;
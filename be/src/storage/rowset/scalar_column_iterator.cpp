@@ -34,11 +34,14 @@
 
 #include "storage/rowset/scalar_column_iterator.h"
 
+#include "storage/chunk_helper.h"
 #include "storage/column_predicate.h"
+#include "storage/decoded_page_cache.h"
 #include "storage/rowset/binary_dict_page.h"
 #include "storage/rowset/bitshuffle_page.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/dict_page.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/encoding_info.h"
 #include "util/bitmap.h"
 
@@ -60,6 +63,38 @@ Status ScalarColumnIterator::init(const ColumnIteratorOptions& opts) {
     RETURN_IF_ERROR(_reader->load_ordinal_index(index_opts));
     _opts.stats->total_columns_data_page_count += _reader->num_data_pages();
 
+    RETURN_IF_ERROR(_init_dict(opts));
+    // dictionary codes are read from the encoded pages, so the pages of all dict encoded columns are not
+    // kept decoded.
+    _use_decoded_page_cache = !_all_dict_encoded && _decoded_page_cache_enabled();
+    return Status::OK();
+}
+
+bool ScalarColumnIterator::_decoded_page_cache_enabled() const {
+    if (DecodedPageCache::instance() == nullptr || !_opts.use_page_cache) {
+        return false;
+    }
+    switch (_reader->column_type()) {
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DECIMALV2:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status ScalarColumnIterator::_init_dict(const ColumnIteratorOptions& opts) {
     if (_reader->encoding_info()->encoding() != DICT_ENCODING) {
         return Status::OK();
     }
@@ -299,6 +334,32 @@ Status ScalarColumnIterator::next_batch(const SparseRange<>& range, Column* dst)
     return Status::OK();
 }
 
+Status ScalarColumnIterator::next_batch_selection(const EncodedPredicates& predicates, const SparseRange<>& range,
+                                                  uint8_t* selection) {
+    // don't seek to the pages whose decoders can't evaluate the predicates at all
+    if (!EncodedPredicates::is_supported_encoding(_reader->encoding_info()->encoding())) {
+        return Status::NotSupported("next_batch_selection() not supported");
+    }
+    SparseRangeIterator<> iter = range.new_iterator();
+    while (iter.has_more()) {
+        RETURN_IF_ERROR(seek_to_ordinal(iter.begin()));
+        size_t end_ord = _page->first_ordinal() + _page->num_rows();
+        Range<> r = iter.next(end_ord - _current_ordinal);
+        size_t n = r.span_size();
+        Status st = _page->read_selection(predicates, &n, selection);
+        if (st.is_not_supported()) {
+            // e.g. the v1 pages with nulls, all rows are selected and evaluated after being read
+            memset(selection, 1, r.span_size());
+        } else {
+            RETURN_IF_ERROR(st);
+            DCHECK_EQ(r.span_size(), n);
+        }
+        _current_ordinal = r.end();
+        selection += r.span_size();
+    }
+    return Status::OK();
+}
+
 Status ScalarColumnIterator::_load_next_page(bool* eos) {
     _page_iter.next();
     if (!_page_iter.valid()) {
@@ -353,6 +414,15 @@ Status ScalarColumnIterator::_do_init_dict_decoder() {
 }
 
 Status ScalarColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter) {
+    if (_use_decoded_page_cache) {
+        DecodedPageCacheHandle decoded_handle;
+        StoragePageCache::CacheKey key(_opts.read_file->filename(), iter.page().offset);
+        if (DecodedPageCache::instance()->lookup(key, &decoded_handle)) {
+            return parse_decoded_page(&_page, std::move(decoded_handle), iter.page(), iter.page_index());
+        }
+    }
+
+    const int64_t prev_cached_pages = _opts.stats->cached_pages_num;
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
@@ -368,9 +438,31 @@ Status ScalarColumnIterator::_read_data_page(const OrdinalPageIndexIterator& ite
     if (_init_dict_decoder_func != nullptr) {
         RETURN_IF_ERROR((this->*_init_dict_decoder_func)());
     }
+
+    // a page hit in page cache is read at least twice, decode it once and keep it decoded
+    if (_use_decoded_page_cache && _opts.fill_page_cache && _opts.stats->cached_pages_num > prev_cached_pages) {
+        RETURN_IF_ERROR(_fill_decoded_page_cache(iter));
+    }
     return Status::OK();
 }
 
+Status ScalarColumnIterator::_fill_decoded_page_cache(const OrdinalPageIndexIterator& iter) {
+    DCHECK_EQ(0, _page->offset());
+    auto decoded = std::make_unique<DecodedPage>();
+    decoded->column = ChunkHelper::column_from_field_type(_reader->column_type(), _reader->is_nullable());
+    decoded->first_ordinal = _page->first_ordinal();
+    decoded->corresponding_element_ordinal = _page->corresponding_element_ordinal();
+    size_t num_rows = _page->num_rows();
+    decoded->column->reserve(num_rows);
+    RETURN_IF_ERROR(_page->read(decoded->column.get(), &num_rows));
+    DCHECK_EQ(num_rows, _page->num_rows());
+
+    DecodedPageCacheHandle decoded_handle;
+    StoragePageCache::CacheKey key(_opts.read_file->filename(), iter.page().offset);
+    DecodedPageCache::instance()->insert(key, std::move(decoded), &decoded_handle);
+    return parse_decoded_page(&_page, std::move(decoded_handle), iter.page(), iter.page_index());
+}
+
 Status ScalarColumnIterator::get_row_ranges_by_zone_map(const std::vector<const ColumnPredicate*>& predicates,
                                                         const ColumnPredicate* del_predicate,
                                                         SparseRange<>* row_ranges) {
@@ -82,6 +82,9 @@ public:
 
     [[nodiscard]] Status next_dict_codes(const SparseRange<>& range, Column* dst) override;
 
+    [[nodiscard]] Status next_batch_selection(const EncodedPredicates& predicates, const SparseRange<>& range,
+                                              uint8_t* selection) override;
+
     [[nodiscard]] Status decode_dict_codes(const int32_t* codes, size_t size, Column* words) override;
 
     [[nodiscard]] Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, Column* values) override;
@@ -104,6 +107,9 @@ private:
     static Status _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    Status _fill_decoded_page_cache(const OrdinalPageIndexIterator& iter);
+    Status _init_dict(const ColumnIteratorOptions& opts);
+    bool _decoded_page_cache_enabled() const;
 
     template <LogicalType Type>
     int _do_dict_lookup(const Slice& word);
@@ -166,6 +172,9 @@ private:
     // whether all data pages are dict-encoded.
     bool _all_dict_encoded = false;
 
+    // whether data pages are read from and kept in DecodedPageCache.
+    bool _use_decoded_page_cache = false;
+
     // variable used for array column(offset, element)
     // It's used to get element ordinal for specfied offset value.
     int64_t _element_ordinal = 0;
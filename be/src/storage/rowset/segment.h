@@ -170,6 +170,12 @@ public:
         return _sk_index_decoder->num_items() - 1;
     }
 
+    // Return nullptr if this segment has no learned key index.
+    const LearnedKeyIndex* learned_key_index() const {
+        DCHECK(invoked(_load_index_once));
+        return _sk_index_decoder->learned_key_index();
+    }
+
     size_t num_columns() const { return _column_readers.size(); }
 
     const ColumnReader* column(size_t i) const {
@@ -181,6 +187,10 @@ public:
         return _column_readers.count(uid) > 0 ? _column_readers.at(uid).get() : nullptr;
     }
 
+    ColumnReader* column_with_uid(size_t uid) {
+        return _column_readers.count(uid) > 0 ? _column_readers.at(uid).get() : nullptr;
+    }
+
     FileSystem* file_system() const { return _fs.get(); }
 
     const TabletSchema& tablet_schema() const { return *_tablet_schema; }
@@ -15,14 +15,18 @@
 #include "segment_iterator.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <stack>
 #include <unordered_map>
 
+#include "column/array_column.h"
 #include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "common/config.h"
 #include "common/status.h"
 #include "fs/fs.h"
@@ -41,20 +45,24 @@
 #include "storage/del_vector.h"
 #include "storage/inverted/index_descriptor.hpp"
 #include "storage/lake/update_manager.h"
+#include "storage/learned_key_index.h"
 #include "storage/olap_runtime_range_pruner.hpp"
 #include "storage/projection_iterator.h"
 #include "storage/range.h"
 #include "storage/roaring2range.h"
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/column_decoder.h"
+#include "storage/rowset/column_reader.h"
 #include "storage/rowset/common.h"
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/dictcode_column_iterator.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/fill_subfield_iterator.h"
 #include "storage/rowset/rowid_column_iterator.h"
 #include "storage/rowset/rowid_range_option.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/short_key_range_option.h"
+#include "storage/rowset/vector_search_option.h"
 #include "storage/storage_engine.h"
 #include "storage/types.h"
 #include "storage/update_manager.h"
@@ -195,6 +203,10 @@ private:
         // for inverted index.
         std::unordered_set<size_t> _prune_cols;
         bool _prune_column_after_index_filter = false;
+
+        // the iterators of |_column_iterators| which evaluate the predicates on the encoded pages before
+        // the columns are read, see SegmentIterator::_refine_range_by_encoded_predicates().
+        std::vector<std::pair<ColumnIterator*, const EncodedPredicates*>> _encoded_predicates;
     };
 
     Status _init();
@@ -224,6 +236,10 @@ private:
 
     void _init_column_predicates();
 
+    void _init_encoded_predicates();
+
+    Status _refine_range_by_encoded_predicates(const SparseRange<>& range, SparseRange<>* refined);
+
     Status _init_context();
 
     template <bool late_materialization>
@@ -262,6 +278,8 @@ private:
 
     Status _apply_inverted_index();
 
+    Status _apply_vector_index();
+
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
 
     void _init_column_access_paths();
@@ -312,6 +330,10 @@ private:
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
     std::vector<const ColumnPredicate*> _expr_ctx_preds; // predicates using ExprContext*
+    // the predicates which can be evaluated on the encoded pages, a subset of |_cid_to_predicates|.
+    std::map<ColumnId, EncodedPredicates> _cid_to_encoded_predicates;
+    Buffer<uint8_t> _encoded_selection;
+    Buffer<uint8_t> _encoded_column_selection;
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
 
@@ -446,11 +468,13 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
     RETURN_IF_ERROR(_apply_inverted_index());
+    RETURN_IF_ERROR(_apply_vector_index());
     // rewrite stage
     // Rewriting predicates using segment dictionary codes
     RETURN_IF_ERROR(_rewrite_predicates());
     RETURN_IF_ERROR(_init_context());
     _init_column_predicates();
+    _init_encoded_predicates();
 
     // reverse scan_range
     if (!_opts.asc_hint) {
@@ -475,6 +499,11 @@ Status SegmentIterator::_try_to_update_ranges_by_runtime_filter() {
                 del_pred = iter != _del_predicates.end() ? &(iter->second) : nullptr;
                 SparseRange<> r;
                 RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(predicates, del_pred, &r));
+                if (config::enable_index_bloom_filter && !r.empty() &&
+                    std::any_of(predicates.begin(), predicates.end(),
+                                [](const ColumnPredicate* pred) { return pred->support_bloom_filter(); })) {
+                    RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_bloom_filter(predicates, &r));
+                }
                 size_t prev_size = _scan_range.span_size();
                 SparseRange<> res;
                 res.set_sorted(_scan_range.is_sorted());
@@ -539,6 +568,7 @@ Status SegmentIterator::_init_column_iterator_by_cid(const ColumnId cid, const C
     ColumnIteratorOptions iter_opts;
     iter_opts.stats = _opts.stats;
     iter_opts.use_page_cache = _opts.use_page_cache;
+    iter_opts.fill_page_cache = _opts.fill_page_cache;
     iter_opts.check_dict_encoding = check_dict_enc;
     iter_opts.reader_type = _opts.reader_type;
     iter_opts.lake_io_opts = _opts.lake_io_opts;
@@ -676,6 +706,96 @@ void SegmentIterator::_init_column_predicates() {
     }
 }
 
+void SegmentIterator::_init_encoded_predicates() {
+    if (!config::enable_encoded_page_predicate) {
+        return;
+    }
+    for (ScanContext& ctx : _context_list) {
+        for (size_t i = 0; i < ctx._read_schema.num_fields(); i++) {
+            const FieldPtr& f = ctx._read_schema.field(i);
+            auto iter = _cid_to_predicates.find(f->id());
+            // the dict code columns are read by the wrapped iterators, whose predicates are rewritten
+            if (iter == _cid_to_predicates.end() || ctx._prune_cols.count(i) ||
+                ctx._column_iterators[i] != _column_iterators[f->id()].get()) {
+                continue;
+            }
+            EncodedPredicates& encoded_preds = _cid_to_encoded_predicates[f->id()];
+            if (encoded_preds.empty()) {
+                for (const ColumnPredicate* pred : iter->second) {
+                    // the predicates only used to compute the row ranges are not evaluated on the rows
+                    if (!pred->is_index_filter_only() && EncodedPredicates::is_supported(pred, f->type()->type())) {
+                        encoded_preds.add(pred);
+                    }
+                }
+            }
+            if (!encoded_preds.empty()) {
+                ctx._encoded_predicates.emplace_back(ctx._column_iterators[i], &encoded_preds);
+            }
+        }
+    }
+}
+
+// Evaluate the predicates on the encoded pages, and remove the rows which do not satisfy them from |range|,
+// so they are not read at all. The predicates are still evaluated by `_filter` on the rows read.
+Status SegmentIterator::_refine_range_by_encoded_predicates(const SparseRange<>& range, SparseRange<>* refined) {
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+    const size_t num_rows = range.span_size();
+    _encoded_selection.resize(num_rows);
+    _encoded_column_selection.resize(num_rows);
+    bool evaluated = false;
+    auto& encoded_predicates = _context->_encoded_predicates;
+    for (size_t k = 0; k < encoded_predicates.size();) {
+        const auto& [iter, preds] = encoded_predicates[k];
+        uint8_t* selection = evaluated ? _encoded_column_selection.data() : _encoded_selection.data();
+        Status st = iter->next_batch_selection(*preds, range, selection);
+        if (st.is_not_supported()) {
+            // the column is not evaluated on the encoded pages of the following ranges either
+            encoded_predicates.erase(encoded_predicates.begin() + k);
+            continue;
+        }
+        RETURN_IF_ERROR(st);
+        k++;
+        if (evaluated) {
+            for (size_t i = 0; i < num_rows; i++) {
+                _encoded_selection[i] &= _encoded_column_selection[i];
+            }
+        }
+        evaluated = true;
+    }
+    if (!evaluated) {
+        *refined = range;
+        return Status::OK();
+    }
+
+    const uint8_t* selection = _encoded_selection.data();
+    SparseRangeIterator<> range_iter = range.new_iterator();
+    while (range_iter.has_more()) {
+        Range<> r = range_iter.next(num_rows);
+        size_t i = 0;
+        while (i < r.span_size()) {
+            while (i < r.span_size() && !selection[i]) {
+                i++;
+            }
+            size_t start = i;
+            while (i < r.span_size() && selection[i]) {
+                i++;
+            }
+            if (i > start) {
+                refined->add(Range<>(r.begin() + start, r.begin() + i));
+            }
+        }
+        selection += r.span_size();
+    }
+    // too few rows are skipped to pay for reading many short ranges, read all the rows and filter them instead
+    const auto min_range_rows = static_cast<size_t>(std::max(config::encoded_page_predicate_min_range_rows, 0));
+    if (!refined->empty() && refined->span_size() < min_range_rows * refined->size()) {
+        *refined = range;
+        return Status::OK();
+    }
+    _opts.stats->rows_vec_cond_filtered += num_rows - refined->span_size();
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     if (_opts.is_first_split_of_segment) {
         StarRocksMetrics::instance()->segment_row_total.increment(num_rows());
@@ -855,30 +975,43 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
 // or end if no such row is found.
 // |rowid| will be assigned to the id of found row or |end| if no such row is found.
 Status SegmentIterator::_lookup_ordinal(const SeekTuple& key, bool lower, rowid_t end, rowid_t* rowid) {
-    std::string index_key;
-    index_key = lower ? key.short_key_encode(_segment->num_short_keys(), KEY_MINIMAL_MARKER)
-                      : key.short_key_encode(_segment->num_short_keys(), KEY_MAXIMAL_MARKER);
-
-    uint32_t start_block_id;
-    auto start_iter = _segment->lower_bound(index_key);
-    if (start_iter.valid()) {
-        // Because previous block may contain this key, so we should set rowid to
-        // last block's first row.
-        start_block_id = start_iter.ordinal();
-        if (start_block_id > 0) {
-            start_block_id--;
-        }
+    rowid_t start;
+    const LearnedKeyIndex* learned_key_index = _segment->learned_key_index();
+    int64_t first_key;
+    if (learned_key_index != nullptr && key.columns() > 0 &&
+        learned_key_index->to_key(key.schema().field(0)->type()->type(), key.get(0), &first_key)) {
+        // the ordinal is in the range predicted by the first column of the key
+        uint32_t from;
+        uint32_t to;
+        learned_key_index->locate(first_key, &from, &to);
+        start = from;
+        end = std::min<rowid_t>(end, to);
     } else {
-        // When we don't find a valid index item, which means all short key is
-        // smaller than input key, this means that this key may exist in the last
-        // row block. so we set the rowid to first row of last row block.
-        start_block_id = _segment->last_block();
-    }
-    rowid_t start = start_block_id * _segment->num_rows_per_block();
+        std::string index_key;
+        index_key = lower ? key.short_key_encode(_segment->num_short_keys(), KEY_MINIMAL_MARKER)
+                          : key.short_key_encode(_segment->num_short_keys(), KEY_MAXIMAL_MARKER);
+
+        uint32_t start_block_id;
+        auto start_iter = _segment->lower_bound(index_key);
+        if (start_iter.valid()) {
+            // Because previous block may contain this key, so we should set rowid to
+            // last block's first row.
+            start_block_id = start_iter.ordinal();
+            if (start_block_id > 0) {
+                start_block_id--;
+            }
+        } else {
+            // When we don't find a valid index item, which means all short key is
+            // smaller than input key, this means that this key may exist in the last
+            // row block. so we set the rowid to first row of last row block.
+            start_block_id = _segment->last_block();
+        }
+        start = start_block_id * _segment->num_rows_per_block();
 
-    auto end_iter = _segment->upper_bound(index_key);
-    if (end_iter.valid()) {
-        end = end_iter.ordinal() * _segment->num_rows_per_block();
+        auto end_iter = _segment->upper_bound(index_key);
+        if (end_iter.valid()) {
+            end = end_iter.ordinal() * _segment->num_rows_per_block();
+        }
     }
 
     // binary search to find the exact key
@@ -1005,6 +1138,20 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
     _range_iter.next_range(n, &range);
     read_num += range.span_size();
 
+    if (!_context->_encoded_predicates.empty()) {
+        SparseRange<> refined;
+        RETURN_IF_ERROR(_refine_range_by_encoded_predicates(range, &refined));
+        if (refined.empty()) {
+            // the columns evaluated are not at the position of |_cur_rowid|, make sure the next read seeks
+            _cur_rowid = range.begin();
+            _opts.stats->raw_rows_read += read_num;
+            return Status::OK();
+        }
+        // the columns evaluated are at the end of |range| now
+        RETURN_IF_ERROR(_context->seek_columns(refined.begin()));
+        range = std::move(refined);
+    }
+
     {
         _opts.stats->blocks_load += 1;
         SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
@@ -1947,6 +2094,85 @@ Status SegmentIterator::_apply_inverted_index() {
     return Status::OK();
 }
 
+// Keep only the k rows nearest to the query vector among the candidates of the vector index, the
+// top-k of all segments is merged by the sort operator above the scan.
+Status SegmentIterator::_apply_vector_index() {
+    RETURN_IF(_opts.vector_search_option == nullptr, Status::OK());
+    RETURN_IF(_scan_range.empty(), Status::OK());
+    // the rows filtered by predicates or runtime filters later could leave less than k rows
+    RETURN_IF(!_opts.pred_tree.empty() || !_opts.delete_predicates.empty() || !_opts.runtime_range_pruner.empty(),
+              Status::OK());
+    // the rows of the other key types are merged after being read from the segments
+    const KeysType keys_type = _segment->tablet_schema().keys_type();
+    RETURN_IF(keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS, Status::OK());
+    const VectorSearchOption& search = *_opts.vector_search_option;
+    RETURN_IF(search.k <= 0, Status::OK());
+
+    const ColumnId cid = search.column_id;
+    const Field* field = nullptr;
+    for (const auto& f : _schema.fields()) {
+        if (f->id() == cid) {
+            field = f.get();
+            break;
+        }
+    }
+    RETURN_IF(field == nullptr || cid >= _column_iterators.size() || _column_iterators[cid] == nullptr, Status::OK());
+    ColumnReader* reader = _column_iterators[cid]->get_column_reader();
+    RETURN_IF(reader == nullptr || !reader->has_vector_index(), Status::OK());
+    SCOPED_RAW_TIMER(&_opts.stats->vector_index_filter_ns);
+
+    IndexReadOptions opts;
+    opts.use_page_cache = !config::disable_storage_page_cache;
+    opts.lake_io_opts = _opts.lake_io_opts;
+    opts.read_file = _column_files[cid].get();
+    opts.stats = _opts.stats;
+    RETURN_IF_ERROR(reader->load_vector_index(opts));
+    const VectorIndexReader* index = reader->vector_index();
+    if (index->dim() != search.query_vector.size()) {
+        return Status::InvalidArgument(strings::Substitute("the dimension of query vector is $0, but the index is $1",
+                                                           search.query_vector.size(), index->dim()));
+    }
+
+    std::vector<rowid_t> rowids;
+    index->search(search.query_vector, search.nprobe, &rowids);
+    roaring::Roaring candidates;
+    candidates.addMany(rowids.size(), rowids.data());
+    candidates &= range2roaring(_scan_range);
+    rowids.resize(candidates.cardinality());
+    candidates.toUint32Array(rowids.data());
+
+    // re-rank the candidates by the exact distances of their vectors
+    auto column = ChunkHelper::column_from_field(*field);
+    RETURN_IF_ERROR(_column_iterators[cid]->fetch_values_by_rowid(rowids.data(), rowids.size(), column.get()));
+    const uint8_t* nulls = column->is_nullable() ? down_cast<NullableColumn*>(column.get())->null_column_data().data()
+                                                 : nullptr;
+    const auto* arrays = down_cast<const ArrayColumn*>(ColumnHelper::get_data_column(column.get()));
+    const auto& offsets = arrays->offsets().get_data();
+    const float* values =
+            down_cast<const FloatColumn*>(ColumnHelper::get_data_column(arrays->elements_column().get()))
+                    ->get_data()
+                    .data();
+    std::vector<std::pair<float, rowid_t>> nearest;
+    nearest.reserve(rowids.size());
+    for (size_t i = 0; i < rowids.size(); i++) {
+        if ((nulls != nullptr && nulls[i]) || offsets[i + 1] - offsets[i] != index->dim()) {
+            continue;
+        }
+        nearest.emplace_back(index->distance(search.query_vector.data(), values + offsets[i]), rowids[i]);
+    }
+    const size_t k = std::min<size_t>(search.k, nearest.size());
+    std::partial_sort(nearest.begin(), nearest.begin() + k, nearest.end());
+
+    roaring::Roaring row_bitmap;
+    for (size_t i = 0; i < k; i++) {
+        row_bitmap.add(nearest[i].second);
+    }
+    const size_t input_rows = _scan_range.span_size();
+    _scan_range = roaring2range(row_bitmap);
+    _opts.stats->rows_vector_index_filtered += input_rows - _scan_range.span_size();
+    return Status::OK();
+}
+
 Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     RETURN_IF(!config::enable_index_bloom_filter, Status::OK());
     RETURN_IF(_scan_range.empty(), Status::OK());
@@ -63,6 +63,7 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     dst->fs = fs;
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
+    dst->fill_page_cache = fill_page_cache;
     dst->profile = profile;
     dst->global_dictmaps = global_dictmaps;
     dst->rowid_range_option = rowid_range_option;
@@ -0,0 +1,176 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/segment_page_copier.h"
+
+#include <algorithm>
+
+#include "column/column.h"
+#include "common/config.h"
+#include "fs/fs.h"
+#include "gutil/strings/substitute.h"
+#include "storage/chunk_helper.h"
+#include "storage/rowset/column_iterator.h"
+#include "storage/rowset/column_reader.h"
+#include "storage/rowset/column_writer.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/ordinal_page_index.h"
+#include "storage/rowset/page_io.h"
+#include "storage/rowset/segment.h"
+#include "storage/tablet_schema.h"
+
+namespace starrocks {
+
+SegmentPageCopier::SegmentPageCopier(std::vector<std::shared_ptr<Segment>> segments)
+        : _segments(std::move(segments)) {}
+
+SegmentPageCopier::~SegmentPageCopier() = default;
+
+Status SegmentPageCopier::init() {
+    _files.reserve(_segments.size());
+    _first_rows.reserve(_segments.size());
+    for (const auto& segment : _segments) {
+        ASSIGN_OR_RETURN(auto file, segment->file_system()->new_random_access_file(segment->file_info()));
+        _files.emplace_back(std::move(file));
+        _first_rows.push_back(_num_rows);
+        _num_rows += segment->num_rows();
+    }
+    return Status::OK();
+}
+
+bool SegmentPageCopier::can_copy(const TabletColumn& column) const {
+    switch (column.type()) {
+    case TYPE_ARRAY:
+    case TYPE_MAP:
+    case TYPE_STRUCT:
+    case TYPE_JSON:
+    // CHAR values are padded after being read, see ChunkHelper::padding_char_columns
+    case TYPE_CHAR:
+        return false;
+    default:
+        break;
+    }
+    for (const auto& segment : _segments) {
+        const ColumnReader* reader = segment->column_with_uid(column.unique_id());
+        if (reader == nullptr || reader->column_type() != column.type() ||
+            reader->is_nullable() != column.is_nullable() || reader->sub_readers() != nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status SegmentPageCopier::append_rows(const TabletColumn& column, int64_t first_row, size_t num_rows,
+                                      ColumnWriter* writer) {
+    const int64_t end_row = first_row + static_cast<int64_t>(num_rows);
+    // the segment which contains |first_row|
+    auto it = std::upper_bound(_first_rows.begin(), _first_rows.end(), first_row);
+    size_t segment_index = std::distance(_first_rows.begin(), it) - 1;
+    for (int64_t row = first_row; row < end_row; ++segment_index) {
+        if (segment_index >= _segments.size()) {
+            return Status::InternalError(strings::Substitute("row $0 is out of the segments", row));
+        }
+        const int64_t segment_first_row = _first_rows[segment_index];
+        const int64_t segment_end_row = segment_first_row + _segments[segment_index]->num_rows();
+        const ordinal_t from = row - segment_first_row;
+        const ordinal_t to = std::min(end_row, segment_end_row) - segment_first_row;
+        if (from < to) {
+            RETURN_IF_ERROR(_append_segment_rows(segment_index, column, from, to, writer));
+        }
+        row = segment_first_row + to;
+    }
+    return Status::OK();
+}
+
+Status SegmentPageCopier::_append_segment_rows(size_t segment_index, const TabletColumn& column, ordinal_t from,
+                                               ordinal_t to, ColumnWriter* writer) {
+    auto* reader = _segments[segment_index]->column_with_uid(column.unique_id());
+    DCHECK(reader != nullptr);
+    // the page zone maps are required to copy the pages without their values
+    if (!reader->has_zone_map() ||
+        !writer->can_append_encoded_page(reader->encoding_info()->encoding(), reader->compress_codec())) {
+        return _decode_rows(segment_index, reader, column, from, to, writer);
+    }
+
+    IndexReadOptions opts;
+    opts.read_file = _files[segment_index].get();
+    opts.stats = &_stats;
+    RETURN_IF_ERROR(reader->load_ordinal_index(opts));
+    ASSIGN_OR_RETURN(auto page_zone_maps, reader->load_page_zone_maps(opts));
+
+    OrdinalPageIndexIterator iter;
+    RETURN_IF_ERROR(reader->seek_at_or_before(from, &iter));
+    std::string body;
+    PageFooterPB footer;
+    for (ordinal_t ordinal = from; ordinal < to; iter.next()) {
+        if (!iter.valid()) {
+            return Status::Corruption(strings::Substitute("ordinal $0 is out of the pages of column $1 in $2",
+                                                          ordinal, column.name(),
+                                                          _segments[segment_index]->file_name()));
+        }
+        const ordinal_t page_end = iter.last_ordinal() + 1;
+        const ordinal_t end = std::min(page_end, to);
+        if (ordinal > iter.first_ordinal() || end < page_end) {
+            // only a part of the page is written
+            RETURN_IF_ERROR(_decode_rows(segment_index, reader, column, ordinal, end, writer));
+            ordinal = end;
+            continue;
+        }
+        if (page_zone_maps == nullptr || static_cast<size_t>(iter.page_index()) >= page_zone_maps->size()) {
+            return Status::Corruption(strings::Substitute("missing zone map of page $0 of column $1 in $2",
+                                                          iter.page_index(), column.name(),
+                                                          _segments[segment_index]->file_name()));
+        }
+        RETURN_IF_ERROR(PageIO::read_encoded_page(_files[segment_index].get(), iter.page(), &body, &footer));
+        if (footer.data_page_footer().num_values() != page_end - ordinal) {
+            return Status::Corruption(strings::Substitute("page $0 of column $1 in $2 has $3 values, expect $4",
+                                                          iter.page_index(), column.name(),
+                                                          _segments[segment_index]->file_name(),
+                                                          footer.data_page_footer().num_values(), page_end - ordinal));
+        }
+        RETURN_IF_ERROR(writer->append_encoded_page(body, footer, &(*page_zone_maps)[iter.page_index()]));
+        ++_num_copied_pages;
+        ordinal = end;
+    }
+    return Status::OK();
+}
+
+Status SegmentPageCopier::_decode_rows(size_t segment_index, ColumnReader* reader, const TabletColumn& column,
+                                       ordinal_t from, ordinal_t to, ColumnWriter* writer) {
+    ASSIGN_OR_RETURN(auto iter, reader->new_iterator());
+    ColumnIteratorOptions iter_opts;
+    iter_opts.read_file = _files[segment_index].get();
+    iter_opts.stats = &_stats;
+    iter_opts.is_nullable = column.is_nullable();
+    RETURN_IF_ERROR(iter->init(iter_opts));
+    RETURN_IF_ERROR(iter->seek_to_ordinal(from));
+
+    auto values = ChunkHelper::column_from_field(ChunkHelper::convert_field(0, column));
+    for (ordinal_t ordinal = from; ordinal < to;) {
+        size_t n = std::min<size_t>(to - ordinal, config::vector_chunk_size);
+        values->reset_column();
+        RETURN_IF_ERROR(iter->next_batch(&n, values.get()));
+        if (n == 0) {
+            return Status::Corruption(strings::Substitute("ordinal $0 is out of column $1 in $2", ordinal,
+                                                          column.name(), _segments[segment_index]->file_name()));
+        }
+        RETURN_IF_ERROR(writer->append(*values));
+        ordinal += n;
+    }
+    _num_decoded_rows += static_cast<int64_t>(to - from);
+    return Status::OK();
+}
+
+} // namespace starrocks
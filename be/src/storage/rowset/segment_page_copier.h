@@ -0,0 +1,73 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+#include "storage/rowset/common.h"
+
+namespace starrocks {
+
+class ColumnReader;
+class ColumnWriter;
+class RandomAccessFile;
+class Segment;
+class TabletColumn;
+
+// SegmentPageCopier writes the columns of the rows of a list of segments, taken as a whole in order, to the
+// column writers of other segments, e.g. the value columns of a vertical compaction whose output rows are the
+// input rows in order. The data pages which lie entirely in the written rows are appended as they are stored,
+// without decompressing, decoding, encoding and compressing them again, the others are decoded.
+class SegmentPageCopier {
+public:
+    explicit SegmentPageCopier(std::vector<std::shared_ptr<Segment>> segments);
+    ~SegmentPageCopier();
+
+    Status init();
+
+    // Whether |column| can be written by append_rows(), i.e. all the segments store it in the same type
+    // without conversion.
+    bool can_copy(const TabletColumn& column) const;
+
+    // Appends the rows [first_row, first_row + num_rows) of |column| of the segments to |writer|.
+    // REQUIRES: can_copy(column)
+    Status append_rows(const TabletColumn& column, int64_t first_row, size_t num_rows, ColumnWriter* writer);
+
+    // the number of rows of all the segments
+    int64_t num_rows() const { return _num_rows; }
+    int64_t num_copied_pages() const { return _num_copied_pages; }
+    int64_t num_decoded_rows() const { return _num_decoded_rows; }
+
+private:
+    Status _append_segment_rows(size_t segment_index, const TabletColumn& column, ordinal_t from, ordinal_t to,
+                                ColumnWriter* writer);
+    Status _decode_rows(size_t segment_index, ColumnReader* reader, const TabletColumn& column, ordinal_t from,
+                        ordinal_t to, ColumnWriter* writer);
+
+    std::vector<std::shared_ptr<Segment>> _segments;
+    std::vector<std::unique_ptr<RandomAccessFile>> _files;
+    // the ordinal of the first row of each segment in all the rows
+    std::vector<int64_t> _first_rows;
+    int64_t _num_rows = 0;
+    OlapReaderStatistics _stats;
+
+    int64_t _num_copied_pages = 0;
+    int64_t _num_decoded_rows = 0;
+};
+
+} // namespace starrocks
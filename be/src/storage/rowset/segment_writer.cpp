@@ -42,19 +42,25 @@
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
 #include "column/schema.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "fs/fs.h"          // FileSystem
 #include "gen_cpp/segment.pb.h"
+#include "runtime/current_thread.h"
 #include "storage/inverted/index_descriptor.hpp"
+#include "storage/learned_key_index.h"
 #include "storage/row_store_encoder.h"
 #include "storage/rowset/column_writer.h" // ColumnWriter
 #include "storage/rowset/page_io.h"
 #include "storage/seek_tuple.h"
 #include "storage/short_key_index.h"
 #include "types/logical_type.h"
+#include "util/countdown_latch.h"
 #include "util/crc32c.h"
+#include "util/defer_op.h"
 #include "util/faststring.h"
 #include "util/json.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -170,6 +176,7 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
         opts.need_inverted_index = _tablet_schema->has_index(column.unique_id(), GIN);
+        opts.need_vector_index = _tablet_schema->has_index(column.unique_id(), VECTOR);
 
         RETURN_IF_ERROR(_tablet_schema->get_indexes_for_column(column.unique_id(), &opts.tablet_index));
         if (opts.need_inverted_index) {
@@ -186,6 +193,8 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
             if (opts.need_bitmap_index) {
                 return Status::NotSupported("Do not support bitmap index for array type");
             }
+        } else if (opts.need_vector_index) {
+            return Status::NotSupported("Vector index is only supported for array type");
         }
 
         if (column.type() == LogicalType::TYPE_VARCHAR && _opts.global_dicts != nullptr) {
@@ -197,6 +206,7 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         }
 
         opts.need_flat = config::enable_json_flat;
+        opts.tablet_id = _opts.tablet_id;
         ASSIGN_OR_RETURN(auto writer, ColumnWriter::create(opts, &column, _wfile.get()));
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
@@ -225,6 +235,13 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
     _has_key = has_key;
     if (_has_key) {
         _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+        if (config::learned_key_index_max_error > 0 && !_sort_column_indexes.empty()) {
+            LogicalType key_type = _tablet_schema->column(_tablet_schema->sort_key_idxes()[0]).type();
+            if (LearnedKeyIndexBuilder::is_supported(key_type)) {
+                _learned_key_index_builder = std::make_unique<LearnedKeyIndexBuilder>(
+                        key_type, config::learned_key_index_max_error, _opts.num_rows_per_block);
+            }
+        }
     }
     const auto& column = _tablet_schema->columns().back();
     if (column.name() == Schema::FULL_ROW_COLUMN) {
@@ -272,37 +289,7 @@ Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     }
     _num_rows_written = 0;
 
-    size_t num_columns = _tablet_schema->num_columns();
-    for (size_t i = 0; i < _column_indexes.size(); ++i) {
-        uint32_t column_index = _column_indexes[i];
-        if (column_index >= num_columns) {
-            return Status::InternalError(
-                    strings::Substitute("column index $0 out of range $1", column_index, num_columns));
-        }
-
-        auto& column_writer = _column_writers[i];
-        RETURN_IF_ERROR(column_writer->finish());
-        // write data
-        RETURN_IF_ERROR(column_writer->write_data());
-        // write index
-        uint64_t index_offset = _wfile->size();
-        RETURN_IF_ERROR(column_writer->write_ordinal_index());
-        RETURN_IF_ERROR(column_writer->write_zone_map());
-        RETURN_IF_ERROR(column_writer->write_bitmap_index());
-        RETURN_IF_ERROR(column_writer->write_bloom_filter_index());
-        RETURN_IF_ERROR(column_writer->write_inverted_index());
-        *index_size += _wfile->size() - index_offset;
-
-        // check global dict valid
-        const auto& column = _tablet_schema->column(column_index);
-        if (!column_writer->is_global_dict_valid() && is_string_type(column.type())) {
-            std::string col_name(column.name());
-            _global_dict_columns_valid_info[col_name] = false;
-        }
-
-        // reset to release memory
-        column_writer.reset();
-    }
+    RETURN_IF_ERROR(_finish_and_write_columns(index_size));
     _column_writers.clear();
     _column_indexes.clear();
 
@@ -328,6 +315,10 @@ Status SegmentWriter::_write_short_key_index() {
     std::vector<Slice> body;
     PageFooterPB footer;
     RETURN_IF_ERROR(_index_builder->finalize(_num_rows, &body, &footer));
+    LearnedKeyIndexPB learned_key_index;
+    if (_learned_key_index_builder != nullptr && _learned_key_index_builder->finish(&learned_key_index)) {
+        *footer.mutable_short_key_page_footer()->mutable_learned_key_index() = std::move(learned_key_index);
+    }
     PagePointer pp;
     // short key index page is not compressed right now
     RETURN_IF_ERROR(PageIO::write_page(_wfile.get(), body, footer, &pp));
@@ -364,13 +355,165 @@ Status SegmentWriter::_write_raw_data(const std::vector<Slice>& slices) {
     return Status::OK();
 }
 
+bool SegmentWriter::_parallel_encode_enabled() const {
+    return _opts.encode_pool != nullptr && config::segment_parallel_encode_min_columns > 0 &&
+           _column_writers.size() >= static_cast<size_t>(config::segment_parallel_encode_min_columns);
+}
+
+Status SegmentWriter::_write_column(size_t idx, uint64_t* index_size) {
+    uint32_t column_index = _column_indexes[idx];
+    auto& column_writer = _column_writers[idx];
+    // write data
+    RETURN_IF_ERROR(column_writer->write_data());
+    // write index
+    uint64_t index_offset = _wfile->size();
+    RETURN_IF_ERROR(column_writer->write_ordinal_index());
+    RETURN_IF_ERROR(column_writer->write_zone_map());
+    RETURN_IF_ERROR(column_writer->write_bitmap_index());
+    RETURN_IF_ERROR(column_writer->write_bloom_filter_index());
+    RETURN_IF_ERROR(column_writer->write_inverted_index());
+    RETURN_IF_ERROR(column_writer->write_vector_index());
+    *index_size += _wfile->size() - index_offset;
+
+    // check global dict valid
+    const auto& column = _tablet_schema->column(column_index);
+    if (!column_writer->is_global_dict_valid() && is_string_type(column.type())) {
+        std::string col_name(column.name());
+        _global_dict_columns_valid_info[col_name] = false;
+    }
+
+    // reset to release memory
+    column_writer.reset();
+    return Status::OK();
+}
+
+Status SegmentWriter::_finish_and_write_columns(uint64_t* index_size) {
+    size_t num_columns = _tablet_schema->num_columns();
+    for (uint32_t column_index : _column_indexes) {
+        if (column_index >= num_columns) {
+            return Status::InternalError(
+                    strings::Substitute("column index $0 out of range $1", column_index, num_columns));
+        }
+    }
+
+    if (!_parallel_encode_enabled()) {
+        for (size_t i = 0; i < _column_writers.size(); ++i) {
+            RETURN_IF_ERROR(_column_writers[i]->finish());
+            RETURN_IF_ERROR(_write_column(i, index_size));
+        }
+        return Status::OK();
+    }
+
+    // Finishing a column encodes and compresses its last page and its dictionary page, which is
+    // independent of the other columns. Submit all of them at once and write the columns out in
+    // order as soon as each one is ready, so the IO of a column overlaps the encoding of the next.
+    // The writes stay in the current thread: the column writers record the page pointers and index
+    // offsets as the file size at the time of each append, so the appends must be done in order and
+    // synchronously with the column writer which produces them.
+    struct FinishTask {
+        CountDownLatch latch{1};
+        Status status;
+    };
+    std::vector<std::unique_ptr<FinishTask>> tasks(_column_writers.size());
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        tasks[i] = std::make_unique<FinishTask>();
+        auto* task = tasks[i].get();
+        auto* writer = _column_writers[i].get();
+        auto st = _opts.encode_pool->submit_func([task, writer, mem_tracker]() {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+            task->status = writer->finish();
+            task->latch.count_down();
+        });
+        if (!st.ok()) {
+            // the pool is shutting down or full, finish it in the current thread
+            task->status = writer->finish();
+            task->latch.count_down();
+        }
+    }
+    // the column writers must outlive all the submitted tasks, even if we return early
+    DeferOp wait_all([&tasks]() {
+        for (auto& task : tasks) {
+            task->latch.wait();
+        }
+    });
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        tasks[i]->latch.wait();
+        RETURN_IF_ERROR(tasks[i]->status);
+        RETURN_IF_ERROR(_write_column(i, index_size));
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::_append_columns(const Chunk& chunk, size_t num_columns) {
+    if (!_parallel_encode_enabled()) {
+        for (size_t i = 0; i < num_columns; ++i) {
+            const Column* col = chunk.get_column_by_index(i).get();
+            RETURN_IF_ERROR(_column_writers[i]->append(*col));
+        }
+        return Status::OK();
+    }
+
+    // Split the columns into contiguous batches. The batches except the first one are encoded by
+    // the pool and the first one is encoded by the current thread, which then waits for the others.
+    size_t num_batches = std::min<size_t>(num_columns, _opts.encode_pool->max_threads() + 1);
+    size_t batch_size = (num_columns + num_batches - 1) / num_batches;
+    num_batches = (num_columns + batch_size - 1) / batch_size;
+    std::vector<Status> statuses(num_batches);
+    auto append_batch = [this, &chunk, &statuses, batch_size, num_columns](size_t batch) {
+        size_t end = std::min(num_columns, (batch + 1) * batch_size);
+        for (size_t i = batch * batch_size; i < end; ++i) {
+            const Column* col = chunk.get_column_by_index(i).get();
+            auto st = _column_writers[i]->append(*col);
+            if (!st.ok()) {
+                statuses[batch] = std::move(st);
+                return;
+            }
+        }
+    };
+
+    CountDownLatch latch(static_cast<int>(num_batches - 1));
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    for (size_t batch = 1; batch < num_batches; ++batch) {
+        auto st = _opts.encode_pool->submit_func([&append_batch, &latch, mem_tracker, batch]() {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+            append_batch(batch);
+            latch.count_down();
+        });
+        if (!st.ok()) {
+            append_batch(batch);
+            latch.count_down();
+        }
+    }
+    append_batch(0);
+    latch.wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
+}
+
+Status SegmentWriter::append_columns(size_t num_rows,
+                                     const std::function<Status(size_t, ColumnWriter*)>& append_column) {
+    if (_has_key) {
+        return Status::NotSupported("key columns must be appended by chunks");
+    }
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        RETURN_IF_ERROR(append_column(i, _column_writers[i].get()));
+        if (_column_writers[i]->get_next_rowid() != _num_rows_written + num_rows) {
+            return Status::InternalError(strings::Substitute("column $0 has $1 rows, expect $2", _column_indexes[i],
+                                                             _column_writers[i]->get_next_rowid(),
+                                                             _num_rows_written + num_rows));
+        }
+    }
+    _num_rows_written += num_rows;
+    return Status::OK();
+}
+
 Status SegmentWriter::append_chunk(const Chunk& chunk) {
     size_t chunk_num_rows = chunk.num_rows();
     size_t chunk_num_columns = chunk.num_columns();
-    for (size_t i = 0; i < chunk_num_columns; ++i) {
-        const Column* col = chunk.get_column_by_index(i).get();
-        RETURN_IF_ERROR(_column_writers[i]->append(*col));
-    }
+    RETURN_IF_ERROR(_append_columns(chunk, chunk_num_columns));
 
     // TODO(cbl): put the fill full row column logic here is a bit hacky, this segment writer is used in many other
     //            situations(compaction etc.), so better to put it into somewhere early in the write pipeline
@@ -389,6 +532,9 @@ Status SegmentWriter::append_chunk(const Chunk& chunk) {
     }
 
     if (_has_key) {
+        if (_learned_key_index_builder != nullptr) {
+            _learned_key_index_builder->add_keys(*chunk.get_column_by_index(_sort_column_indexes[0]));
+        }
         for (size_t i = 0; i < chunk_num_rows; i++) {
             // At the begin of one block, so add a short key index entry
             if ((_num_rows_written % _opts.num_rows_per_block) == 0) {
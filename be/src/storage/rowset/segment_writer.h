@@ -35,6 +35,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -52,11 +53,13 @@ class RowBlock;
 class TabletSchema;
 class TabletColumn;
 class ShortKeyIndexBuilder;
+class LearnedKeyIndexBuilder;
 class MemTracker;
 class WritableFile;
 class Chunk;
 class ColumnWriter;
 class Schema;
+class ThreadPool;
 
 extern const char* const k_segment_magic;
 extern const uint32_t k_segment_magic_length;
@@ -76,6 +79,13 @@ struct SegmentWriterOptions {
     GlobalDictByNameMaps* global_dicts = nullptr;
     std::vector<int32_t> referenced_column_ids;
     SegmentFileMark segment_file_mark;
+    // If not nullptr and the segment has at least `config::segment_parallel_encode_min_columns`
+    // columns, column pages are encoded and compressed by this pool in parallel across columns,
+    // and the final pages of the columns are finished in the background while the previous
+    // columns are being written to the file.
+    ThreadPool* encode_pool = nullptr;
+    // the tablet of the segment, 0 if unknown
+    int64_t tablet_id = 0;
 };
 
 // SegmentWriter is responsible for writing data into single segment by all or partital columns.
@@ -121,6 +131,11 @@ public:
     // |chunk| contains partial or all columns data corresponding to _column_writers.
     Status append_chunk(const Chunk& chunk);
 
+    // Used for vertical compaction
+    // Appends |num_rows| rows to each non-key column writer initialized by init() by calling |append_column|
+    // with the index of the column in |column_indexes| and the writer, e.g. to copy the encoded pages.
+    Status append_columns(size_t num_rows, const std::function<Status(size_t, ColumnWriter*)>& append_column);
+
     uint64_t estimate_segment_size();
 
     uint32_t num_rows_written() const { return _num_rows_written; }
@@ -148,6 +163,12 @@ private:
     Status _write_footer();
     Status _write_raw_data(const std::vector<Slice>& slices);
     void _init_column_meta(ColumnMetaPB* meta, uint32_t column_id, const TabletColumn& column);
+    bool _parallel_encode_enabled() const;
+    // Appends |chunk| to `_column_writers[0, num_columns)`, in parallel if enabled.
+    Status _append_columns(const Chunk& chunk, size_t num_columns);
+    // Finishes all column writers and writes their data and indexes in column order.
+    Status _finish_and_write_columns(uint64_t* index_size);
+    Status _write_column(size_t idx, uint64_t* index_size);
 
     uint32_t _segment_id;
     TabletSchemaCSPtr _tablet_schema;
@@ -157,6 +178,8 @@ private:
 
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
+    // nullptr if the learned key index is not written
+    std::unique_ptr<LearnedKeyIndexBuilder> _learned_key_index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
     std::vector<uint32_t> _column_indexes;
     bool _has_key = true;
@@ -133,6 +133,9 @@ DataDecoder* DataDecoder::get_data_decoder(EncodingTypePB encoding) {
         return &g_binary_dict_decoder;
     }
     case FOR_ENCODING:
+    case ALP_ENCODING:
+    case DELTA_OF_DELTA_ENCODING:
+    case FSST_ENCODING:
     case PLAIN_ENCODING:
     case PREFIX_ENCODING:
     case RLE: {
@@ -158,7 +161,8 @@ Status StoragePageDecoder::decode_page(PageFooterPB* footer, uint32_t footer_siz
     DCHECK(footer->has_type()) << "type must be set";
     switch (footer->type()) {
     case INDEX_PAGE:
-    case SHORT_KEY_PAGE: {
+    case SHORT_KEY_PAGE:
+    case VECTOR_INDEX_PAGE: {
         return Status::OK();
     }
     case DICTIONARY_PAGE:
@@ -0,0 +1,380 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/vector_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "column/array_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "fs/fs.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/page_handle.h"
+#include "storage/rowset/page_io.h"
+#include "storage/tablet_index.h"
+
+namespace starrocks {
+
+static float l2_distance(const float* a, const float* b, uint32_t dim) {
+    float sum = 0;
+    for (uint32_t i = 0; i < dim; i++) {
+        float d = a[i] - b[i];
+        sum += d * d;
+    }
+    return sum;
+}
+
+// Zero vectors are kept as is.
+static void normalize(float* v, uint32_t dim) {
+    float norm = 0;
+    for (uint32_t i = 0; i < dim; i++) {
+        norm += v[i] * v[i];
+    }
+    if (norm > 0) {
+        norm = std::sqrt(norm);
+        for (uint32_t i = 0; i < dim; i++) {
+            v[i] /= norm;
+        }
+    }
+}
+
+static uint32_t nearest_centroid(const float* v, const float* centroids, uint32_t num_lists, uint32_t dim,
+                                 float* distance) {
+    uint32_t nearest = 0;
+    *distance = std::numeric_limits<float>::max();
+    for (uint32_t c = 0; c < num_lists; c++) {
+        float d = l2_distance(v, centroids + static_cast<size_t>(c) * dim, dim);
+        if (d < *distance) {
+            *distance = d;
+            nearest = c;
+        }
+    }
+    return nearest;
+}
+
+StatusOr<VectorIndexOptions> VectorIndexOptions::create(const TabletIndex& index) {
+    VectorIndexOptions options;
+    const auto& properties = index.index_properties();
+    auto it = properties.find(VECTOR_DIM_KEY);
+    if (it == properties.end()) {
+        return Status::InvalidArgument(strings::Substitute("vector index $0 requires $1", index.index_name(),
+                                                           VECTOR_DIM_KEY));
+    }
+    int64_t dim = std::strtoll(it->second.c_str(), nullptr, 10);
+    if (dim <= 0 || dim > std::numeric_limits<uint16_t>::max()) {
+        return Status::InvalidArgument(strings::Substitute("invalid $0 of vector index: $1", VECTOR_DIM_KEY, it->second));
+    }
+    options.dim = dim;
+    it = properties.find(VECTOR_METRIC_TYPE_KEY);
+    if (it != properties.end()) {
+        if (it->second == "l2_distance") {
+            options.metric_type = L2_DISTANCE;
+        } else if (it->second == "cosine_similarity") {
+            options.metric_type = COSINE_SIMILARITY;
+        } else {
+            return Status::InvalidArgument(
+                    strings::Substitute("invalid $0 of vector index: $1", VECTOR_METRIC_TYPE_KEY, it->second));
+        }
+    }
+    it = properties.find(VECTOR_NUM_LISTS_KEY);
+    if (it != properties.end()) {
+        int64_t num_lists = std::strtoll(it->second.c_str(), nullptr, 10);
+        if (num_lists <= 0 || num_lists > std::numeric_limits<uint16_t>::max()) {
+            return Status::InvalidArgument(
+                    strings::Substitute("invalid $0 of vector index: $1", VECTOR_NUM_LISTS_KEY, it->second));
+        }
+        options.num_lists = num_lists;
+    }
+    return options;
+}
+
+Status VectorIndexWriter::add_values(const ArrayColumn& arrays, const uint8_t* nulls) {
+    const uint32_t dim = _options.dim;
+    const auto& offsets = arrays.offsets().get_data();
+    const Column& elements = arrays.elements();
+    const uint8_t* element_nulls = nullptr;
+    if (elements.is_nullable() && elements.has_null()) {
+        element_nulls = down_cast<const NullableColumn&>(elements).null_column_data().data();
+    }
+    const auto& values = down_cast<const FloatColumn*>(ColumnHelper::get_data_column(&elements))->get_data();
+    for (size_t i = 0; i < arrays.size(); i++, _next_rowid++) {
+        if (nulls != nullptr && nulls[i]) {
+            continue;
+        }
+        const uint32_t begin = offsets[i];
+        const uint32_t end = offsets[i + 1];
+        if (end - begin != dim) {
+            return Status::InvalidArgument(
+                    strings::Substitute("the vector index requires vectors of dimension $0, but got $1", dim,
+                                        end - begin));
+        }
+        if (element_nulls != nullptr &&
+            std::any_of(element_nulls + begin, element_nulls + end, [](uint8_t null) { return null != 0; })) {
+            return Status::InvalidArgument("the vector index does not support vectors with null elements");
+        }
+        _vectors.insert(_vectors.end(), values.begin() + begin, values.begin() + end);
+        float* vector = _vectors.data() + _vectors.size() - dim;
+        if (_options.metric_type == COSINE_SIMILARITY) {
+            normalize(vector, dim);
+        }
+        _rowids.push_back(_next_rowid);
+        if (!_centroids.empty()) {
+            float distance;
+            _lists.push_back(nearest_centroid(vector, _centroids.data(), _num_lists, dim, &distance));
+            _vectors.resize(_vectors.size() - dim);
+        } else if (_rowids.size() == kMaxTrainingVectors) {
+            _train_and_assign();
+        }
+    }
+    return Status::OK();
+}
+
+void VectorIndexWriter::_train_and_assign() {
+    const uint32_t dim = _options.dim;
+    const size_t num_vectors = _vectors.size() / dim;
+    uint32_t num_lists = _options.num_lists;
+    if (num_lists == 0) {
+        num_lists = std::min<size_t>(kMaxDefaultLists, std::sqrt(num_vectors));
+    }
+    // every list has one training vector at least, see _train()
+    _num_lists = std::min<size_t>(std::max<uint32_t>(num_lists, 1), num_vectors);
+    _centroids = _train(_num_lists);
+    for (size_t i = 0; i < num_vectors; i++) {
+        float distance;
+        _lists.push_back(nearest_centroid(_vectors.data() + i * dim, _centroids.data(), _num_lists, dim, &distance));
+    }
+    std::vector<float>().swap(_vectors);
+}
+
+std::vector<float> VectorIndexWriter::_train(uint32_t num_lists) const {
+    const uint32_t dim = _options.dim;
+    const size_t num_vectors = _vectors.size() / dim;
+    std::vector<const float*> samples(num_vectors);
+    for (size_t i = 0; i < num_vectors; i++) {
+        samples[i] = _vectors.data() + i * dim;
+    }
+    DCHECK_LE(num_lists, samples.size());
+
+    // farthest point initialization: the next centroid is the sample farthest from the chosen ones,
+    // which spreads the centroids over the clusters and keeps the index deterministic
+    std::vector<float> centroids(static_cast<size_t>(num_lists) * dim);
+    std::vector<float> distances(samples.size(), std::numeric_limits<float>::max());
+    size_t next = 0;
+    for (uint32_t c = 0; c < num_lists; c++) {
+        float* centroid = centroids.data() + static_cast<size_t>(c) * dim;
+        memcpy(centroid, samples[next], dim * sizeof(float));
+        for (size_t s = 0; s < samples.size(); s++) {
+            distances[s] = std::min(distances[s], l2_distance(samples[s], centroid, dim));
+            if (distances[s] > distances[next]) {
+                next = s;
+            }
+        }
+    }
+
+    std::vector<uint32_t> assignments(samples.size());
+    std::vector<uint32_t> counts(num_lists);
+    for (int iter = 0; iter < kTrainingIterations; iter++) {
+        for (size_t s = 0; s < samples.size(); s++) {
+            assignments[s] = nearest_centroid(samples[s], centroids.data(), num_lists, dim, &distances[s]);
+        }
+        std::fill(centroids.begin(), centroids.end(), 0);
+        std::fill(counts.begin(), counts.end(), 0);
+        for (size_t s = 0; s < samples.size(); s++) {
+            float* centroid = centroids.data() + static_cast<size_t>(assignments[s]) * dim;
+            for (uint32_t i = 0; i < dim; i++) {
+                centroid[i] += samples[s][i];
+            }
+            counts[assignments[s]]++;
+        }
+        for (uint32_t c = 0; c < num_lists; c++) {
+            float* centroid = centroids.data() + static_cast<size_t>(c) * dim;
+            if (counts[c] > 0) {
+                for (uint32_t i = 0; i < dim; i++) {
+                    centroid[i] /= counts[c];
+                }
+            } else {
+                // move the centroid of an empty cluster to the sample farthest from its centroid
+                size_t farthest = std::max_element(distances.begin(), distances.end()) - distances.begin();
+                memcpy(centroid, samples[farthest], dim * sizeof(float));
+                distances[farthest] = 0;
+            }
+        }
+    }
+    return centroids;
+}
+
+Status VectorIndexWriter::finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta) {
+    const uint32_t dim = _options.dim;
+    const size_t num_vectors = _rowids.size();
+    if (_centroids.empty() && num_vectors > 0) {
+        _train_and_assign();
+    }
+    DCHECK_EQ(num_vectors, _lists.size());
+    const uint32_t num_lists = _num_lists;
+    std::vector<uint32_t> offsets(num_lists + 1, 0);
+    for (uint32_t list : _lists) {
+        offsets[list + 1]++;
+    }
+    for (uint32_t c = 0; c < num_lists; c++) {
+        offsets[c + 1] += offsets[c];
+    }
+    // |_rowids| are ascending, so are the rowids of every list
+    std::vector<rowid_t> rowids(num_vectors);
+    std::vector<uint32_t> positions(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < num_vectors; i++) {
+        rowids[positions[_lists[i]]++] = _rowids[i];
+    }
+
+    std::vector<Slice> body{
+            Slice(reinterpret_cast<const uint8_t*>(_centroids.data()), _centroids.size() * sizeof(float)),
+            Slice(reinterpret_cast<const uint8_t*>(offsets.data()), offsets.size() * sizeof(uint32_t)),
+            Slice(reinterpret_cast<const uint8_t*>(rowids.data()), rowids.size() * sizeof(rowid_t))};
+    PageFooterPB footer;
+    footer.set_type(VECTOR_INDEX_PAGE);
+    footer.set_uncompressed_size(body[0].size + body[1].size + body[2].size);
+    PagePointer pp;
+    RETURN_IF_ERROR(PageIO::write_page(wfile, body, footer, &pp));
+
+    index_meta->set_type(VECTOR_INDEX);
+    VectorIndexPB* meta = index_meta->mutable_vector_index();
+    meta->set_dim(dim);
+    meta->set_num_lists(num_lists);
+    meta->set_metric_type(_options.metric_type);
+    pp.to_proto(meta->mutable_page());
+
+    std::vector<float>().swap(_centroids);
+    std::vector<rowid_t>().swap(_rowids);
+    std::vector<uint32_t>().swap(_lists);
+    return Status::OK();
+}
+
+VectorIndexReader::VectorIndexReader() {
+    MEM_TRACKER_SAFE_CONSUME(GlobalEnv::GetInstance()->vector_index_mem_tracker(), sizeof(VectorIndexReader));
+}
+
+VectorIndexReader::~VectorIndexReader() {
+    MEM_TRACKER_SAFE_RELEASE(GlobalEnv::GetInstance()->vector_index_mem_tracker(), mem_usage());
+}
+
+StatusOr<bool> VectorIndexReader::load(const IndexReadOptions& opts, const VectorIndexPB& meta) {
+    return success_once(_load_once, [&]() {
+        Status st = _do_load(opts, meta);
+        if (st.ok()) {
+            MEM_TRACKER_SAFE_CONSUME(GlobalEnv::GetInstance()->vector_index_mem_tracker(),
+                                     mem_usage() - sizeof(VectorIndexReader));
+        } else {
+            _reset();
+        }
+        return st;
+    });
+}
+
+Status VectorIndexReader::_do_load(const IndexReadOptions& opts, const VectorIndexPB& meta) {
+    PageReadOptions page_opts;
+    page_opts.read_file = opts.read_file;
+    page_opts.page_pointer = PagePointer(meta.page());
+    page_opts.codec = nullptr; // vector index page is not compressed
+    page_opts.stats = opts.stats;
+    page_opts.use_page_cache = opts.use_page_cache;
+    page_opts.kept_in_memory = opts.kept_in_memory;
+
+    PageHandle page_handle;
+    Slice body;
+    PageFooterPB footer;
+    RETURN_IF_ERROR(PageIO::read_and_decompress_page(page_opts, &page_handle, &body, &footer));
+
+    const size_t centroids_size = static_cast<size_t>(meta.num_lists()) * meta.dim() * sizeof(float);
+    const size_t offsets_size = (static_cast<size_t>(meta.num_lists()) + 1) * sizeof(uint32_t);
+    if (footer.type() != VECTOR_INDEX_PAGE || body.size < centroids_size + offsets_size) {
+        return Status::Corruption(
+                strings::Substitute("Bad vector index page, file=$0, size=$1", opts.read_file->filename(), body.size));
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(body.data);
+    _centroids.resize(centroids_size / sizeof(float));
+    memcpy(_centroids.data(), data, centroids_size);
+    _offsets.resize(meta.num_lists() + 1);
+    memcpy(_offsets.data(), data + centroids_size, offsets_size);
+    const size_t rowids_size = body.size - centroids_size - offsets_size;
+    if (_offsets.front() != 0 || !std::is_sorted(_offsets.begin(), _offsets.end()) ||
+        static_cast<size_t>(_offsets.back()) * sizeof(rowid_t) != rowids_size) {
+        return Status::Corruption(
+                strings::Substitute("Bad vector index page, invalid list offsets, file=$0", opts.read_file->filename()));
+    }
+    _rowids.resize(_offsets.back());
+    memcpy(_rowids.data(), data + centroids_size + offsets_size, rowids_size);
+    _dim = meta.dim();
+    _num_lists = meta.num_lists();
+    _metric_type = meta.metric_type();
+    return Status::OK();
+}
+
+void VectorIndexReader::_reset() {
+    _dim = 0;
+    _num_lists = 0;
+    _metric_type = L2_DISTANCE;
+    std::vector<float>().swap(_centroids);
+    std::vector<uint32_t>().swap(_offsets);
+    std::vector<rowid_t>().swap(_rowids);
+}
+
+void VectorIndexReader::search(const std::vector<float>& query, int32_t nprobe, std::vector<rowid_t>* rowids) const {
+    DCHECK_EQ(_dim, query.size());
+    rowids->clear();
+    if (_num_lists == 0) {
+        return;
+    }
+    std::vector<float> q(query);
+    if (_metric_type == COSINE_SIMILARITY) {
+        normalize(q.data(), _dim);
+    }
+    std::vector<std::pair<float, uint32_t>> lists(_num_lists);
+    for (uint32_t c = 0; c < _num_lists; c++) {
+        lists[c] = {l2_distance(q.data(), _centroids.data() + static_cast<size_t>(c) * _dim, _dim), c};
+    }
+    const size_t num_probes = std::clamp<int64_t>(nprobe, 1, _num_lists);
+    std::partial_sort(lists.begin(), lists.begin() + num_probes, lists.end());
+    for (size_t i = 0; i < num_probes; i++) {
+        uint32_t c = lists[i].second;
+        rowids->insert(rowids->end(), _rowids.begin() + _offsets[c], _rowids.begin() + _offsets[c + 1]);
+    }
+    std::sort(rowids->begin(), rowids->end());
+}
+
+float VectorIndexReader::distance(const float* query, const float* vector) const {
+    if (_metric_type == L2_DISTANCE) {
+        return l2_distance(query, vector, _dim);
+    }
+    float dot = 0;
+    float query_norm = 0;
+    float vector_norm = 0;
+    for (uint32_t i = 0; i < _dim; i++) {
+        dot += query[i] * vector[i];
+        query_norm += query[i] * query[i];
+        vector_norm += vector[i] * vector[i];
+    }
+    if (query_norm == 0 || vector_norm == 0) {
+        return 1;
+    }
+    return 1 - dot / std::sqrt(query_norm * vector_norm);
+}
+
+} // namespace starrocks
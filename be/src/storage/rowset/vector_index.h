@@ -0,0 +1,148 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/statusor.h"
+#include "gen_cpp/segment.pb.h"
+#include "storage/rowset/common.h"
+#include "storage/rowset/options.h"
+#include "util/once.h"
+
+namespace starrocks {
+
+class ArrayColumn;
+class TabletIndex;
+class WritableFile;
+
+static const std::string VECTOR_DIM_KEY = "dim";
+static const std::string VECTOR_METRIC_TYPE_KEY = "metric_type";
+static const std::string VECTOR_NUM_LISTS_KEY = "nlist";
+static const std::string VECTOR_NPROBE_KEY = "nprobe";
+
+struct VectorIndexOptions {
+    uint32_t dim = 0;
+    VectorMetricTypePB metric_type = L2_DISTANCE;
+    // number of the inverted lists, 0 means the square root of the number of vectors
+    uint32_t num_lists = 0;
+
+    // Parse the options from the index properties of a VECTOR index.
+    static StatusOr<VectorIndexOptions> create(const TabletIndex& index);
+};
+
+// The IVF index of an ARRAY<FLOAT> column in a segment. The vectors of the segment are clustered
+// by k-means, and the rowid of every vector is kept in the inverted list of its nearest centroid.
+// A search probes the lists of the centroids nearest to the query vector, and returns the rowids
+// in them as the candidates, which are re-ranked by the exact distances of their vectors read from
+// the column, so the vectors are not duplicated in the index.
+//
+// The index is a single page of the segment file:
+//     VectorIndexPage := Centroids, ListOffsets, RowIds
+//     - Centroids are num_lists * dim floats
+//     - ListOffsets are num_lists + 1 uint32, the rowids of list i are RowIds[ListOffsets[i], ListOffsets[i + 1])
+//     - RowIds are sorted in every list
+//
+// The vectors are normalized for COSINE_SIMILARITY, so the nearest vectors by L2 distance are the most
+// similar ones.
+class VectorIndexWriter {
+public:
+    explicit VectorIndexWriter(const VectorIndexOptions& options) : _options(options) {}
+
+    // |nulls| is the null flags of |arrays|, nullptr if not nullable. Null arrays are not indexed,
+    // arrays of a different dimension or with null elements are rejected.
+    Status add_values(const ArrayColumn& arrays, const uint8_t* nulls);
+
+    Status finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const {
+        return (_vectors.size() + _centroids.size()) * sizeof(float) + _rowids.size() * sizeof(rowid_t) +
+               _lists.size() * sizeof(uint32_t);
+    }
+
+    // k-means is trained on the first vectors of a segment, which are buffered until then, the following
+    // vectors are assigned to their lists as they are added, so the memory of a large segment is bounded.
+    static constexpr size_t kMaxTrainingVectors = 32768;
+
+private:
+    // Train the centroids on the buffered vectors, and assign them to their lists.
+    void _train_and_assign();
+
+    // Return the centroids of |num_lists| clusters of the buffered vectors.
+    std::vector<float> _train(uint32_t num_lists) const;
+
+    static constexpr int kTrainingIterations = 10;
+    static constexpr uint32_t kMaxDefaultLists = 1024;
+
+    const VectorIndexOptions _options;
+    rowid_t _next_rowid = 0;
+    // the vectors until the centroids are trained
+    std::vector<float> _vectors;
+    // the rowid and the list of every vector, the lists are known after the centroids are trained
+    std::vector<rowid_t> _rowids;
+    std::vector<uint32_t> _lists;
+    uint32_t _num_lists = 0;
+    std::vector<float> _centroids;
+};
+
+class VectorIndexReader {
+public:
+    VectorIndexReader();
+    ~VectorIndexReader();
+
+    // Multiple callers may call this method concurrently, but only the first one
+    // can load the data, the others will wait until the first one finished loading
+    // data.
+    //
+    // Return true if the index data was successfully loaded by the caller, false if
+    // the data was loaded by another caller.
+    StatusOr<bool> load(const IndexReadOptions& opts, const VectorIndexPB& meta);
+
+    bool loaded() const { return invoked(_load_once); }
+
+    uint32_t dim() const { return _dim; }
+
+    VectorMetricTypePB metric_type() const { return _metric_type; }
+
+    // Set |rowids| to the sorted rowids in the |nprobe| lists whose centroids are nearest to |query|.
+    // REQUIRES: the index data has been successfully `load()`ed into memory.
+    void search(const std::vector<float>& query, int32_t nprobe, std::vector<rowid_t>* rowids) const;
+
+    // The distance between |query| and |vector| by the metric of the index, a smaller distance means
+    // a nearer vector: the squared L2 distance for L2_DISTANCE, 1 - cosine similarity for COSINE_SIMILARITY.
+    float distance(const float* query, const float* vector) const;
+
+    size_t mem_usage() const {
+        return sizeof(VectorIndexReader) + _centroids.size() * sizeof(float) + _offsets.size() * sizeof(uint32_t) +
+               _rowids.size() * sizeof(rowid_t);
+    }
+
+private:
+    Status _do_load(const IndexReadOptions& opts, const VectorIndexPB& meta);
+
+    void _reset();
+
+    OnceFlag _load_once;
+    uint32_t _dim = 0;
+    uint32_t _num_lists = 0;
+    VectorMetricTypePB _metric_type = L2_DISTANCE;
+    std::vector<float> _centroids;
+    std::vector<uint32_t> _offsets;
+    std::vector<rowid_t> _rowids;
+};
+
+} // namespace starrocks
@@ -0,0 +1,38 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+// `ORDER BY distance(column, query_vector) LIMIT k` of a scan, which is answered by the vector
+// index of |column_id|: every segment returns only its |k| nearest rows among the candidates of
+// the index, and the top-k of the query is merged from them by the sort operator above the scan.
+//
+// The rows filtered by other predicates or runtime filters, or merged with the rows of the same key,
+// could leave less than k rows of a segment, so the option is ignored by such scans and segments.
+struct VectorSearchOption {
+    ColumnId column_id = 0;
+    std::vector<float> query_vector;
+    int64_t k = 0;
+    // number of the inverted lists to probe
+    int32_t nprobe = 1;
+};
+
+} // namespace starrocks
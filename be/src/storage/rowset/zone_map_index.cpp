@@ -36,12 +36,17 @@
 
 #include <bthread/sys_futex.h>
 
+#include <algorithm>
+#include <limits>
+
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "common/config.h"
 #include "storage/chunk_helper.h"
 #include "storage/decimal_type_info.h"
 #include "storage/olap_define.h"
 #include "storage/olap_type_infra.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/encoding_info.h"
 #include "storage/rowset/indexed_column_reader.h"
 #include "storage/rowset/indexed_column_writer.h"
@@ -145,16 +150,36 @@ public:
 
     void add_values(const void* values, size_t count) override;
 
-    void add_nulls(uint32_t count) override { _page_zone_map.has_null |= count > 0; }
+    void add_nulls(uint32_t count) override {
+        _page_zone_map.has_null |= count > 0;
+        if constexpr (kSupportRowBlock) {
+            _add_row_block_nulls(count);
+        }
+    }
 
     // mark the end of one data page so that we can finalize the corresponding zone map
     Status flush() override;
 
+    bool support_page_zone_map() const override { return kSupportPageZoneMap && _row_block_size == 0; }
+
+    Status add_page_zone_map(const ZoneMapPB& page_zone_map) override;
+
     Status finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta) override;
 
     uint64_t size() const override { return _estimated_size; }
 
 private:
+    // the row-block zone maps are only written for the types which can be pruned by EncodedValueRange
+    static constexpr bool kSupportRowBlock = is_encoded_value_type<type>();
+    // the zone maps of the pages are only parsed back for the types whose zone map strings are exact
+    static constexpr bool kSupportPageZoneMap = type == TYPE_BOOLEAN || type == TYPE_TINYINT ||
+                                                type == TYPE_SMALLINT || type == TYPE_INT || type == TYPE_BIGINT ||
+                                                type == TYPE_LARGEINT || type == TYPE_DATE;
+
+    void _add_row_block_values(const CppType* values, size_t count);
+    void _add_row_block_nulls(size_t count);
+    void _flush_row_block();
+
     void _reset_zone_map(ZoneMap<type>* zone_map) {
         // we should allocate max varchar length and set to max for min value
         zone_map->min_value.reset(_type_info);
@@ -171,12 +196,72 @@ private:
     // serialized ZoneMapPB for each data page
     std::vector<std::string> _values;
     uint64_t _estimated_size = 0;
+
+    // 0 if the row-block zone maps are not written
+    uint32_t _row_block_size = 0;
+    uint32_t _rows_in_block = 0;
+    CppType _block_min{};
+    CppType _block_max{};
+    std::vector<CppType> _row_block_mins;
+    std::vector<CppType> _row_block_maxs;
 };
 
 template <LogicalType type>
 ZoneMapIndexWriterImpl<type>::ZoneMapIndexWriterImpl(TypeInfo* type_info) : _type_info(type_info) {
     _reset_zone_map(&_page_zone_map);
     _reset_zone_map(&_segment_zone_map);
+    if constexpr (kSupportRowBlock) {
+        _row_block_size = std::max(config::zone_map_row_block_size, 0);
+        _block_min = std::numeric_limits<CppType>::max();
+        _block_max = std::numeric_limits<CppType>::lowest();
+    }
+}
+
+template <LogicalType type>
+void ZoneMapIndexWriterImpl<type>::_add_row_block_values(const CppType* values, size_t count) {
+    if (_row_block_size == 0) {
+        return;
+    }
+    while (count > 0) {
+        size_t n = std::min<size_t>(count, _row_block_size - _rows_in_block);
+        for (size_t i = 0; i < n; i++) {
+            CppType v = unaligned_load<CppType>(values + i);
+            _block_min = std::min(_block_min, v);
+            _block_max = std::max(_block_max, v);
+        }
+        _rows_in_block += n;
+        if (_rows_in_block == _row_block_size) {
+            _flush_row_block();
+        }
+        values += n;
+        count -= n;
+    }
+}
+
+template <LogicalType type>
+void ZoneMapIndexWriterImpl<type>::_add_row_block_nulls(size_t count) {
+    if (_row_block_size == 0) {
+        return;
+    }
+    while (count > 0) {
+        size_t n = std::min<size_t>(count, _row_block_size - _rows_in_block);
+        _rows_in_block += n;
+        if (_rows_in_block == _row_block_size) {
+            _flush_row_block();
+        }
+        count -= n;
+    }
+}
+
+template <LogicalType type>
+void ZoneMapIndexWriterImpl<type>::_flush_row_block() {
+    // the min is greater than the max if all rows of the block are null
+    _row_block_mins.push_back(_block_min);
+    _row_block_maxs.push_back(_block_max);
+    _estimated_size += 2 * sizeof(CppType);
+    _rows_in_block = 0;
+    _block_min = std::numeric_limits<CppType>::max();
+    _block_max = std::numeric_limits<CppType>::lowest();
 }
 
 template <LogicalType type>
@@ -202,6 +287,9 @@ void ZoneMapIndexWriterImpl<type>::add_values(const void* values, size_t count)
             _type_info->direct_copy(&_page_zone_map.max_value.value, pmax);
         }
         _page_zone_map.has_not_null = true;
+        if constexpr (kSupportRowBlock) {
+            _add_row_block_values(vals, count);
+        }
     }
 }
 
@@ -246,6 +334,21 @@ Status ZoneMapIndexWriterImpl<type>::flush() {
     return Status::OK();
 }
 
+template <LogicalType type>
+Status ZoneMapIndexWriterImpl<type>::add_page_zone_map(const ZoneMapPB& page_zone_map) {
+    if (!support_page_zone_map()) {
+        return Status::NotSupported("the page zone map can't be added without the values");
+    }
+    DCHECK(!_page_zone_map.has_null && !_page_zone_map.has_not_null);
+    if (page_zone_map.has_not_null()) {
+        RETURN_IF_ERROR(_type_info->from_string(&_page_zone_map.min_value.value, page_zone_map.min()));
+        RETURN_IF_ERROR(_type_info->from_string(&_page_zone_map.max_value.value, page_zone_map.max()));
+        _page_zone_map.has_not_null = true;
+    }
+    _page_zone_map.has_null = page_zone_map.has_null();
+    return flush();
+}
+
 struct ZoneMapIndexWriterBuilder {
     template <LogicalType ftype>
     std::unique_ptr<ZoneMapIndexWriter> operator()(TypeInfo* type_info) {
@@ -263,6 +366,17 @@ Status ZoneMapIndexWriterImpl<type>::finish(WritableFile* wfile, ColumnIndexMeta
     ZoneMapIndexPB* meta = index_meta->mutable_zone_map_index();
     // store segment zone map
     _segment_zone_map.to_proto(meta->mutable_segment_zone_map(), _type_info);
+    // store row-block zone maps
+    if constexpr (kSupportRowBlock) {
+        if (_rows_in_block > 0) {
+            _flush_row_block();
+        }
+        if (!_row_block_mins.empty()) {
+            meta->set_row_block_size(_row_block_size);
+            meta->set_row_block_min_values(_row_block_mins.data(), _row_block_mins.size() * sizeof(CppType));
+            meta->set_row_block_max_values(_row_block_maxs.data(), _row_block_maxs.size() * sizeof(CppType));
+        }
+    }
 
     // write out zone map for each data pages
     TypeInfoPtr typeinfo = get_type_info(TYPE_OBJECT);
@@ -338,14 +452,77 @@ Status ZoneMapIndexReader::_do_load(const IndexReadOptions& opts, const ZoneMapI
         }
         column->resize(0);
     }
+
+    if (meta.row_block_size() > 0) {
+        if (meta.row_block_min_values().size() != meta.row_block_max_values().size()) {
+            return Status::Corruption("Invalid row-block zone maps");
+        }
+        _row_block_size = meta.row_block_size();
+        _row_block_min_values = meta.row_block_min_values();
+        _row_block_max_values = meta.row_block_max_values();
+    }
     return Status::OK();
 }
 
+template <LogicalType Type>
+static void select_row_blocks(const EncodedPredicates& predicates, const std::string& mins, const std::string& maxs,
+                              std::vector<uint8_t>* selection) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    selection->resize(mins.size() / sizeof(CppType));
+    EncodedValueRange<Type>(predicates).evaluate_zone_maps(mins.data(), maxs.data(), selection->size(),
+                                                           selection->data());
+}
+
+void ZoneMapIndexReader::filter_row_blocks(LogicalType type, const EncodedPredicates& predicates,
+                                           SparseRange<>* row_ranges) const {
+    DCHECK(has_row_block_zone_maps());
+    std::vector<uint8_t> selection;
+    switch (type) {
+#define SELECT_ROW_BLOCKS(T)                                                                        \
+    case T:                                                                                         \
+        select_row_blocks<T>(predicates, _row_block_min_values, _row_block_max_values, &selection); \
+        break;
+        SELECT_ROW_BLOCKS(TYPE_TINYINT)
+        SELECT_ROW_BLOCKS(TYPE_SMALLINT)
+        SELECT_ROW_BLOCKS(TYPE_INT)
+        SELECT_ROW_BLOCKS(TYPE_BIGINT)
+        SELECT_ROW_BLOCKS(TYPE_LARGEINT)
+        SELECT_ROW_BLOCKS(TYPE_FLOAT)
+        SELECT_ROW_BLOCKS(TYPE_DOUBLE)
+        SELECT_ROW_BLOCKS(TYPE_DATE)
+        SELECT_ROW_BLOCKS(TYPE_DATETIME)
+        SELECT_ROW_BLOCKS(TYPE_DECIMAL32)
+        SELECT_ROW_BLOCKS(TYPE_DECIMAL64)
+        SELECT_ROW_BLOCKS(TYPE_DECIMAL128)
+#undef SELECT_ROW_BLOCKS
+    default:
+        return;
+    }
+
+    SparseRange<> block_ranges;
+    const size_t num_blocks = selection.size();
+    size_t i = 0;
+    while (i < num_blocks) {
+        while (i < num_blocks && !selection[i]) {
+            i++;
+        }
+        size_t begin = i;
+        while (i < num_blocks && selection[i]) {
+            i++;
+        }
+        if (i > begin) {
+            block_ranges.add(Range<>(begin * _row_block_size, i * _row_block_size));
+        }
+    }
+    *row_ranges = row_ranges->intersection(block_ranges);
+}
+
 size_t ZoneMapIndexReader::mem_usage() const {
     size_t size = sizeof(ZoneMapIndexReader);
     for (const auto& zone_map : _page_zone_maps) {
         size += zone_map.SpaceUsedLong();
     }
+    size += _row_block_min_values.capacity() + _row_block_max_values.capacity();
     return size;
 }
 
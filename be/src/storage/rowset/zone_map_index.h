@@ -43,12 +43,15 @@
 #include "gen_cpp/segment.pb.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "storage/range.h"
 #include "storage/rowset/binary_plain_page.h"
+#include "types/logical_type.h"
 #include "util/once.h"
 #include "util/slice.h"
 
 namespace starrocks {
 
+class EncodedPredicates;
 class FileSystem;
 class WritableFile;
 
@@ -69,6 +72,12 @@ public:
     // mark the end of one data page so that we can finalize the corresponding zone map
     virtual Status flush() = 0;
 
+    // Whether add_page_zone_map() is supported, i.e. the zone maps don't need the values of the pages.
+    virtual bool support_page_zone_map() const = 0;
+
+    // Adds the zone map of a whole data page whose values are not added, e.g. a page copied from another segment.
+    virtual Status add_page_zone_map(const ZoneMapPB& page_zone_map) = 0;
+
     virtual Status finish(WritableFile* wfile, ColumnIndexMetaPB* index_meta) = 0;
 
     virtual uint64_t size() const = 0;
@@ -97,15 +106,32 @@ public:
 
     bool loaded() const { return invoked(_load_once); }
 
+    // REQUIRES: the index data has been successfully `load()`ed into memory.
+    bool has_row_block_zone_maps() const { return _row_block_size > 0; }
+
+    // Remove the row blocks from |row_ranges| whose min and max values do not satisfy |predicates|.
+    // |type| is the type of the column.
+    // REQUIRES: has_row_block_zone_maps().
+    void filter_row_blocks(LogicalType type, const EncodedPredicates& predicates, SparseRange<>* row_ranges) const;
+
     size_t mem_usage() const;
 
 private:
-    void _reset() { std::vector<ZoneMapPB>{}.swap(_page_zone_maps); }
+    void _reset() {
+        std::vector<ZoneMapPB>{}.swap(_page_zone_maps);
+        _row_block_size = 0;
+        std::string{}.swap(_row_block_min_values);
+        std::string{}.swap(_row_block_max_values);
+    }
 
     Status _do_load(const IndexReadOptions& opts, const ZoneMapIndexPB& meta);
 
     OnceFlag _load_once;
     std::vector<ZoneMapPB> _page_zone_maps;
+    // see ZoneMapIndexPB::row_block_size
+    uint32_t _row_block_size = 0;
+    std::string _row_block_min_values;
+    std::string _row_block_max_values;
 };
 
 } // namespace starrocks
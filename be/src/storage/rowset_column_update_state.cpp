@@ -14,6 +14,8 @@
 
 #include "rowset_column_update_state.h"
 
+#include <unordered_set>
+
 #include "common/tracer.h"
 #include "fs/fs_util.h"
 #include "gutil/strings/substitute.h"
@@ -27,6 +29,7 @@
 #include "storage/rowset/rowset_options.h"
 #include "storage/rowset/segment_options.h"
 #include "storage/rowset/segment_rewriter.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
 #include "storage/update_manager.h"
@@ -756,6 +759,29 @@ Status RowsetColumnUpdateState::finalize(Tablet* tablet, Rowset* rowset, uint32_
         // 3.7. reclaim update chunk cache
         reclaim_update_cache_fn(false);
     }
+    // 3.8 column-only compaction of segments with too many delta column groups
+    // It's done here rather than by a background task because the delta column groups of a segment are only
+    // replaced by an apply: the consolidated columns become the `.cols` files of this version in the same meta
+    // commit, while a background rewrite would need its own version and could race with the next applies. The
+    // cost is reading and writing the carried columns of a few segments, in the apply thread and under the
+    // index lock of the tablet, so the number of segments consolidated by one apply is bounded.
+    if (config::partial_update_column_mode_dcg_consolidate_threshold > 0) {
+        int64_t t1 = MonotonicMillis();
+        int32_t num_consolidated = 0;
+        for (const auto& each : rss_rowid_to_update_rowid) {
+            if (num_consolidated >= config::partial_update_column_mode_dcg_consolidate_max_segments) {
+                break;
+            }
+            ASSIGN_OR_RETURN(bool consolidated,
+                             _consolidate_delta_column_groups(tablet, rowset, each.first, latest_applied_version,
+                                                              unique_update_column_ids, idx, &stats, tracker,
+                                                              &dcg_column_ids[each.first],
+                                                              &dcg_column_files[each.first]));
+            num_consolidated += consolidated;
+        }
+        cost_str << " [consolidate delta column group] segments:" << num_consolidated << " cost(ms):"
+                 << MonotonicMillis() - t1;
+    }
     // 4 generate delta columngroup
     for (const auto& each : rss_rowid_to_update_rowid) {
         update_rows += each.second.size();
@@ -791,6 +817,81 @@ Status RowsetColumnUpdateState::finalize(Tablet* tablet, Rowset* rowset, uint32_
     return Status::OK();
 }
 
+StatusOr<bool> RowsetColumnUpdateState::_consolidate_delta_column_groups(
+        Tablet* tablet, Rowset* rowset, uint32_t rssid, EditVersion latest_applied_version,
+        const std::vector<uint32_t>& update_column_uids, int idx, OlapReaderStatistics* stats, MemTracker* tracker,
+        std::vector<std::vector<uint32_t>>* dcg_column_ids, std::vector<std::string>* dcg_column_files) {
+    DeltaColumnGroupList dcgs;
+    TabletSegmentId tsid(tablet->tablet_id(), rssid);
+    RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_delta_column_group(
+            tablet->data_dir()->get_meta(), tsid, latest_applied_version.major_number(), &dcgs));
+    const auto& tschema = rowset->schema();
+    // dcgs are ordered from new to old, a dcg is live if some of its columns are not covered by newer ones
+    std::unordered_set<uint32_t> covered_uids;
+    std::vector<int32_t> carry_column_ids;
+    std::vector<uint32_t> carry_column_uids;
+    size_t num_live_dcgs = 0;
+    for (const auto& dcg : dcgs) {
+        bool live = false;
+        for (const auto& uids : dcg->column_ids()) {
+            for (uint32_t uid : uids) {
+                if (!covered_uids.insert(uid).second) {
+                    continue;
+                }
+                live = true;
+                auto cid = tschema->field_index(uid);
+                // skip the columns written by this update and the ones dropped by schema change
+                if (cid == -1 || std::find(update_column_uids.begin(), update_column_uids.end(), uid) !=
+                                         update_column_uids.end()) {
+                    continue;
+                }
+                carry_column_ids.push_back(cid);
+                carry_column_uids.push_back(uid);
+            }
+        }
+        num_live_dcgs += live;
+    }
+    // the delta column group generated by this update will be one more
+    if (num_live_dcgs + 1 < static_cast<size_t>(config::partial_update_column_mode_dcg_consolidate_threshold)) {
+        return false;
+    }
+    if (carry_column_ids.empty()) {
+        return false;
+    }
+    ASSIGN_OR_RETURN(auto rowsetid_segid, _find_rowset_seg_id(rssid));
+    const std::string seg_path = Rowset::segment_file_path(rowset->rowset_path(), rowsetid_segid.unique_rowset_id,
+                                                           rowsetid_segid.segment_id);
+    const size_t batch_size = config::vertical_compaction_max_columns_per_group;
+    for (size_t col_index = 0; col_index < carry_column_ids.size(); col_index += batch_size, idx++) {
+        std::vector<int32_t> selective_column_ids = append_fixed_batch(carry_column_ids, col_index, batch_size);
+        std::vector<uint32_t> selective_column_uids = append_fixed_batch(carry_column_uids, col_index, batch_size);
+        std::vector<uint32_t> selective_cids(selective_column_ids.begin(), selective_column_ids.end());
+        auto partial_tschema = TabletSchema::create(tschema, selective_column_ids);
+        Schema partial_schema = ChunkHelper::convert_schema(tschema, selective_cids);
+        // the source segment read with delta column groups gives the latest values of these columns
+        ASSIGN_OR_RETURN(auto source_chunk_ptr,
+                         read_from_source_segment(rowset, partial_schema, tablet, stats,
+                                                  latest_applied_version.major_number(), rowsetid_segid, seg_path));
+        const size_t source_chunk_size = source_chunk_ptr->memory_usage();
+        tracker->consume(source_chunk_size);
+        DeferOp tracker_defer([&]() { tracker->release(source_chunk_size); });
+        padding_char_columns(partial_schema, partial_tschema, source_chunk_ptr.get());
+        uint64_t segment_file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        ASSIGN_OR_RETURN(auto writer,
+                         _prepare_delta_column_group_writer(rowset, partial_tschema, rssid,
+                                                            latest_applied_version.major_number() + 1, idx));
+        RETURN_IF_ERROR(writer->append_chunk(*source_chunk_ptr));
+        RETURN_IF_ERROR(writer->finalize(&segment_file_size, &index_size, &footer_position));
+        dcg_column_ids->push_back(selective_column_uids);
+        dcg_column_files->push_back(file_name(writer->segment_path()));
+    }
+    VLOG(1) << "consolidate delta column groups tablet:" << tablet->tablet_id() << " rssid:" << rssid
+            << " live dcgs:" << num_live_dcgs << " carried columns:" << carry_column_ids.size();
+    return true;
+}
+
 Status RowsetColumnUpdateState::_init_rowset_seg_id(Tablet* tablet) {
     std::vector<RowsetSharedPtr> rowsets;
     int64_t version;
@@ -171,6 +171,19 @@ private:
     StatusOr<std::unique_ptr<SegmentWriter>> _prepare_delta_column_group_writer(
             Rowset* rowset, const std::shared_ptr<TabletSchema>& tschema, uint32_t rssid, int64_t ver, int idx);
 
+    // Column-only compaction of a segment's delta column groups: rewrite the columns still served by older
+    // delta column groups into new `.cols` files of this version, so that reads of the segment only open the
+    // newest delta column group and the older ones are reclaimed by dcg gc without a full rowset compaction.
+    // |update_column_uids| : unique ids of columns already written by this update
+    // |idx| : first `.cols` filename suffix can be used
+    // Returns whether the segment is consolidated.
+    StatusOr<bool> _consolidate_delta_column_groups(Tablet* tablet, Rowset* rowset, uint32_t rssid,
+                                                    EditVersion latest_applied_version,
+                                                    const std::vector<uint32_t>& update_column_uids, int idx,
+                                                    OlapReaderStatistics* stats, MemTracker* tracker,
+                                                    std::vector<std::vector<uint32_t>>* dcg_column_ids,
+                                                    std::vector<std::string>* dcg_column_files);
+
     // to build `_partial_update_states`
     Status _prepare_partial_update_states(Tablet* tablet, Rowset* rowset, uint32_t start_idx, uint32_t end_idx,
                                           bool need_lock);
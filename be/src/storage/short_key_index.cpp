@@ -97,6 +97,13 @@ Status ShortKeyIndexDecoder::parse(const Slice& body, const ShortKeyFooterPB& fo
     if (offset_slice.size != 0) {
         return Status::Corruption("Still has data after parse all key offset");
     }
+
+    if (_footer.has_learned_key_index()) {
+        _learned_key_index = std::make_unique<LearnedKeyIndex>();
+        RETURN_IF_ERROR(_learned_key_index->parse(_footer.learned_key_index(), _footer.num_segment_rows()));
+        // the model is kept by |_learned_key_index| only
+        _footer.clear_learned_key_index();
+    }
     _parsed = true;
     return Status::OK();
 }
@@ -36,11 +36,13 @@
 
 #include <cstdint>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment.pb.h"
+#include "storage/learned_key_index.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -215,9 +217,16 @@ public:
         return {_key_data.data + _offsets[ordinal], _offsets[ordinal + 1] - _offsets[ordinal]};
     }
 
+    // Return nullptr if the segment has no learned key index.
+    const LearnedKeyIndex* learned_key_index() const {
+        DCHECK(_parsed);
+        return _learned_key_index.get();
+    }
+
     int64_t mem_usage() const {
         return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + _key_data.size +
-               _footer.ByteSizeLong() - sizeof(_footer);
+               _footer.ByteSizeLong() - sizeof(_footer) +
+               (_learned_key_index != nullptr ? _learned_key_index->mem_usage() : 0);
     }
 
 private:
@@ -237,6 +246,7 @@ private:
     ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
     Slice _key_data;
+    std::unique_ptr<LearnedKeyIndex> _learned_key_index;
 };
 
 inline Slice ShortKeyIndexIterator::operator*() const {
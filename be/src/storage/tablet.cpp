@@ -50,6 +50,7 @@
 #include "storage/binlog_builder.h"
 #include "storage/compaction_candidate.h"
 #include "storage/compaction_context.h"
+#include "storage/compaction_cost_model.h"
 #include "storage/compaction_manager.h"
 #include "storage/compaction_task.h"
 #include "storage/default_compaction_policy.h"
@@ -1672,6 +1673,21 @@ int64_t Tablet::data_size() {
     }
 }
 
+void Tablet::record_scan() {
+    std::lock_guard lock(_scan_heat_lock);
+    int64_t now_ms = UnixMillis();
+    _scan_heat = CompactionCostModel::decay_scan_heat(_scan_heat, now_ms - _scan_heat_update_ms,
+                                                      config::compaction_scan_heat_half_life_sec) +
+                 1;
+    _scan_heat_update_ms = now_ms;
+}
+
+double Tablet::scan_heat() {
+    std::lock_guard lock(_scan_heat_lock);
+    return CompactionCostModel::decay_scan_heat(_scan_heat, UnixMillis() - _scan_heat_update_ms,
+                                                config::compaction_scan_heat_half_life_sec);
+}
+
 int64_t Tablet::in_writing_data_size() {
     int64_t size = 0;
     std::shared_lock rdlock(_meta_lock);
@@ -317,6 +317,13 @@ public:
 
     void remove_in_writing_data_size(int64_t txn_id);
 
+    // Records a query scan of this tablet, the cost based compaction scheduler favors the
+    // tablets that are scanned frequently.
+    void record_scan();
+
+    // Number of recent scans, decayed by `config::compaction_scan_heat_half_life_sec`.
+    double scan_heat();
+
     // verify all rowsets of current(max) version in this tablet
     [[nodiscard]] Status verify();
 
@@ -419,6 +426,10 @@ private:
     // used for default base cumulative compaction strategy to control the
     bool _has_running_compaction = false;
 
+    std::mutex _scan_heat_lock;
+    double _scan_heat = 0;
+    int64_t _scan_heat_update_ms = 0;
+
     // if this tablet is broken, set to true. default is false
     // timestamp of last cumu compaction failure
     std::atomic<int64_t> _last_cumu_compaction_failure_millis{0};
@@ -41,6 +41,7 @@
 
 #include <boost/algorithm/string/trim.hpp>
 #include <fstream>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -888,7 +889,7 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
     for (auto& rssid_delvec : delvecs) {
         tsid.segment_id = rssid_delvec.first;
         auto dv_key = encode_del_vector_key(tsid.tablet_id, tsid.segment_id, version.major_number());
-        auto dv_value = rssid_delvec.second->save();
+        auto dv_value = rssid_delvec.second->save_incremental();
         total_bytes += dv_value.size();
         st = batch.Put(handle, dv_key, dv_value);
         if (!st.ok()) {
@@ -969,7 +970,7 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
     for (auto& rssid_delvec : delvecs) {
         tsid.segment_id = rssid_delvec.first;
         auto dv_key = encode_del_vector_key(tsid.tablet_id, tsid.segment_id, version.major_number());
-        auto dv_value = rssid_delvec.second->save();
+        auto dv_value = rssid_delvec.second->save_incremental();
         st = batch.Put(handle, dv_key, dv_value);
         if (!st.ok()) {
             LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed, tablet_id: " << tablet_id;
@@ -1043,6 +1044,7 @@ Status TabletMetaManager::get_del_vector(KVStore* meta, TTabletId tablet_id, uin
     std::string upper = encode_del_vector_key(tablet_id, segment_id, 0);
 
     Status st;
+    Status load_st;
     bool found = false;
     bool first = true;
     auto traverse_versions = [&](std::string_view key, std::string_view value) -> bool {
@@ -1052,12 +1054,25 @@ Status TabletMetaManager::get_del_vector(KVStore* meta, TTabletId tablet_id, uin
             *latest_version = cv;
             first = false;
         }
-        if (version >= cv) {
-            st = delvec->load(cv, value.data(), value.size());
-            found = true;
-            return false;
+        if (!found) {
+            if (version >= cv) {
+                load_st = delvec->load(cv, value.data(), value.size());
+                found = true;
+                return load_st.ok() && delvec->has_pending_base();
+            }
+            return true;
         }
-        return true;
+        // The found delvec is a delta, keep walking towards older versions and merge its bases
+        // until a full checkpoint is reached.
+        if (cv > delvec->pending_base_version()) {
+            return true;
+        }
+        DelVector base;
+        load_st = base.load(cv, value.data(), value.size());
+        if (load_st.ok()) {
+            load_st = delvec->merge_base(base);
+        }
+        return load_st.ok() && delvec->has_pending_base();
     };
     st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper, traverse_versions);
     if (!st.ok()) {
@@ -1069,6 +1084,15 @@ Status TabletMetaManager::get_del_vector(KVStore* meta, TTabletId tablet_id, uin
         return Status::NotFound(strings::Substitute("no delete vector found tablet:$0 segment:$1 version:$2", tablet_id,
                                                     segment_id, version));
     }
+    if (load_st.ok() && delvec->has_pending_base()) {
+        load_st = Status::Corruption(strings::Substitute("missing base delete vector tablet:$0 segment:$1 version:$2",
+                                                         tablet_id, segment_id, delvec->pending_base_version()));
+    }
+    if (!load_st.ok()) {
+        LOG(WARNING) << "fail to load delvec. tablet_id=" << tablet_id << " segment_id=" << segment_id
+                     << " error_code=" << load_st.to_string();
+        return load_st;
+    }
     VLOG(3) << strings::Substitute("get_del_vec in-meta tablet_id=$0 segment_id=$1 version=$2 actual_version=$3",
                                    tablet_id, segment_id, version, delvec ? delvec->version() : -1);
     return st;
@@ -1134,7 +1158,8 @@ StatusOr<size_t> TabletMetaManager::delete_del_vector_before_version(KVStore* me
     DeleteVectorList ret;
     std::string lower = encode_del_vector_key(tablet_id, 0, INT64_MAX);
     std::string upper = encode_del_vector_key(tablet_id, UINT32_MAX, 0);
-    std::map<uint32_t, std::vector<int64_t>> segments;
+    // segment id => [(version, base version)], base version is -1 for full checkpoints
+    std::map<uint32_t, std::vector<std::pair<int64_t, int64_t>>> segments;
     auto st = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper,
                                   [&](std::string_view key, std::string_view value) -> bool {
                                       TTabletId dummy;
@@ -1142,7 +1167,8 @@ StatusOr<size_t> TabletMetaManager::delete_del_vector_before_version(KVStore* me
                                       int64_t version;
                                       decode_del_vector_key(key, &dummy, &segment_id, &version);
                                       DCHECK_EQ(tablet_id, dummy);
-                                      segments[segment_id].push_back(version);
+                                      segments[segment_id].emplace_back(
+                                              version, DelVector::parse_base_version(value.data(), value.size()));
                                       return true;
                                   });
     if (!st.ok()) {
@@ -1157,8 +1183,10 @@ StatusOr<size_t> TabletMetaManager::delete_del_vector_before_version(KVStore* me
         auto& versions = segment.second;
         bool del = false;
         bool added = false;
-        for (long i : versions) {
-            if (del) {
+        // bases of the delta delvecs that are kept, versions are visited in descending order
+        std::set<int64_t> required_bases;
+        for (auto [i, base_version] : versions) {
+            if (del && required_bases.erase(i) == 0) {
                 std::string key = encode_del_vector_key(tablet_id, segment.first, i);
                 rocksdb::Status st = batch.Delete(cf_handle, key);
                 if (!st.ok()) {
@@ -1171,10 +1199,14 @@ StatusOr<size_t> TabletMetaManager::delete_del_vector_before_version(KVStore* me
                 } else {
                     vlog_delvec_maplist << "," << i;
                 }
+                continue;
             } else if (i <= version) {
                 // versions after this version can be deleted
                 del = true;
             }
+            if (base_version >= 0) {
+                required_bases.insert(base_version);
+            }
         }
     }
     RETURN_IF_ERROR(meta->write_batch(&batch));
@@ -211,6 +211,8 @@ public:
     // suppose we have delete vectors of version 1, 3, 5, 6, 7, 12, 16
     // min queryable version is 10, which require delvector of version 7
     // delvector of versin < 7 can be deleted, that is [1,3,5,6]
+    // delta delvecs keep their bases back to the last full checkpoint, e.g. if 7 is a delta of 6
+    // and 6 is a delta of the checkpoint 5, only [1,3] are deleted
     // return num of del vector deleted
     static StatusOr<size_t> delete_del_vector_before_version(KVStore* meta, TTabletId tablet_id, int64_t version);
 
@@ -37,6 +37,8 @@ struct RowidRangeOption;
 using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
 struct ShortKeyRangesOption;
 using ShortKeyRangesOptionPtr = std::shared_ptr<ShortKeyRangesOption>;
+struct VectorSearchOption;
+using VectorSearchOptionPtr = std::shared_ptr<VectorSearchOption>;
 struct OlapScanRange;
 
 static inline std::unordered_set<uint32_t> EMPTY_FILTERED_COLUMN_IDS;
@@ -58,6 +60,9 @@ struct TabletReaderParams {
     // 2. when read column index page
     //     if config::disable_storage_page_cache is false, we use page cache
     bool use_page_cache = false;
+    // false for large scans, the data pages they read are not inserted into page cache so that
+    // they do not flush the pages of other queries
+    bool fill_page_cache = true;
 
     // Options only applies to cloud-native table r/w IO
     LakeIOOptions lake_io_opts{.fill_data_cache = true};
@@ -93,6 +98,8 @@ struct TabletReaderParams {
 
     bool prune_column_after_index_filter = false;
 
+    VectorSearchOptionPtr vector_search_option = nullptr;
+
 public:
     std::string to_string() const;
 };
@@ -14,10 +14,12 @@
 
 #include "storage/vertical_compaction_task.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "column/schema.h"
 #include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "storage/chunk_helper.h"
 #include "storage/compaction_utils.h"
 #include "storage/olap_common.h"
@@ -25,8 +27,13 @@
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/segment_page_copier.h"
 #include "storage/tablet_reader.h"
 #include "storage/tablet_reader_params.h"
+#include "util/blocking_queue.hpp"
+#include "util/countdown_latch.h"
+#include "util/defer_op.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -73,18 +80,35 @@ Status VerticalCompactionTask::_vertical_compaction_data(Statistics* statistics)
           "size:$1",
           max_rows_per_segment, column_groups.size());
 
-    for (size_t i = 0; i < column_groups.size(); ++i) {
-        if (should_stop()) {
-            LOG(INFO) << "vertical compaction task_id:" << _task_info.task_id << " is stopped.";
-            return Status::Cancelled("vertical compaction task is stopped.");
-        }
-        bool is_key = (i == 0);
-        if (!is_key) {
+    RETURN_IF_ERROR(_compact_column_group(true, 0, column_groups[0], output_rs_writer.get(), mask_buffer.get(),
+                                          source_masks.get(), statistics));
+    ASSIGN_OR_RETURN(auto page_copier, _create_page_copier(statistics, mask_buffer.get()));
+
+    int parallelism = config::vertical_compaction_column_group_parallelism;
+    ThreadPool* pool = ExecEnv::GetInstance()->vertical_compaction_pool();
+    if (parallelism <= 1 || column_groups.size() <= 2 || pool == nullptr) {
+        for (size_t i = 1; i < column_groups.size(); ++i) {
+            if (should_stop()) {
+                LOG(INFO) << "vertical compaction task_id:" << _task_info.task_id << " is stopped.";
+                return Status::Cancelled("vertical compaction task is stopped.");
+            }
+            if (_can_copy_column_group(page_copier.get(), column_groups[i])) {
+                RETURN_IF_ERROR(_copy_column_group(page_copier.get(), column_groups[i], output_rs_writer.get()));
+                continue;
+            }
             // read mask buffer from the beginning
             RETURN_IF_ERROR(mask_buffer->flip_to_read());
+            RETURN_IF_ERROR(_compact_column_group(false, i, column_groups[i], output_rs_writer.get(),
+                                                  mask_buffer.get(), source_masks.get(), statistics));
         }
-        RETURN_IF_ERROR(_compact_column_group(is_key, i, column_groups[i], output_rs_writer.get(), mask_buffer.get(),
-                                              source_masks.get(), statistics));
+    } else {
+        RETURN_IF_ERROR(_compact_value_column_groups_in_parallel(column_groups, parallelism, pool, page_copier.get(),
+                                                                 output_rs_writer.get(), mask_buffer.get()));
+    }
+    if (page_copier != nullptr) {
+        VLOG(1) << "compaction task_id:" << _task_info.task_id << ", tablet=" << _tablet->tablet_id()
+                << ", copied pages=" << page_copier->num_copied_pages()
+                << ", decoded rows=" << page_copier->num_decoded_rows();
     }
     TRACE("[Compaction] data compacted");
 
@@ -125,22 +149,8 @@ Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_gro
     Schema schema = ChunkHelper::convert_schema(_tablet_schema, column_group);
     TabletReader reader(std::static_pointer_cast<Tablet>(_tablet->shared_from_this()), output_rs_writer->version(),
                         schema, is_key, mask_buffer, _tablet_schema);
-    RETURN_IF_ERROR(reader.prepare());
-    TabletReaderParams reader_params;
-    DCHECK(compaction_type() == BASE_COMPACTION || compaction_type() == CUMULATIVE_COMPACTION);
-    reader_params.reader_type =
-            compaction_type() == BASE_COMPACTION ? READER_BASE_COMPACTION : READER_CUMULATIVE_COMPACTION;
-    reader_params.profile = _runtime_profile.create_child("merge_rowsets");
-
-    StatusOr<int32_t> ret = _calculate_chunk_size_for_column_group(column_group);
-    if (!ret.ok()) {
-        return ret.status();
-    }
-    int32_t chunk_size = ret.value();
-    VLOG(1) << "compaction task_id:" << _task_info.task_id << ", tablet=" << _tablet->tablet_id()
-            << ", column group=" << column_group_index << ", reader chunk size=" << chunk_size;
-    reader_params.chunk_size = chunk_size;
-    RETURN_IF_ERROR(reader.open(reader_params));
+    int32_t chunk_size = 0;
+    RETURN_IF_ERROR(_open_reader(column_group_index, column_group, &reader, &chunk_size));
 
     StatusOr<size_t> rows_st = _compact_data(is_key, chunk_size, column_group, schema, &reader, output_rs_writer,
                                              mask_buffer, source_masks);
@@ -162,6 +172,248 @@ Status VerticalCompactionTask::_compact_column_group(bool is_key, int column_gro
     return Status::OK();
 }
 
+Status VerticalCompactionTask::_open_reader(int column_group_index, const std::vector<uint32_t>& column_group,
+                                            TabletReader* reader, int32_t* chunk_size) {
+    RETURN_IF_ERROR(reader->prepare());
+    TabletReaderParams reader_params;
+    DCHECK(compaction_type() == BASE_COMPACTION || compaction_type() == CUMULATIVE_COMPACTION);
+    reader_params.reader_type =
+            compaction_type() == BASE_COMPACTION ? READER_BASE_COMPACTION : READER_CUMULATIVE_COMPACTION;
+    reader_params.profile = _runtime_profile.create_child("merge_rowsets");
+
+    StatusOr<int32_t> ret = _calculate_chunk_size_for_column_group(column_group);
+    if (!ret.ok()) {
+        return ret.status();
+    }
+    *chunk_size = ret.value();
+    VLOG(1) << "compaction task_id:" << _task_info.task_id << ", tablet=" << _tablet->tablet_id()
+            << ", column group=" << column_group_index << ", reader chunk size=" << *chunk_size;
+    reader_params.chunk_size = *chunk_size;
+    return reader->open(reader_params);
+}
+
+// Reads and merges one value column group in a thread of the vertical compaction pool. The merged chunks are
+// handed over to the compaction thread through a bounded queue, which writes the column groups in order.
+struct ColumnGroupReadTask {
+    explicit ColumnGroupReadTask(size_t queue_capacity) : chunks(queue_capacity) {}
+
+    BlockingQueue<ChunkPtr> chunks;
+    // counted down when the task is done, if it's submitted
+    CountDownLatch finished{1};
+    bool submitted = false;
+    Status status;
+    int64_t del_filtered_rows = 0;
+    int64_t merged_rows = 0;
+};
+
+Status VerticalCompactionTask::_read_column_group(int column_group_index, const std::vector<uint32_t>& column_group,
+                                                  const Version& version, RowSourceMaskBuffer* mask_buffer,
+                                                  ColumnGroupReadTask* task) {
+    ASSIGN_OR_RETURN(auto group_mask_buffer, mask_buffer->clone_for_read());
+    Schema schema = ChunkHelper::convert_schema(_tablet_schema, column_group);
+    TabletReader reader(std::static_pointer_cast<Tablet>(_tablet->shared_from_this()), version, schema, false,
+                        group_mask_buffer.get(), _tablet_schema);
+    int32_t chunk_size = 0;
+    RETURN_IF_ERROR(_open_reader(column_group_index, column_group, &reader, &chunk_size));
+
+    auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+    std::vector<RowSourceMask> source_masks;
+    while (LIKELY(!should_stop())) {
+#ifndef BE_TEST
+        RETURN_IF_ERROR(tls_thread_status.mem_tracker()->check_mem_limit("Compaction"));
+#endif
+        ChunkPtr chunk = ChunkHelper::new_chunk(schema, chunk_size);
+        auto st = reader.get_next(chunk.get(), &source_masks);
+        if (st.is_end_of_file()) {
+            break;
+        } else if (!st.ok()) {
+            LOG(WARNING) << "reader get next error. tablet=" << _tablet->tablet_id() << ", err=" << st.to_string();
+            return Status::InternalError(fmt::format("reader get_next error: {}", st.to_string()));
+        }
+        source_masks.clear();
+        ChunkHelper::padding_char_columns(char_field_indexes, schema, _tablet_schema, chunk.get());
+        if (!task->chunks.blocking_put(std::move(chunk))) {
+            return Status::Cancelled("column group read is cancelled");
+        }
+    }
+    if (should_stop()) {
+        return Status::Cancelled("vertical compaction task is stopped.");
+    }
+    task->del_filtered_rows = reader.stats().rows_del_filtered;
+    task->merged_rows = reader.merged_rows();
+    return Status::OK();
+}
+
+Status VerticalCompactionTask::_compact_value_column_groups_in_parallel(
+        const std::vector<std::vector<uint32_t>>& column_groups, int parallelism, ThreadPool* pool,
+        SegmentPageCopier* page_copier, RowsetWriter* output_rs_writer, RowSourceMaskBuffer* mask_buffer) {
+    // the column groups are read from |mask_buffer| through independent clones
+    RETURN_IF_ERROR(mask_buffer->flip_to_read());
+
+    const size_t num_groups = column_groups.size();
+    std::vector<std::unique_ptr<ColumnGroupReadTask>> tasks(num_groups);
+    DeferOp stop_tasks([&tasks]() {
+        for (auto& task : tasks) {
+            if (task != nullptr && task->submitted) {
+                task->chunks.shutdown();
+                task->finished.wait();
+            }
+        }
+    });
+
+    MemTracker* mem_tracker = tls_thread_status.mem_tracker();
+    const Version version = output_rs_writer->version();
+    // a zero capacity queue would block the reading task forever
+    const size_t queue_capacity = std::max(1, config::vertical_compaction_column_group_queue_size);
+    size_t next_to_start = 1;
+    // The tasks are submitted in the order of the column groups and the pool runs them in FIFO order, so the group
+    // being written has always got a thread before the later groups of the same compaction, which may block on
+    // their full queues, even if the pool is shared by many compactions.
+    auto start_tasks_until = [&](size_t end) -> Status {
+        for (; next_to_start < std::min(end, num_groups); ++next_to_start) {
+            size_t i = next_to_start;
+            if (_can_copy_column_group(page_copier, column_groups[i])) {
+                // written by the compaction thread without reading
+                continue;
+            }
+            tasks[i] = std::make_unique<ColumnGroupReadTask>(queue_capacity);
+            auto* task = tasks[i].get();
+            RETURN_IF_ERROR(pool->submit_func([this, i, task, mem_tracker, version, mask_buffer, &column_groups]() {
+                SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+                task->status = _read_column_group(i, column_groups[i], version, mask_buffer, task);
+                task->chunks.shutdown();
+                task->finished.count_down();
+            }));
+            task->submitted = true;
+        }
+        return Status::OK();
+    };
+
+    for (size_t i = 1; i < num_groups; ++i) {
+        if (should_stop()) {
+            LOG(INFO) << "vertical compaction task_id:" << _task_info.task_id << " is stopped.";
+            return Status::Cancelled("vertical compaction task is stopped.");
+        }
+        // keep |parallelism| column groups being read, including the one being written
+        RETURN_IF_ERROR(start_tasks_until(i + parallelism));
+
+        auto* task = tasks[i].get();
+        if (task == nullptr) {
+            RETURN_IF_ERROR(_copy_column_group(page_copier, column_groups[i], output_rs_writer));
+            continue;
+        }
+        ChunkPtr chunk;
+        while (task->chunks.blocking_get(&chunk)) {
+            RETURN_IF_ERROR(output_rs_writer->add_columns(*chunk, column_groups[i], false));
+            _task_info.total_output_num_rows += chunk->num_rows();
+        }
+        task->finished.wait();
+        RETURN_IF_ERROR(task->status);
+        _task_info.total_del_filtered_rows += task->del_filtered_rows;
+        _task_info.total_merged_rows += task->merged_rows;
+
+        RETURN_IF_ERROR(output_rs_writer->flush_columns());
+        tasks[i].reset();
+    }
+    return Status::OK();
+}
+
+StatusOr<std::unique_ptr<SegmentPageCopier>> VerticalCompactionTask::_create_page_copier(
+        const Statistics* statistics, RowSourceMaskBuffer* mask_buffer) {
+    if (!config::enable_vertical_compaction_page_copy || _tablet_schema->keys_type() != DUP_KEYS ||
+        statistics == nullptr || statistics->merged_rows != 0 || statistics->filtered_rows != 0) {
+        return nullptr;
+    }
+    std::vector<RowsetSharedPtr> rowsets = _input_rowsets;
+    std::sort(rowsets.begin(), rowsets.end(), Rowset::comparator);
+    // the segments with rows and the number of rows of each iterator merged by the key column group,
+    // see Rowset::get_segment_iterators()
+    std::vector<SegmentSharedPtr> segments;
+    std::vector<int64_t> source_rows;
+    for (const auto& rowset : rowsets) {
+        if (rowset->rowset_meta()->has_delete_predicate()) {
+            return nullptr;
+        }
+        int64_t rowset_rows = 0;
+        for (const auto& segment : rowset->segments()) {
+            if (segment->num_rows() == 0) {
+                continue;
+            }
+            segments.push_back(segment);
+            if (rowset->rowset_meta()->is_segments_overlapping()) {
+                source_rows.push_back(segment->num_rows());
+            } else {
+                rowset_rows += segment->num_rows();
+            }
+        }
+        if (rowset_rows > 0) {
+            source_rows.push_back(rowset_rows);
+        }
+    }
+    if (source_rows.empty()) {
+        return nullptr;
+    }
+
+    // The output rows are the rows of the segments in order only if the key column group took all the rows of
+    // each source before the next one. The masks are read through a clone, |mask_buffer| is read from the
+    // beginning by the value column groups.
+    ASSIGN_OR_RETURN(auto masks, mask_buffer->clone_for_read());
+    size_t source = 0;
+    int64_t rows = 0;
+    while (true) {
+        ASSIGN_OR_RETURN(bool has_remaining, masks->has_remaining());
+        if (!has_remaining) {
+            break;
+        }
+        uint16_t source_num = masks->current().get_source_num();
+        masks->advance();
+        if (source_num != source) {
+            if (source_num != source + 1 || rows != source_rows[source]) {
+                return nullptr;
+            }
+            source = source_num;
+            rows = 0;
+        }
+        if (source >= source_rows.size()) {
+            return nullptr;
+        }
+        ++rows;
+    }
+    if (source + 1 != source_rows.size() || rows != source_rows[source]) {
+        return nullptr;
+    }
+
+    auto page_copier = std::make_unique<SegmentPageCopier>(std::move(segments));
+    RETURN_IF_ERROR(page_copier->init());
+    return page_copier;
+}
+
+bool VerticalCompactionTask::_can_copy_column_group(const SegmentPageCopier* page_copier,
+                                                    const std::vector<uint32_t>& column_group) const {
+    if (page_copier == nullptr) {
+        return false;
+    }
+    for (uint32_t column_index : column_group) {
+        if (!page_copier->can_copy(_tablet_schema->column(column_index))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status VerticalCompactionTask::_copy_column_group(SegmentPageCopier* page_copier,
+                                                  const std::vector<uint32_t>& column_group,
+                                                  RowsetWriter* output_rs_writer) {
+    RETURN_IF_ERROR(output_rs_writer->append_columns(
+            column_group, [&](size_t index, int64_t first_row, size_t num_rows, ColumnWriter* writer) {
+                return page_copier->append_rows(_tablet_schema->column(column_group[index]), first_row, num_rows,
+                                                writer);
+            }));
+    RETURN_IF_ERROR(output_rs_writer->flush_columns());
+    _task_info.total_output_num_rows += page_copier->num_rows();
+    return Status::OK();
+}
+
 StatusOr<int32_t> VerticalCompactionTask::_calculate_chunk_size_for_column_group(
         const std::vector<uint32_t>& column_group) {
     int64_t total_num_rows = 0;
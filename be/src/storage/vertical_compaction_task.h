@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/status.h"
@@ -27,7 +28,10 @@ namespace starrocks {
 class RowsetWriter;
 class TabletReader;
 class RowSourceMaskBuffer;
+class SegmentPageCopier;
+class ThreadPool;
 struct RowSourceMask;
+struct ColumnGroupReadTask;
 
 // need a factory of compaction task
 class VerticalCompactionTask : public CompactionTask {
@@ -48,6 +52,27 @@ private:
                                    const Schema& schema, TabletReader* reader, RowsetWriter* output_rs_writer,
                                    RowSourceMaskBuffer* mask_buffer, std::vector<RowSourceMask>* source_masks);
 
+    // Reads the value column groups with |parallelism| tasks of |pool| and writes them in order.
+    Status _compact_value_column_groups_in_parallel(const std::vector<std::vector<uint32_t>>& column_groups,
+                                                    int parallelism, ThreadPool* pool, SegmentPageCopier* page_copier,
+                                                    RowsetWriter* output_rs_writer, RowSourceMaskBuffer* mask_buffer);
+
+    Status _read_column_group(int column_group_index, const std::vector<uint32_t>& column_group,
+                              const Version& version, RowSourceMaskBuffer* mask_buffer, ColumnGroupReadTask* task);
+
+    // Returns a copier of the input segments if the output rows are the input rows in order, i.e. the value
+    // column groups need no merge, otherwise nullptr.
+    StatusOr<std::unique_ptr<SegmentPageCopier>> _create_page_copier(const Statistics* statistics,
+                                                                     RowSourceMaskBuffer* mask_buffer);
+
+    bool _can_copy_column_group(const SegmentPageCopier* page_copier, const std::vector<uint32_t>& column_group) const;
+
+    Status _copy_column_group(SegmentPageCopier* page_copier, const std::vector<uint32_t>& column_group,
+                              RowsetWriter* output_rs_writer);
+
+    Status _open_reader(int column_group_index, const std::vector<uint32_t>& column_group, TabletReader* reader,
+                        int32_t* chunk_size);
+
     StatusOr<int32_t> _calculate_chunk_size_for_column_group(const std::vector<uint32_t>& column_group);
 };
 
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <type_traits>
 
 #include "util/bit_util.h"
 #include "util/coding.h"
@@ -368,6 +369,28 @@ T ForDecoder<T>::decode_frame_min_value(uint32_t frame_index) {
     return min;
 }
 
+template <typename T>
+bool ForDecoder<T>::frame_bounds(uint32_t frame_index, T* min, T* max) {
+    DCHECK_LT(frame_index, _frame_count);
+    *min = decode_frame_min_value(frame_index);
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+        uint8_t storage_format = _storage_formats[frame_index];
+        if (storage_format == 2) {
+            return false;
+        }
+        // the deltas are at most 2^bit_width - 1, the ascending frames keep the deltas of adjacent values
+        __int128 max_delta = (static_cast<__int128>(1) << _bit_widths[frame_index]) - 1;
+        if (storage_format == 1) {
+            max_delta *= frame_size(frame_index) - 1;
+        }
+        __int128 upper = static_cast<__int128>(*min) + max_delta;
+        *max = upper > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : static_cast<T>(upper);
+        return true;
+    } else {
+        return false;
+    }
+}
+
 template <typename T>
 T* ForDecoder<T>::copy_value(T* val, size_t count) {
     memcpy(val, &_out_buffer[_current_index % _max_frame_size], sizeof(T) * count);
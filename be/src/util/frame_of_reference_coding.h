@@ -163,13 +163,22 @@ public:
 
     uint32_t count() const { return _values_num; }
 
-private:
-    void bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output);
+    uint32_t frame_count() const { return _frame_count; }
 
-    uint32_t frame_size(uint32_t frame_index) {
+    uint32_t max_frame_size() const { return _max_frame_size; }
+
+    uint32_t frame_size(uint32_t frame_index) const {
         return (frame_index == _frame_count - 1) ? _last_frame_size : _max_frame_size;
     }
 
+    // Get the bounds of the values in frame |frame_index| from the frame header without decoding the
+    // frame. |min| is always exact, return false if the upper bound is unknown, e.g. the frame keeps
+    // the original values.
+    bool frame_bounds(uint32_t frame_index, T* min, T* max);
+
+private:
+    void bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output);
+
     void decode_current_frame(T* output);
 
     T decode_frame_min_value(uint32_t frame_index);
@@ -0,0 +1,199 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/fsst.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/phmap/phmap.h"
+
+namespace starrocks {
+
+static inline uint64_t load_word(const uint8_t* p, size_t remain) {
+    uint64_t word = 0;
+    memcpy(&word, p, std::min(remain, sizeof(uint64_t)));
+    return word;
+}
+
+static inline uint64_t symbol_mask(size_t len) {
+    return len >= sizeof(uint64_t) ? ~0ULL : (1ULL << (len * 8)) - 1;
+}
+
+void FsstSymbolTable::clear() {
+    _num_symbols = 0;
+    memset(_symbols, 0, sizeof(_symbols));
+    memset(_lengths, 0, sizeof(_lengths));
+    _rebuild_index();
+}
+
+void FsstSymbolTable::_rebuild_index() {
+    uint16_t counts[256] = {};
+    for (size_t code = 0; code < _num_symbols; code++) {
+        counts[_symbols[code] & 0xFF]++;
+    }
+    _index_begin[0] = 0;
+    for (size_t b = 0; b < 256; b++) {
+        _index_begin[b + 1] = _index_begin[b] + counts[b];
+    }
+    uint16_t next[256];
+    memcpy(next, _index_begin, sizeof(next));
+    for (size_t code = 0; code < _num_symbols; code++) {
+        _index_codes[next[_symbols[code] & 0xFF]++] = code;
+    }
+    for (size_t b = 0; b < 256; b++) {
+        std::stable_sort(_index_codes + _index_begin[b], _index_codes + _index_begin[b + 1],
+                         [this](uint8_t lhs, uint8_t rhs) { return _lengths[lhs] > _lengths[rhs]; });
+    }
+}
+
+uint8_t FsstSymbolTable::_find_longest(const uint8_t* p, size_t remain, size_t* len) const {
+    const uint64_t word = load_word(p, remain);
+    const uint8_t first = p[0];
+    for (uint16_t i = _index_begin[first]; i < _index_begin[first + 1]; i++) {
+        uint8_t code = _index_codes[i];
+        size_t symbol_len = _lengths[code];
+        if (symbol_len <= remain && (word & symbol_mask(symbol_len)) == _symbols[code]) {
+            *len = symbol_len;
+            return code;
+        }
+    }
+    *len = 1;
+    return kEscapeCode;
+}
+
+size_t FsstSymbolTable::compress(const Slice& in, uint8_t* out) const {
+    const auto* p = reinterpret_cast<const uint8_t*>(in.data);
+    size_t remain = in.size;
+    uint8_t* start = out;
+    while (remain > 0) {
+        size_t len;
+        uint8_t code = _find_longest(p, remain, &len);
+        *out++ = code;
+        if (code == kEscapeCode) {
+            *out++ = *p;
+        }
+        p += len;
+        remain -= len;
+    }
+    return out - start;
+}
+
+// The simplified training algorithm of the FSST paper: in every generation, the samples are
+// compressed with the current table, the gain of every used symbol and the concatenation of every
+// two adjacent symbols is counted, and the symbols with the most gain make up the next table.
+void FsstSymbolTable::build(const std::vector<Slice>& samples) {
+    static constexpr int kGenerations = 5;
+    // codes of the current table and 256 pseudo codes for the escaped bytes
+    static constexpr size_t kNumCodes = 512;
+
+    clear();
+    std::vector<uint32_t> count1(kNumCodes);
+    // the pairs of adjacent codes, keyed by `prev * kNumCodes + code`, at most one per sample byte
+    phmap::flat_hash_map<uint32_t, uint32_t> count2;
+    auto code_symbol = [this](size_t code) -> uint64_t { return code >= 256 ? code - 256 : _symbols[code]; };
+    auto code_length = [this](size_t code) -> size_t { return code >= 256 ? 1 : _lengths[code]; };
+
+    for (int gen = 0; gen < kGenerations; gen++) {
+        std::fill(count1.begin(), count1.end(), 0);
+        count2.clear();
+        for (const Slice& sample : samples) {
+            const auto* p = reinterpret_cast<const uint8_t*>(sample.data);
+            size_t remain = sample.size;
+            size_t prev = kNumCodes;
+            while (remain > 0) {
+                size_t len;
+                size_t code = _find_longest(p, remain, &len);
+                if (code == kEscapeCode) {
+                    code = 256 + *p;
+                }
+                count1[code]++;
+                if (prev != kNumCodes) {
+                    count2[prev * kNumCodes + code]++;
+                }
+                prev = code;
+                p += len;
+                remain -= len;
+            }
+        }
+
+        phmap::flat_hash_map<std::pair<uint64_t, uint8_t>, uint64_t> gains;
+        for (size_t code = 0; code < kNumCodes; code++) {
+            if (count1[code] == 0) {
+                continue;
+            }
+            size_t len = code_length(code);
+            gains[{code_symbol(code), len}] += static_cast<uint64_t>(count1[code]) * len;
+        }
+        for (const auto& [pair, count] : count2) {
+            size_t code = pair / kNumCodes;
+            size_t next = pair % kNumCodes;
+            size_t len = code_length(code);
+            size_t next_len = code_length(next);
+            if (len + next_len > kMaxSymbolLength) {
+                continue;
+            }
+            uint64_t symbol = code_symbol(code) | (code_symbol(next) << (len * 8));
+            gains[{symbol, len + next_len}] += static_cast<uint64_t>(count) * (len + next_len);
+        }
+
+        std::vector<std::pair<uint64_t, std::pair<uint64_t, uint8_t>>> candidates;
+        candidates.reserve(gains.size());
+        for (const auto& [symbol, gain] : gains) {
+            candidates.emplace_back(gain, symbol);
+        }
+        size_t n = std::min(candidates.size(), kMaxSymbols);
+        std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end(),
+                          [](const auto& lhs, const auto& rhs) { return lhs > rhs; });
+        _num_symbols = n;
+        for (size_t code = 0; code < n; code++) {
+            _symbols[code] = candidates[code].second.first;
+            _lengths[code] = candidates[code].second.second;
+        }
+        _rebuild_index();
+    }
+}
+
+void FsstSymbolTable::serialize(faststring* buf) const {
+    buf->push_back(_num_symbols);
+    buf->append(_lengths, _num_symbols);
+    for (size_t code = 0; code < _num_symbols; code++) {
+        buf->append(&_symbols[code], _lengths[code]);
+    }
+}
+
+StatusOr<size_t> FsstSymbolTable::deserialize(const uint8_t* data, size_t size) {
+    clear();
+    if (size < 1 || data[0] > kMaxSymbols || size < 1 + data[0]) {
+        return Status::Corruption("invalid fsst symbol count");
+    }
+    const size_t num_symbols = data[0];
+    const uint8_t* lengths = data + 1;
+    size_t pos = 1 + num_symbols;
+    for (size_t code = 0; code < num_symbols; code++) {
+        size_t len = lengths[code];
+        if (len == 0 || len > kMaxSymbolLength || pos + len > size) {
+            clear();
+            return Status::Corruption("invalid fsst symbol length");
+        }
+        _lengths[code] = len;
+        memcpy(&_symbols[code], data + pos, len);
+        pos += len;
+    }
+    _num_symbols = num_symbols;
+    _rebuild_index();
+    return pos;
+}
+
+} // namespace starrocks
@@ -0,0 +1,110 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common/status.h"
+#include "common/statusor.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+// FSST (Fast Static Symbol Table) string compression.
+//
+// A symbol table maps up to 255 one-byte codes to symbols of 1 to 8 bytes, which are learnt from
+// sample strings. A string is compressed by replacing its longest matching prefix with the code
+// repeatedly, the bytes without matching symbol are written as an escape code followed by the byte.
+// Every string is compressed independently, so a single value can be decompressed without its
+// neighbours, and since compression is deterministic for a table, two strings are equal if and
+// only if their compressed forms are equal.
+class FsstSymbolTable {
+public:
+    static constexpr size_t kMaxSymbols = 255;
+    static constexpr size_t kMaxSymbolLength = 8;
+    static constexpr uint8_t kEscapeCode = 255;
+
+    FsstSymbolTable() = default;
+
+    // Learn the symbol table from the samples, the previous symbols are discarded.
+    void build(const std::vector<Slice>& samples);
+
+    void clear();
+
+    size_t num_symbols() const { return _num_symbols; }
+
+    bool empty() const { return _num_symbols == 0; }
+
+    // | num_symbols(1) | lengths(num_symbols) | symbols(sum of lengths) |
+    void serialize(faststring* buf) const;
+
+    // Return the number of bytes consumed, or Corruption if the data is malformed.
+    StatusOr<size_t> deserialize(const uint8_t* data, size_t size);
+
+    // The upper bound of compressed size, when no byte is matched.
+    static size_t max_compressed_size(size_t size) { return size * 2; }
+
+    // The decompressed symbols are copied in 8 bytes, so the output buffer of decompress() must
+    // have this many bytes more than the decompressed size.
+    static constexpr size_t kDecompressPadding = kMaxSymbolLength;
+
+    // `out` must have at least max_compressed_size(in.size) bytes, return the compressed size.
+    size_t compress(const Slice& in, uint8_t* out) const;
+
+    // `out` must have at least `capacity` + kDecompressPadding bytes, return the decompressed size, or
+    // Corruption if `in` is malformed or decompressed to more than `capacity` bytes.
+    StatusOr<size_t> decompress(const uint8_t* in, size_t size, uint8_t* out, size_t capacity) const {
+        uint8_t* start = out;
+        const uint8_t* end = in + size;
+        const uint8_t* out_end = out + capacity;
+        while (in < end) {
+            uint8_t code = *in++;
+            if (code != kEscapeCode) {
+                if (UNLIKELY(code >= _num_symbols || out + _lengths[code] > out_end)) {
+                    return Status::Corruption("invalid fsst code");
+                }
+                memcpy(out, &_symbols[code], sizeof(uint64_t));
+                out += _lengths[code];
+            } else {
+                if (UNLIKELY(in == end || out == out_end)) {
+                    return Status::Corruption("invalid fsst escape");
+                }
+                *out++ = *in++;
+            }
+        }
+        return out - start;
+    }
+
+private:
+    // Return the code of the longest symbol which is a prefix of `p`, or kEscapeCode if no one.
+    uint8_t _find_longest(const uint8_t* p, size_t remain, size_t* len) const;
+
+    void _rebuild_index();
+
+    uint8_t _num_symbols = 0;
+    // symbols are packed in little endian and padded with zeros
+    uint64_t _symbols[kMaxSymbols + 1] = {};
+    uint8_t _lengths[kMaxSymbols + 1] = {};
+    // codes of the symbols starting with byte b are _index_codes[_index_begin[b], _index_begin[b + 1]),
+    // in the order of length descending
+    uint16_t _index_begin[257] = {};
+    uint8_t _index_codes[kMaxSymbols] = {};
+};
+
+} // namespace starrocks
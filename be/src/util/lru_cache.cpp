@@ -154,6 +154,8 @@ LRUCache::LRUCache() {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected.next = &_protected;
+    _protected.prev = &_protected;
 }
 
 LRUCache::~LRUCache() noexcept {
@@ -162,14 +164,15 @@ LRUCache::~LRUCache() noexcept {
 
 bool LRUCache::_unref(LRUHandle* e) {
     DCHECK(e->refs > 0);
-    e->refs--;
-    return e->refs == 0;
+    // a single atomic operation, CLOCK releases may drop the other references concurrently
+    return e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
 }
 
 void LRUCache::_lru_remove(LRUHandle* e) {
     e->next->prev = e->prev;
     e->prev->next = e->next;
     e->prev = e->next = nullptr;
+    --_list_length;
 }
 
 void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
@@ -178,6 +181,7 @@ void LRUCache::_lru_append(LRUHandle* list, LRUHandle* e) {
     e->prev = list->prev;
     e->prev->next = e;
     e->next->prev = e;
+    ++_list_length;
 }
 
 void LRUCache::set_capacity(size_t capacity) {
@@ -186,6 +190,7 @@ void LRUCache::set_capacity(size_t capacity) {
         std::lock_guard l(_mutex);
         _capacity = capacity;
         _evict_from_lru(0, &last_ref_list);
+        _demote_protected();
     }
 
     for (auto entry : last_ref_list) {
@@ -197,14 +202,17 @@ void LRUCache::set_charge_mode(ChargeMode charge_mode) {
     _charge_mode = charge_mode;
 }
 
+void LRUCache::set_eviction_policy(EvictionPolicy eviction_policy) {
+    _eviction_policy = eviction_policy;
+    _mutex.set_shared(eviction_policy == EvictionPolicy::CLOCK);
+}
+
 uint64_t LRUCache::get_lookup_count() const {
-    std::lock_guard l(_mutex);
-    return _lookup_count;
+    return _lookup_count.load(std::memory_order_relaxed);
 }
 
 uint64_t LRUCache::get_hit_count() const {
-    std::lock_guard l(_mutex);
-    return _hit_count;
+    return _hit_count.load(std::memory_order_relaxed);
 }
 
 size_t LRUCache::get_usage() const {
@@ -218,6 +226,9 @@ size_t LRUCache::get_capacity() const {
 }
 
 Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
+    if (_eviction_policy == EvictionPolicy::CLOCK) {
+        return _clock_lookup(key, hash);
+    }
     std::lock_guard l(_mutex);
     ++_lookup_count;
     LRUHandle* e = _table.lookup(key, hash);
@@ -230,6 +241,28 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        if (_eviction_policy == EvictionPolicy::SLRU && !e->in_protected) {
+            // hit again after admitted, it will be put to protected segment when released
+            e->in_protected = true;
+            _protected_usage += e->charge;
+        }
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Cache::Handle* LRUCache::_clock_lookup(const CacheKey& key, uint32_t hash) {
+    std::shared_lock l(_mutex);
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    LRUHandle* e = _table.lookup(key, hash);
+    if (e != nullptr) {
+        DCHECK(e->in_cache);
+        // the entry stays in the list, eviction can not run until the shared lock is released
+        e->refs.fetch_add(1, std::memory_order_relaxed);
+        // avoid dirtying the cache line of hot entries which are already referenced
+        if (!e->visited.load(std::memory_order_relaxed)) {
+            e->visited.store(true, std::memory_order_relaxed);
+        }
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -239,6 +272,18 @@ void LRUCache::release(Cache::Handle* handle) {
         return;
     }
     auto* e = reinterpret_cast<LRUHandle*>(handle);
+    if (_eviction_policy == EvictionPolicy::CLOCK) {
+        // the entry stays in the list while in use, only the release of an entry which has left the cache
+        // needs the lock to update usage
+        if (_unref(e)) {
+            {
+                std::lock_guard l(_mutex);
+                _usage -= e->charge;
+            }
+            e->free();
+        }
+        return;
+    }
     bool last_ref = false;
     {
         std::lock_guard l(_mutex);
@@ -251,9 +296,13 @@ void LRUCache::release(Cache::Handle* handle) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
+                _leave_protected(e);
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
+            } else if (e->in_protected) {
+                _lru_append(&_protected, e);
+                _demote_protected();
             } else {
                 // put it to LRU free list
                 _lru_append(&_lru, e);
@@ -268,23 +317,55 @@ void LRUCache::release(Cache::Handle* handle) {
 }
 
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
+    if (_eviction_policy == EvictionPolicy::CLOCK) {
+        _evict_from_clock(charge, deleted);
+        return;
+    }
+    // probationary entries are evicted before protected ones, the protected list is always empty with LRU
+    LRUHandle* lists[] = {&_lru, &_protected};
     // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
-        LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
-            cur = cur->next;
-            continue;
+    for (LRUHandle* list : lists) {
+        LRUHandle* cur = list;
+        while (_usage + charge > _capacity && cur->next != list) {
+            LRUHandle* old = cur->next;
+            if (old->priority == CachePriority::DURABLE) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
         }
-        _evict_one_entry(old);
-        deleted->push_back(old);
     }
     // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
+    for (LRUHandle* list : lists) {
+        while (_usage + charge > _capacity && list->next != list) {
+            LRUHandle* old = list->next;
+            DCHECK(old->priority == CachePriority::DURABLE);
+            _evict_one_entry(old);
+            deleted->push_back(old);
+        }
+    }
+}
+
+void LRUCache::_evict_from_clock(size_t charge, std::vector<LRUHandle*>* deleted) {
+    // 1. evict normal cache entries, 2. evict durable cache entries if need
+    for (bool evict_durable : {false, true}) {
+        // the hand passes each entry at most twice, once to clear its reference bit and once to evict it
+        size_t steps = 2 * _list_length;
+        for (; _usage + charge > _capacity && steps > 0; --steps) {
+            LRUHandle* old = _lru.next;
+            // lookups are excluded by the lock, refs == 1 means nobody else holds the entry
+            bool evictable = old->refs.load(std::memory_order_acquire) == 1 &&
+                             (evict_durable || old->priority != CachePriority::DURABLE);
+            if (evictable && !old->visited.exchange(false, std::memory_order_relaxed)) {
+                _evict_one_entry(old);
+                deleted->push_back(old);
+                continue;
+            }
+            // entries in use and the referenced ones get a second chance
+            _lru_remove(old);
+            _lru_append(&_lru, old);
+        }
     }
 }
 
@@ -294,10 +375,29 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
+    _leave_protected(e);
     _unref(e);
     _usage -= e->charge;
 }
 
+void LRUCache::_leave_protected(LRUHandle* e) {
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
+void LRUCache::_demote_protected() {
+    const auto protected_capacity = static_cast<size_t>(_capacity * kProtectedRatio);
+    while (_protected_usage > protected_capacity && _protected.next != &_protected) {
+        // oldest protected entry gets another chance as the newest probationary entry
+        LRUHandle* old = _protected.next;
+        _lru_remove(old);
+        _leave_protected(old);
+        _lru_append(&_lru, old);
+    }
+}
+
 Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                                 void (*deleter)(const CacheKey& key, void* value), CachePriority priority,
                                 size_t value_size) {
@@ -311,6 +411,8 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->next = e->prev = nullptr;
     e->in_cache = true;
     e->priority = priority;
+    e->in_protected = false;
+    e->visited = false;
     e->value_size = value_size;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
@@ -326,13 +428,19 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         // space was freed
         auto old = _table.insert(e);
         _usage += charge;
+        if (_eviction_policy == EvictionPolicy::CLOCK) {
+            _lru_append(&_lru, e);
+        }
         if (old != nullptr) {
+            // old is on LRU if it's not in use, or always with CLOCK. It must be unlinked before unref,
+            // a concurrent CLOCK release may free it right after.
+            if (_eviction_policy == EvictionPolicy::CLOCK || old->refs == 1) {
+                _lru_remove(old);
+            }
             old->in_cache = false;
+            _leave_protected(old);
             if (_unref(old)) {
                 _usage -= old->charge;
-                // old is on LRU because it's in cache and its reference count
-                // was just 1 (Unref returned 0)
-                _lru_remove(old);
                 last_ref_list.push_back(old);
             }
         }
@@ -354,15 +462,18 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
         std::lock_guard l(_mutex);
         e = _table.remove(key, hash);
         if (e != nullptr) {
+            // we get it from _table, so in_cache must be true, it locates in free list if not in use,
+            // or always with CLOCK. Unlink it before unref, a concurrent CLOCK release may free it right after.
+            DCHECK(e->in_cache);
+            if (_eviction_policy == EvictionPolicy::CLOCK || e->refs == 1) {
+                _lru_remove(e);
+            }
+            e->in_cache = false;
+            _leave_protected(e);
             last_ref = _unref(e);
             if (last_ref) {
                 _usage -= e->charge;
-                if (e->in_cache) {
-                    // locate in free list
-                    _lru_remove(e);
-                }
             }
-            e->in_cache = false;
         }
     }
     // free handle out of mutex, when last_ref is true, e must not be nullptr
@@ -372,19 +483,25 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
 }
 
 int LRUCache::prune() {
+    return prune_if([](const CacheKey&) { return true; });
+}
+
+int LRUCache::prune_if(const std::function<bool(const CacheKey&)>& pred) {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected}) {
+            LRUHandle* cur = list->next;
+            while (cur != list) {
+                LRUHandle* next = cur->next;
+                DCHECK(cur->in_cache);
+                // with CLOCK the list also contains entries in use, which can not be evicted
+                if (cur->refs == 1 && pred(cur->key())) {
+                    _evict_one_entry(cur);
+                    last_ref_list.push_back(cur);
+                }
+                cur = next;
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -401,12 +518,13 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity, ChargeMode charge_mode)
+ShardedLRUCache::ShardedLRUCache(size_t capacity, ChargeMode charge_mode, EvictionPolicy eviction_policy)
         : _last_id(0), _capacity(capacity), _charge_mode(charge_mode) {
     const size_t per_shard = (_capacity + (kNumShards - 1)) / kNumShards;
     for (auto& _shard : _shards) {
         _shard.set_capacity(per_shard);
         _shard.set_charge_mode(_charge_mode);
+        _shard.set_eviction_policy(eviction_policy);
     }
 }
 
@@ -490,6 +608,14 @@ void ShardedLRUCache::prune() {
     VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
 }
 
+void ShardedLRUCache::prune_if(const std::function<bool(const CacheKey&)>& pred) {
+    int num_prune = 0;
+    for (auto& shard : _shards) {
+        num_prune += shard.prune_if(pred);
+    }
+    VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
+}
+
 size_t ShardedLRUCache::get_memory_usage() const {
     return _get_stat(&LRUCache::get_usage);
 }
@@ -536,8 +662,8 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
     }
 }
 
-Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode) {
-    return new ShardedLRUCache(capacity, charge_mode);
+Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode, EvictionPolicy eviction_policy) {
+    return new ShardedLRUCache(capacity, charge_mode, eviction_policy);
 }
 
 } // namespace starrocks
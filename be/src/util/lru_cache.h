@@ -6,9 +6,12 @@
 
 #include <rapidjson/document.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -27,9 +30,24 @@ enum class ChargeMode {
     MEMSIZE = 1
 };
 
+// The policy to choose the entries evicted from a cache created by new_lru_cache().
+enum class EvictionPolicy {
+    // evict the least recently used entry
+    LRU = 0,
+    // segmented LRU: new entries are admitted to a probationary segment and only promoted to the
+    // protected segment when they are hit again, probationary entries are evicted first. A single pass
+    // over lots of entries, e.g. a large scan, only evicts other probationary entries.
+    SLRU = 1,
+    // CLOCK (second chance): lookups only take a read lock and set a reference bit of the entry, so
+    // concurrent hits do not serialize. Entries stay in the list while in use, eviction skips them and
+    // gives the referenced ones a second chance.
+    CLOCK = 2
+};
+
 // Create a new cache with a fixed size capacity.  This implementation
 // of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE);
+extern Cache* new_lru_cache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE,
+                            EvictionPolicy eviction_policy = EvictionPolicy::LRU);
 
 class CacheKey {
 public:
@@ -183,6 +201,9 @@ public:
     // leveldb may change prune() to a pure abstract method.
     virtual void prune() {}
 
+    // Remove the cache entries that are not actively in use and whose key satisfies `pred`.
+    virtual void prune_if(const std::function<bool(const CacheKey&)>& pred) {}
+
     virtual void get_cache_status(rapidjson::Document* document) = 0;
 
     virtual void set_capacity(size_t capacity) = 0;
@@ -210,9 +231,12 @@ typedef struct LRUHandle {
     size_t charge;
     size_t key_length;
     bool in_cache; // Whether entry is in the cache.
-    uint32_t refs;
+    // Atomic since CLOCK lookups and releases change it without holding the exclusive lock.
+    std::atomic<uint32_t> refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
+    bool in_protected = false; // Whether entry is in the protected segment of SLRU.
+    std::atomic<bool> visited; // Reference bit of CLOCK, set by lookups and cleared by eviction.
     size_t value_size;
     char key_data[1]; // Beginning of key
 
@@ -265,6 +289,24 @@ private:
     bool _resize();
 };
 
+// The lock of a shard. Only CLOCK lookups take it in shared mode, so the other policies use a plain mutex,
+// which is cheaper to lock exclusively than a std::shared_mutex.
+class ShardMutex {
+public:
+    // Must be called before the mutex is used.
+    void set_shared(bool shared) { _shared = shared; }
+
+    void lock() { _shared ? _shared_mutex.lock() : _mutex.lock(); }
+    void unlock() { _shared ? _shared_mutex.unlock() : _mutex.unlock(); }
+    void lock_shared() { _shared_mutex.lock_shared(); }
+    void unlock_shared() { _shared_mutex.unlock_shared(); }
+
+private:
+    bool _shared{false};
+    std::mutex _mutex;
+    std::shared_mutex _shared_mutex;
+};
+
 // A single shard of sharded cache.
 class LRUCache {
 public:
@@ -276,6 +318,9 @@ public:
 
     void set_charge_mode(ChargeMode charge_mode);
 
+    // Must be called before the cache is used.
+    void set_eviction_policy(EvictionPolicy eviction_policy);
+
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                           void (*deleter)(const CacheKey& key, void* value),
@@ -284,6 +329,7 @@ public:
     void release(Cache::Handle* handle);
     void erase(const CacheKey& key, uint32_t hash);
     int prune();
+    int prune_if(const std::function<bool(const CacheKey&)>& pred);
 
     uint64_t get_lookup_count() const;
     uint64_t get_hit_count() const;
@@ -295,26 +341,45 @@ private:
     void _lru_append(LRUHandle* list, LRUHandle* e);
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
+    void _evict_from_clock(size_t charge, std::vector<LRUHandle*>* deleted);
+    Cache::Handle* _clock_lookup(const CacheKey& key, uint32_t hash);
     void _evict_one_entry(LRUHandle* e);
+    void _leave_protected(LRUHandle* e);
+    void _demote_protected();
+
+    // Share of the capacity the protected segment of SLRU may take.
+    static constexpr double kProtectedRatio = 0.8;
 
     // Initialized before use.
     size_t _capacity{0};
 
     ChargeMode _charge_mode;
+    EvictionPolicy _eviction_policy{EvictionPolicy::LRU};
 
     // _mutex protects the following state.
-    mutable std::mutex _mutex;
+    // CLOCK lookups take it in shared mode, they only touch the atomic fields of entries and counters.
+    mutable ShardMutex _mutex;
     size_t _usage{0};
+    // Number of entries in `_lru` and `_protected`.
+    size_t _list_length{0};
 
     // Dummy head of LRU list.
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
+    // With SLRU this is the probationary segment.
+    // With CLOCK all the entries with in_cache==true are in it, including the ones in use.
     LRUHandle _lru;
 
+    // Dummy head of the protected segment of SLRU, ordered like `_lru`.
+    // Entries have refs==1, in_cache==true and in_protected==true.
+    LRUHandle _protected;
+    // Total charge of the entries in protected segment, including the ones in use.
+    size_t _protected_usage{0};
+
     HandleTable _table;
 
-    uint64_t _lookup_count{0};
-    uint64_t _hit_count{0};
+    std::atomic<uint64_t> _lookup_count{0};
+    std::atomic<uint64_t> _hit_count{0};
 };
 
 static const int kNumShardBits = 5;
@@ -322,7 +387,8 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE);
+    explicit ShardedLRUCache(size_t capacity, ChargeMode charge_mode = ChargeMode::VALUESIZE,
+                             EvictionPolicy eviction_policy = EvictionPolicy::LRU);
     ~ShardedLRUCache() override = default;
     Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
                    CachePriority priority = CachePriority::NORMAL, size_t value_size = 0) override;
@@ -333,6 +399,7 @@ public:
     Slice value_slice(Handle* handle) override;
     uint64_t new_id() override;
     void prune() override;
+    void prune_if(const std::function<bool(const CacheKey&)>& pred) override;
     void get_cache_status(rapidjson::Document* document) override;
     void set_capacity(size_t capacity) override;
     size_t get_memory_usage() const override;
@@ -422,4 +422,56 @@ TEST_F(ChunkTest, test_reset_with_extra_data) {
     ASSERT_TRUE(!chunk1->has_extra_data());
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_selection) {
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+    ASSERT_FALSE(chunk->has_selection());
+    ASSERT_EQ(100, chunk->num_selected_rows());
+
+    // the multiples of 2, the rows are not removed
+    Filter filter(100);
+    for (size_t i = 0; i < 100; i++) {
+        filter[i] = i % 2 == 0;
+    }
+    ASSERT_EQ(50, chunk->select(filter, 0.3));
+    ASSERT_TRUE(chunk->has_selection());
+    ASSERT_EQ(100, chunk->num_rows());
+    ASSERT_EQ(50, chunk->num_selected_rows());
+
+    auto copy = chunk->clone_unique();
+    ASSERT_TRUE(copy->has_selection());
+    ASSERT_EQ(50, copy->num_selected_rows());
+
+    // the multiples of 6, the selection is merged
+    for (size_t i = 0; i < 100; i++) {
+        filter[i] = i % 3 == 0;
+    }
+    ASSERT_EQ(17, chunk->select(filter, 0.1));
+    ASSERT_EQ(100, chunk->num_rows());
+
+    chunk->materialize_selection();
+    ASSERT_FALSE(chunk->has_selection());
+    ASSERT_EQ(17, chunk->num_rows());
+    for (size_t i = 0; i < 17; i++) {
+        ASSERT_EQ(static_cast<int32_t>(i * 6), chunk->get_column_by_index(0)->get(i).get_int32());
+    }
+
+    // materialized once the selected rows are less than the density
+    for (size_t i = 0; i < 100; i++) {
+        filter[i] = i < 30;
+    }
+    ASSERT_EQ(15, copy->select(filter, 0.5));
+    ASSERT_FALSE(copy->has_selection());
+    ASSERT_EQ(15, copy->num_rows());
+
+    // all the rows are selected or not
+    filter.assign(15, 1);
+    ASSERT_EQ(15, copy->select(filter, 0.5));
+    ASSERT_FALSE(copy->has_selection());
+    filter.assign(15, 0);
+    ASSERT_EQ(0, copy->select(filter, 0.5));
+    ASSERT_FALSE(copy->has_selection());
+    ASSERT_EQ(0, copy->num_rows());
+}
+
 } // namespace starrocks
@@ -0,0 +1,168 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/adaptive_conjuncts_evaluator.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "exec/exec_node.h"
+#include "exprs/column_ref.h"
+#include "exprs/expr_context.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+// `slot % modulus == 0`, spinning |spins| times per row to make it expensive.
+class ModuloPredicate final : public Expr {
+public:
+    ModuloPredicate(Expr* column, int32_t modulus, int32_t spins)
+            : Expr(TypeDescriptor(TYPE_BOOLEAN), false), _modulus(modulus), _spins(spins) {
+        add_child(column);
+    }
+
+    Expr* clone(ObjectPool* pool) const override { return nullptr; }
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* chunk) override {
+        ASSIGN_OR_RETURN(ColumnPtr column, get_child(0)->evaluate_checked(context, chunk));
+        const auto& values = down_cast<Int32Column*>(column.get())->get_data();
+        auto result = BooleanColumn::create();
+        for (int32_t value : values) {
+            for (volatile int32_t i = 0; i < _spins; i = i + 1) {
+            }
+            result->append(value % _modulus == 0);
+        }
+        evaluated_rows += values.size();
+        return result;
+    }
+
+    size_t evaluated_rows = 0;
+
+private:
+    const int32_t _modulus;
+    const int32_t _spins;
+};
+
+class AdaptiveConjunctsEvaluatorTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _enable_adaptive_conjuncts_order = config::enable_adaptive_conjuncts_order;
+        config::enable_adaptive_conjuncts_order = true;
+    }
+
+    void TearDown() override {
+        Expr::close(_ctxs, &_runtime_state);
+        config::enable_adaptive_conjuncts_order = _enable_adaptive_conjuncts_order;
+    }
+
+    ModuloPredicate* add_conjunct(SlotId slot_id, int32_t modulus, int32_t spins) {
+        auto* column = _pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), slot_id));
+        auto* expr = _pool.add(new ModuloPredicate(column, modulus, spins));
+        auto* ctx = _pool.add(new ExprContext(expr));
+        CHECK_OK(ctx->prepare(&_runtime_state));
+        CHECK_OK(ctx->open(&_runtime_state));
+        _ctxs.push_back(ctx);
+        return expr;
+    }
+
+    // The chunk of slot 1 and 2 of the values [start, start + num_rows), and slot 3 and more which are not
+    // referenced, so that the chunk is too wide to be pruned eagerly by ExecNode::eval_conjuncts.
+    static ChunkPtr create_chunk(int32_t start, size_t num_rows) {
+        auto chunk = std::make_shared<Chunk>();
+        for (SlotId slot_id = 1; slot_id <= static_cast<SlotId>(ExecNode::kEagerPruneMaxColumnNumber) + 1; ++slot_id) {
+            auto column = Int32Column::create();
+            for (size_t i = 0; i < num_rows; ++i) {
+                column->append(start + static_cast<int32_t>(i));
+            }
+            chunk->append_column(std::move(column), slot_id);
+        }
+        return chunk;
+    }
+
+protected:
+    bool _enable_adaptive_conjuncts_order = true;
+    RuntimeState _runtime_state;
+    ObjectPool _pool;
+    std::vector<ExprContext*> _ctxs;
+};
+
+TEST_F(AdaptiveConjunctsEvaluatorTest, test_reorder) {
+    // the expensive conjunct filtering half of the rows is before the cheap one filtering most of the rows
+    auto* expensive = add_conjunct(1, 2, 200);
+    auto* cheap = add_conjunct(2, 100, 0);
+
+    AdaptiveConjunctsEvaluator evaluator;
+    const size_t num_rows = 4096;
+    for (int32_t i = 0; i < config::adaptive_conjuncts_window_size; ++i) {
+        int32_t start = i * num_rows;
+        auto chunk = create_chunk(start, num_rows);
+        ASSERT_OK(evaluator.eval(_ctxs, chunk.get()));
+        // the multiples of 100
+        size_t expected_rows = (start + num_rows + 99) / 100 - (start + 99) / 100;
+        ASSERT_EQ(expected_rows, chunk->num_rows());
+        ASSERT_EQ(_ctxs[0], evaluator.order()[0]);
+    }
+
+    // the cheap one is evaluated first, and the expensive one is evaluated only on the selected rows
+    expensive->evaluated_rows = 0;
+    cheap->evaluated_rows = 0;
+    auto chunk = create_chunk(0, num_rows);
+    ASSERT_OK(evaluator.eval(_ctxs, chunk.get()));
+    ASSERT_EQ(_ctxs[1], evaluator.order()[0]);
+    ASSERT_EQ(num_rows, cheap->evaluated_rows);
+    ASSERT_EQ(num_rows / 100 + 1, expensive->evaluated_rows);
+    ASSERT_EQ(num_rows / 100 + 1, chunk->num_rows());
+    auto column = chunk->get_column_by_slot_id(3);
+    for (size_t i = 0; i < chunk->num_rows(); ++i) {
+        ASSERT_EQ(static_cast<int32_t>(i * 100), column->get(i).get_int32());
+    }
+}
+
+TEST_F(AdaptiveConjunctsEvaluatorTest, test_filter) {
+    add_conjunct(1, 3, 0);
+    add_conjunct(2, 5, 0);
+    add_conjunct(1, 7, 0);
+
+    AdaptiveConjunctsEvaluator evaluator;
+    for (int32_t i = 0; i < config::adaptive_conjuncts_window_size * 2; ++i) {
+        auto chunk = create_chunk(i * 1000, 1000);
+        auto expected_chunk = chunk->clone_unique();
+        FilterPtr filter;
+        FilterPtr expected_filter;
+        ASSERT_OK(evaluator.eval(_ctxs, chunk.get(), &filter, false));
+        ASSERT_OK(ExecNode::eval_conjuncts(_ctxs, expected_chunk.get(), &expected_filter, false));
+        ASSERT_EQ(1000u, chunk->num_rows());
+        ASSERT_EQ(*expected_filter, *filter);
+
+        ASSERT_OK(evaluator.eval(_ctxs, chunk.get()));
+        ASSERT_OK(ExecNode::eval_conjuncts(_ctxs, expected_chunk.get()));
+        ASSERT_EQ(expected_chunk->num_rows(), chunk->num_rows());
+        for (size_t row = 0; row < chunk->num_rows(); ++row) {
+            ASSERT_EQ(expected_chunk->get_column_by_slot_id(3)->get(row).get_int32(),
+                      chunk->get_column_by_slot_id(3)->get(row).get_int32());
+        }
+    }
+
+    // nothing is selected
+    add_conjunct(2, 1000000, 0);
+    auto chunk = create_chunk(1, 1000);
+    ASSERT_OK(evaluator.eval(_ctxs, chunk.get()));
+    ASSERT_EQ(0u, chunk->num_rows());
+}
+
+} // namespace starrocks
@@ -0,0 +1,420 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exec/hash_joiner.h"
+#include "exec/pipeline/project_operator.h"
+#include "exec/pipeline/query_context.h"
+#include "exec/pipeline/select_operator.h"
+#include "exprs/column_ref.h"
+#include "exprs/expr_context.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks::pipeline {
+
+namespace {
+
+// `slot % modulus != 0`
+class NotMultiplePredicate final : public Expr {
+public:
+    NotMultiplePredicate(Expr* column, int32_t modulus)
+            : Expr(TypeDescriptor(TYPE_BOOLEAN), false), _modulus(modulus) {
+        add_child(column);
+    }
+
+    Expr* clone(ObjectPool* pool) const override { return nullptr; }
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* chunk) override {
+        ASSIGN_OR_RETURN(ColumnPtr column, get_child(0)->evaluate_checked(context, chunk));
+        const auto& values = down_cast<Int32Column*>(ColumnHelper::get_data_column(column.get()))->get_data();
+        auto result = BooleanColumn::create();
+        for (int32_t value : values) {
+            result->append(value % _modulus != 0);
+        }
+        return result;
+    }
+
+private:
+    const int32_t _modulus;
+};
+
+// `slot + 1`, which counts the rows it is evaluated on
+class PlusOneExpr final : public Expr {
+public:
+    explicit PlusOneExpr(Expr* column) : Expr(TypeDescriptor(TYPE_INT), false) { add_child(column); }
+
+    Expr* clone(ObjectPool* pool) const override { return nullptr; }
+
+    StatusOr<ColumnPtr> evaluate_checked(ExprContext* context, Chunk* chunk) override {
+        ASSIGN_OR_RETURN(ColumnPtr column, get_child(0)->evaluate_checked(context, chunk));
+        const auto& values = down_cast<Int32Column*>(column.get())->get_data();
+        auto result = Int32Column::create();
+        for (int32_t value : values) {
+            result->append(value + 1);
+        }
+        evaluated_rows += values.size();
+        return result;
+    }
+
+    size_t evaluated_rows = 0;
+};
+
+} // namespace
+
+class ChunkSelectionTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _enable_chunk_selection = config::enable_chunk_selection;
+        TQueryOptions query_options;
+        query_options.batch_size = config::vector_chunk_size;
+        _runtime_state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        _runtime_state->init_instance_mem_tracker();
+        _runtime_state->set_query_ctx(_query_ctx.get());
+    }
+
+    void TearDown() override {
+        Expr::close(_ctxs, _runtime_state.get());
+        config::enable_chunk_selection = _enable_chunk_selection;
+    }
+
+protected:
+    ColumnRef* column_ref(SlotId slot_id) { return _pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), slot_id)); }
+
+    ExprContext* create_ctx(Expr* expr) {
+        auto* ctx = _pool.add(new ExprContext(expr));
+        CHECK_OK(ctx->prepare(_runtime_state.get()));
+        CHECK_OK(ctx->open(_runtime_state.get()));
+        _ctxs.push_back(ctx);
+        return ctx;
+    }
+
+    // The chunk of the INT slots |slot_ids| of the values [start, start + num_rows), the value of the first slot
+    // is null in every |null_step| rows if |null_step| is not 0.
+    static ChunkPtr create_chunk(const std::vector<SlotId>& slot_ids, int32_t start, size_t num_rows,
+                                 size_t null_step = 0) {
+        auto chunk = std::make_shared<Chunk>();
+        for (SlotId slot_id : slot_ids) {
+            auto column = Int32Column::create();
+            for (size_t i = 0; i < num_rows; ++i) {
+                column->append(start + static_cast<int32_t>(i));
+            }
+            if (null_step > 0 && slot_id == slot_ids[0]) {
+                auto nulls = NullColumn::create(num_rows, 0);
+                for (size_t i = 0; i < num_rows; i += null_step) {
+                    nulls->get_data()[i] = 1;
+                }
+                chunk->append_column(NullableColumn::create(std::move(column), std::move(nulls)), slot_id);
+            } else {
+                chunk->append_column(std::move(column), slot_id);
+            }
+        }
+        return chunk;
+    }
+
+    // The filter of the rows whose value of |slot_id| is not a multiple of |modulus|.
+    static Filter not_multiple_filter(const Chunk& chunk, SlotId slot_id, int32_t modulus) {
+        const Column* column = ColumnHelper::get_data_column(chunk.get_column_by_slot_id(slot_id).get());
+        const auto& values = down_cast<const Int32Column*>(column)->get_data();
+        Filter filter(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            filter[i] = values[i] % modulus != 0;
+        }
+        return filter;
+    }
+
+    // Filter the rows of |chunk| by |filter|, by the selection or by compacting the columns.
+    static void apply_filter(Chunk* chunk, const Filter& filter, bool use_selection) {
+        if (use_selection) {
+            chunk->select(filter, 0);
+            ASSERT_TRUE(chunk->has_selection());
+        } else {
+            chunk->filter(filter);
+        }
+    }
+
+    // The selected rows of the chunks.
+    static std::vector<std::string> selected_rows(const std::vector<ChunkPtr>& chunks) {
+        std::vector<std::string> rows;
+        for (const auto& chunk : chunks) {
+            auto copy = chunk->clone_unique();
+            copy->materialize_selection();
+            for (size_t i = 0; i < copy->num_rows(); ++i) {
+                rows.emplace_back(copy->debug_row(i));
+            }
+        }
+        return rows;
+    }
+
+    // Push the chunks to |op| and pull its output. The selection of a chunk is materialized before it's pushed
+    // if |op| doesn't accept it, which is what PipelineDriver does.
+    StatusOr<std::vector<ChunkPtr>> run(Operator* op, const std::vector<ChunkPtr>& chunks) {
+        std::vector<ChunkPtr> outputs;
+        auto pull = [&]() -> Status {
+            ASSIGN_OR_RETURN(auto output, op->pull_chunk(_runtime_state.get()));
+            if (output != nullptr && output->num_rows() > 0) {
+                outputs.emplace_back(std::move(output));
+            }
+            return Status::OK();
+        };
+        for (const auto& chunk : chunks) {
+            if (!op->need_input()) {
+                RETURN_IF_ERROR(pull());
+            }
+            if (chunk->has_selection() && !op->accept_chunk_selection()) {
+                chunk->materialize_selection();
+            }
+            RETURN_IF_ERROR(op->push_chunk(_runtime_state.get(), chunk));
+            RETURN_IF_ERROR(pull());
+        }
+        RETURN_IF_ERROR(op->set_finishing(_runtime_state.get()));
+        while (op->has_output()) {
+            RETURN_IF_ERROR(pull());
+        }
+        return outputs;
+    }
+
+    bool _enable_chunk_selection = false;
+    std::unique_ptr<QueryContext> _query_ctx = std::make_unique<QueryContext>();
+    std::shared_ptr<RuntimeState> _runtime_state;
+    ObjectPool _pool;
+    std::vector<ExprContext*> _ctxs;
+};
+
+TEST_F(ChunkSelectionTest, test_select_operator) {
+    SelectOperatorFactory factory(1, 1, {create_ctx(_pool.add(new NotMultiplePredicate(column_ref(1), 3)))});
+    std::vector<std::string> expected;
+    for (bool enable_chunk_selection : {false, true}) {
+        config::enable_chunk_selection = enable_chunk_selection;
+        auto op = factory.create(1, 0);
+        ASSERT_OK(op->prepare(_runtime_state.get()));
+        // the large chunk is output as it is, and the small ones are merged
+        std::vector<ChunkPtr> chunks{create_chunk({1, 2}, 0, 4096), create_chunk({1, 2}, 4096, 100),
+                                     create_chunk({1, 2}, 4196, 100), create_chunk({1, 2}, 4296, 4096)};
+        ASSIGN_OR_ABORT(auto outputs, run(op.get(), chunks));
+        ASSERT_FALSE(outputs.empty());
+        ASSERT_EQ(enable_chunk_selection, outputs[0]->has_selection());
+        ASSERT_EQ(enable_chunk_selection ? 4096 : 2730, outputs[0]->num_rows());
+        ASSERT_EQ(2730, outputs[0]->num_selected_rows());
+        auto rows = selected_rows(outputs);
+        if (enable_chunk_selection) {
+            ASSERT_EQ(expected, rows);
+        } else {
+            expected = std::move(rows);
+        }
+        op->close(_runtime_state.get());
+    }
+    // the rows of [0, 8392) which are not multiples of 3
+    ASSERT_EQ(8392 - 2798, expected.size());
+
+    // most of the rows are filtered, the selection is materialized at once
+    config::enable_chunk_selection = true;
+    SelectOperatorFactory sparse_factory(2, 2,
+                                         {create_ctx(_pool.add(new NotMultiplePredicate(column_ref(1), 4))),
+                                          create_ctx(_pool.add(new NotMultiplePredicate(column_ref(2), 3))),
+                                          create_ctx(_pool.add(new NotMultiplePredicate(column_ref(2), 2)))});
+    auto op = sparse_factory.create(1, 0);
+    ASSERT_OK(op->prepare(_runtime_state.get()));
+    ASSIGN_OR_ABORT(auto outputs, run(op.get(), {create_chunk({1, 2}, 0, 4096)}));
+    ASSERT_EQ(1, outputs.size());
+    ASSERT_FALSE(outputs[0]->has_selection());
+    // the odd numbers of [0, 4096) which are not multiples of 3
+    ASSERT_EQ(1365, outputs[0]->num_rows());
+    op->close(_runtime_state.get());
+}
+
+TEST_F(ChunkSelectionTest, test_project_operator_pass_through) {
+    ProjectOperatorFactory factory(1, 1, {10, 11}, {create_ctx(column_ref(2)), create_ctx(column_ref(1))},
+                                   {false, false}, {}, {});
+    std::vector<std::string> expected;
+    for (bool use_selection : {false, true}) {
+        auto op = factory.create(1, 0);
+        ASSERT_OK(op->prepare(_runtime_state.get()));
+        ASSERT_TRUE(op->accept_chunk_selection());
+        auto chunk = create_chunk({1, 2, 3}, 0, 4096);
+        apply_filter(chunk.get(), not_multiple_filter(*chunk, 1, 3), use_selection);
+        ASSIGN_OR_ABORT(auto outputs, run(op.get(), {chunk}));
+        ASSERT_EQ(1, outputs.size());
+        // the slot refs are projected without compacting the columns
+        ASSERT_EQ(use_selection, outputs[0]->has_selection());
+        ASSERT_EQ(use_selection ? 4096 : 2730, outputs[0]->num_rows());
+        ASSERT_EQ(2730, outputs[0]->num_selected_rows());
+        ASSERT_EQ(2, outputs[0]->num_columns());
+        ASSERT_TRUE(outputs[0]->is_slot_exist(10));
+        ASSERT_TRUE(outputs[0]->is_slot_exist(11));
+        auto rows = selected_rows(outputs);
+        if (use_selection) {
+            ASSERT_EQ(expected, rows);
+        } else {
+            expected = std::move(rows);
+        }
+        op->close(_runtime_state.get());
+    }
+}
+
+TEST_F(ChunkSelectionTest, test_project_operator_materialize) {
+    auto* plus_one = _pool.add(new PlusOneExpr(column_ref(1)));
+    ProjectOperatorFactory factory(1, 1, {10, 11}, {create_ctx(plus_one), create_ctx(column_ref(2))},
+                                   {false, true}, {}, {});
+    std::vector<std::string> expected;
+    for (bool use_selection : {false, true}) {
+        plus_one->evaluated_rows = 0;
+        auto op = factory.create(1, 0);
+        ASSERT_OK(op->prepare(_runtime_state.get()));
+        auto chunk = create_chunk({1, 2, 3}, 0, 4096);
+        apply_filter(chunk.get(), not_multiple_filter(*chunk, 2, 3), use_selection);
+        ASSIGN_OR_ABORT(auto outputs, run(op.get(), {chunk}));
+        ASSERT_EQ(1, outputs.size());
+        // the expression is only evaluated on the selected rows
+        ASSERT_FALSE(outputs[0]->has_selection());
+        ASSERT_EQ(2730, outputs[0]->num_rows());
+        ASSERT_EQ(2730, plus_one->evaluated_rows);
+        ASSERT_TRUE(outputs[0]->get_column_by_slot_id(11)->is_nullable());
+        auto rows = selected_rows(outputs);
+        if (use_selection) {
+            ASSERT_EQ(expected, rows);
+        } else {
+            expected = std::move(rows);
+        }
+        op->close(_runtime_state.get());
+    }
+}
+
+class HashJoinChunkSelectionTest : public ChunkSelectionTest {
+protected:
+    // The probe side is the tuple 0 of the slots 0 (the key) and 1, and the build side is the tuple 1 of the slots
+    // 2 (the key) and 3.
+    void create_descriptors(bool nullable_probe_key) {
+        TDescriptorTableBuilder desc_builder;
+        for (int tuple = 0; tuple < 2; ++tuple) {
+            TTupleDescriptorBuilder tuple_builder;
+            for (int i = 0; i < 2; ++i) {
+                tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                               .type(TYPE_INT)
+                                               .column_name("c" + std::to_string(i))
+                                               .column_pos(i)
+                                               .nullable(tuple == 0 && i == 0 && nullable_probe_key)
+                                               .build());
+            }
+            tuple_builder.build(&desc_builder);
+        }
+        DescriptorTbl* tbl = nullptr;
+        CHECK_OK(DescriptorTbl::create(_runtime_state.get(), &_pool, desc_builder.desc_tbl(), &tbl,
+                                       config::vector_chunk_size));
+        _row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0, 1}, std::vector<bool>{false, false});
+        _probe_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0}, std::vector<bool>{false});
+        _build_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{1}, std::vector<bool>{false});
+    }
+
+    std::unique_ptr<HashJoiner> create_joiner(TJoinOp::type join_type) {
+        _join_node.join_op = join_type;
+        _join_node.__set_distribution_mode(TJoinDistributionMode::BROADCAST);
+        HashJoinerParam param(&_pool, _join_node, 1, TPlanNodeType::HASH_JOIN_NODE, {false},
+                              {create_ctx(column_ref(2))}, {create_ctx(column_ref(0))}, {}, {}, *_build_row_desc,
+                              *_probe_row_desc, *_row_desc, TPlanNodeType::OLAP_SCAN_NODE,
+                              TPlanNodeType::OLAP_SCAN_NODE, true, {}, {}, {}, TJoinDistributionMode::BROADCAST,
+                              false);
+        return std::make_unique<HashJoiner>(param);
+    }
+
+    // Join the probe rows [0, 3000), of the keys [0, 3000) and null in every 7 rows if |nullable_probe_key|, to
+    // the build rows of the keys [1000, 2000), after filtering the probe rows of the multiples of 3 by the
+    // selection or by compacting the columns. The probe side is pushed in chunks of 1000 rows.
+    StatusOr<std::vector<std::string>> join(TJoinOp::type join_type, bool nullable_probe_key, bool use_selection) {
+        create_descriptors(nullable_probe_key);
+        auto joiner = create_joiner(join_type);
+        RuntimeProfile profile("join");
+        RETURN_IF_ERROR(joiner->prepare_builder(_runtime_state.get(), &profile));
+        RETURN_IF_ERROR(joiner->prepare_prober(_runtime_state.get(), &profile));
+        RETURN_IF_ERROR(joiner->append_chunk_to_ht(create_chunk({2, 3}, 1000, 1000)));
+        RETURN_IF_ERROR(joiner->build_ht(_runtime_state.get()));
+        joiner->enter_probe_phase();
+
+        std::vector<ChunkPtr> outputs;
+        for (int32_t start = 0; start < 3000; start += 1000) {
+            auto chunk = create_chunk({0, 1}, start, 1000, nullable_probe_key ? 7 : 0);
+            apply_filter(chunk.get(), not_multiple_filter(*chunk, 1, 3), use_selection);
+            // see HashJoinProbeOperator::accept_chunk_selection()
+            if (!joiner->accept_probe_selection()) {
+                chunk->materialize_selection();
+            }
+            RETURN_IF_ERROR(joiner->push_chunk(_runtime_state.get(), std::move(chunk)));
+            while (joiner->has_output()) {
+                ASSIGN_OR_RETURN(auto output, joiner->pull_chunk(_runtime_state.get()));
+                outputs.emplace_back(std::move(output));
+            }
+        }
+        joiner->enter_post_probe_phase();
+        while (!joiner->is_done()) {
+            ASSIGN_OR_RETURN(auto output, joiner->pull_chunk(_runtime_state.get()));
+            outputs.emplace_back(std::move(output));
+        }
+        auto rows = selected_rows(outputs);
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    THashJoinNode _join_node;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<RowDescriptor> _probe_row_desc;
+    std::unique_ptr<RowDescriptor> _build_row_desc;
+};
+
+TEST_F(HashJoinChunkSelectionTest, test_accept_probe_selection) {
+    create_descriptors(false);
+    for (auto join_type : {TJoinOp::INNER_JOIN, TJoinOp::LEFT_SEMI_JOIN, TJoinOp::RIGHT_SEMI_JOIN,
+                           TJoinOp::RIGHT_OUTER_JOIN}) {
+        ASSERT_TRUE(create_joiner(join_type)->accept_probe_selection()) << join_type;
+    }
+    // the probe rows not matched are output, so the rows not selected must not be probed
+    for (auto join_type : {TJoinOp::LEFT_OUTER_JOIN, TJoinOp::FULL_OUTER_JOIN, TJoinOp::LEFT_ANTI_JOIN,
+                           TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN, TJoinOp::RIGHT_ANTI_JOIN}) {
+        ASSERT_FALSE(create_joiner(join_type)->accept_probe_selection()) << join_type;
+    }
+}
+
+TEST_F(HashJoinChunkSelectionTest, test_push_probe_chunk) {
+    // the number of the probe rows in [1000, 2000) which are not multiples of 3
+    const size_t num_matched = 1000 - 333;
+    const std::vector<std::pair<TJoinOp::type, size_t>> join_types{
+            {TJoinOp::INNER_JOIN, num_matched},
+            {TJoinOp::LEFT_SEMI_JOIN, num_matched},
+            {TJoinOp::RIGHT_SEMI_JOIN, num_matched},
+            {TJoinOp::RIGHT_OUTER_JOIN, 1000},
+            {TJoinOp::LEFT_OUTER_JOIN, 2000},
+            {TJoinOp::FULL_OUTER_JOIN, 2000 + 333},
+            {TJoinOp::LEFT_ANTI_JOIN, 2000 - num_matched},
+            {TJoinOp::RIGHT_ANTI_JOIN, 333}};
+    for (bool nullable_probe_key : {false, true}) {
+        for (const auto& [join_type, num_rows] : join_types) {
+            ASSIGN_OR_ABORT(auto expected, join(join_type, nullable_probe_key, false));
+            ASSIGN_OR_ABORT(auto rows, join(join_type, nullable_probe_key, true));
+            ASSERT_EQ(expected, rows) << join_type << " " << nullable_probe_key;
+            if (!nullable_probe_key) {
+                ASSERT_EQ(num_rows, rows.size()) << join_type;
+            }
+        }
+    }
+}
+
+} // namespace starrocks::pipeline
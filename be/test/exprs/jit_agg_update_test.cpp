@@ -0,0 +1,165 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "exprs/jit/jit_engine.h"
+#include "testutil/assert.h"
+#include "testutil/function_utils.h"
+
+namespace starrocks {
+
+class JITAggUpdateTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        utils = std::make_unique<FunctionUtils>();
+        ctx = utils->get_fn_ctx();
+    }
+
+protected:
+    std::unique_ptr<FunctionUtils> utils;
+    FunctionContext* ctx = nullptr;
+};
+
+// The states updated by the fused loop are the same as the ones updated by update_batch.
+TEST_F(JITAggUpdateTest, test_fused_update) {
+    if (!JITEngine::get_instance()->support_jit()) {
+        GTEST_SKIP() << "JIT is not supported";
+    }
+    const size_t num_rows = 4096;
+    const size_t num_groups = 10;
+
+    // sum(nullable int), count(*), count(nullable int), min(double), max(nullable bigint), avg(int)
+    std::vector<const AggregateFunction*> functions = {
+            get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true),
+            get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, false),
+            get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true),
+            get_aggregate_function("min", TYPE_DOUBLE, TYPE_DOUBLE, false),
+            get_aggregate_function("max", TYPE_BIGINT, TYPE_BIGINT, true),
+            get_aggregate_function("avg", TYPE_INT, TYPE_DOUBLE, false),
+    };
+    std::vector<size_t> offsets;
+    size_t row_size = 0;
+    for (const auto* function : functions) {
+        ASSERT_NE(nullptr, function);
+        size_t align = function->alignof_size();
+        row_size = (row_size + align - 1) / align * align;
+        offsets.push_back(row_size);
+        row_size += function->size();
+    }
+    row_size = (row_size + 15) / 16 * 16;
+
+    std::vector<AggStateUpdateLayout> layouts(functions.size());
+    for (size_t i = 0; i < functions.size(); i++) {
+        ASSERT_TRUE(functions[i]->get_update_layout(&layouts[i])) << functions[i]->get_name();
+        layouts[i].value_offset += offsets[i];
+        layouts[i].count_offset += offsets[i];
+        if (layouts[i].null_flag_offset >= 0) {
+            layouts[i].null_flag_offset += offsets[i];
+        }
+    }
+    ASSERT_TRUE(layouts[0].skip_null);
+    ASSERT_GE(layouts[0].null_flag_offset, 0);
+    ASSERT_FALSE(layouts[1].skip_null);
+    ASSERT_TRUE(layouts[2].skip_null);
+    ASSERT_LT(layouts[2].null_flag_offset, 0);
+
+    // the rows of the last group are all null in |ints|
+    auto ints = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    auto doubles = DoubleColumn::create();
+    auto bigints = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    auto plain_ints = Int32Column::create();
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i % 7 == 0 || i % num_groups == num_groups - 1) {
+            ints->append_nulls(1);
+        } else {
+            ints->append_datum(Datum(static_cast<int32_t>(i % 100) - 50));
+        }
+        doubles->append(static_cast<double>(i * 37 % 101) - 0.5);
+        if (i % 5 == 0) {
+            bigints->append_nulls(1);
+        } else {
+            bigints->append_datum(Datum(static_cast<int64_t>(i * 7919 % 1000) - 500));
+        }
+        plain_ints->append(static_cast<int32_t>(i));
+    }
+    std::vector<std::vector<const Column*>> inputs = {{ints.get()}, {},           {ints.get()},
+                                                      {doubles.get()}, {bigints.get()}, {plain_ints.get()}};
+
+    std::vector<uint64_t> expected_buffer(num_groups * row_size / sizeof(uint64_t), 0);
+    std::vector<uint64_t> actual_buffer(num_groups * row_size / sizeof(uint64_t), 0);
+    auto* expected_base = reinterpret_cast<AggDataPtr>(expected_buffer.data());
+    auto* actual_base = reinterpret_cast<AggDataPtr>(actual_buffer.data());
+    for (size_t g = 0; g < num_groups; g++) {
+        for (size_t i = 0; i < functions.size(); i++) {
+            functions[i]->create(ctx, expected_base + g * row_size + offsets[i]);
+            functions[i]->create(ctx, actual_base + g * row_size + offsets[i]);
+        }
+    }
+    std::vector<AggDataPtr> expected_states(num_rows);
+    std::vector<AggDataPtr> actual_states(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        expected_states[i] = expected_base + (i % num_groups) * row_size;
+        actual_states[i] = actual_base + (i % num_groups) * row_size;
+    }
+
+    for (size_t i = 0; i < functions.size(); i++) {
+        functions[i]->update_batch(ctx, num_rows, offsets[i], inputs[i].data(), expected_states.data());
+    }
+
+    auto cache = std::make_shared<JitObjectCache>(JITEngine::agg_update_func_name(layouts),
+                                                  JITEngine::get_instance()->get_func_cache());
+    ASSERT_OK(JITEngine::compile_agg_update_function(layouts, cache.get()));
+    auto function = cache->get_agg_update_func();
+    ASSERT_NE(nullptr, function);
+
+    std::vector<uint8_t> zero_null_flags(num_rows, 0);
+    std::vector<JITColumn> jit_columns(functions.size());
+    for (size_t i = 0; i < functions.size(); i++) {
+        if (inputs[i].empty()) {
+            continue;
+        }
+        const Column* data_column = inputs[i][0];
+        const uint8_t* null_flags = layouts[i].skip_null ? zero_null_flags.data() : nullptr;
+        if (inputs[i][0]->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(inputs[i][0]);
+            data_column = nullable_column->data_column().get();
+            null_flags = nullable_column->null_column()->raw_data();
+        }
+        jit_columns[i].datums = reinterpret_cast<const int8_t*>(data_column->raw_data());
+        jit_columns[i].null_flags = reinterpret_cast<const int8_t*>(null_flags);
+    }
+    function(num_rows, jit_columns.data(), actual_states.data());
+
+    for (size_t g = 0; g < num_groups; g++) {
+        for (size_t i = 0; i < functions.size(); i++) {
+            ASSERT_EQ(0, memcmp(expected_base + g * row_size + offsets[i], actual_base + g * row_size + offsets[i],
+                                functions[i]->size()))
+                    << "group=" << g << " function=" << functions[i]->get_name();
+        }
+    }
+
+    // the compiled function is cached
+    auto cached = std::make_shared<JitObjectCache>(JITEngine::agg_update_func_name(layouts),
+                                                   JITEngine::get_instance()->get_func_cache());
+    ASSERT_TRUE(JITEngine::get_instance()->lookup_function(cached.get()));
+    ASSERT_EQ(function, cached->get_agg_update_func());
+}
+
+} // namespace starrocks
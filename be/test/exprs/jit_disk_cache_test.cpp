@@ -0,0 +1,156 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/jit/jit_disk_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "fmt/format.h"
+#include "fs/fs_util.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class JitDiskCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        _test_dir = fmt::format("{}/jit_disk_cache_test", std::filesystem::current_path().string());
+        CHECK_OK(fs::remove_all(_test_dir));
+    }
+
+    void TearDown() override { ASSERT_OK(fs::remove_all(_test_dir)); }
+
+    static llvm::MemoryBufferRef to_ref(const std::string& data) {
+        return llvm::MemoryBufferRef(llvm::StringRef(data), "test");
+    }
+
+    static std::string to_string(const std::unique_ptr<llvm::MemoryBuffer>& buffer) {
+        return buffer == nullptr ? "" : buffer->getBuffer().str();
+    }
+
+protected:
+    std::string _test_dir;
+};
+
+TEST_F(JitDiskCacheTest, test_insert_and_lookup) {
+    std::string obj1(1000, 'a');
+    std::string obj2(2000, 'b');
+    // the key of 2 bytes and the checksum are kept in the file
+    int64_t file_size1 = obj1.size() + 2 * sizeof(uint32_t) + 2;
+    int64_t file_size2 = obj2.size() + 2 * sizeof(uint32_t) + 2;
+    {
+        JitDiskCache cache(_test_dir, 1L << 20);
+        ASSERT_EQ(nullptr, cache.lookup("f1"));
+        ASSERT_OK(cache.insert("f1", to_ref(obj1)));
+        ASSERT_OK(cache.insert("f2", to_ref(obj2)));
+        ASSERT_EQ(obj1, to_string(cache.lookup("f1")));
+        ASSERT_EQ(obj2, to_string(cache.lookup("f2")));
+        ASSERT_EQ(2u, cache.num_objects());
+        ASSERT_EQ(file_size1 + file_size2, cache.size());
+
+        // overwrite
+        ASSERT_OK(cache.insert("f1", to_ref(obj2)));
+        ASSERT_EQ(obj2, to_string(cache.lookup("f1")));
+        ASSERT_EQ(2u, cache.num_objects());
+        ASSERT_EQ(file_size2 * 2, cache.size());
+    }
+
+    // the objects are loaded by a new cache of the same directory, e.g. after restart
+    JitDiskCache cache(_test_dir, 1L << 20);
+    ASSERT_EQ(obj2, to_string(cache.lookup("f1")));
+    ASSERT_EQ(obj2, to_string(cache.lookup("f2")));
+    ASSERT_EQ(nullptr, cache.lookup("f3"));
+    ASSERT_EQ(2u, cache.num_objects());
+
+    cache.erase("f1");
+    ASSERT_EQ(nullptr, cache.lookup("f1"));
+    ASSERT_EQ(1u, cache.num_objects());
+    ASSERT_EQ(file_size2, cache.size());
+}
+
+TEST_F(JitDiskCacheTest, test_evict) {
+    std::string obj(1000, 'x');
+    int64_t file_size = obj.size() + 2 * sizeof(uint32_t) + 2;
+    JitDiskCache cache(_test_dir, file_size * 3);
+    ASSERT_OK(cache.insert("f1", to_ref(obj)));
+    ASSERT_OK(cache.insert("f2", to_ref(obj)));
+    ASSERT_OK(cache.insert("f3", to_ref(obj)));
+    // f1 becomes the most recently used one, so f2 is evicted
+    ASSERT_NE(nullptr, cache.lookup("f1"));
+    ASSERT_OK(cache.insert("f4", to_ref(obj)));
+    ASSERT_EQ(3u, cache.num_objects());
+    ASSERT_EQ(file_size * 3, cache.size());
+    ASSERT_EQ(nullptr, cache.lookup("f2"));
+    ASSERT_NE(nullptr, cache.lookup("f1"));
+    ASSERT_NE(nullptr, cache.lookup("f3"));
+    ASSERT_NE(nullptr, cache.lookup("f4"));
+
+    // shrink the capacity
+    cache.set_capacity(file_size);
+    ASSERT_OK(cache.insert("f5", to_ref(obj)));
+    ASSERT_EQ(1u, cache.num_objects());
+    ASSERT_NE(nullptr, cache.lookup("f5"));
+
+    // an object larger than the capacity is not kept
+    ASSERT_OK(cache.insert("f6", to_ref(std::string(2000, 'y'))));
+    ASSERT_EQ(nullptr, cache.lookup("f6"));
+    ASSERT_EQ(0, cache.size());
+}
+
+TEST_F(JitDiskCacheTest, test_key_mismatch) {
+    std::string obj(100, 'a');
+    JitDiskCache cache(_test_dir, 1L << 20);
+    ASSERT_OK(cache.insert("f1", to_ref(obj)));
+
+    // replace the content of the file with the one of another key
+    std::string file_name;
+    for (const auto& entry : std::filesystem::directory_iterator(_test_dir)) {
+        file_name = entry.path().string();
+    }
+    ASSERT_FALSE(file_name.empty());
+    {
+        JitDiskCache other(_test_dir + "_other", 1L << 20);
+        ASSERT_OK(other.insert("f2", to_ref(obj)));
+        for (const auto& entry : std::filesystem::directory_iterator(_test_dir + "_other")) {
+            std::filesystem::copy_file(entry.path(), file_name, std::filesystem::copy_options::overwrite_existing);
+        }
+        ASSERT_OK(fs::remove_all(_test_dir + "_other"));
+    }
+    ASSERT_EQ(nullptr, cache.lookup("f1"));
+}
+
+TEST_F(JitDiskCacheTest, test_checksum_mismatch) {
+    std::string obj(100, 'a');
+    JitDiskCache cache(_test_dir, 1L << 20);
+    ASSERT_OK(cache.insert("f1", to_ref(obj)));
+    ASSERT_EQ(obj, to_string(cache.lookup("f1")));
+
+    // corrupt the last byte of the object code
+    std::string file_name;
+    for (const auto& entry : std::filesystem::directory_iterator(_test_dir)) {
+        file_name = entry.path().string();
+    }
+    ASSERT_FALSE(file_name.empty());
+    {
+        std::fstream file(file_name, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('b');
+    }
+    ASSERT_EQ(nullptr, cache.lookup("f1"));
+}
+
+} // namespace starrocks
@@ -0,0 +1,212 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exprs/exprs_test_helper.h"
+#include "exprs/function_call_expr.h"
+#include "exprs/literal.h"
+#include "exprs/mock_vectorized_expr.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class JITFunctionTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _runtime_state.set_jit_level(-1);
+        _datetimes = NullableColumn::create(TimestampColumn::create(), NullColumn::create());
+        _dates = DateColumn::create();
+        _ints = Int32Column::create();
+        for (int i = 0; i < 1000; i++) {
+            int year = 1900 + i % 200;
+            int month = i % 12 + 1;
+            int day = i % 28 + 1;
+            if (i % 17 == 0) {
+                _datetimes->append_nulls(1);
+            } else if (i % 101 == 0) {
+                _datetimes->append_datum(Datum(TimestampValue::create(9999, 12, 31, 23, 59, 59, 999999)));
+            } else {
+                _datetimes->append_datum(
+                        Datum(TimestampValue::create(year, month, day, i % 24, i % 60, (i * 7) % 60, i * 1000)));
+            }
+            if (year % 4 == 0 && year != 1900) {
+                _dates->append(DateValue::create(year, 2, 29));
+            } else {
+                _dates->append(DateValue::create(year, month, day));
+            }
+            _ints->append(i % 2 == 0 ? i * 37 : -i * 37);
+        }
+    }
+
+    Expr* create_function(int64_t fid, const std::string& name, TPrimitiveType::type result_type,
+                          const std::vector<Expr*>& children) {
+        TFunctionName function_name;
+        function_name.__set_function_name(name);
+        TFunction function;
+        function.__set_name(function_name);
+        function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        function.__set_fid(fid);
+
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::FUNCTION_CALL);
+        node.__set_type(gen_type_desc(result_type));
+        node.__set_is_nullable(true);
+        node.__set_fn(function);
+        auto* expr = _pool.add(new VectorizedFunctionCallExpr(node));
+        for (auto* child : children) {
+            expr->add_child(child);
+        }
+        return expr;
+    }
+
+    Expr* create_column(TPrimitiveType::type type, const ColumnPtr& column) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(gen_type_desc(type));
+        node.__set_is_nullable(column->is_nullable());
+        return _pool.add(new MockColumnExpr(node, column));
+    }
+
+    Expr* create_string_literal(const std::string& value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::STRING_LITERAL);
+        node.__set_type(gen_type_desc(TPrimitiveType::VARCHAR));
+        node.__set_is_nullable(false);
+        TStringLiteral literal;
+        literal.__set_value(value);
+        node.__set_string_literal(literal);
+        return _pool.add(new VectorizedLiteral(node));
+    }
+
+    // Evaluate |expr| without JIT, and compare the result with the one of JIT.
+    void verify(Expr* expr) {
+        ASSERT_TRUE(expr->is_compilable(&_runtime_state));
+        ExprContext context(expr);
+        std::vector<ExprContext*> contexts = {&context};
+        ASSERT_OK(Expr::prepare(contexts, &_runtime_state));
+        ASSERT_OK(Expr::open(contexts, &_runtime_state));
+        ASSIGN_OR_ABORT(auto result, context.evaluate(nullptr));
+        ExprsTestHelper::verify_result_with_jit(result, expr, &_runtime_state);
+        Expr::close(contexts, &_runtime_state);
+    }
+
+protected:
+    RuntimeState _runtime_state;
+    ObjectPool _pool;
+    NullableColumn::Ptr _datetimes;
+    DateColumn::Ptr _dates;
+    Int32Column::Ptr _ints;
+};
+
+TEST_F(JITFunctionTest, test_date_time_functions) {
+    struct Function {
+        int64_t fid;
+        std::string name;
+        TPrimitiveType::type result_type;
+    };
+    std::vector<Function> datetime_functions = {
+            {50010, "year", TPrimitiveType::INT},      {50009, "year", TPrimitiveType::SMALLINT},
+            {50030, "quarter", TPrimitiveType::INT},   {50020, "month", TPrimitiveType::INT},
+            {50061, "day", TPrimitiveType::INT},       {50058, "day", TPrimitiveType::TINYINT},
+            {50070, "hour", TPrimitiveType::INT},      {50080, "minute", TPrimitiveType::INT},
+            {50090, "second", TPrimitiveType::INT},    {50050, "to_date", TPrimitiveType::DATE},
+            {50069, "hour", TPrimitiveType::TINYINT},  {50089, "second", TPrimitiveType::TINYINT},
+            {50079, "minute", TPrimitiveType::TINYINT}};
+    for (const auto& function : datetime_functions) {
+        auto* expr = create_function(function.fid, function.name, function.result_type,
+                                     {create_column(TPrimitiveType::DATETIME, _datetimes)});
+        verify(expr);
+    }
+
+    std::vector<Function> date_functions = {{50008, "year", TPrimitiveType::SMALLINT},
+                                            {50018, "month", TPrimitiveType::TINYINT},
+                                            {50057, "day", TPrimitiveType::TINYINT},
+                                            {50231, "to_days", TPrimitiveType::INT}};
+    for (const auto& function : date_functions) {
+        auto* expr = create_function(function.fid, function.name, function.result_type,
+                                     {create_column(TPrimitiveType::DATE, _dates)});
+        verify(expr);
+    }
+
+    // the results out of the range of DATETIME are null
+    std::vector<Function> add_functions = {{50140, "days_add", TPrimitiveType::DATETIME},
+                                           {50141, "days_sub", TPrimitiveType::DATETIME},
+                                           {50150, "hours_add", TPrimitiveType::DATETIME},
+                                           {50151, "hours_sub", TPrimitiveType::DATETIME},
+                                           {50160, "minutes_add", TPrimitiveType::DATETIME},
+                                           {50171, "seconds_sub", TPrimitiveType::DATETIME}};
+    for (const auto& function : add_functions) {
+        auto* expr = create_function(
+                function.fid, function.name, function.result_type,
+                {create_column(TPrimitiveType::DATETIME, _datetimes), create_column(TPrimitiveType::INT, _ints)});
+        verify(expr);
+    }
+
+    // year(days_add(dt, n)) is compiled into one function
+    auto* days_add = create_function(
+            50140, "days_add", TPrimitiveType::DATETIME,
+            {create_column(TPrimitiveType::DATETIME, _datetimes), create_column(TPrimitiveType::INT, _ints)});
+    verify(create_function(50010, "year", TPrimitiveType::INT, {days_add}));
+}
+
+TEST_F(JITFunctionTest, test_string_functions) {
+    auto strings = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    auto patterns = BinaryColumn::create();
+    for (int i = 0; i < 1000; i++) {
+        std::string value = std::string(i % 7, 'a') + std::to_string(i);
+        if (i % 13 == 0) {
+            strings->append_nulls(1);
+        } else {
+            strings->append_datum(Datum(Slice(value)));
+        }
+        patterns->append(i % 3 == 0 ? value.substr(0, i % 5) : value.substr(value.size() - i % 4));
+    }
+
+    verify(create_function(30120, "length", TPrimitiveType::INT,
+                           {create_column(TPrimitiveType::VARCHAR, strings)}));
+    for (const auto& prefix : {"", "a", "aaa", "aaaaaaaaaa"}) {
+        verify(create_function(30050, "starts_with", TPrimitiveType::BOOLEAN,
+                               {create_column(TPrimitiveType::VARCHAR, strings), create_string_literal(prefix)}));
+    }
+    verify(create_function(30050, "starts_with", TPrimitiveType::BOOLEAN,
+                           {create_column(TPrimitiveType::VARCHAR, strings),
+                            create_column(TPrimitiveType::VARCHAR, patterns)}));
+    verify(create_function(30040, "ends_with", TPrimitiveType::BOOLEAN,
+                           {create_column(TPrimitiveType::VARCHAR, strings),
+                            create_column(TPrimitiveType::VARCHAR, patterns)}));
+}
+
+TEST_F(JITFunctionTest, test_func_name) {
+    auto* expr = create_function(30050, "starts_with", TPrimitiveType::BOOLEAN,
+                                 {create_column(TPrimitiveType::VARCHAR, BinaryColumn::create()),
+                                  create_string_literal("a]}")});
+    auto* other = create_function(30050, "starts_with", TPrimitiveType::BOOLEAN,
+                                  {create_column(TPrimitiveType::VARCHAR, BinaryColumn::create()),
+                                   create_string_literal("a")});
+    ASSERT_NE(expr->jit_func_name(&_runtime_state), other->jit_func_name(&_runtime_state));
+
+    // the functions without IR are not compilable
+    auto* substr = create_function(30012, "substring", TPrimitiveType::VARCHAR,
+                                   {create_column(TPrimitiveType::VARCHAR, BinaryColumn::create()),
+                                    create_column(TPrimitiveType::INT, Int32Column::create())});
+    ASSERT_FALSE(substr->is_compilable(&_runtime_state));
+}
+
+} // namespace starrocks
@@ -0,0 +1,201 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/json_path_extractor.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/json_column.h"
+#include "column/nullable_column.h"
+#include "testutil/assert.h"
+#include "util/json_converter.h"
+
+namespace starrocks {
+
+class JsonPathExtractorTest : public ::testing::Test {
+public:
+    static JsonPath parse_path(const std::string& path) {
+        auto res = JsonPath::parse(Slice(path));
+        CHECK(res.ok()) << path;
+        return std::move(res.value());
+    }
+
+    // The values of |path| in |texts| by JsonPath::extract.
+    template <LogicalType ResultType>
+    static ColumnPtr expected_column(const std::vector<std::string>& texts, const JsonPath& path) {
+        ColumnBuilder<ResultType> result(texts.size());
+        for (const auto& text : texts) {
+            JsonValue json;
+            if (!JsonValue::parse(Slice(text), &json).ok()) {
+                result.append_null();
+                continue;
+            }
+            vpack::Builder builder;
+            vpack::Slice slice = JsonPath::extract(&json, path, &builder);
+            if (!cast_vpjson_to<ResultType, false>(slice, result).ok()) {
+                result.append_null();
+            }
+        }
+        return result.build_nullable_column();
+    }
+
+    template <LogicalType ResultType>
+    static void verify(const std::vector<std::string>& texts, const std::vector<std::string>& path_strings) {
+        std::vector<JsonPath> paths;
+        std::vector<const JsonPath*> path_ptrs;
+        for (const auto& path : path_strings) {
+            paths.emplace_back(parse_path(path));
+            ASSERT_TRUE(JsonPathExtractor::is_supported(paths.back())) << path;
+        }
+        for (const auto& path : paths) {
+            path_ptrs.push_back(&path);
+        }
+
+        auto text_column = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+        auto json_column = NullableColumn::create(JsonColumn::create(), NullColumn::create());
+        for (const auto& text : texts) {
+            text_column->append_datum(Datum(Slice(text)));
+            JsonValue json;
+            if (JsonValue::parse(Slice(text), &json).ok()) {
+                json_column->append_datum(Datum(&json));
+            } else {
+                json_column->append_nulls(1);
+            }
+        }
+        text_column->append_nulls(1);
+        json_column->append_nulls(1);
+
+        std::vector<ColumnBuilder<ResultType>> text_builders;
+        std::vector<ColumnBuilder<ResultType>> json_builders;
+        for (size_t i = 0; i < paths.size(); ++i) {
+            text_builders.emplace_back(texts.size() + 1);
+            json_builders.emplace_back(texts.size() + 1);
+        }
+        std::vector<ColumnBuilder<ResultType>*> text_results;
+        std::vector<ColumnBuilder<ResultType>*> json_results;
+        for (size_t i = 0; i < paths.size(); ++i) {
+            text_results.push_back(&text_builders[i]);
+            json_results.push_back(&json_builders[i]);
+        }
+
+        JsonPathExtractor extractor(path_ptrs);
+        extractor.extract_text<ResultType>(text_column, text_results);
+        extractor.extract_json<ResultType>(json_column, json_results);
+
+        for (size_t i = 0; i < paths.size(); ++i) {
+            auto expected = expected_column<ResultType>(texts, paths[i]);
+            auto text_result = text_builders[i].build_nullable_column();
+            auto json_result = json_builders[i].build_nullable_column();
+            ASSERT_EQ(texts.size() + 1, text_result->size());
+            ASSERT_EQ(texts.size() + 1, json_result->size());
+            for (size_t row = 0; row < texts.size(); ++row) {
+                ASSERT_EQ(expected->debug_item(row), text_result->debug_item(row))
+                        << path_strings[i] << ": " << texts[row];
+                ASSERT_EQ(expected->debug_item(row), json_result->debug_item(row))
+                        << path_strings[i] << ": " << texts[row];
+            }
+            ASSERT_TRUE(text_result->is_null(texts.size()));
+            ASSERT_TRUE(json_result->is_null(texts.size()));
+        }
+    }
+};
+
+TEST_F(JsonPathExtractorTest, test_supported) {
+    ASSERT_TRUE(JsonPathExtractor::is_supported(parse_path("$.a")));
+    ASSERT_TRUE(JsonPathExtractor::is_supported(parse_path("$.a.b[1].c")));
+    ASSERT_TRUE(JsonPathExtractor::is_supported(parse_path("$[0].a")));
+    ASSERT_TRUE(JsonPathExtractor::is_supported(parse_path("a.b")));
+    ASSERT_TRUE(JsonPathExtractor::is_supported(parse_path("$.\"a.b\".c")));
+    ASSERT_FALSE(JsonPathExtractor::is_supported(parse_path("$")));
+    ASSERT_FALSE(JsonPathExtractor::is_supported(parse_path("$.a[*]")));
+    ASSERT_FALSE(JsonPathExtractor::is_supported(parse_path("$.a[1:3].b")));
+}
+
+TEST_F(JsonPathExtractorTest, test_extract) {
+    std::vector<std::string> texts = {
+            R"({"a": 1, "b": "x", "c": {"d": [1, 2, {"e": true}]}})",
+            R"({"b": "y", "a": 2.5, "c": {"d": []}})",
+            R"({"a": null, "b": {"x": 1}, "c": [1, 2]})",
+            R"({"a": "3", "b": ["p", "q"], "a.b": {"c": 7}})",
+            R"([{"a": 4}, {"a": 5}])",
+            R"({"a": 9223372036854775807, "b": "中\n\"q\""})",
+            R"({"a": 100000000000000000000000, "b": -1e10})",
+            R"(  {"a": 6, "c": {"d": [0, 1, {"e": "f"}]}})",
+            "{}",
+            "[]",
+            "",
+            "   ",
+            "abc",
+            R"("a string")",
+            "123",
+            R"({"a": tru})",
+    };
+    std::vector<std::string> paths = {"$.a", "$.b", "$.c.d[2].e", "$.c.d", "$[1].a", "$.\"a.b\".c", "$.b[1]", "$.x.y"};
+    verify<TYPE_VARCHAR>(texts, paths);
+    verify<TYPE_JSON>(texts, paths);
+    verify<TYPE_INT>(texts, paths);
+    verify<TYPE_BIGINT>(texts, paths);
+    verify<TYPE_DOUBLE>(texts, paths);
+    verify<TYPE_BOOLEAN>(texts, paths);
+}
+
+TEST_F(JsonPathExtractorTest, test_malformed) {
+    // the values before the malformed part are NULL too
+    std::vector<std::string> texts = {
+            R"({"a": 1, "b": tru})",
+            R"({"a": 1, "b": [1, 2})",
+            R"({"a": 1, "b": "x)",
+            R"({"a": 1, "b": "\x"})",
+            R"({"a": 1, "b": nul})",
+            R"({"a": 1, "b": 1.2.3})",
+            R"({"a": 1} {"b": 2})",
+            R"({"a": 1,)",
+            R"([{"a": 1}, )",
+            "\v{\"a\": 1}",
+            "\t\r\n {\"a\": 1}",
+    };
+    verify<TYPE_BIGINT>(texts, {"$.a", "$[0].a"});
+    verify<TYPE_JSON>(texts, {"$.a", "$.b"});
+}
+
+TEST_F(JsonPathExtractorTest, test_escaped_key) {
+    std::vector<std::string> texts = {
+            R"({"\u0061": 1})",
+            R"({"b": {"\u0061": 2}, "a\"": 3})",
+            R"({"a\\b": 4, "a": 5})",
+            R"({"x": "\n", "a": 6})",
+            R"({"x": "\n", "c": 7})",
+    };
+    verify<TYPE_BIGINT>(texts, {"$.a", "$.b.a", "$.c"});
+}
+
+TEST_F(JsonPathExtractorTest, test_key_layout) {
+    // the position of the field changes with the key layout of the rows
+    std::vector<std::string> texts;
+    for (int i = 0; i < 100; ++i) {
+        std::string text = "{";
+        for (int k = 0; k < i % 7; ++k) {
+            text += "\"k" + std::to_string(k) + "\": " + std::to_string(k) + ", ";
+        }
+        if (i % 5 != 0) {
+            text += "\"target\": {\"v\": " + std::to_string(i) + "}, ";
+        }
+        text += "\"z\": 0}";
+        texts.push_back(text);
+    }
+    verify<TYPE_BIGINT>(texts, {"$.target.v", "$.k3", "$.z", "$.k0"});
+}
+
+} // namespace starrocks
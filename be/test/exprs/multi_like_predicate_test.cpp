@@ -0,0 +1,219 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exprs/multi_like_predicate.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exprs/expr_context.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class MultiLikePredicateTest : public ::testing::Test {
+public:
+    void SetUp() override { _enable_multi_like_predicate = config::enable_multi_like_predicate; }
+
+    void TearDown() override { config::enable_multi_like_predicate = _enable_multi_like_predicate; }
+
+    static TExprNode or_node() {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::COMPOUND_PRED);
+        node.__set_opcode(TExprOpcode::COMPOUND_OR);
+        node.__set_type(gen_type_desc(TPrimitiveType::BOOLEAN));
+        node.__set_num_children(2);
+        node.__set_is_nullable(true);
+        return node;
+    }
+
+    static TExprNode like_node(bool is_like) {
+        TFunctionName function_name;
+        function_name.__set_function_name(is_like ? "like" : "regexp");
+        TFunction function;
+        function.__set_name(function_name);
+        function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        function.__set_fid(is_like ? 60010 : 60020);
+
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::FUNCTION_CALL);
+        node.__set_type(gen_type_desc(TPrimitiveType::BOOLEAN));
+        node.__set_num_children(2);
+        node.__set_is_nullable(true);
+        node.__set_fn(function);
+        return node;
+    }
+
+    static TExprNode slot_node(SlotId slot_id) {
+        TSlotRef slot_ref;
+        slot_ref.__set_slot_id(slot_id);
+        slot_ref.__set_tuple_id(0);
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(gen_type_desc(TPrimitiveType::VARCHAR));
+        node.__set_num_children(0);
+        node.__set_is_nullable(true);
+        node.__set_slot_ref(slot_ref);
+        return node;
+    }
+
+    static TExprNode literal_node(const std::string& value) {
+        TStringLiteral literal;
+        literal.__set_value(value);
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::STRING_LITERAL);
+        node.__set_type(gen_type_desc(TPrimitiveType::VARCHAR));
+        node.__set_num_children(0);
+        node.__set_is_nullable(false);
+        node.__set_string_literal(literal);
+        return node;
+    }
+
+    struct Operand {
+        SlotId slot_id;
+        bool is_like;
+        std::string pattern;
+    };
+
+    // The OR predicate of |operands|, e.g. ((a OR b) OR c).
+    ExprContext* create_or_predicate(const std::vector<Operand>& operands) {
+        TExpr texpr;
+        for (size_t i = 1; i < operands.size(); ++i) {
+            texpr.nodes.emplace_back(or_node());
+        }
+        for (size_t i = 0; i < operands.size(); ++i) {
+            texpr.nodes.emplace_back(like_node(operands[i].is_like));
+            texpr.nodes.emplace_back(slot_node(operands[i].slot_id));
+            texpr.nodes.emplace_back(literal_node(operands[i].pattern));
+        }
+        // the pre-order of the left-deep tree is all the OR nodes followed by all the operands
+        ExprContext* context = nullptr;
+        CHECK_OK(Expr::create_expr_tree(&_pool, texpr, &context, &_runtime_state));
+        CHECK_OK(context->prepare(&_runtime_state));
+        CHECK_OK(context->open(&_runtime_state));
+        return context;
+    }
+
+    // Evaluate the OR predicate of |operands| with and without merging the patterns.
+    void verify(const std::vector<Operand>& operands, Chunk* chunk) {
+        config::enable_multi_like_predicate = false;
+        auto* expected_context = create_or_predicate(operands);
+        config::enable_multi_like_predicate = true;
+        auto* actual_context = create_or_predicate(operands);
+
+        ASSIGN_OR_ABORT(auto expected, expected_context->evaluate(chunk));
+        ASSIGN_OR_ABORT(auto actual, actual_context->evaluate(chunk));
+        ASSERT_EQ(expected->size(), actual->size());
+        for (size_t i = 0; i < expected->size(); ++i) {
+            ASSERT_EQ(expected->is_null(i), actual->is_null(i)) << i;
+            if (!expected->is_null(i)) {
+                ASSERT_EQ(expected->get(i).get_uint8(), actual->get(i).get_uint8())
+                        << "row " << i << ": " << chunk->get_column_by_slot_id(1)->debug_item(i);
+            }
+        }
+        expected_context->close(&_runtime_state);
+        actual_context->close(&_runtime_state);
+    }
+
+protected:
+    bool _enable_multi_like_predicate = true;
+    RuntimeState _runtime_state;
+    ObjectPool _pool;
+};
+
+TEST_F(MultiLikePredicateTest, test_merge) {
+    config::enable_multi_like_predicate = true;
+    auto* context = create_or_predicate({{1, true, "%error%"},
+                                         {2, true, "abc%"},
+                                         {1, false, "time.*out"},
+                                         {1, true, "%fail_"},
+                                         {2, false, "x"}});
+    // (c1 LIKE ... OR c1 REGEXP ... OR c1 LIKE ...) OR (c2 LIKE ... OR c2 REGEXP ...)
+    auto* root = context->root();
+    ASSERT_TRUE(MultiLikePredicate::is_or_predicate(root));
+    auto* c1 = dynamic_cast<MultiLikePredicate*>(root->get_child(0));
+    auto* c2 = dynamic_cast<MultiLikePredicate*>(root->get_child(1));
+    ASSERT_NE(nullptr, c1);
+    ASSERT_NE(nullptr, c2);
+    ASSERT_EQ(3u, c1->patterns().size());
+    ASSERT_EQ("%error%", c1->patterns()[0].pattern);
+    ASSERT_FALSE(c1->patterns()[1].is_like);
+    ASSERT_EQ("%fail_", c1->patterns()[2].pattern);
+    ASSERT_EQ(2u, c2->patterns().size());
+    // time.*out has no literal
+    ASSERT_FALSE(c1->has_literal_filter());
+    ASSERT_TRUE(c2->has_literal_filter());
+
+    // nothing to merge
+    auto* other = create_or_predicate({{1, true, "%error%"}, {2, true, "abc%"}});
+    ASSERT_TRUE(MultiLikePredicate::is_or_predicate(other->root()));
+    ASSERT_EQ(nullptr, dynamic_cast<MultiLikePredicate*>(other->root()->get_child(0)));
+
+    // all operands are merged
+    auto* merged = create_or_predicate({{1, true, "%a%"}, {1, true, "%b%"}});
+    ASSERT_NE(nullptr, dynamic_cast<MultiLikePredicate*>(merged->root()));
+
+    for (auto* ctx : {context, other, merged}) {
+        ctx->close(&_runtime_state);
+    }
+}
+
+TEST_F(MultiLikePredicateTest, test_evaluate) {
+    std::mt19937 rng(1);
+    std::vector<std::string> words = {"error", "timeout", "fail", "abc", "ERROR", "时间", "%", "_", "\\", "\n", ""};
+    auto column = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    for (size_t i = 0; i < 4096; ++i) {
+        if (i % 23 == 0) {
+            column->append_nulls(1);
+            continue;
+        }
+        std::string value;
+        size_t num_words = rng() % 5;
+        for (size_t k = 0; k < num_words; ++k) {
+            value += words[rng() % words.size()];
+            value += std::string(rng() % 3, 'x');
+        }
+        column->append_datum(Datum(Slice(value)));
+    }
+    auto chunk = std::make_shared<Chunk>();
+    chunk->append_column(column, 1);
+
+    // exact literals
+    verify({{1, true, "%error%"}, {1, true, "%timeout%"}, {1, false, "fail"}}, chunk.get());
+    // literals and patterns
+    verify({{1, true, "%error%"}, {1, true, "%time_ut%"}, {1, true, "abc%"}, {1, true, "%x\\%%"}}, chunk.get());
+    verify({{1, true, "%\\_%"}, {1, true, "%\\\\%"}, {1, true, "%时间%"}, {1, false, "ERR"}}, chunk.get());
+    // no literals
+    verify({{1, true, "%error%"}, {1, false, "^fail.*x$"}, {1, true, "%"}, {1, true, ""}}, chunk.get());
+    verify({{1, false, "(error|timeout)x+"}, {1, false, "a.c"}, {1, true, "_"}}, chunk.get());
+    // many patterns
+    std::vector<Operand> operands;
+    for (size_t i = 0; i < 50; ++i) {
+        operands.push_back({1, true, "%" + words[i % 5] + std::string(i % 3, 'x') + "%"});
+    }
+    verify(operands, chunk.get());
+
+    // constant input
+    auto const_chunk = std::make_shared<Chunk>();
+    const_chunk->append_column(ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice("a timeout"), 10), 1);
+    verify({{1, true, "%error%"}, {1, true, "%timeout%"}}, const_chunk.get());
+}
+
+} // namespace starrocks
@@ -20,9 +20,14 @@
 #include <random>
 #include <utility>
 
+#include "column/binary_column.h"
 #include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "exprs/runtime_filter_bank.h"
 #include "simd/simd.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -162,6 +167,168 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilter) {
     EXPECT_EQ(chunk.num_rows(), 12);
 }
 
+TEST_F(RuntimeFilterTest, TestAdaptiveRuntimeFilter) {
+    bool enable_adaptive_runtime_filter = config::enable_adaptive_runtime_filter;
+    DeferOp defer([&]() { config::enable_adaptive_runtime_filter = enable_adaptive_runtime_filter; });
+    config::enable_adaptive_runtime_filter = true;
+
+    // dense integers are kept in the membership bitmap
+    {
+        auto column = NullableColumn::create(Int32Column::create(), NullColumn::create());
+        for (int i = -300; i <= 699; i += 3) {
+            column->append_datum(Datum(i));
+        }
+        column->append_nulls(1);
+        RuntimeBloomFilter<TYPE_INT> bf;
+        ASSERT_OK(RuntimeFilterHelper::build_runtime_bloom_filter({column}, TYPE_INT, &bf, 0, true));
+        EXPECT_TRUE(bf.has_membership());
+        EXPECT_GE(bf.membership_bits(), 1000u);
+        EXPECT_TRUE(bf.has_null());
+        EXPECT_EQ(-300, bf.min_value());
+        EXPECT_EQ(699, bf.max_value());
+        // the bloom filter is still built for the remote consumers
+        EXPECT_TRUE(bf.can_use_bf());
+        for (int i = -300; i <= 699; i += 3) {
+            EXPECT_TRUE(bf._test_data(i));
+        }
+
+        ColumnPtr probe = Int32Column::create();
+        for (int i = -400; i <= 800; i++) {
+            down_cast<Int32Column*>(probe.get())->append(i);
+        }
+        JoinRuntimeFilter::RunningContext ctx;
+        ctx.use_merged_selection = false;
+        ctx.selection.assign(probe->size(), 1);
+        bf.evaluate(probe.get(), &ctx);
+        for (int i = -400; i <= 800; i++) {
+            bool expected = i >= -300 && i <= 699 && i % 3 == 0;
+            EXPECT_EQ(expected, ctx.selection[i + 400] != 0) << i;
+        }
+
+        // merged with a filter which only has the bloom filter
+        RuntimeBloomFilter<TYPE_INT> other;
+        other.init(bf.size());
+        other.insert(1000);
+        bf.merge(&other);
+        EXPECT_FALSE(bf.has_membership());
+        EXPECT_TRUE(bf._test_data(1000));
+    }
+
+    // the bloom filter is sized to the distinct values instead of the rows
+    {
+        auto column = BinaryColumn::create();
+        std::vector<std::string> values;
+        for (int i = 0; i < 100; i++) {
+            values.push_back("value_" + std::to_string(i));
+        }
+        for (int i = 0; i < 100000; i++) {
+            column->append(Slice(values[i % 100]));
+        }
+        RuntimeBloomFilter<TYPE_VARCHAR> bf;
+        ASSERT_OK(RuntimeFilterHelper::build_runtime_bloom_filter({column}, TYPE_VARCHAR, &bf, 0, false));
+        EXPECT_FALSE(bf.has_membership());
+        EXPECT_LE(bf.size(), 200u);
+        for (const auto& value : values) {
+            EXPECT_TRUE(bf._test_data(Slice(value)));
+        }
+    }
+
+    // sparse integers
+    {
+        auto column = Int64Column::create();
+        for (int64_t i = 0; i < 20000; i++) {
+            column->append((i % 5000) * 1000003);
+        }
+        RuntimeBloomFilter<TYPE_BIGINT> bf;
+        ASSERT_OK(RuntimeFilterHelper::build_runtime_bloom_filter({column}, TYPE_BIGINT, &bf, 0, false));
+        EXPECT_FALSE(bf.has_membership());
+        EXPECT_LE(bf.size(), 10000u);
+        for (int64_t i = 0; i < 5000; i++) {
+            EXPECT_TRUE(bf._test_data(i * 1000003));
+        }
+    }
+
+    // the filter is built as before if it's disabled
+    {
+        config::enable_adaptive_runtime_filter = false;
+        auto column = Int32Column::create();
+        for (int i = 0; i < 10000; i++) {
+            column->append(i % 10);
+        }
+        RuntimeBloomFilter<TYPE_INT> bf;
+        ASSERT_OK(RuntimeFilterHelper::build_runtime_bloom_filter({column}, TYPE_INT, &bf, 0, false));
+        EXPECT_FALSE(bf.has_membership());
+        EXPECT_EQ(10000u, bf.size());
+    }
+}
+
+TEST_F(RuntimeFilterTest, TestHasFewDistinctValues) {
+    auto column = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int i = 0; i < 10000; i++) {
+        column->append_datum(Datum(i % 10));
+        column->append_nulls(1);
+    }
+    EXPECT_TRUE(RuntimeFilterHelper::has_few_distinct_values(column, TYPE_INT, 0, 10));
+    EXPECT_FALSE(RuntimeFilterHelper::has_few_distinct_values(column, TYPE_INT, 0, 9));
+    // the values before the offset are skipped
+    EXPECT_TRUE(RuntimeFilterHelper::has_few_distinct_values(column, TYPE_INT, 19990, 5));
+}
+
+TEST_F(RuntimeFilterTest, TestRuntimeFilterRange) {
+    // with the membership bitmap
+    {
+        RuntimeBloomFilter<TYPE_INT> bf;
+        bf.init(100);
+        bf.init_membership(-100, 1000);
+        for (int i = -100; i <= 1000; i += 100) {
+            bf.insert(i);
+        }
+        EXPECT_TRUE(bf.has_membership());
+        EXPECT_TRUE(bf.test_range(-200, -100, 64));
+        EXPECT_TRUE(bf.test_range(150, 250, 64));
+        EXPECT_TRUE(bf.test_range(-1000, 10000, 64));
+        EXPECT_FALSE(bf.test_range(101, 199, 64));
+        EXPECT_FALSE(bf.test_range(1001, 2000, 64));
+        EXPECT_FALSE(bf.test_range(-1000, -101, 64));
+        // the ranges crossing the words of the bitmap
+        EXPECT_FALSE(bf.test_range(-99, -1, 64));
+        EXPECT_TRUE(bf.test_range(-99, 0, 64));
+
+        std::vector<int32_t> values;
+        EXPECT_TRUE(bf.get_membership_values(100, &values));
+        EXPECT_EQ(std::vector<int32_t>({-100, 0, 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000}), values);
+        values.clear();
+        EXPECT_FALSE(bf.get_membership_values(5, &values));
+    }
+
+    // with the bloom filter only
+    {
+        RuntimeBloomFilter<TYPE_BIGINT> bf;
+        bf.init(100);
+        for (int64_t i = 0; i < 10; i++) {
+            bf.insert(i * 1000);
+        }
+        EXPECT_FALSE(bf.has_membership());
+        std::vector<int64_t> values;
+        EXPECT_FALSE(bf.get_membership_values(100, &values));
+        EXPECT_TRUE(bf.test_range(990, 1010, 64));
+        EXPECT_FALSE(bf.test_range(-100, -1, 64));
+        EXPECT_FALSE(bf.test_range(9001, 10000, 64));
+        // the range of too many values to probe is kept
+        EXPECT_TRUE(bf.test_range(1001, 1999, 64));
+    }
+
+    // the range of other types is tested by min/max
+    {
+        RuntimeBloomFilter<TYPE_DOUBLE> bf;
+        bf.init(100);
+        bf.insert(1.5);
+        bf.insert(2.5);
+        EXPECT_TRUE(bf.test_range(0, 2, 64));
+        EXPECT_FALSE(bf.test_range(3, 4, 64));
+    }
+}
+
 TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSlice) {
     RuntimeBloomFilter<TYPE_VARCHAR> bf;
     // JoinRuntimeFilter* rf = &bf;
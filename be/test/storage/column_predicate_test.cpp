@@ -16,9 +16,11 @@
 
 #include <vector>
 
+#include "exprs/runtime_filter.h"
 #include "gtest/gtest.h"
 #include "storage/chunk_helper.h"
 #include "storage/column_or_predicate.h"
+#include "storage/rowset/bloom_filter.h"
 #include "testutil/assert.h"
 
 namespace starrocks {
@@ -2162,6 +2164,50 @@ TEST(ColumnPredicateTest, zone_map_filter_varchar) {
     EXPECT_TRUE(not_in_xx_yy->ZMF(Datum("xy"), Datum("zz")));
 }
 
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, test_runtime_filter) {
+    RuntimeBloomFilter<TYPE_INT> rf;
+    rf.init(100);
+    rf.init_membership(100, 1000);
+    for (int i = 100; i <= 1000; i += 100) {
+        rf.insert(i);
+    }
+    std::unique_ptr<ColumnPredicate> pred(new_column_runtime_filter_predicate(get_type_info(TYPE_INT), 0, &rf));
+    ASSERT_NE(nullptr, pred);
+    EXPECT_TRUE(pred->is_index_filter_only());
+
+    EXPECT_TRUE(pred->ZMF(Datum(90), Datum(100)));
+    EXPECT_TRUE(pred->ZMF(Datum(150), Datum(250)));
+    EXPECT_TRUE(pred->ZMF(Datum(), Datum(50)));
+    EXPECT_FALSE(pred->ZMF(Datum(101), Datum(199)));
+    EXPECT_FALSE(pred->ZMF(Datum(1001), Datum(2000)));
+
+    // the bloom filter index of the page is probed with the values of the runtime filter
+    ASSERT_TRUE(pred->support_bloom_filter());
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_OK(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+    ASSERT_OK(bf->init(1000, 0.001, HASH_MURMUR3_X64_64));
+    for (int32_t i = 1; i < 10; i++) {
+        bf->add_bytes(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+    EXPECT_FALSE(pred->bloom_filter(bf.get()));
+    int32_t value = 500;
+    bf->add_bytes(reinterpret_cast<const char*>(&value), sizeof(value));
+    EXPECT_TRUE(pred->bloom_filter(bf.get()));
+
+    // the rows are not filtered by the predicate
+    auto c = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    c->append_datum(Datum(1));
+    c->append_datum(Datum(100));
+    std::vector<uint8_t> buff(2, 0);
+    ASSERT_OK(pred->evaluate(c.get(), buff.data()));
+    EXPECT_EQ("1,1", to_string(buff));
+
+    // not supported types
+    RuntimeBloomFilter<TYPE_VARCHAR> varchar_rf;
+    EXPECT_EQ(nullptr, new_column_runtime_filter_predicate(get_type_info(TYPE_VARCHAR), 0, &varchar_rf));
+}
+
 // NOLINTNEXTLINE
 TEST(ColumnPredicateTest, test_convert_cmp_predicate) {
     // clang-format off
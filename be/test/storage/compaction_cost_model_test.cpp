@@ -0,0 +1,82 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/compaction_cost_model.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+TEST(CompactionCostModelTest, test_priority) {
+    const int64_t MB = 1024 * 1024;
+    // nothing to merge, nothing to gain
+    ASSERT_EQ(0, CompactionCostModel::priority(100, 0, 10 * MB));
+
+    // a hot tablet is preferred over a cold tablet with the same shape
+    double hot = CompactionCostModel::priority(100, 10, 10 * MB);
+    double cold = CompactionCostModel::priority(0, 10, 10 * MB);
+    ASSERT_GT(hot, cold);
+    ASSERT_GT(cold, 0);
+
+    // with the same heat, saving more runs per byte is preferred
+    ASSERT_GT(CompactionCostModel::priority(10, 100, 10 * MB), CompactionCostModel::priority(10, 100, 1000 * MB));
+    ASSERT_GT(CompactionCostModel::priority(10, 100, 10 * MB), CompactionCostModel::priority(10, 10, 10 * MB));
+
+    // tiny inputs are not over-weighted
+    ASSERT_EQ(CompactionCostModel::priority(10, 10, 1), CompactionCostModel::priority(10, 10, MB));
+}
+
+TEST(CompactionCostModelTest, test_decay_scan_heat) {
+    ASSERT_DOUBLE_EQ(8, CompactionCostModel::decay_scan_heat(8, 0, 60));
+    ASSERT_DOUBLE_EQ(4, CompactionCostModel::decay_scan_heat(8, 60 * 1000, 60));
+    ASSERT_DOUBLE_EQ(2, CompactionCostModel::decay_scan_heat(8, 120 * 1000, 60));
+    // decay disabled
+    ASSERT_DOUBLE_EQ(8, CompactionCostModel::decay_scan_heat(8, 120 * 1000, 0));
+}
+
+TEST(CompactionCostModelTest, test_disk_budget) {
+    CompactionDiskBudget budget;
+    const int64_t rate = 100;
+    const int64_t burst = 1000;
+
+    // starts with a full budget
+    ASSERT_TRUE(budget.try_acquire(600, 0, rate, burst));
+    ASSERT_TRUE(budget.try_acquire(600, 0, rate, burst));
+    // overdrawn
+    ASSERT_FALSE(budget.try_acquire(1, 0, rate, burst));
+    ASSERT_FALSE(budget.try_acquire(1, 1000, rate, burst));
+    // refilled after 2 more seconds
+    ASSERT_TRUE(budget.try_acquire(1, 3000, rate, burst));
+
+    // refill is capped by burst
+    ASSERT_TRUE(budget.try_acquire(0, 1000000, rate, burst));
+    ASSERT_DOUBLE_EQ(burst, budget.available());
+
+    // the budget of a task which never ran is given back
+    ASSERT_TRUE(budget.try_acquire(1500, 1000000, rate, burst));
+    ASSERT_FALSE(budget.try_acquire(1, 1000000, rate, burst));
+    budget.release(1500);
+    ASSERT_DOUBLE_EQ(burst, budget.available());
+    ASSERT_TRUE(budget.try_acquire(1, 1000000, rate, burst));
+
+    // no limit
+    CompactionDiskBudget unlimited;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(unlimited.try_acquire(1L << 40, 0, 0, 0));
+    }
+}
+
+} // namespace starrocks
@@ -36,6 +36,9 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
+#include "testutil/assert.h"
+
 namespace starrocks {
 
 // NOLINTNEXTLINE
@@ -54,4 +57,41 @@ TEST(DelVector, testLoadSave) {
     ASSERT_EQ(dv2.cardinality(), dels.size());
 };
 
+// NOLINTNEXTLINE
+TEST(DelVector, testDeltaLoadMerge) {
+    bool old_enable = config::enable_delvec_delta_chain;
+    config::enable_delvec_delta_chain = true;
+
+    DelVector base;
+    std::vector<uint32_t> base_dels = {1, 3, 5};
+    base.init(2, base_dels.data(), base_dels.size());
+    std::shared_ptr<DelVector> delta;
+    base.add_dels_as_new_version({7, 90000}, 3, &delta);
+    config::enable_delvec_delta_chain = old_enable;
+    ASSERT_EQ(5, delta->cardinality());
+
+    // the full format is kept for everything except the incremental meta write
+    std::string full = delta->save();
+    ASSERT_EQ(-1, DelVector::parse_base_version(full.data(), full.size()));
+    std::string raw = delta->save_incremental();
+    ASSERT_EQ(2, DelVector::parse_base_version(raw.data(), raw.size()));
+
+    DelVector loaded;
+    ASSERT_OK(loaded.load(3, raw.data(), raw.size()));
+    ASSERT_TRUE(loaded.has_pending_base());
+    ASSERT_EQ(2, loaded.pending_base_version());
+    // cardinality of the whole chain is available without merging
+    ASSERT_EQ(5, loaded.cardinality());
+
+    DelVector wrong_base;
+    wrong_base.init(1, nullptr, 0);
+    ASSERT_FALSE(loaded.merge_base(wrong_base).ok());
+
+    ASSERT_OK(loaded.merge_base(base));
+    ASSERT_FALSE(loaded.has_pending_base());
+    ASSERT_EQ(5, loaded.cardinality());
+    ASSERT_TRUE(loaded.roaring()->contains(90000));
+    ASSERT_TRUE(loaded.roaring()->contains(1));
+}
+
 } // namespace starrocks
@@ -0,0 +1,95 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/json_path_access_stats.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class JsonPathAccessStatsTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _max_columns = config::json_flat_access_stats_max_columns;
+        JsonPathAccessStats::instance()->clear();
+    }
+
+    void TearDown() override {
+        config::json_flat_access_stats_max_columns = _max_columns;
+        JsonPathAccessStats::instance()->clear();
+    }
+
+private:
+    int64_t _max_columns = 0;
+};
+
+TEST_F(JsonPathAccessStatsTest, test_hot_paths) {
+    auto* stats = JsonPathAccessStats::instance();
+    ASSERT_TRUE(stats->hot_paths(1, 1).empty());
+
+    stats->record(1, 1, {"a", "b"});
+    stats->record(1, 1, {"b", "c"});
+    stats->record(1, 1, {"b"});
+    stats->record(1, 2, {"x"});
+    stats->record(2, 1, {"y"});
+    stats->record(1, 1, {});
+
+    ASSERT_EQ((std::vector<std::string>{"b", "a", "c"}), stats->hot_paths(1, 1));
+    ASSERT_EQ((std::vector<std::string>{"x"}), stats->hot_paths(1, 2));
+    ASSERT_EQ((std::vector<std::string>{"y"}), stats->hot_paths(2, 1));
+    ASSERT_EQ(3u, stats->num_columns());
+}
+
+TEST_F(JsonPathAccessStatsTest, test_decay) {
+    auto* stats = JsonPathAccessStats::instance();
+    stats->record(1, 1, {"old"});
+    // the field accessed only long ago is forgotten
+    for (int i = 0; i < 10000; ++i) {
+        stats->record(1, 1, {"new"});
+    }
+    ASSERT_EQ((std::vector<std::string>{"new"}), stats->hot_paths(1, 1));
+
+    // the recent accesses weigh more
+    for (int i = 0; i < 2000; ++i) {
+        stats->record(1, 1, {"newer"});
+    }
+    auto paths = stats->hot_paths(1, 1);
+    ASSERT_EQ(2u, paths.size());
+    ASSERT_EQ("newer", paths[0]);
+}
+
+TEST_F(JsonPathAccessStatsTest, test_evict) {
+    config::json_flat_access_stats_max_columns = 2;
+    auto* stats = JsonPathAccessStats::instance();
+    stats->record(1, 1, {"a"});
+    stats->record(2, 1, {"a"});
+    stats->record(1, 1, {"a"});
+    // the least recently accessed column is evicted
+    stats->record(3, 1, {"a"});
+    ASSERT_EQ(2u, stats->num_columns());
+    ASSERT_FALSE(stats->hot_paths(1, 1).empty());
+    ASSERT_TRUE(stats->hot_paths(2, 1).empty());
+    ASSERT_FALSE(stats->hot_paths(3, 1).empty());
+
+    // the columns beyond the lowered limit are evicted at the next access
+    config::json_flat_access_stats_max_columns = 1;
+    stats->record(1, 1, {"b"});
+    ASSERT_EQ(1u, stats->num_columns());
+    ASSERT_FALSE(stats->hot_paths(1, 1).empty());
+    ASSERT_TRUE(stats->hot_paths(3, 1).empty());
+}
+
+} // namespace starrocks
@@ -0,0 +1,156 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/learned_key_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+
+namespace starrocks {
+
+class LearnedKeyIndexTest : public testing::Test {
+protected:
+    // Build the index of |keys| in batches and check that every key in [min - 10, max + 10] is located.
+    void check_locate(const std::vector<int64_t>& keys, uint32_t max_error) {
+        LearnedKeyIndexBuilder builder(TYPE_BIGINT, max_error, 1024);
+        for (size_t i = 0; i < keys.size(); i += 4096) {
+            auto column = Int64Column::create();
+            for (size_t j = i; j < std::min(keys.size(), i + 4096); j++) {
+                column->append(keys[j]);
+            }
+            builder.add_keys(*column);
+        }
+        LearnedKeyIndexPB pb;
+        ASSERT_TRUE(builder.finish(&pb));
+
+        LearnedKeyIndex index;
+        ASSERT_TRUE(index.parse(pb, keys.size()).ok());
+        ASSERT_EQ(TYPE_BIGINT, index.key_type());
+        for (int64_t k = keys.front() - 10; k <= keys.back() + 10; k++) {
+            uint32_t lower = std::lower_bound(keys.begin(), keys.end(), k) - keys.begin();
+            uint32_t upper = std::upper_bound(keys.begin(), keys.end(), k) - keys.begin();
+            uint32_t from;
+            uint32_t to;
+            index.locate(k, &from, &to);
+            ASSERT_LE(from, lower) << "key=" << k;
+            ASSERT_GE(to, upper) << "key=" << k;
+            ASSERT_LE(to - from, upper - lower + 4 * max_error + 4) << "key=" << k;
+        }
+    }
+};
+
+TEST_F(LearnedKeyIndexTest, test_sequential_keys) {
+    std::vector<int64_t> keys;
+    for (int64_t i = 0; i < 100000; i++) {
+        keys.push_back(1000 + i * 3);
+    }
+    check_locate(keys, 16);
+}
+
+TEST_F(LearnedKeyIndexTest, test_duplicate_keys) {
+    std::mt19937_64 rng(42);
+    std::vector<int64_t> keys;
+    int64_t key = -5000;
+    while (keys.size() < 100000) {
+        size_t duplicates = rng() % 10000 == 0 ? 500 : rng() % 2 + 1;
+        for (size_t i = 0; i < duplicates; i++) {
+            keys.push_back(key);
+        }
+        key += rng() % 2 + 1;
+    }
+    check_locate(keys, 64);
+}
+
+TEST_F(LearnedKeyIndexTest, test_abandoned) {
+    {
+        LearnedKeyIndexBuilder builder(TYPE_BIGINT, 16, 1024);
+        auto column = Int64Column::create();
+        column->append(2);
+        column->append(1);
+        builder.add_keys(*column);
+        LearnedKeyIndexPB pb;
+        ASSERT_FALSE(builder.finish(&pb));
+    }
+    {
+        LearnedKeyIndexBuilder builder(TYPE_BIGINT, 16, 1024);
+        auto column = NullableColumn::create(Int64Column::create(), NullColumn::create());
+        column->append_datum(Datum(int64_t(1)));
+        column->append_nulls(1);
+        builder.add_keys(*column);
+        LearnedKeyIndexPB pb;
+        ASSERT_FALSE(builder.finish(&pb));
+    }
+    {
+        // random keys need more pieces than the short key index
+        std::mt19937_64 rng(7);
+        std::vector<int64_t> keys(100000);
+        for (auto& k : keys) {
+            k = static_cast<int64_t>(rng() >> 1);
+        }
+        std::sort(keys.begin(), keys.end());
+        LearnedKeyIndexBuilder builder(TYPE_BIGINT, 1, 1024);
+        auto column = Int64Column::create();
+        for (int64_t k : keys) {
+            column->append(k);
+        }
+        builder.add_keys(*column);
+        LearnedKeyIndexPB pb;
+        ASSERT_FALSE(builder.finish(&pb));
+    }
+}
+
+TEST_F(LearnedKeyIndexTest, test_to_key) {
+    LearnedKeyIndexBuilder builder(TYPE_DATE, 16, 1024);
+    auto column = DateColumn::create();
+    column->append(DateValue::create(2024, 1, 1));
+    column->append(DateValue::create(2024, 1, 2));
+    builder.add_keys(*column);
+    LearnedKeyIndexPB pb;
+    ASSERT_TRUE(builder.finish(&pb));
+
+    LearnedKeyIndex index;
+    ASSERT_TRUE(index.parse(pb, 2).ok());
+    int64_t key;
+    ASSERT_TRUE(index.to_key(TYPE_DATE, Datum(DateValue::create(2024, 1, 2)), &key));
+    ASSERT_EQ(DateValue::create(2024, 1, 2).julian(), key);
+    ASSERT_FALSE(index.to_key(TYPE_INT, Datum(int32_t(1)), &key));
+    ASSERT_FALSE(index.to_key(TYPE_DATE, Datum(), &key));
+
+    uint32_t from;
+    uint32_t to;
+    index.locate(key, &from, &to);
+    ASSERT_LE(from, 1u);
+    ASSERT_EQ(2u, to);
+}
+
+TEST_F(LearnedKeyIndexTest, test_corruption) {
+    LearnedKeyIndexPB pb;
+    pb.set_key_type(TYPE_BIGINT);
+    pb.add_first_keys(10);
+    pb.add_last_keys(5);
+    pb.add_intercepts(0);
+    pb.add_slopes(1);
+    LearnedKeyIndex index;
+    ASSERT_TRUE(index.parse(pb, 10).is_corruption());
+    pb.clear_slopes();
+    ASSERT_TRUE(index.parse(pb, 10).is_corruption());
+}
+
+} // namespace starrocks
@@ -36,7 +36,9 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -184,4 +186,72 @@ TEST_F(StoragePageCacheTest, metrics) {
     ASSERT_EQ(cache.get_hit_count(), 2);
 }
 
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, file_id_registry) {
+    auto* registry = PageCacheFileIdRegistry::instance();
+    uint64_t id1 = registry->get_or_register("registry_file_1");
+    uint64_t id2 = registry->get_or_register("registry_file_2");
+    ASSERT_NE(id1, id2);
+    ASSERT_EQ(id1, registry->get_or_register("registry_file_1"));
+
+    // ids are not reused, pages cached for the removed file can not be hit any more
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+    {
+        char* buf = new char[1024];
+        PageCacheHandle handle;
+        cache.insert(StoragePageCache::CacheKey("registry_file_1", 0), Slice(buf, 1024), &handle, false);
+    }
+    PageCacheHandle handle;
+    ASSERT_TRUE(cache.lookup(StoragePageCache::CacheKey("registry_file_1", 0), &handle));
+    registry->remove("registry_file_1");
+    ASSERT_NE(id1, registry->get_or_register("registry_file_1"));
+    ASSERT_FALSE(cache.lookup(StoragePageCache::CacheKey("registry_file_1", 0), &handle));
+}
+
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, file_id_registry_eviction) {
+    auto* registry = PageCacheFileIdRegistry::instance();
+    int64_t old_max_size = config::page_cache_file_id_registry_max_size;
+    config::page_cache_file_id_registry_max_size = 32;
+    DeferOp reset_config([&]() { config::page_cache_file_id_registry_max_size = old_max_size; });
+    // evict the files registered by the other tests
+    for (int i = 0; i < 64; ++i) {
+        registry->get_or_register("eviction_warmup_file_" + std::to_string(i));
+    }
+    ASSERT_LE(registry->size(), 32);
+
+    uint64_t hot_id = registry->get_or_register("eviction_hot_file");
+    uint64_t cold_id = registry->get_or_register("eviction_cold_file");
+    for (int i = 0; i < 100; ++i) {
+        // the file used between the registrations keeps its id
+        ASSERT_EQ(hot_id, registry->get_or_register("eviction_hot_file"));
+        registry->get_or_register("eviction_file_" + std::to_string(i));
+        ASSERT_LE(registry->size(), 32);
+    }
+    ASSERT_EQ(hot_id, registry->get_or_register("eviction_hot_file"));
+    // the file not used is evicted, it gets a new id when it's read again
+    ASSERT_NE(cold_id, registry->get_or_register("eviction_cold_file"));
+    // the pages of the evicted files are erased by the background thread
+    registry->erase_evicted_pages();
+}
+
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, erase_files) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+    for (uint64_t file_id = 1; file_id <= 4; ++file_id) {
+        for (int64_t offset = 0; offset < 4; ++offset) {
+            char* buf = new char[16];
+            PageCacheHandle handle;
+            cache.insert(StoragePageCache::CacheKey(file_id, offset), Slice(buf, 16), &handle, false);
+        }
+    }
+    cache.erase_files({2, 4});
+    for (uint64_t file_id = 1; file_id <= 4; ++file_id) {
+        for (int64_t offset = 0; offset < 4; ++offset) {
+            PageCacheHandle handle;
+            ASSERT_EQ(file_id % 2 == 1, cache.lookup(StoragePageCache::CacheKey(file_id, offset), &handle));
+        }
+    }
+}
+
 } // namespace starrocks
@@ -229,4 +229,41 @@ TEST_F(RowSourceMaskTest, memory_masks_with_persistence) {
     ASSERT_FALSE(buffer.has_same_source(mask.get_source_num(), 4));
 }
 
+// NOLINTNEXTLINE
+TEST_F(RowSourceMaskTest, clone_for_read) {
+    for (int64_t memory_bytes : {1024L, 1L}) {
+        config::max_row_source_mask_memory_bytes = memory_bytes;
+        RowSourceMaskBuffer buffer(2, config::storage_root_path);
+        std::vector<RowSourceMask> source_masks;
+        for (uint16_t i = 0; i < 10; ++i) {
+            source_masks.emplace_back(RowSourceMask(i, i % 2 == 0));
+            ASSERT_TRUE(buffer.write(source_masks).ok());
+            source_masks.clear();
+        }
+        ASSERT_TRUE(buffer.flush().ok());
+        ASSERT_TRUE(buffer.flip_to_read().ok());
+
+        auto clone1 = buffer.clone_for_read();
+        ASSERT_TRUE(clone1.ok());
+        auto clone2 = buffer.clone_for_read();
+        ASSERT_TRUE(clone2.ok());
+
+        // the clones are read interleaved, each one sees all the masks from the beginning
+        for (uint16_t i = 0; i < 10; ++i) {
+            for (auto* reader : {clone1.value().get(), clone2.value().get(), &buffer}) {
+                ASSERT_TRUE(reader->has_remaining().value());
+                RowSourceMask mask = reader->current();
+                ASSERT_EQ(i, mask.get_source_num());
+                ASSERT_EQ(i % 2 == 0, mask.get_agg_flag());
+                reader->advance();
+            }
+        }
+        for (auto* reader : {clone1.value().get(), clone2.value().get(), &buffer}) {
+            auto st = reader->has_remaining();
+            ASSERT_TRUE(st.ok());
+            ASSERT_FALSE(st.value());
+        }
+    }
+}
+
 } // namespace starrocks
@@ -0,0 +1,147 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/alp_page.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "storage/chunk_helper.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+
+namespace starrocks {
+
+class AlpPageTest : public testing::Test {
+public:
+    // Returns the encoded page size.
+    template <LogicalType Type>
+    size_t test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        AlpPageBuilder<Type> page_builder(builder_options);
+        size_t size = page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), size);
+        OwnedSlice s = page_builder.finish()->build();
+        EXPECT_EQ(size, page_builder.count());
+
+        AlpPageDecoder<Type> page_decoder(s.slice());
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(size, page_decoder.count());
+        EXPECT_EQ(ALP_ENCODING, page_decoder.encoding_type());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t size_to_fetch = size;
+        EXPECT_TRUE(page_decoder.next_batch(&size_to_fetch, column.get()).ok());
+        EXPECT_EQ(size, size_to_fetch);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < size; i++) {
+            // compare bits, NaN and -0.0 must be restored exactly
+            EXPECT_EQ(0, memcmp(&src[i], &values[i], sizeof(CppType))) << "i=" << i;
+        }
+
+        for (int i = 0; i < 100 && size > 0; i++) {
+            uint32_t seek_off = random() % size;
+            EXPECT_TRUE(page_decoder.seek_to_position_in_page(seek_off).ok());
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            auto one = ChunkHelper::column_from_field_type(Type, false);
+            size_t n = 1;
+            EXPECT_TRUE(page_decoder.next_batch(&n, one.get()).ok());
+            EXPECT_EQ(1, n);
+            EXPECT_EQ(0, memcmp(&src[seek_off], one->raw_data(), sizeof(CppType)));
+        }
+        return s.slice().size;
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, TestDecimalLikeDouble) {
+    std::vector<double> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back((random() % 100000) / 100.0);
+    }
+    size_t encoded_size = test_encode_decode<TYPE_DOUBLE>(src);
+    // about 24 bits for each value
+    ASSERT_LT(encoded_size, src.size() * sizeof(double) / 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, TestDecimalLikeFloat) {
+    std::vector<float> src;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back((random() % 1000) / 10.0f);
+    }
+    test_encode_decode<TYPE_FLOAT>(src);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, TestExceptions) {
+    std::vector<double> src;
+    for (int i = 0; i < 1000; i++) {
+        src.push_back(i * 0.5);
+    }
+    src[10] = std::numeric_limits<double>::quiet_NaN();
+    src[20] = std::numeric_limits<double>::infinity();
+    src[30] = -std::numeric_limits<double>::infinity();
+    src[40] = -0.0;
+    src[50] = M_PI;
+    src[60] = std::numeric_limits<double>::max();
+    src[70] = std::numeric_limits<double>::denorm_min();
+    test_encode_decode<TYPE_DOUBLE>(src);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, TestRandomDouble) {
+    // random bits are not compressible, the page is stored as is
+    std::vector<double> src;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t bits = (static_cast<uint64_t>(random()) << 32) ^ random();
+        double v;
+        memcpy(&v, &bits, sizeof(v));
+        src.push_back(v);
+    }
+    size_t encoded_size = test_encode_decode<TYPE_DOUBLE>(src);
+    ASSERT_EQ(alp::kHeaderSize + src.size() * sizeof(double), encoded_size);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, TestEmptyAndSingle) {
+    test_encode_decode<TYPE_DOUBLE>({});
+    test_encode_decode<TYPE_DOUBLE>({1.5});
+    test_encode_decode<TYPE_FLOAT>({-3.25f});
+}
+
+// NOLINTNEXTLINE
+TEST_F(AlpPageTest, TestCorruption) {
+    AlpPageDecoder<TYPE_DOUBLE> too_small(Slice("abc", 3));
+    ASSERT_TRUE(too_small.init().is_corruption());
+
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    AlpPageBuilder<TYPE_DOUBLE> page_builder(builder_options);
+    std::vector<double> src{1.1, 2.2, 3.3};
+    page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+    OwnedSlice s = page_builder.finish()->build();
+    AlpPageDecoder<TYPE_DOUBLE> truncated(Slice(s.slice().data, s.slice().size - 1));
+    ASSERT_TRUE(truncated.init().is_corruption());
+}
+
+} // namespace starrocks
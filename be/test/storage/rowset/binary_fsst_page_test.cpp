@@ -0,0 +1,201 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/binary_fsst_page.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/nullable_column.h"
+#include "storage/range.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class BinaryFsstPageTest : public testing::Test {
+public:
+    OwnedSlice build_page(const std::vector<std::string>& values) {
+        std::vector<Slice> slices(values.begin(), values.end());
+        PageBuilderOptions options;
+        options.data_page_size = 256 * 1024;
+        BinaryFsstPageBuilder page_builder(options);
+        size_t count = page_builder.add(reinterpret_cast<const uint8_t*>(slices.data()), slices.size());
+        EXPECT_EQ(values.size(), count);
+        OwnedSlice page = page_builder.finish()->build();
+        if (!values.empty()) {
+            Slice first_value;
+            EXPECT_OK(page_builder.get_first_value(&first_value));
+            EXPECT_EQ(values.front(), first_value.to_string());
+            Slice last_value;
+            EXPECT_OK(page_builder.get_last_value(&last_value));
+            EXPECT_EQ(values.back(), last_value.to_string());
+        }
+        return page;
+    }
+
+    static std::vector<std::string> log_lines(int n) {
+        std::vector<std::string> values;
+        for (int i = 0; i < n; i++) {
+            values.emplace_back("2024-01-01 00:00:" + std::to_string(i % 60) + " INFO [query-" + std::to_string(i) +
+                                "] finished scan of tablet " + std::to_string(i * 31 % 1000));
+        }
+        return values;
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(BinaryFsstPageTest, test_read) {
+    auto values = log_lines(2000);
+    size_t raw_size = 0;
+    for (const auto& v : values) {
+        raw_size += v.size();
+    }
+    OwnedSlice page = build_page(values);
+    ASSERT_LT(page.slice().size * 2, raw_size);
+
+    BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    ASSERT_EQ(values.size(), decoder.count());
+    ASSERT_EQ(FSST_ENCODING, decoder.encoding_type());
+
+    auto column = BinaryColumn::create();
+    size_t n = values.size();
+    ASSERT_OK(decoder.next_batch(&n, column.get()));
+    ASSERT_EQ(values.size(), n);
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(values[i], column->get_slice(i).to_string());
+    }
+
+    // random access and sparse range into a nullable column
+    auto nullable = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    ASSERT_OK(decoder.seek_to_position_in_page(0));
+    SparseRange<> range;
+    range.add(Range<>(3, 5));
+    range.add(Range<>(1000, 1001));
+    ASSERT_OK(decoder.next_batch(range, nullable.get()));
+    ASSERT_EQ(3, nullable->size());
+    ASSERT_EQ(1001, decoder.current_index());
+    ASSERT_EQ(values[3], nullable->get(0).get_slice().to_string());
+    ASSERT_EQ(values[4], nullable->get(1).get_slice().to_string());
+    ASSERT_EQ(values[1000], nullable->get(2).get_slice().to_string());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BinaryFsstPageTest, test_match_equal) {
+    auto values = log_lines(100);
+    OwnedSlice page = build_page(values);
+    BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+
+    std::vector<uint8_t> selection(values.size());
+    decoder.match_equal(Slice(values[42]), 0, values.size(), selection.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(i == 42, selection[i]);
+    }
+    decoder.match_equal(Slice("not exists"), 0, values.size(), selection.data());
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(0, selection[i]);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(BinaryFsstPageTest, test_incompressible) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 100; i++) {
+        std::string v;
+        for (int j = 0; j < 16; j++) {
+            v.push_back(static_cast<char>(random()));
+        }
+        values.emplace_back(std::move(v));
+    }
+    values.emplace_back("");
+    OwnedSlice page = build_page(values);
+    BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    auto column = BinaryColumn::create();
+    size_t n = values.size();
+    ASSERT_OK(decoder.next_batch(&n, column.get()));
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(values[i], column->get_slice(i).to_string());
+    }
+
+    OwnedSlice empty = build_page({});
+    BinaryFsstPageDecoder<TYPE_VARCHAR> empty_decoder(empty.slice());
+    ASSERT_OK(empty_decoder.init());
+    ASSERT_EQ(0, empty_decoder.count());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BinaryFsstPageTest, test_char) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 100; i++) {
+        std::string v = "code-" + std::to_string(i);
+        v.resize(16, '\0');
+        values.emplace_back(std::move(v));
+    }
+    OwnedSlice page = build_page(values);
+    BinaryFsstPageDecoder<TYPE_CHAR> decoder(page.slice());
+    ASSERT_OK(decoder.init());
+    auto column = BinaryColumn::create();
+    size_t n = values.size();
+    ASSERT_OK(decoder.next_batch(&n, column.get()));
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ("code-" + std::to_string(i), column->get_slice(i).to_string());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(BinaryFsstPageTest, test_corruption) {
+    auto values = log_lines(100);
+    OwnedSlice page = build_page(values);
+    const Slice data = page.slice();
+    const uint32_t table_size = decode_fixed32_le(reinterpret_cast<const uint8_t*>(data.data));
+
+    // a trailing escape code in the last string
+    {
+        std::string bytes = data.to_string();
+        const size_t trailer_size = (values.size() + 2) * sizeof(uint32_t);
+        bytes[bytes.size() - trailer_size - 2] = 0;
+        bytes[bytes.size() - trailer_size - 1] = static_cast<char>(FsstSymbolTable::kEscapeCode);
+        BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(Slice(bytes));
+        ASSERT_OK(decoder.init());
+        ASSERT_OK(decoder.seek_to_position_in_page(values.size() - 1));
+        auto column = BinaryColumn::create();
+        size_t n = 1;
+        ASSERT_TRUE(decoder.next_batch(&n, column.get()).is_corruption());
+        ASSERT_EQ(0, column->size());
+    }
+    // a symbol longer than 8 bytes
+    {
+        std::string bytes = data.to_string();
+        ASSERT_GT(static_cast<uint8_t>(bytes[sizeof(uint32_t)]), 0);
+        bytes[sizeof(uint32_t) + 1] = static_cast<char>(FsstSymbolTable::kMaxSymbolLength + 1);
+        BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(Slice(bytes));
+        ASSERT_TRUE(decoder.init().is_corruption());
+    }
+    // an offset out of the strings
+    {
+        std::string bytes = data.to_string();
+        const size_t trailer_size = (values.size() + 2) * sizeof(uint32_t);
+        encode_fixed32_le(reinterpret_cast<uint8_t*>(bytes.data() + bytes.size() - trailer_size),
+                          bytes.size() - table_size);
+        BinaryFsstPageDecoder<TYPE_VARCHAR> decoder(Slice(bytes));
+        ASSERT_TRUE(decoder.init().is_corruption());
+    }
+}
+
+} // namespace starrocks
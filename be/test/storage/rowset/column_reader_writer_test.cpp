@@ -49,11 +49,14 @@
 #include "storage/aggregate_type.h"
 #include "storage/chunk_helper.h"
 #include "storage/decimal12.h"
+#include "storage/decoded_page_cache.h"
 #include "storage/olap_common.h"
 #include "storage/range.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/column_writer.h"
 #include "storage/rowset/default_value_column_iterator.h"
+#include "storage/rowset/ordinal_page_index.h"
+#include "storage/rowset/page_io.h"
 #include "storage/rowset/scalar_column_iterator.h"
 #include "storage/rowset/segment.h"
 #include "storage/storage_engine.h"
@@ -178,7 +181,8 @@ protected:
 
             // first read get data from disk
             // second read get data from page cache
-            for (int i = 0; i < 2; ++i) {
+            // third read get data from decoded page cache if it is enabled
+            for (int i = 0; i < 3; ++i) {
                 // sequence read
                 {
                     st = iter->seek_to_first();
@@ -551,6 +555,28 @@ TEST_F(ColumnReaderWriterTest, test_int) {
     test_numeric_types<TYPE_INT>();
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_decoded_page_cache) {
+    StoragePageCache::instance()->prune();
+    DecodedPageCache::create_global_cache(nullptr, 64 * 1024 * 1024);
+    DeferOp defer([] { DecodedPageCache::release_global_cache(); });
+
+    test_numeric_types<TYPE_INT>();
+    auto c = high_cardinality_strings(100);
+    test_nullable_data<TYPE_VARCHAR, DICT_ENCODING, 1>(*c, "0", "100");
+    test_nullable_data<TYPE_VARCHAR, DICT_ENCODING, 2>(*c, "1", "100");
+    ASSERT_GT(DecodedPageCache::instance()->memory_usage(), 0);
+    ASSERT_GT(DecodedPageCache::instance()->get_hit_count(), 0);
+
+    // shrunk under memory pressure and grown back
+    auto* cache = DecodedPageCache::instance();
+    ASSERT_TRUE(cache->adjust_capacity(-static_cast<int64_t>(cache->max_capacity())));
+    ASSERT_EQ(0, cache->get_capacity());
+    ASSERT_EQ(0, cache->memory_usage());
+    ASSERT_TRUE(cache->adjust_capacity(cache->max_capacity()));
+    ASSERT_EQ(64 * 1024 * 1024, cache->get_capacity());
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_double) {
     test_numeric_types<TYPE_DOUBLE>();
@@ -800,4 +826,163 @@ TEST_F(ColumnReaderWriterTest, test_large_varchar_column_writer) {
     }
 }
 
+TEST_F(ColumnReaderWriterTest, test_append_encoded_page) {
+    auto fs = std::make_shared<MemoryFileSystem>();
+    ASSERT_TRUE(fs->create_dir(TEST_DIR).ok());
+    const std::string src_fname = strings::Substitute("$0/test_append_encoded_page_src.data", TEST_DIR);
+    const std::string dst_fname = strings::Substitute("$0/test_append_encoded_page_dst.data", TEST_DIR);
+    auto src_segment = create_dummy_segment(fs, src_fname);
+    auto dst_segment = create_dummy_segment(fs, dst_fname);
+    TabletColumn column(STORAGE_AGGREGATE_NONE, TYPE_INT);
+
+    auto new_writer_opts = [](ColumnMetaPB* meta) {
+        ColumnWriterOptions writer_opts;
+        writer_opts.page_format = 2;
+        writer_opts.meta = meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(TYPE_INT);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(BIT_SHUFFLE);
+        writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+        writer_opts.meta->set_is_nullable(true);
+        writer_opts.need_zone_map = true;
+        writer_opts.data_page_size = 1024;
+        return writer_opts;
+    };
+    auto finish = [](ColumnWriter* writer) {
+        ASSERT_OK(writer->finish());
+        ASSERT_OK(writer->write_data());
+        ASSERT_OK(writer->write_ordinal_index());
+        ASSERT_OK(writer->write_zone_map());
+    };
+
+    // source: 4096 rows of several pages, every 7th row is null
+    const int32_t num_src_rows = 4096;
+    auto src = ChunkHelper::column_from_field_type(TYPE_INT, true);
+    for (int32_t i = 0; i < num_src_rows; ++i) {
+        if (i % 7 == 0) {
+            src->append_nulls(1);
+        } else {
+            (void)src->append_numbers(&i, sizeof(int32_t));
+        }
+    }
+    ColumnMetaPB src_meta;
+    {
+        ASSIGN_OR_ABORT(auto wfile, fs->new_writable_file(src_fname));
+        ASSIGN_OR_ABORT(auto writer, ColumnWriter::create(new_writer_opts(&src_meta), &column, wfile.get()));
+        ASSERT_OK(writer->init());
+        ASSERT_OK(writer->append(*src));
+        finish(writer.get());
+        ASSERT_OK(wfile->close());
+    }
+    ASSIGN_OR_ABORT(auto src_reader, ColumnReader::create(&src_meta, src_segment.get()));
+    ASSIGN_OR_ABORT(auto src_file, fs->new_random_access_file(src_fname));
+    OlapReaderStatistics stats;
+    IndexReadOptions opts;
+    opts.read_file = src_file.get();
+    opts.stats = &stats;
+    ASSERT_OK(src_reader->load_ordinal_index(opts));
+    ASSIGN_OR_ABORT(auto src_zone_maps, src_reader->load_page_zone_maps(opts));
+    ASSERT_TRUE(src_zone_maps != nullptr);
+    const size_t num_src_pages = src_zone_maps->size();
+    ASSERT_GT(num_src_pages, 2);
+
+    // destination: 3 appended rows, the pages of the source copied as they are, and 5 appended rows
+    auto head = ChunkHelper::column_from_field_type(TYPE_INT, true);
+    auto tail = ChunkHelper::column_from_field_type(TYPE_INT, true);
+    for (int32_t i = 0; i < 3; ++i) {
+        int32_t v = -1 - i;
+        (void)head->append_numbers(&v, sizeof(int32_t));
+    }
+    for (int32_t i = 0; i < 5; ++i) {
+        int32_t v = 100000 + i;
+        (void)tail->append_numbers(&v, sizeof(int32_t));
+    }
+    ColumnMetaPB dst_meta;
+    {
+        ASSIGN_OR_ABORT(auto wfile, fs->new_writable_file(dst_fname));
+        ASSIGN_OR_ABORT(auto writer, ColumnWriter::create(new_writer_opts(&dst_meta), &column, wfile.get()));
+        ASSERT_OK(writer->init());
+        ASSERT_TRUE(writer->can_append_encoded_page(BIT_SHUFFLE, src_reader->compress_codec()));
+        ASSERT_FALSE(writer->can_append_encoded_page(PLAIN_ENCODING, src_reader->compress_codec()));
+        ASSERT_FALSE(writer->can_append_encoded_page(BIT_SHUFFLE, nullptr));
+
+        ASSERT_OK(writer->append(*head));
+        OrdinalPageIndexIterator iter;
+        ASSERT_OK(src_reader->seek_at_or_before(0, &iter));
+        std::string body;
+        PageFooterPB footer;
+        for (; iter.valid(); iter.next()) {
+            ASSERT_OK(PageIO::read_encoded_page(src_file.get(), iter.page(), &body, &footer));
+            ASSERT_EQ(iter.last_ordinal() - iter.first_ordinal() + 1, footer.data_page_footer().num_values());
+            ASSERT_OK(writer->append_encoded_page(body, footer, &(*src_zone_maps)[iter.page_index()]));
+        }
+        ASSERT_OK(writer->append(*tail));
+        finish(writer.get());
+        ASSERT_OK(wfile->close());
+    }
+
+    ASSERT_EQ(3 + num_src_rows + 5, dst_meta.num_rows());
+    ASSIGN_OR_ABORT(auto dst_reader, ColumnReader::create(&dst_meta, dst_segment.get()));
+    ASSIGN_OR_ABORT(auto dst_file, fs->new_random_access_file(dst_fname));
+
+    // the values
+    {
+        ASSIGN_OR_ABORT(auto iter, dst_reader->new_iterator());
+        ColumnIteratorOptions iter_opts;
+        iter_opts.stats = &stats;
+        iter_opts.read_file = dst_file.get();
+        ASSERT_OK(iter->init(iter_opts));
+        ASSERT_OK(iter->seek_to_first());
+        auto dst = ChunkHelper::column_from_field_type(TYPE_INT, true);
+        size_t rows_read = dst_meta.num_rows();
+        ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+        ASSERT_EQ(dst_meta.num_rows(), rows_read);
+
+        auto expected = ChunkHelper::column_from_field_type(TYPE_INT, true);
+        expected->append(*head);
+        expected->append(*src);
+        expected->append(*tail);
+        TypeInfoPtr type_info = get_type_info(TYPE_INT);
+        for (size_t i = 0; i < rows_read; ++i) {
+            ASSERT_EQ(0, type_info->cmp(expected->get(i), dst->get(i))) << " row " << i;
+        }
+
+        // seek into a copied page
+        ASSERT_OK(iter->seek_to_ordinal(3 + 1000));
+        dst->reset_column();
+        rows_read = 10;
+        ASSERT_OK(iter->next_batch(&rows_read, dst.get()));
+        for (size_t i = 0; i < rows_read; ++i) {
+            ASSERT_EQ(0, type_info->cmp(expected->get(3 + 1000 + i), dst->get(i))) << " row " << 3 + 1000 + i;
+        }
+    }
+
+    // the page zone maps of the copied pages are kept, the segment zone map covers all the pages
+    {
+        opts.read_file = dst_file.get();
+        ASSIGN_OR_ABORT(auto dst_zone_maps, dst_reader->load_page_zone_maps(opts));
+        ASSERT_TRUE(dst_zone_maps != nullptr);
+        ASSERT_EQ(num_src_pages + 2, dst_zone_maps->size());
+        for (size_t i = 0; i < num_src_pages; ++i) {
+            const auto& expected = (*src_zone_maps)[i];
+            const auto& actual = (*dst_zone_maps)[i + 1];
+            ASSERT_EQ(expected.min(), actual.min());
+            ASSERT_EQ(expected.max(), actual.max());
+            ASSERT_EQ(expected.has_null(), actual.has_null());
+            ASSERT_EQ(expected.has_not_null(), actual.has_not_null());
+        }
+        ZoneMapPB segment_zone_map;
+        for (const auto& index : dst_meta.indexes()) {
+            if (index.type() == ZONE_MAP_INDEX) {
+                segment_zone_map = index.zone_map_index().segment_zone_map();
+            }
+        }
+        ASSERT_EQ("-3", segment_zone_map.min());
+        ASSERT_EQ("100004", segment_zone_map.max());
+        ASSERT_TRUE(segment_zone_map.has_null());
+    }
+}
+
 } // namespace starrocks
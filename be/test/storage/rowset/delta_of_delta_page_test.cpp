@@ -0,0 +1,153 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/delta_of_delta_page.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "storage/chunk_helper.h"
+#include "types/timestamp_value.h"
+#include "storage/rowset/options.h"
+#include "storage/rowset/page_builder.h"
+#include "storage/rowset/page_decoder.h"
+
+namespace starrocks {
+
+class DeltaOfDeltaPageTest : public testing::Test {
+public:
+    // Returns the encoded page size.
+    template <LogicalType Type>
+    size_t test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        DeltaOfDeltaPageBuilder<Type> page_builder(builder_options);
+        size_t size = page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), size);
+        OwnedSlice s = page_builder.finish()->build();
+        EXPECT_EQ(size, page_builder.count());
+
+        DeltaOfDeltaPageDecoder<Type> page_decoder(s.slice());
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(size, page_decoder.count());
+        EXPECT_EQ(DELTA_OF_DELTA_ENCODING, page_decoder.encoding_type());
+
+        auto column = ChunkHelper::column_from_field_type(Type, false);
+        size_t size_to_fetch = size;
+        EXPECT_TRUE(page_decoder.next_batch(&size_to_fetch, column.get()).ok());
+        EXPECT_EQ(size, size_to_fetch);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < size; i++) {
+            EXPECT_EQ(src[i], values[i]) << "i=" << i;
+        }
+
+        for (int i = 0; i < 100 && size > 0; i++) {
+            uint32_t seek_off = random() % size;
+            EXPECT_TRUE(page_decoder.seek_to_position_in_page(seek_off).ok());
+            EXPECT_EQ(seek_off, page_decoder.current_index());
+            auto one = ChunkHelper::column_from_field_type(Type, false);
+            size_t n = 1;
+            EXPECT_TRUE(page_decoder.next_batch(&n, one.get()).ok());
+            EXPECT_EQ(1, n);
+            EXPECT_EQ(src[seek_off], *reinterpret_cast<const CppType*>(one->raw_data()));
+        }
+        return s.slice().size;
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(DeltaOfDeltaPageTest, TestFixedInterval) {
+    std::vector<int64_t> src;
+    int64_t start = 1700000000000;
+    for (int i = 0; i < 10000; i++) {
+        src.push_back(start + i * 1000);
+    }
+    size_t encoded_size = test_encode_decode<TYPE_BIGINT>(src);
+    // all the delta of deltas are 0
+    ASSERT_LT(encoded_size, 1024);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaOfDeltaPageTest, TestJitterInterval) {
+    std::vector<int64_t> src;
+    int64_t v = 1700000000000;
+    for (int i = 0; i < 10000; i++) {
+        v += 1000 + random() % 16;
+        src.push_back(v);
+    }
+    size_t encoded_size = test_encode_decode<TYPE_BIGINT>(src);
+    ASSERT_LT(encoded_size, src.size() * sizeof(int64_t) / 4);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaOfDeltaPageTest, TestOverflow) {
+    std::vector<int64_t> src{std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0, -1,
+                             std::numeric_limits<int64_t>::max(), 5};
+    test_encode_decode<TYPE_BIGINT>(src);
+    test_encode_decode<TYPE_BIGINT>({});
+    test_encode_decode<TYPE_BIGINT>({42});
+    test_encode_decode<TYPE_BIGINT>({42, -42});
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaOfDeltaPageTest, TestDatetime) {
+    std::vector<int64_t> src;
+    for (int i = 0; i < 5000; i++) {
+        // one sample every minute, in the first 4 days of 2024
+        src.push_back(TimestampValue::create(2024, 1, 1 + i / 1440, i / 60 % 24, i % 60, 0).timestamp());
+    }
+    test_encode_decode<TYPE_DATETIME>(src);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaOfDeltaPageTest, TestSeekAtOrAfterValue) {
+    std::vector<int64_t> src;
+    for (int i = 0; i < 1000; i++) {
+        src.push_back(i * 10);
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    DeltaOfDeltaPageBuilder<TYPE_BIGINT> page_builder(builder_options);
+    page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+    OwnedSlice s = page_builder.finish()->build();
+    DeltaOfDeltaPageDecoder<TYPE_BIGINT> page_decoder(s.slice());
+    ASSERT_TRUE(page_decoder.init().ok());
+
+    bool exact_match = false;
+    int64_t target = 500;
+    ASSERT_TRUE(page_decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_TRUE(exact_match);
+    ASSERT_EQ(50, page_decoder.current_index());
+
+    target = 505;
+    ASSERT_TRUE(page_decoder.seek_at_or_after_value(&target, &exact_match).ok());
+    ASSERT_FALSE(exact_match);
+    ASSERT_EQ(51, page_decoder.current_index());
+
+    target = 100000;
+    ASSERT_TRUE(page_decoder.seek_at_or_after_value(&target, &exact_match).is_not_found());
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaOfDeltaPageTest, TestCorruption) {
+    DeltaOfDeltaPageDecoder<TYPE_BIGINT> too_small(Slice("abc", 3));
+    ASSERT_TRUE(too_small.init().is_corruption());
+}
+
+} // namespace starrocks
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include "column/column_access_path.h"
@@ -24,6 +25,7 @@
 #include "gen_cpp/PlanNodes_types.h"
 #include "gutil/casts.h"
 #include "storage/chunk_helper.h"
+#include "storage/json_path_access_stats.h"
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/column_writer.h"
@@ -33,6 +35,7 @@
 #include "storage/types.h"
 #include "testutil/assert.h"
 #include "types/logical_type.h"
+#include "util/defer_op.h"
 #include "util/json.h"
 #include "util/json_flattener.h"
 
@@ -310,4 +313,81 @@ TEST_F(FlatJsonColumnRWTest, testEmptyObject) {
     EXPECT_EQ("{a: 4, b: 24}", read_json->debug_item(3));
 }
 
+TEST_F(FlatJsonColumnRWTest, testAccessFeedback) {
+    const auto min_limit = config::json_flat_internal_column_min_limit;
+    const auto column_max = config::json_flat_column_max;
+    const auto access_feedback = config::enable_json_flat_access_feedback;
+    config::json_flat_internal_column_min_limit = 1;
+    config::json_flat_column_max = 2;
+    config::enable_json_flat_access_feedback = true;
+    DeferOp defer([&] {
+        config::json_flat_internal_column_min_limit = min_limit;
+        config::json_flat_column_max = column_max;
+        config::enable_json_flat_access_feedback = access_feedback;
+        JsonPathAccessStats::instance()->clear();
+    });
+
+    // k0, k1 and k2 are in all the rows, k5.x in half of the rows, k8 in a few rows
+    ColumnPtr write_col = JsonColumn::create();
+    auto* json_col = down_cast<JsonColumn*>(write_col.get());
+    for (int i = 0; i < 100; i++) {
+        std::string text = fmt::format(R"({{"k0": {}, "k1": {}, "k2": {})", i, i, i);
+        if (i % 2 == 0) {
+            text += fmt::format(R"(, "k5.x": {})", i);
+        }
+        if (i % 10 == 0) {
+            text += fmt::format(R"(, "k8": {})", i);
+        }
+        text += "}";
+        ASSIGN_OR_ABORT(auto jv, JsonValue::parse(text));
+        json_col->append(&jv);
+    }
+
+    const int64_t tablet_id = 10001;
+    JsonPathAccessStats::instance()->record(tablet_id, 0, {"\"k5.x\"", "k8"});
+    JsonPathAccessStats::instance()->record(tablet_id, 0, {"\"k5.x\"", "k2"});
+
+    auto flat_paths = [&](int64_t writer_tablet_id) {
+        auto fs = std::make_shared<MemoryFileSystem>();
+        CHECK(fs->create_dir(TEST_DIR).ok());
+        TabletColumn json_tablet_column = create_with_default_value<TYPE_JSON>("");
+        ColumnMetaPB meta;
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = &meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(TYPE_JSON);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(DEFAULT_ENCODING);
+        writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+        writer_opts.meta->set_is_nullable(false);
+        writer_opts.need_flat = true;
+        writer_opts.tablet_id = writer_tablet_id;
+
+        auto wfile = *fs->new_writable_file(TEST_DIR + "/test_flat_json_feedback.data");
+        auto writer = *ColumnWriter::create(writer_opts, &json_tablet_column, wfile.get());
+        CHECK(writer->init().ok());
+        CHECK(writer->append(*write_col).ok());
+        CHECK(writer->finish().ok());
+
+        std::vector<std::string> paths;
+        for (const auto& child : meta.children_columns()) {
+            paths.emplace_back(child.name());
+        }
+        return paths;
+    };
+
+    // the accessed fields are flattened first, k8 is too sparse
+    ASSERT_EQ((std::vector<std::string>{"\"k5.x\"", "k2"}), flat_paths(tablet_id));
+    // no access on the other tablet
+    auto paths = flat_paths(tablet_id + 1);
+    ASSERT_EQ(2, paths.size());
+    ASSERT_TRUE(std::find(paths.begin(), paths.end(), "\"k5.x\"") == paths.end());
+
+    config::enable_json_flat_access_feedback = false;
+    paths = flat_paths(tablet_id);
+    config::enable_json_flat_access_feedback = true;
+    ASSERT_TRUE(std::find(paths.begin(), paths.end(), "\"k5.x\"") == paths.end());
+}
+
 } // namespace starrocks
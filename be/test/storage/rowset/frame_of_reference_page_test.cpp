@@ -36,7 +36,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
@@ -44,6 +46,8 @@
 #include "runtime/large_int_value.h"
 #include "runtime/mem_pool.h"
 #include "storage/chunk_helper.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/rowset/options.h"
 #include "storage/rowset/page_builder.h"
 #include "storage/rowset/page_decoder.h"
@@ -343,4 +347,54 @@ TEST_F(FrameOfReferencePageTest, TestFindBitsOfInt) {
     ASSERT_EQ(65, bits(bits_65));
 }
 
+TEST_F(FrameOfReferencePageTest, TestNextBatchSelection) {
+    // ascending frames, which are skipped or selected by the frame bounds, and a shuffled frame
+    const size_t size = 1000;
+    std::vector<int32_t> ints(size);
+    for (int i = 0; i < size; i++) {
+        ints[i] = i * 2;
+    }
+    std::reverse(ints.begin() + 512, ints.begin() + 640);
+
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    FrameOfReferencePageBuilder<TYPE_INT> page_builder(builder_options);
+    ASSERT_EQ(size, page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), size));
+    OwnedSlice s = page_builder.finish()->build();
+
+    FrameOfReferencePageDecoder<TYPE_INT> decoder(s.slice());
+    ASSERT_TRUE(decoder.init().ok());
+
+    std::unique_ptr<ColumnPredicate> ge(new_column_ge_predicate(get_type_info(TYPE_INT), 0, "300"));
+    std::unique_ptr<ColumnPredicate> lt(new_column_lt_predicate(get_type_info(TYPE_INT), 0, "1500"));
+    EncodedPredicates predicates;
+    ASSERT_TRUE(EncodedPredicates::is_supported(ge.get(), TYPE_INT));
+    ASSERT_TRUE(EncodedPredicates::is_supported(lt.get(), TYPE_INT));
+    predicates.add(ge.get());
+    predicates.add(lt.get());
+
+    // start in the middle of a frame and read over the end of the page
+    ASSERT_TRUE(decoder.seek_to_position_in_page(100).ok());
+    std::vector<uint8_t> selection(size);
+    size_t n = size;
+    ASSERT_TRUE(decoder.next_batch_selection(predicates, &n, selection.data()).ok());
+    ASSERT_EQ(size - 100, n);
+    ASSERT_EQ(size, decoder.current_index());
+    for (size_t i = 0; i < n; i++) {
+        int32_t v = ints[100 + i];
+        ASSERT_EQ(v >= 300 && v < 1500, selection[i]) << "index " << 100 + i;
+    }
+
+    // the decoder can be read after the selection
+    ASSERT_TRUE(decoder.seek_to_position_in_page(600).ok());
+    auto column = ChunkHelper::column_from_field_type(TYPE_INT, false);
+    n = 10;
+    ASSERT_TRUE(decoder.next_batch(&n, column.get()).ok());
+    ASSERT_EQ(10, n);
+    auto* values = reinterpret_cast<const int32_t*>(column->raw_data());
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(ints[600 + i], values[i]);
+    }
+}
+
 } // namespace starrocks
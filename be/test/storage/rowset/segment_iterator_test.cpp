@@ -21,12 +21,17 @@
 #include <string>
 #include <unordered_map>
 
+#include "common/config.h"
 #include "common/object_pool.h"
+#include "exprs/runtime_filter.h"
+#include "exprs/runtime_filter_bank.h"
 #include "fs/fs_memory.h"
 #include "gen_cpp/tablet_schema.pb.h"
 #include "gtest/gtest.h"
+#include "runtime/descriptors.h"
 #include "storage/chunk_helper.h"
 #include "storage/olap_common.h"
+#include "storage/predicate_parser.h"
 #include "storage/rowset/column_iterator.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/segment_options.h"
@@ -34,6 +39,7 @@
 #include "storage/tablet_schema_helper.h"
 #include "testutil/assert.h"
 #include "types/logical_type.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -530,4 +536,197 @@ TEST_F(SegmentIteratorTest, TestGlobalDictNoLocalDict) {
     res_chunk->reset();
 }
 
+// NOLINTNEXTLINE
+TEST_F(SegmentIteratorTest, TestLateRuntimeFilterIndexPruning) {
+    const bool index_pruning = config::enable_runtime_filter_index_pruning;
+    DeferOp defer([&] { config::enable_runtime_filter_index_pruning = index_pruning; });
+
+    // c0 is sorted, so its pages are pruned by the zone maps, while c1 is shuffled, so the zone map of every page
+    // has almost all the values, and its pages are pruned by the bloom filter indexes.
+    std::shared_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema(
+            {create_int_key_pb(0, false, true), create_int_value_pb(1, "NONE", false, "", true)});
+    std::string file_name = kSegmentDir + "/late_runtime_filter";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+    SegmentWriterOptions opts;
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    const int32_t num_rows = 100000;
+    auto schema = ChunkHelper::convert_schema(tablet_schema);
+    auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    for (int32_t i = 0; i < num_rows;) {
+        chunk->reset();
+        for (; i < num_rows && chunk->num_rows() < config::vector_chunk_size; ++i) {
+            chunk->columns()[0]->append_datum(Datum(i));
+            chunk->columns()[1]->append_datum(Datum(static_cast<int32_t>(int64_t(i) * 7919 % num_rows)));
+        }
+        ASSERT_OK(writer.append_chunk(*chunk));
+    }
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    uint64_t footer_position = 0;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+    auto segment = *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    ASSERT_EQ(num_rows, segment->num_rows());
+
+    // the values of the build side, whose min/max covers all the pages
+    const std::vector<int32_t> values{10, 50000, 99990};
+    PredicateParser parser(tablet_schema);
+
+    // Read the segment with a runtime filter on |cid| arriving after the first chunk, and return the rows passing
+    // the filter, which the scan operator keeps.
+    auto read = [&](ColumnId cid, OlapReaderStatistics* stats) {
+        RuntimeBloomFilter<TYPE_INT> rf;
+        rf.init(values.size());
+        rf.init_membership(values.front(), values.back());
+        for (int32_t value : values) {
+            rf.insert(value);
+        }
+        SlotDescriptor slot(0, std::string(tablet_schema->column(cid).name()), TypeDescriptor(TYPE_INT));
+        RuntimeFilterProbeDescriptor rf_desc;
+        CHECK_OK(rf_desc.init(0, nullptr));
+        UnarrivedRuntimeFilterList rf_list;
+        rf_list.add_unarrived_rf(&rf_desc, &slot, 0);
+
+        SegmentReadOptions seg_opts;
+        seg_opts.fs = _fs;
+        seg_opts.stats = stats;
+        seg_opts.tablet_schema = tablet_schema;
+        seg_opts.runtime_range_pruner = OlapRuntimeScanRangePruner(&parser, rf_list);
+        auto iter = *segment->new_iterator(schema, seg_opts);
+        auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        std::vector<std::pair<int32_t, int32_t>> rows;
+        for (bool first = true;; first = false) {
+            if (!first) {
+                rf_desc.set_runtime_filter(&rf);
+            }
+            chunk->reset();
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            CHECK_OK(st);
+            for (size_t i = 0; i < chunk->num_rows(); ++i) {
+                auto row = chunk->get(i);
+                int32_t value = row[cid].get_int32();
+                if (std::find(values.begin(), values.end(), value) != values.end()) {
+                    rows.emplace_back(row[0].get_int32(), row[1].get_int32());
+                }
+            }
+        }
+        iter->close();
+        return rows;
+    };
+
+    for (ColumnId cid : {0, 1}) {
+        config::enable_runtime_filter_index_pruning = false;
+        OlapReaderStatistics stats;
+        auto expected = read(cid, &stats);
+        ASSERT_EQ(values.size(), expected.size());
+        // the min/max of the filter prunes no page
+        ASSERT_EQ(num_rows, stats.raw_rows_read);
+
+        config::enable_runtime_filter_index_pruning = true;
+        OlapReaderStatistics pruned_stats;
+        ASSERT_EQ(expected, read(cid, &pruned_stats)) << cid;
+        ASSERT_LT(pruned_stats.raw_rows_read, num_rows) << cid;
+        ASSERT_GT(pruned_stats.runtime_stats_filtered, stats.runtime_stats_filtered) << cid;
+    }
+}
+
+TEST_F(SegmentIteratorTest, TestLearnedKeyIndexRangeScan) {
+    const int32_t max_error = config::learned_key_index_max_error;
+    DeferOp defer([&] { config::learned_key_index_max_error = max_error; });
+
+    std::shared_ptr<TabletSchema> tablet_schema =
+            TabletSchemaHelper::create_tablet_schema({create_int_key_pb(0), create_int_value_pb(1)});
+    const int32_t num_rows = 100000;
+    // each key is repeated three times, so the rows of a key may span two blocks or two pages
+    auto key_of = [](int32_t row) { return row / 3; };
+    auto schema = ChunkHelper::convert_schema(tablet_schema);
+
+    SegmentWriterOptions opts;
+    auto write = [&](const std::string& file_name) {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+        SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+        CHECK_OK(writer.init());
+        auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        for (int32_t i = 0; i < num_rows;) {
+            chunk->reset();
+            for (; i < num_rows && chunk->num_rows() < config::vector_chunk_size; ++i) {
+                chunk->columns()[0]->append_datum(Datum(key_of(i)));
+                chunk->columns()[1]->append_datum(Datum(i));
+            }
+            CHECK_OK(writer.append_chunk(*chunk));
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        CHECK_OK(writer.finalize(&file_size, &index_size, &footer_position));
+        return *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    };
+    config::learned_key_index_max_error = 0;
+    auto segment = write(kSegmentDir + "/short_key_index");
+    ASSERT_EQ(nullptr, segment->learned_key_index());
+    config::learned_key_index_max_error = 16;
+    auto learned_segment = write(kSegmentDir + "/learned_key_index");
+    ASSERT_NE(nullptr, learned_segment->learned_key_index());
+
+    // Return the values of the rows in the key range.
+    auto key_schema = ChunkHelper::convert_schema(tablet_schema, {0});
+    auto read = [&](const std::shared_ptr<Segment>& seg, int32_t lower, int32_t upper, bool inc_lower,
+                    bool inc_upper) {
+        OlapReaderStatistics stats;
+        SegmentReadOptions seg_opts;
+        seg_opts.fs = _fs;
+        seg_opts.stats = &stats;
+        seg_opts.tablet_schema = tablet_schema;
+        SeekRange range(SeekTuple(key_schema, {Datum(lower)}), SeekTuple(key_schema, {Datum(upper)}));
+        range.set_inclusive_lower(inc_lower);
+        range.set_inclusive_upper(inc_upper);
+        seg_opts.ranges.push_back(range);
+        auto iter = *seg->new_iterator(schema, seg_opts);
+        auto chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        std::vector<int32_t> values;
+        while (true) {
+            chunk->reset();
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            CHECK_OK(st);
+            for (size_t i = 0; i < chunk->num_rows(); ++i) {
+                values.push_back(chunk->get(i)[1].get_int32());
+            }
+        }
+        iter->close();
+        return values;
+    };
+
+    // the keys of the rows around the boundaries of some short key blocks and of the data pages
+    std::vector<int32_t> keys{0, key_of(num_rows - 1)};
+    const int32_t rows_per_page = config::data_page_size / sizeof(int32_t);
+    for (int32_t step : {static_cast<int32_t>(opts.num_rows_per_block) * 7, rows_per_page}) {
+        for (int32_t row = step; row < num_rows; row += step) {
+            keys.push_back(key_of(row - 1));
+            keys.push_back(key_of(row));
+        }
+    }
+    for (int32_t key : keys) {
+        for (int32_t width : {0, 50}) {
+            for (bool inc : {true, false}) {
+                // the rows of the keys in [lower, upper] are [3 * lower, 3 * upper + 3)
+                const int32_t lower = inc ? key : key - 1;
+                const int32_t upper = inc ? key + width : key + width + 1;
+                std::vector<int32_t> expected;
+                for (int32_t i = 3 * std::max(key, 0); i < std::min(3 * (key + width) + 3, num_rows); ++i) {
+                    expected.push_back(i);
+                }
+                ASSERT_EQ(expected, read(segment, lower, upper, inc, inc)) << key << " " << width << " " << inc;
+                ASSERT_EQ(expected, read(learned_segment, lower, upper, inc, inc)) << key << " " << width << " " << inc;
+            }
+        }
+    }
+}
+
 } // namespace starrocks
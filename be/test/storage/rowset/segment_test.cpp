@@ -41,20 +41,27 @@
 
 #include "column/datum_tuple.h"
 #include "common/logging.h"
+#include "common/object_pool.h"
 #include "fs/fs_memory.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "storage/chunk_helper.h"
 #include "storage/chunk_iterator.h"
+#include "storage/column_predicate.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/column_iterator.h"
+#include "storage/metadata_util.h"
+#include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/segment_options.h"
 #include "storage/rowset/segment_writer.h"
 #include "storage/tablet_schema.h"
 #include "storage/tablet_schema_helper.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
+#include "util/json_util.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -271,6 +278,77 @@ TEST_F(SegmentReaderWriterTest, TestHorizontalWrite) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(SegmentReaderWriterTest, TestParallelEncodeWrite) {
+    const int num_columns = 32;
+    std::vector<ColumnPB> columns{create_int_key_pb(0), create_int_key_pb(1)};
+    for (int i = 2; i < num_columns; ++i) {
+        columns.emplace_back(create_int_value_pb(i));
+    }
+    std::shared_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema(columns);
+
+    std::unique_ptr<ThreadPool> encode_pool;
+    ASSERT_OK(ThreadPoolBuilder("segment_encode_test").set_min_threads(1).set_max_threads(4).build(&encode_pool));
+    int32_t old_min_columns = config::segment_parallel_encode_min_columns;
+    config::segment_parallel_encode_min_columns = 8;
+    DeferOp restore([&]() { config::segment_parallel_encode_min_columns = old_min_columns; });
+
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+    opts.encode_pool = encode_pool.get();
+
+    std::string file_name = kSegmentDir + "/parallel_encode_write_case";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema, opts);
+    ASSERT_OK(writer.init());
+
+    int32_t chunk_size = config::vector_chunk_size;
+    size_t num_rows = 10000;
+    auto schema = ChunkHelper::convert_schema(tablet_schema);
+    auto chunk = ChunkHelper::new_chunk(schema, chunk_size);
+    for (size_t base = 0; base < num_rows; base += chunk_size) {
+        chunk->reset();
+        auto& cols = chunk->columns();
+        for (size_t rid = base; rid < std::min(num_rows, base + chunk_size); ++rid) {
+            for (int cid = 0; cid < num_columns; ++cid) {
+                cols[cid]->append_datum(DefaultIntGenerator(rid, cid, 0));
+            }
+        }
+        ASSERT_OK(writer.append_chunk(*chunk));
+    }
+
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    uint64_t footer_position = 0;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+
+    auto segment = *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    ASSERT_EQ(segment->num_rows(), num_rows);
+
+    SegmentReadOptions seg_options;
+    seg_options.fs = _fs;
+    OlapReaderStatistics stats;
+    seg_options.stats = &stats;
+    ASSIGN_OR_ABORT(auto seg_iterator, segment->new_iterator(schema, seg_options));
+
+    size_t count = 0;
+    while (true) {
+        chunk->reset();
+        auto st = seg_iterator->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(st);
+        for (size_t i = 0; i < chunk->num_rows(); ++i) {
+            for (int cid = 0; cid < num_columns; ++cid) {
+                ASSERT_EQ(count * 10 + cid, chunk->get(i)[cid].get_int32());
+            }
+            ++count;
+        }
+    }
+    EXPECT_EQ(count, num_rows);
+}
+
 // NOLINTNEXTLINE
 TEST_F(SegmentReaderWriterTest, TestVerticalWrite) {
     std::shared_ptr<TabletSchema> tablet_schema = TabletSchemaHelper::create_tablet_schema(
@@ -558,4 +636,231 @@ TEST_F(SegmentReaderWriterTest, TestTypeConversion) {
         EXPECT_EQ(10, read_chunk->get(0)[1].get_int64());
     }
 }
+// The rows read with the predicates evaluated on the encoded pages must be the same as without.
+TEST_F(SegmentReaderWriterTest, TestEncodedPagePredicate) {
+    ColumnPB varchar_pb = create_int_value_pb(3, "NONE", false);
+    varchar_pb.set_type("VARCHAR");
+    varchar_pb.set_length(64);
+    auto tablet_schema = std::shared_ptr<TabletSchema>{TabletSchemaHelper::create_tablet_schema(
+            {create_int_key_pb(0, false), create_int_value_pb(1, "NONE", false), create_int_value_pb(2, "NONE", false),
+             varchar_pb})};
+    auto file_name = kSegmentDir + "/encoded_page_predicate";
+    ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+    SegmentWriter writer(std::move(wfile), 0, tablet_schema, SegmentWriterOptions{});
+    ASSERT_OK(writer.init());
+
+    // c1 has long runs of the same value, c2 and c3 change on every row
+    const int32_t num_rows = 100000;
+    const std::vector<std::string> strings = {"a", "b", "c", "d", "e", "f", "g"};
+    auto write_schema = ChunkHelper::convert_schema(tablet_schema);
+    auto chunk = ChunkHelper::new_chunk(write_schema, config::vector_chunk_size);
+    for (int32_t i = 0; i < num_rows;) {
+        chunk->reset();
+        auto& cols = chunk->columns();
+        for (int32_t j = 0; j < config::vector_chunk_size && i < num_rows; ++j, ++i) {
+            cols[0]->append_datum(Datum(i));
+            cols[1]->append_datum(Datum(i / 100));
+            cols[2]->append_datum(Datum(i % 7));
+            cols[3]->append_datum(Datum(Slice(strings[i % 7])));
+        }
+        ASSERT_OK(writer.append_chunk(*chunk));
+    }
+    uint64_t file_size = 0;
+    uint64_t index_size = 0;
+    uint64_t footer_position = 0;
+    ASSERT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+    auto segment = *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    ASSERT_EQ(num_rows, segment->num_rows());
+
+    auto int_type = get_type_info(TYPE_INT);
+    auto varchar_type = get_type_info(TYPE_VARCHAR);
+    ObjectPool pool;
+    auto read_keys = [&](const std::vector<ColumnPredicate*>& predicates) {
+        PredicateAndNode pred_root;
+        for (ColumnPredicate* pred : predicates) {
+            pred_root.add_child(PredicateColumnNode{pred});
+        }
+        OlapReaderStatistics stats;
+        SegmentReadOptions seg_options;
+        seg_options.fs = _fs;
+        seg_options.stats = &stats;
+        seg_options.tablet_schema = tablet_schema;
+        seg_options.pred_tree = PredicateTree::create(std::move(pred_root));
+        auto read_schema = ChunkHelper::convert_schema(tablet_schema);
+        std::vector<int32_t> keys;
+        auto seg_iter = segment->new_iterator(read_schema, seg_options).value();
+        auto read_chunk = ChunkHelper::new_chunk(read_schema, config::vector_chunk_size);
+        while (true) {
+            read_chunk->reset();
+            auto st = seg_iter->get_next(read_chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            CHECK(st.ok()) << st;
+            for (size_t i = 0; i < read_chunk->num_rows(); ++i) {
+                keys.push_back(read_chunk->get(i)[0].get_int32());
+            }
+        }
+        return keys;
+    };
+
+    const bool old_enable = config::enable_encoded_page_predicate;
+    DeferOp defer([&]() { config::enable_encoded_page_predicate = old_enable; });
+    auto* c1_ge = pool.add(new_column_ge_predicate(int_type, 1, "200"));
+    auto* c1_lt = pool.add(new_column_lt_predicate(int_type, 1, "400"));
+    auto* c1_lt_small = pool.add(new_column_lt_predicate(int_type, 1, "10"));
+    auto* c2_eq = pool.add(new_column_eq_predicate(int_type, 2, "3"));
+    auto* c3_eq = pool.add(new_column_eq_predicate(varchar_type, 3, "d"));
+    std::vector<std::pair<std::vector<ColumnPredicate*>, size_t>> cases = {
+            // a few long ranges are selected
+            {{c1_ge, c1_lt}, 20000},
+            // the selected rows are scattered, all the rows are read
+            {{c2_eq}, 14286},
+            {{c1_ge, c2_eq}, 11429},
+            // the dictionary encoded pages are not evaluated
+            {{c3_eq, c1_lt_small}, 143},
+    };
+    for (const auto& [predicates, expected_rows] : cases) {
+        config::enable_encoded_page_predicate = false;
+        auto expected = read_keys(predicates);
+        config::enable_encoded_page_predicate = true;
+        auto actual = read_keys(predicates);
+        EXPECT_EQ(expected_rows, expected.size());
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+namespace {
+
+// A predicate probing the n-grams of |pattern|, like `c LIKE '%pattern%'` on an ngram bloom filter index.
+class NgramTestPredicate final : public ColumnPredicate {
+public:
+    NgramTestPredicate(const TypeInfoPtr& type_info, ColumnId id, std::string pattern)
+            : ColumnPredicate(type_info, id), _pattern(std::move(pattern)) {}
+
+    Status evaluate(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        memset(selection + from, 1, to - from);
+        return Status::OK();
+    }
+    Status evaluate_and(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        return Status::OK();
+    }
+    Status evaluate_or(const Column* column, uint8_t* selection, uint16_t from, uint16_t to) const override {
+        memset(selection + from, 1, to - from);
+        return Status::OK();
+    }
+
+    bool support_ngram_bloom_filter() const override { return true; }
+    bool ngram_bloom_filter(const BloomFilter* bf, const NgramBloomFilterReaderOptions& options) const override {
+        for (size_t i = 0; i + options.index_gram_num <= _pattern.size(); ++i) {
+            if (!bf->test_bytes(_pattern.data() + i, options.index_gram_num)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    PredicateType type() const override { return PredicateType::kUnknown; }
+    bool can_vectorized() const override { return false; }
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override {
+        *output = this;
+        return Status::OK();
+    }
+
+private:
+    std::string _pattern;
+};
+
+} // namespace
+
+// All the bloom filter predicates of a column must be satisfied by a page, and only the predicates supporting
+// ngram bloom filter are probed on an ngram bloom filter index.
+TEST_F(SegmentReaderWriterTest, TestBloomFilterConjuncts) {
+    auto write_segment = [&](const std::string& file_name, const TabletSchemaCSPtr& tablet_schema) {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(file_name));
+        SegmentWriter writer(std::move(wfile), 0, tablet_schema, SegmentWriterOptions{});
+        CHECK(writer.init().ok());
+        const std::vector<std::string> values = {"apple", "banana"};
+        auto chunk = ChunkHelper::new_chunk(ChunkHelper::convert_schema(tablet_schema), 1000);
+        for (int32_t i = 0; i < 1000; ++i) {
+            chunk->columns()[0]->append_datum(Datum(i));
+            chunk->columns()[1]->append_datum(Datum(Slice(values[i % values.size()])));
+        }
+        CHECK(writer.append_chunk(*chunk).ok());
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        CHECK(writer.finalize(&file_size, &index_size, &footer_position).ok());
+        return *Segment::open(_fs, FileInfo{file_name}, 0, tablet_schema);
+    };
+    auto new_schema_pb = []() {
+        TabletSchemaPB schema_pb;
+        schema_pb.set_keys_type(DUP_KEYS);
+        schema_pb.set_num_short_key_columns(1);
+        *schema_pb.add_column() = create_int_key_pb(0, false);
+        ColumnPB* c1 = schema_pb.add_column();
+        *c1 = create_int_value_pb(1, "NONE", false, "", true);
+        c1->set_type("VARCHAR");
+        c1->set_length(64);
+        return schema_pb;
+    };
+    auto bloom_filter_rows = [&](const std::shared_ptr<Segment>& segment,
+                                 const std::vector<const ColumnPredicate*>& predicates) {
+        ColumnReader* reader = segment->column_with_uid(1);
+        CHECK(reader != nullptr && reader->has_bloom_filter_index());
+        ASSIGN_OR_ABORT(auto rfile, _fs->new_random_access_file(segment->file_name()));
+        OlapReaderStatistics stats;
+        IndexReadOptions opts;
+        opts.read_file = rfile.get();
+        opts.stats = &stats;
+        CHECK(reader->load_ordinal_index(opts).ok());
+        SparseRange<> ranges(0, segment->num_rows());
+        CHECK(reader->bloom_filter(predicates, &ranges, opts).ok());
+        return ranges.span_size();
+    };
+
+    auto varchar_type = get_type_info(TYPE_VARCHAR);
+    ObjectPool pool;
+    const ColumnPredicate* eq_apple = pool.add(new_column_eq_predicate(varchar_type, 1, "apple"));
+    const ColumnPredicate* eq_banana = pool.add(new_column_eq_predicate(varchar_type, 1, "banana"));
+    const ColumnPredicate* eq_cherry = pool.add(new_column_eq_predicate(varchar_type, 1, "cherry"));
+
+    {
+        TabletSchemaCSPtr tablet_schema = std::make_shared<TabletSchema>(new_schema_pb());
+        auto segment = write_segment(kSegmentDir + "/bloom_filter_conjuncts", tablet_schema);
+        EXPECT_EQ(1000, bloom_filter_rows(segment, {eq_apple}));
+        EXPECT_EQ(1000, bloom_filter_rows(segment, {eq_apple, eq_banana}));
+        EXPECT_EQ(0, bloom_filter_rows(segment, {eq_cherry}));
+        // the page is skipped if any of the predicates is not satisfied, whatever the order
+        EXPECT_EQ(0, bloom_filter_rows(segment, {eq_apple, eq_cherry}));
+        EXPECT_EQ(0, bloom_filter_rows(segment, {eq_cherry, eq_apple}));
+    }
+
+    {
+        TabletSchemaPB schema_pb = new_schema_pb();
+        TabletIndexPB* index_pb = schema_pb.add_table_indices();
+        index_pb->set_index_id(0);
+        index_pb->set_index_name("ngram_bf");
+        index_pb->set_index_type(IndexType::NGRAMBF);
+        index_pb->add_col_unique_id(1);
+        std::map<std::string, std::map<std::string, std::string>> properties;
+        properties[INDEX_PROPERTIES] = {{GRAM_NUM_KEY, "3"}, {CASE_SENSITIVE_KEY, "true"}};
+        index_pb->set_index_properties(to_json(properties));
+        TabletSchemaCSPtr tablet_schema = std::make_shared<TabletSchema>(schema_pb);
+        auto segment = write_segment(kSegmentDir + "/ngram_bloom_filter_conjuncts", tablet_schema);
+
+        const ColumnPredicate* like_ppl = pool.add(new NgramTestPredicate(varchar_type, 1, "ppl"));
+        const ColumnPredicate* like_nan = pool.add(new NgramTestPredicate(varchar_type, 1, "nan"));
+        const ColumnPredicate* like_xyz = pool.add(new NgramTestPredicate(varchar_type, 1, "xyz"));
+        EXPECT_EQ(1000, bloom_filter_rows(segment, {like_ppl, like_nan}));
+        EXPECT_EQ(0, bloom_filter_rows(segment, {like_xyz}));
+        EXPECT_EQ(0, bloom_filter_rows(segment, {like_ppl, like_xyz}));
+        EXPECT_EQ(0, bloom_filter_rows(segment, {like_xyz, like_ppl}));
+        // the values are not in the ngram bloom filters, the equality predicates must not skip the page
+        EXPECT_EQ(1000, bloom_filter_rows(segment, {eq_apple, like_nan}));
+        EXPECT_EQ(0, bloom_filter_rows(segment, {eq_apple, like_xyz}));
+    }
+}
+
 } // namespace starrocks
@@ -0,0 +1,277 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/rowset/vector_index.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "column/array_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "fs/fs_memory.h"
+#include "storage/page_cache.h"
+#include "storage/tablet_index.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+const std::string kTestDir = "/vector_index_test";
+
+class VectorIndexTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _fs = std::make_shared<MemoryFileSystem>();
+        ASSERT_TRUE(_fs->create_dir(kTestDir).ok());
+
+        _opts.use_page_cache = true;
+        _opts.kept_in_memory = false;
+        _opts.stats = &_stats;
+    }
+    void TearDown() override { StoragePageCache::instance()->prune(); }
+
+    static ColumnPtr make_arrays(const std::vector<std::vector<float>>& vectors) {
+        auto elements = NullableColumn::create(FloatColumn::create(), NullColumn::create());
+        auto offsets = UInt32Column::create();
+        offsets->append(0);
+        for (const auto& v : vectors) {
+            for (float x : v) {
+                elements->append_datum(Datum(x));
+            }
+            offsets->append(elements->size());
+        }
+        return ArrayColumn::create(elements, offsets);
+    }
+
+    // Write the index of |vectors| in batches, and load it into |reader|.
+    void write_and_load(const std::string& file_name, const VectorIndexOptions& options,
+                        const std::vector<std::vector<float>>& vectors, VectorIndexReader* reader) {
+        std::string fname = kTestDir + "/" + file_name;
+        ColumnIndexMetaPB meta;
+        {
+            ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(fname));
+            VectorIndexWriter writer(options);
+            for (size_t i = 0; i < vectors.size(); i += 1000) {
+                std::vector<std::vector<float>> batch(vectors.begin() + i,
+                                                      vectors.begin() + std::min(vectors.size(), i + 1000));
+                auto arrays = make_arrays(batch);
+                ASSERT_OK(writer.add_values(down_cast<const ArrayColumn&>(*arrays), nullptr));
+            }
+            ASSERT_OK(writer.finish(wfile.get(), &meta));
+            ASSERT_OK(wfile->close());
+            ASSERT_EQ(VECTOR_INDEX, meta.type());
+            ASSERT_EQ(options.dim, meta.vector_index().dim());
+        }
+        ASSIGN_OR_ABORT(_rfile, _fs->new_random_access_file(fname));
+        _opts.read_file = _rfile.get();
+        ASSIGN_OR_ABORT(auto first_load, reader->load(_opts, meta.vector_index()));
+        ASSERT_TRUE(first_load);
+    }
+
+    // |num_clusters| clusters of |n| vectors around random centers.
+    static std::vector<std::vector<float>> make_vectors(size_t n, uint32_t dim, size_t num_clusters, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> center_dist(-100, 100);
+        std::normal_distribution<float> noise(0, 1);
+        std::vector<std::vector<float>> centers(num_clusters, std::vector<float>(dim));
+        for (auto& c : centers) {
+            for (auto& x : c) {
+                x = center_dist(rng);
+            }
+        }
+        std::vector<std::vector<float>> vectors(n, std::vector<float>(dim));
+        for (size_t i = 0; i < n; i++) {
+            for (uint32_t d = 0; d < dim; d++) {
+                vectors[i][d] = centers[i % num_clusters][d] + noise(rng);
+            }
+        }
+        return vectors;
+    }
+
+    std::shared_ptr<MemoryFileSystem> _fs = nullptr;
+    std::unique_ptr<RandomAccessFile> _rfile;
+    OlapReaderStatistics _stats;
+    IndexReadOptions _opts;
+};
+
+TEST_F(VectorIndexTest, test_search) {
+    const uint32_t dim = 16;
+    auto vectors = make_vectors(5000, dim, 20, 1);
+    VectorIndexOptions options;
+    options.dim = dim;
+    options.num_lists = 20;
+    VectorIndexReader reader;
+    write_and_load("search", options, vectors, &reader);
+    ASSERT_EQ(dim, reader.dim());
+
+    // probing all lists returns all rows
+    std::vector<rowid_t> rowids;
+    reader.search(vectors[0], 20, &rowids);
+    ASSERT_EQ(vectors.size(), rowids.size());
+    for (size_t i = 0; i < rowids.size(); i++) {
+        ASSERT_EQ(i, rowids[i]);
+    }
+
+    // the nearest row of a query is a candidate of the nearest lists
+    std::mt19937 rng(2);
+    std::normal_distribution<float> noise(0, 1);
+    size_t hits = 0;
+    for (size_t q = 0; q < 100; q++) {
+        std::vector<float> query = vectors[q * 37];
+        for (auto& x : query) {
+            x += noise(rng);
+        }
+        rowid_t nearest = 0;
+        for (rowid_t i = 1; i < vectors.size(); i++) {
+            if (reader.distance(query.data(), vectors[i].data()) <
+                reader.distance(query.data(), vectors[nearest].data())) {
+                nearest = i;
+            }
+        }
+        reader.search(query, 2, &rowids);
+        ASSERT_TRUE(std::is_sorted(rowids.begin(), rowids.end()));
+        ASSERT_LT(rowids.size(), vectors.size());
+        hits += std::binary_search(rowids.begin(), rowids.end(), nearest);
+    }
+    ASSERT_GE(hits, 95u);
+}
+
+// The vectors after the first kMaxTrainingVectors ones are not buffered by the writer.
+TEST_F(VectorIndexTest, test_large_segment) {
+    const uint32_t dim = 16;
+    const size_t num_vectors = VectorIndexWriter::kMaxTrainingVectors + 20000;
+    auto vectors = make_vectors(num_vectors, dim, 50, 3);
+    VectorIndexOptions options;
+    options.dim = dim;
+    options.num_lists = 50;
+    ColumnIndexMetaPB meta;
+    {
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(kTestDir + "/large"));
+        VectorIndexWriter writer(options);
+        for (size_t i = 0; i < vectors.size(); i += 1000) {
+            std::vector<std::vector<float>> batch(vectors.begin() + i,
+                                                  vectors.begin() + std::min(vectors.size(), i + 1000));
+            auto arrays = make_arrays(batch);
+            ASSERT_OK(writer.add_values(down_cast<const ArrayColumn&>(*arrays), nullptr));
+        }
+        ASSERT_LT(writer.size(), num_vectors * (sizeof(rowid_t) + sizeof(uint32_t)) + 50 * dim * sizeof(float) + 1);
+        ASSERT_OK(writer.finish(wfile.get(), &meta));
+        ASSERT_OK(wfile->close());
+    }
+    ASSIGN_OR_ABORT(_rfile, _fs->new_random_access_file(kTestDir + "/large"));
+    _opts.read_file = _rfile.get();
+    VectorIndexReader reader;
+    ASSERT_OK(reader.load(_opts, meta.vector_index()).status());
+
+    std::vector<rowid_t> rowids;
+    reader.search(vectors[0], 50, &rowids);
+    ASSERT_EQ(num_vectors, rowids.size());
+    // the vectors added after the training are in the lists of their clusters too
+    size_t hits = 0;
+    for (size_t q = num_vectors - 100; q < num_vectors; q++) {
+        reader.search(vectors[q], 1, &rowids);
+        ASSERT_LT(rowids.size(), num_vectors);
+        hits += std::binary_search(rowids.begin(), rowids.end(), q);
+    }
+    ASSERT_EQ(100u, hits);
+}
+
+TEST_F(VectorIndexTest, test_cosine_similarity) {
+    VectorIndexOptions options;
+    options.dim = 2;
+    options.metric_type = COSINE_SIMILARITY;
+    options.num_lists = 2;
+    // the vectors of the same direction are in the same list
+    std::vector<std::vector<float>> vectors;
+    for (int i = 1; i <= 100; i++) {
+        vectors.push_back({static_cast<float>(i), 0});
+        vectors.push_back({0, static_cast<float>(i)});
+    }
+    VectorIndexReader reader;
+    write_and_load("cosine", options, vectors, &reader);
+    ASSERT_EQ(COSINE_SIMILARITY, reader.metric_type());
+
+    std::vector<rowid_t> rowids;
+    reader.search({1000, 1}, 1, &rowids);
+    ASSERT_EQ(100u, rowids.size());
+    for (rowid_t rowid : rowids) {
+        ASSERT_EQ(0u, rowid % 2);
+    }
+    std::vector<float> query{2, 0};
+    ASSERT_FLOAT_EQ(0, reader.distance(query.data(), vectors[10].data()));
+    ASSERT_FLOAT_EQ(1, reader.distance(query.data(), vectors[11].data()));
+}
+
+TEST_F(VectorIndexTest, test_nulls_and_invalid_vectors) {
+    VectorIndexOptions options;
+    options.dim = 2;
+    {
+        VectorIndexWriter writer(options);
+        auto arrays = make_arrays({{1, 2}, {3, 4}, {5, 6}});
+        std::vector<uint8_t> nulls{0, 1, 0};
+        ASSERT_OK(writer.add_values(down_cast<const ArrayColumn&>(*arrays), nulls.data()));
+
+        ASSIGN_OR_ABORT(auto wfile, _fs->new_writable_file(kTestDir + "/nulls"));
+        ColumnIndexMetaPB meta;
+        ASSERT_OK(writer.finish(wfile.get(), &meta));
+        ASSERT_OK(wfile->close());
+        ASSIGN_OR_ABORT(_rfile, _fs->new_random_access_file(kTestDir + "/nulls"));
+        _opts.read_file = _rfile.get();
+        VectorIndexReader reader;
+        ASSERT_OK(reader.load(_opts, meta.vector_index()).status());
+        std::vector<rowid_t> rowids;
+        reader.search({0, 0}, 100, &rowids);
+        ASSERT_EQ((std::vector<rowid_t>{0, 2}), rowids);
+    }
+    {
+        VectorIndexWriter writer(options);
+        auto arrays = make_arrays({{1, 2}, {3, 4, 5}});
+        ASSERT_TRUE(writer.add_values(down_cast<const ArrayColumn&>(*arrays), nullptr).is_invalid_argument());
+    }
+    {
+        VectorIndexWriter writer(options);
+        auto elements = NullableColumn::create(FloatColumn::create(), NullColumn::create());
+        elements->append_datum(Datum(1.0f));
+        elements->append_nulls(1);
+        auto offsets = UInt32Column::create();
+        offsets->append(0);
+        offsets->append(2);
+        auto arrays = ArrayColumn::create(elements, offsets);
+        ASSERT_TRUE(writer.add_values(*arrays, nullptr).is_invalid_argument());
+    }
+}
+
+TEST_F(VectorIndexTest, test_options) {
+    TabletIndex index;
+    ASSERT_FALSE(VectorIndexOptions::create(index).ok());
+    index.add_index_properties(VECTOR_DIM_KEY, "128");
+    ASSIGN_OR_ABORT(auto options, VectorIndexOptions::create(index));
+    ASSERT_EQ(128u, options.dim);
+    ASSERT_EQ(L2_DISTANCE, options.metric_type);
+    ASSERT_EQ(0u, options.num_lists);
+
+    index.add_index_properties(VECTOR_METRIC_TYPE_KEY, "cosine_similarity");
+    index.add_index_properties(VECTOR_NUM_LISTS_KEY, "64");
+    ASSIGN_OR_ABORT(options, VectorIndexOptions::create(index));
+    ASSERT_EQ(COSINE_SIMILARITY, options.metric_type);
+    ASSERT_EQ(64u, options.num_lists);
+
+    TabletIndex invalid;
+    invalid.add_index_properties(VECTOR_DIM_KEY, "0");
+    ASSERT_FALSE(VectorIndexOptions::create(invalid).ok());
+}
+
+} // namespace starrocks
@@ -39,7 +39,10 @@
 #include <memory>
 #include <string>
 
+#include "common/config.h"
 #include "fs/fs_memory.h"
+#include "storage/column_predicate.h"
+#include "storage/rowset/encoded_predicate.h"
 #include "storage/page_cache.h"
 #include "storage/tablet_schema_helper.h"
 #include "testutil/assert.h"
@@ -361,4 +364,52 @@ TEST_F(ColumnZoneMapTest, NormalTestCharPage) {
     test_string("NormalTestCharPage", type_info);
 }
 
+TEST_F(ColumnZoneMapTest, RowBlockZoneMap) {
+    std::string filename = kTestDir + "/RowBlockZoneMap";
+
+    TabletColumn int_column = create_int_key(0);
+    TypeInfoPtr type_info = get_type_info(int_column);
+
+    const int32_t old_row_block_size = config::zone_map_row_block_size;
+    config::zone_map_row_block_size = 4;
+    auto writer = ZoneMapIndexWriter::create(type_info.get());
+    config::zone_map_row_block_size = old_row_block_size;
+
+    // blocks: [0, 3] [4, 7] [null x 4] [8, 11] [12, 13]
+    std::vector<int> values = {0, 1, 2, 3, 4, 5, 6, 7};
+    writer->add_values(values.data(), 6);
+    writer->add_values(values.data() + 6, 2);
+    writer->flush();
+    writer->add_nulls(4);
+    values = {8, 9, 10, 11, 12, 13};
+    writer->add_values(values.data(), 6);
+    writer->flush();
+
+    ColumnIndexMetaPB index_meta;
+    write_file(*writer, index_meta, filename);
+    ASSERT_EQ(4, index_meta.zone_map_index().row_block_size());
+    ASSERT_EQ(5 * sizeof(int32_t), index_meta.zone_map_index().row_block_min_values().size());
+
+    ZoneMapIndexReader reader;
+    load_zone_map(reader, index_meta, filename);
+    ASSERT_TRUE(reader.has_row_block_zone_maps());
+
+    std::unique_ptr<ColumnPredicate> ge(new_column_ge_predicate(type_info, 0, "5"));
+    std::unique_ptr<ColumnPredicate> le(new_column_le_predicate(type_info, 0, "9"));
+    EncodedPredicates predicates;
+    predicates.add(ge.get());
+    predicates.add(le.get());
+
+    SparseRange<> row_ranges(0, 18);
+    reader.filter_row_blocks(TYPE_INT, predicates, &row_ranges);
+    ASSERT_EQ((SparseRange<>{Range<>(4, 8), Range<>(12, 16)}).to_string(), row_ranges.to_string());
+
+    std::unique_ptr<ColumnPredicate> eq(new_column_eq_predicate(type_info, 0, "13"));
+    EncodedPredicates eq_predicates;
+    eq_predicates.add(eq.get());
+    row_ranges = SparseRange<>(0, 18);
+    reader.filter_row_blocks(TYPE_INT, eq_predicates, &row_ranges);
+    ASSERT_EQ(SparseRange<>(16, 18).to_string(), row_ranges.to_string());
+}
+
 } // namespace starrocks
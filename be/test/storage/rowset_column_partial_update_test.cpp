@@ -32,12 +32,14 @@
 #include "storage/snapshot_manager.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_manager.h"
+#include "storage/tablet_meta_manager.h"
 #include "storage/tablet_reader.h"
 #include "storage/tablet_reader_params.h"
 #include "storage/tablet_schema.h"
 #include "storage/union_iterator.h"
 #include "storage/update_manager.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -767,6 +769,67 @@ TEST_P(RowsetColumnPartialUpdateTest, test_dcg_gc) {
     }));
 }
 
+TEST_P(RowsetColumnPartialUpdateTest, test_dcg_consolidate) {
+    // Only run one parameter here
+    if (GetParam() != 104857600) return;
+    int32_t old_val = config::partial_update_column_mode_dcg_consolidate_threshold;
+    config::partial_update_column_mode_dcg_consolidate_threshold = 2;
+    DeferOp reset_config([&]() { config::partial_update_column_mode_dcg_consolidate_threshold = old_val; });
+    const int N = 100;
+    auto tablet = create_tablet(rand(), rand());
+    ASSERT_EQ(1, tablet->updates()->version_history_count());
+    int64_t version = 1;
+    int64_t version_before_partial_update = 1;
+    auto meta = tablet->data_dir()->get_meta();
+    prepare_tablet(this, tablet, version, version_before_partial_update, N);
+    // every update after the first one carries the other column forward, so the newest delta column group
+    // covers all the older ones
+    ASSERT_OK(StorageEngine::instance()
+                      ->update_manager()
+                      ->clear_delta_column_group_before_version(meta, tablet->schema_hash_path(),
+                                                                tablet->tablet_id(), version + 1)
+                      .status());
+    DeltaColumnGroupList dcgs;
+    ASSERT_OK(TabletMetaManager::scan_tablet_delta_column_group(meta, tablet->tablet_id(), &dcgs));
+    ASSERT_EQ(1, dcgs.size());
+    ASSERT_EQ(2, dcgs[0]->column_ids().size());
+    ASSERT_TRUE(check_tablet(tablet, version, N, [](int64_t k1, int64_t v1, int32_t v2) {
+        return (int16_t)(k1 % 100 + 3) == v1 && (int32_t)(k1 % 1000 + 4) == v2;
+    }));
+}
+
+TEST_P(RowsetColumnPartialUpdateTest, test_dcg_consolidate_max_segments) {
+    // Only run one parameter here
+    if (GetParam() != 104857600) return;
+    int32_t old_threshold = config::partial_update_column_mode_dcg_consolidate_threshold;
+    int32_t old_max_segments = config::partial_update_column_mode_dcg_consolidate_max_segments;
+    config::partial_update_column_mode_dcg_consolidate_threshold = 2;
+    config::partial_update_column_mode_dcg_consolidate_max_segments = 0;
+    DeferOp reset_config([&]() {
+        config::partial_update_column_mode_dcg_consolidate_threshold = old_threshold;
+        config::partial_update_column_mode_dcg_consolidate_max_segments = old_max_segments;
+    });
+    const int N = 100;
+    auto tablet = create_tablet(rand(), rand());
+    ASSERT_EQ(1, tablet->updates()->version_history_count());
+    int64_t version = 1;
+    int64_t version_before_partial_update = 1;
+    auto meta = tablet->data_dir()->get_meta();
+    prepare_tablet(this, tablet, version, version_before_partial_update, N);
+    // no segment is consolidated, the newest delta column groups of v1 and v2 are both live
+    ASSERT_OK(StorageEngine::instance()
+                      ->update_manager()
+                      ->clear_delta_column_group_before_version(meta, tablet->schema_hash_path(),
+                                                                tablet->tablet_id(), version + 1)
+                      .status());
+    DeltaColumnGroupList dcgs;
+    ASSERT_OK(TabletMetaManager::scan_tablet_delta_column_group(meta, tablet->tablet_id(), &dcgs));
+    ASSERT_EQ(2, dcgs.size());
+    ASSERT_TRUE(check_tablet(tablet, version, N, [](int64_t k1, int64_t v1, int32_t v2) {
+        return (int16_t)(k1 % 100 + 3) == v1 && (int32_t)(k1 % 1000 + 4) == v2;
+    }));
+}
+
 TEST_P(RowsetColumnPartialUpdateTest, test_get_column_values) {
     const int N = 100;
     auto tablet = create_tablet(rand(), rand());
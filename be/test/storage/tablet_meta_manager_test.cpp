@@ -19,7 +19,10 @@
 #include <filesystem>
 #include <thread>
 
+#include "common/config.h"
 #include "storage/del_vector.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -390,6 +393,65 @@ protected:
     inline static std::unique_ptr<DataDir> _s_data_dir;
 };
 
+// NOLINTNEXTLINE
+TEST_F(TabletMetaManagerTest, delete_vector_delta_chain) {
+    const TTabletId kTabletId = 10087;
+    const uint32_t kSegmentId = 3;
+    auto meta = _data_dir->get_meta();
+    bool old_enable = config::enable_delvec_delta_chain;
+    int32_t old_max_length = config::delvec_delta_chain_max_length;
+    config::enable_delvec_delta_chain = true;
+    config::delvec_delta_chain_max_length = 3;
+    DeferOp reset_config([&]() {
+        config::enable_delvec_delta_chain = old_enable;
+        config::delvec_delta_chain_max_length = old_max_length;
+    });
+
+    DelVector dv2;
+    std::vector<uint32_t> init_dels = {1, 2};
+    dv2.init(2, init_dels.data(), init_dels.size());
+    ASSERT_OK(TabletMetaManager::set_del_vector(meta, kTabletId, kSegmentId, dv2));
+
+    // version 3 and 4 are deltas, 5 is a checkpoint, 6 is a delta of 5
+    DelVectorPtr prev = std::make_shared<DelVector>();
+    prev->copy_from(dv2);
+    PersistentIndexMetaPB index_meta;
+    for (int64_t v = 3; v <= 6; v++) {
+        DelVectorPtr cur;
+        prev->add_dels_as_new_version({static_cast<uint32_t>(v)}, v, &cur);
+        std::vector<std::pair<uint32_t, DelVectorPtr>> delvecs{{kSegmentId, cur}};
+        ASSERT_OK(TabletMetaManager::apply_rowset_commit(_data_dir.get(), kTabletId, v, EditVersion(v, 0), delvecs,
+                                                         index_meta, false, nullptr));
+        prev = cur;
+    }
+
+    auto check_del_vec = [&](int64_t version, size_t expect_cardinality) {
+        DelVector delvec;
+        int64_t latest_version = 0;
+        ASSERT_OK(TabletMetaManager::get_del_vector(meta, kTabletId, kSegmentId, version, &delvec, &latest_version));
+        ASSERT_EQ(6, latest_version);
+        ASSERT_EQ(version, delvec.version());
+        ASSERT_FALSE(delvec.has_pending_base());
+        ASSERT_EQ(expect_cardinality, delvec.cardinality());
+        for (uint32_t i = 1; i <= expect_cardinality; i++) {
+            ASSERT_TRUE(delvec.roaring()->contains(i));
+        }
+    };
+    check_del_vec(3, 3);
+    check_del_vec(4, 4);
+    check_del_vec(5, 5);
+    check_del_vec(6, 6);
+
+    // version 4 still needs 3 and 2
+    ASSIGN_OR_ABORT(auto num_delete, TabletMetaManager::delete_del_vector_before_version(meta, kTabletId, 4));
+    ASSERT_EQ(0, num_delete);
+    check_del_vec(4, 4);
+
+    ASSIGN_OR_ABORT(num_delete, TabletMetaManager::delete_del_vector_before_version(meta, kTabletId, 6));
+    ASSERT_EQ(3, num_delete);
+    check_del_vec(6, 6);
+}
+
 TEST_F(TabletMetaManagerTest, delta_column_group_operations) {
     // insert 20 delta_column_group with 20 version
     auto meta = _data_dir->get_meta();
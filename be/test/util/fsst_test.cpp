@@ -0,0 +1,131 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/fsst.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+static std::string round_trip(const FsstSymbolTable& table, const std::string& value, size_t* compressed_size) {
+    std::string compressed(FsstSymbolTable::max_compressed_size(value.size()), '\0');
+    *compressed_size = table.compress(Slice(value), reinterpret_cast<uint8_t*>(compressed.data()));
+    std::string decompressed(value.size() + FsstSymbolTable::kDecompressPadding, '\0');
+    auto size = table.decompress(reinterpret_cast<const uint8_t*>(compressed.data()), *compressed_size,
+                                 reinterpret_cast<uint8_t*>(decompressed.data()), value.size());
+    EXPECT_TRUE(size.ok()) << size.status();
+    decompressed.resize(size.ok() ? size.value() : 0);
+    return decompressed;
+}
+
+// NOLINTNEXTLINE
+TEST(FsstTest, compress_urls) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 1000; i++) {
+        values.emplace_back("https://www.example.com/products/item?id=" + std::to_string(i * 7919) + "&ref=home");
+    }
+    std::vector<Slice> samples(values.begin(), values.end());
+    FsstSymbolTable table;
+    table.build(samples);
+    ASSERT_FALSE(table.empty());
+
+    size_t raw_size = 0;
+    size_t total_compressed = 0;
+    for (const auto& value : values) {
+        size_t compressed_size = 0;
+        ASSERT_EQ(value, round_trip(table, value, &compressed_size));
+        raw_size += value.size();
+        total_compressed += compressed_size;
+    }
+    ASSERT_LT(total_compressed * 2, raw_size);
+
+    // the bytes never seen are escaped
+    size_t compressed_size = 0;
+    std::string unseen("\x01\x02\xff\x00ZZZ", 7);
+    ASSERT_EQ(unseen, round_trip(table, unseen, &compressed_size));
+    ASSERT_EQ("", round_trip(table, "", &compressed_size));
+    ASSERT_EQ(0, compressed_size);
+}
+
+// NOLINTNEXTLINE
+TEST(FsstTest, serialize) {
+    std::vector<std::string> values{"GET /index.html HTTP/1.1", "POST /login HTTP/1.1", "GET /favicon.ico HTTP/1.1"};
+    std::vector<Slice> samples(values.begin(), values.end());
+    FsstSymbolTable table;
+    table.build(samples);
+
+    faststring buf;
+    table.serialize(&buf);
+    FsstSymbolTable table2;
+    ASSIGN_OR_ABORT(auto consumed, table2.deserialize(buf.data(), buf.size()));
+    ASSERT_EQ(buf.size(), consumed);
+    ASSERT_EQ(table.num_symbols(), table2.num_symbols());
+    for (const auto& value : values) {
+        size_t size1 = 0;
+        size_t size2 = 0;
+        ASSERT_EQ(value, round_trip(table2, value, &size2));
+        round_trip(table, value, &size1);
+        ASSERT_EQ(size1, size2);
+    }
+
+    // truncated
+    ASSERT_TRUE(table2.deserialize(buf.data(), buf.size() - 1).status().is_corruption());
+    ASSERT_TRUE(table2.empty());
+
+    // invalid symbol length
+    faststring bad;
+    bad.push_back(1);
+    bad.push_back(FsstSymbolTable::kMaxSymbolLength + 1);
+    bad.append("123456789", 9);
+    ASSERT_TRUE(table2.deserialize(bad.data(), bad.size()).status().is_corruption());
+    bad.data()[1] = 0;
+    ASSERT_TRUE(table2.deserialize(bad.data(), bad.size()).status().is_corruption());
+    // more symbols than the bytes
+    bad.data()[0] = 200;
+    ASSERT_TRUE(table2.deserialize(bad.data(), bad.size()).status().is_corruption());
+    ASSERT_TRUE(table2.deserialize(bad.data(), 0).status().is_corruption());
+}
+
+// NOLINTNEXTLINE
+TEST(FsstTest, decompress_malformed) {
+    std::vector<std::string> values{"abcabcabc", "abcdefabc"};
+    std::vector<Slice> samples(values.begin(), values.end());
+    FsstSymbolTable table;
+    table.build(samples);
+    ASSERT_GT(table.num_symbols(), 0);
+
+    std::string out(64 + FsstSymbolTable::kDecompressPadding, '\0');
+    auto* out_data = reinterpret_cast<uint8_t*>(out.data());
+    // trailing escape code without the escaped byte
+    const uint8_t trailing_escape[] = {FsstSymbolTable::kEscapeCode};
+    ASSERT_TRUE(table.decompress(trailing_escape, 1, out_data, 64).status().is_corruption());
+    // code without symbol
+    const uint8_t unknown_code[] = {static_cast<uint8_t>(table.num_symbols())};
+    if (table.num_symbols() < FsstSymbolTable::kMaxSymbols) {
+        ASSERT_TRUE(table.decompress(unknown_code, 1, out_data, 64).status().is_corruption());
+    }
+    // decompressed to more than the capacity
+    const uint8_t escaped[] = {FsstSymbolTable::kEscapeCode, 'x', FsstSymbolTable::kEscapeCode, 'y'};
+    ASSERT_TRUE(table.decompress(escaped, 4, out_data, 1).status().is_corruption());
+    ASSIGN_OR_ABORT(auto size, table.decompress(escaped, 4, out_data, 2));
+    ASSERT_EQ(2, size);
+    ASSERT_EQ("xy", out.substr(0, 2));
+}
+
+} // namespace starrocks
@@ -36,6 +36,8 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
 #include <vector>
 
 using namespace starrocks;
@@ -272,6 +274,127 @@ TEST_F(CacheTest, Usage) {
     ASSERT_EQ(950, cache.get_usage());
 }
 
+static bool lookup_LRUCache(LRUCache& cache, const CacheKey& key) {
+    uint32_t hash = key.hash(key.data(), key.size(), 0);
+    Cache::Handle* handle = cache.lookup(key, hash);
+    cache.release(handle);
+    return handle != nullptr;
+}
+
+TEST_F(CacheTest, SegmentedLRUScanResistant) {
+    for (auto policy : {EvictionPolicy::LRU, EvictionPolicy::SLRU}) {
+        LRUCache cache;
+        cache.set_capacity(1000);
+        cache.set_eviction_policy(policy);
+
+        std::vector<std::string> hot_keys;
+        for (int i = 0; i < 5; i++) {
+            hot_keys.push_back("hot" + std::to_string(i));
+            insert_LRUCache(cache, CacheKey(hot_keys.back()), 10, CachePriority::NORMAL);
+            ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(hot_keys.back())));
+        }
+        // a scan touches every entry only once
+        for (int i = 0; i < 500; i++) {
+            std::string key = "scan" + std::to_string(i);
+            insert_LRUCache(cache, CacheKey(key), 10, CachePriority::NORMAL);
+        }
+        ASSERT_LE(cache.get_usage(), 1000);
+        for (const auto& key : hot_keys) {
+            ASSERT_EQ(policy == EvictionPolicy::SLRU, lookup_LRUCache(cache, CacheKey(key)));
+        }
+    }
+}
+
+TEST_F(CacheTest, SegmentedLRUDemoteProtected) {
+    LRUCache cache;
+    cache.set_capacity(100);
+    cache.set_eviction_policy(EvictionPolicy::SLRU);
+    // every entry is hit twice, the protected segment can only hold 80% of capacity
+    for (int i = 0; i < 10; i++) {
+        std::string key = "key" + std::to_string(i);
+        insert_LRUCache(cache, CacheKey(key), 10, CachePriority::NORMAL);
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(key)));
+    }
+    ASSERT_EQ(100, cache.get_usage());
+    insert_LRUCache(cache, CacheKey("new"), 10, CachePriority::NORMAL);
+    ASSERT_EQ(100, cache.get_usage());
+    // the oldest entry was demoted to probationary segment and evicted first
+    ASSERT_FALSE(lookup_LRUCache(cache, CacheKey("key0")));
+    ASSERT_TRUE(lookup_LRUCache(cache, CacheKey("key9")));
+    ASSERT_EQ(10, cache.prune());
+}
+
+TEST_F(CacheTest, ClockSecondChance) {
+    LRUCache cache;
+    cache.set_capacity(100);
+    cache.set_eviction_policy(EvictionPolicy::CLOCK);
+    for (int i = 0; i < 10; i++) {
+        insert_LRUCache(cache, CacheKey("key" + std::to_string(i)), 10, CachePriority::NORMAL);
+    }
+    // referenced entries get a second chance, the first unreferenced one is evicted
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey("key" + std::to_string(i))));
+    }
+    insert_LRUCache(cache, CacheKey("new"), 10, CachePriority::NORMAL);
+    ASSERT_EQ(100, cache.get_usage());
+    ASSERT_FALSE(lookup_LRUCache(cache, CacheKey("key5")));
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey("key" + std::to_string(i))));
+    }
+    ASSERT_EQ(11, cache.get_lookup_count());
+    ASSERT_EQ(10, cache.get_hit_count());
+}
+
+TEST_F(CacheTest, ClockEntryInUse) {
+    LRUCache cache;
+    cache.set_capacity(30);
+    cache.set_eviction_policy(EvictionPolicy::CLOCK);
+    insert_LRUCache(cache, CacheKey("a"), 10, CachePriority::NORMAL);
+    insert_LRUCache(cache, CacheKey("b"), 10, CachePriority::NORMAL);
+    insert_LRUCache(cache, CacheKey("c"), 10, CachePriority::NORMAL);
+
+    CacheKey key_a("a");
+    Cache::Handle* handle = cache.lookup(key_a, key_a.hash(key_a.data(), key_a.size(), 0));
+    ASSERT_TRUE(handle != nullptr);
+    insert_LRUCache(cache, CacheKey("d"), 10, CachePriority::NORMAL);
+    ASSERT_FALSE(lookup_LRUCache(cache, CacheKey("b")));
+    // "a" is in use and can not be pruned
+    ASSERT_EQ(2, cache.prune());
+    ASSERT_EQ(10, cache.get_usage());
+    cache.release(handle);
+    ASSERT_TRUE(lookup_LRUCache(cache, CacheKey("a")));
+    ASSERT_EQ(1, cache.prune());
+    ASSERT_EQ(0, cache.get_usage());
+}
+
+TEST_F(CacheTest, ClockConcurrentLookup) {
+    LRUCache cache;
+    cache.set_capacity(100);
+    cache.set_eviction_policy(EvictionPolicy::CLOCK);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                for (int i = 0; i < 20; i++) {
+                    lookup_LRUCache(cache, CacheKey("key" + std::to_string(i)));
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 20; i++) {
+            insert_LRUCache(cache, CacheKey("key" + std::to_string(i)), 10, CachePriority::NORMAL);
+        }
+        cache.erase(CacheKey("key0"), CacheKey("key0").hash("key0", 4, 0));
+    }
+    stop = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    ASSERT_LE(cache.get_usage(), 100);
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
@@ -0,0 +1,106 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package com.starrocks.analysis;
+
+import com.starrocks.catalog.ArrayType;
+import com.starrocks.catalog.Column;
+import com.starrocks.catalog.Index;
+import com.starrocks.catalog.KeysType;
+import com.starrocks.catalog.PrimitiveType;
+import com.starrocks.catalog.Type;
+import com.starrocks.common.VectorIndexParams.IndexParamsKey;
+import com.starrocks.common.VectorIndexParams.MetricType;
+import com.starrocks.common.VectorIndexParams.SearchParamsKey;
+import com.starrocks.sql.analyzer.SemanticException;
+
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.Map;
+
+public class VectorIndexUtil {
+    public static final String DIM_KEY = IndexParamsKey.DIM.name().toLowerCase(Locale.ROOT);
+    public static final String METRIC_TYPE_KEY = IndexParamsKey.METRIC_TYPE.name().toLowerCase(Locale.ROOT);
+    public static final String NLIST_KEY = IndexParamsKey.NLIST.name().toLowerCase(Locale.ROOT);
+    public static final String NPROBE_KEY = SearchParamsKey.NPROBE.name().toLowerCase(Locale.ROOT);
+
+    // the limit of the dim and the nlist of the segment index
+    private static final int MAX_VALUE = 65535;
+
+    public static void checkVectorIndexValid(Column column, Map<String, String> properties, KeysType keysType)
+            throws SemanticException {
+        Type type = column.getType();
+        if (!type.isArrayType() || ((ArrayType) type).getItemType().getPrimitiveType() != PrimitiveType.FLOAT) {
+            throw new SemanticException(String.format("Invalid vector index column '%s': unsupported type %s, " +
+                    "the type should be ARRAY<FLOAT>", column.getName(), type));
+        }
+        // The top-k of the index is computed on the rows of each segment, which is only the result
+        // if the rows are neither merged nor deleted across the segments.
+        if (keysType != KeysType.DUP_KEYS && keysType != KeysType.PRIMARY_KEYS) {
+            throw new SemanticException("Vector index only used in DUP_KEYS/PRIMARY_KEYS table. invalid column: "
+                    + column.getName());
+        }
+        if (getProperty(properties, DIM_KEY) == null) {
+            throw new SemanticException("Vector index requires the property " + DIM_KEY);
+        }
+        analyzePositiveInt(properties, DIM_KEY);
+        analyzePositiveInt(properties, NLIST_KEY);
+        analyzePositiveInt(properties, NPROBE_KEY);
+        getMetricType(properties);
+    }
+
+    private static void analyzePositiveInt(Map<String, String> properties, String key) throws SemanticException {
+        String value = getProperty(properties, key);
+        if (value == null) {
+            return;
+        }
+        int n;
+        try {
+            n = Integer.parseInt(value);
+        } catch (NumberFormatException e) {
+            throw new SemanticException("Vector index's " + key + " is not an integer: " + value);
+        }
+        if (n <= 0 || n > MAX_VALUE) {
+            throw new SemanticException("Vector index's " + key + " should be in [1, " + MAX_VALUE + "]");
+        }
+    }
+
+    public static MetricType getMetricType(Map<String, String> properties) throws SemanticException {
+        String value = getProperty(properties, METRIC_TYPE_KEY);
+        // the backends only accept the lower case names
+        String metricType = value == null ? IndexParamsKey.METRIC_TYPE.defaultValue() : value;
+        return Arrays.stream(MetricType.values())
+                .filter(m -> m.name().toLowerCase(Locale.ROOT).equals(metricType))
+                .findFirst()
+                .orElseThrow(() -> new SemanticException("Vector index's " + METRIC_TYPE_KEY +
+                        " should be l2_distance or cosine_similarity: " + metricType));
+    }
+
+    public static int getNprobe(Index index) {
+        String value = getProperty(index.getProperties(), NPROBE_KEY);
+        return Integer.parseInt(value == null ? SearchParamsKey.NPROBE.defaultValue() : value);
+    }
+
+    // the keys of the properties are case-insensitive
+    private static String getProperty(Map<String, String> properties, String key) {
+        if (properties == null) {
+            return null;
+        }
+        return properties.entrySet().stream()
+                .filter(e -> e.getKey().equalsIgnoreCase(key))
+                .map(Map.Entry::getValue)
+                .findFirst()
+                .orElse(null);
+    }
+}
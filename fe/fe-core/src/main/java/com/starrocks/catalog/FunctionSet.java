@@ -377,6 +377,7 @@ public class FunctionSet {
     public static final String CEILING = "ceiling";
     public static final String CONV = "conv";
     public static final String COS = "cos";
+    public static final String COSINE_SIMILARITY = "cosine_similarity";
     public static final String COT = "cot";
     public static final String DEGRESS = "degress";
     public static final String DIVIDE = "divide";
@@ -41,6 +41,7 @@ import com.starrocks.common.InvertedIndexParams.CommonIndexParamKey;
 import com.starrocks.common.InvertedIndexParams.IndexParamsKey;
 import com.starrocks.common.InvertedIndexParams.SearchParamsKey;
 import com.starrocks.common.NgramBfIndexParamsKey;
+import com.starrocks.common.VectorIndexParams;
 import com.starrocks.common.io.Text;
 import com.starrocks.common.io.Writable;
 import com.starrocks.common.util.PrintableMap;
@@ -275,6 +276,14 @@ public class Index implements Writable {
                         .map(e -> e.name().toUpperCase(Locale.ROOT))
                         .collect(Collectors.toSet());
                 searchIndexParamKeySet = Collections.emptySet();
+            } else if (indexType == IndexType.VECTOR) {
+                commonIndexParamKeySet = Collections.emptySet();
+                indexIndexParamKeySet = Arrays.stream(VectorIndexParams.IndexParamsKey.values())
+                        .map(e -> e.name().toUpperCase(Locale.ROOT))
+                        .collect(Collectors.toSet());
+                searchIndexParamKeySet = Arrays.stream(VectorIndexParams.SearchParamsKey.values())
+                        .map(e -> e.name().toUpperCase(Locale.ROOT))
+                        .collect(Collectors.toSet());
             } else {
                 commonIndexParamKeySet = Collections.emptySet();
                 indexIndexParamKeySet = Collections.emptySet();
@@ -282,7 +291,9 @@ public class Index implements Writable {
             }
 
             for (Entry<String, String> propEntry : properties.entrySet()) {
-                String key = propEntry.getKey();
+                // the backends look up the properties of the vector index by the lower case keys
+                String key = indexType == IndexType.VECTOR ? propEntry.getKey().toLowerCase(Locale.ROOT) :
+                        propEntry.getKey();
                 String value = propEntry.getValue();
                 String upperKey = key.toUpperCase(Locale.ROOT);
                 if (commonIndexParamKeySet.contains(upperKey)) {
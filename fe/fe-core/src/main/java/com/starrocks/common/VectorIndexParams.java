@@ -0,0 +1,85 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package com.starrocks.common;
+
+import com.starrocks.common.io.ParamsKey;
+
+public class VectorIndexParams {
+
+    public enum MetricType {
+        L2_DISTANCE,
+        COSINE_SIMILARITY
+    }
+
+    public enum IndexParamsKey implements ParamsKey {
+        /**
+         * Dimension of the vectors, every non-null value of the column must have dim elements
+         */
+        DIM(null, false),
+
+        /**
+         * Metric of the distance between the vectors, l2_distance or cosine_similarity
+         */
+        METRIC_TYPE("l2_distance", true),
+
+        /**
+         * Number of the inverted lists, the square root of the number of rows of a segment by default
+         */
+        NLIST(null, false);
+
+        private final String defaultValue;
+        private boolean needDefault = false;
+
+        IndexParamsKey(String defaultValue, boolean needDefault) {
+            this.defaultValue = defaultValue;
+            this.needDefault = needDefault;
+        }
+
+        @Override
+        public String defaultValue() {
+            return defaultValue;
+        }
+
+        @Override
+        public boolean needDefault() {
+            return needDefault;
+        }
+    }
+
+    public enum SearchParamsKey implements ParamsKey {
+        /**
+         * Number of the inverted lists probed by a search, more lists give a better recall and a slower search
+         */
+        NPROBE("1", true);
+
+        private final String defaultValue;
+        private boolean needDefault = false;
+
+        SearchParamsKey(String defaultValue, boolean needDefault) {
+            this.defaultValue = defaultValue;
+            this.needDefault = needDefault;
+        }
+
+        @Override
+        public String defaultValue() {
+            return defaultValue;
+        }
+
+        @Override
+        public boolean needDefault() {
+            return needDefault;
+        }
+    }
+}
@@ -97,6 +97,7 @@ import com.starrocks.thrift.TPrimitiveType;
 import com.starrocks.thrift.TScanRange;
 import com.starrocks.thrift.TScanRangeLocation;
 import com.starrocks.thrift.TScanRangeLocations;
+import com.starrocks.thrift.TVectorSearchOptions;
 import org.apache.commons.collections4.CollectionUtils;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
@@ -176,6 +177,9 @@ public class OlapScanNode extends ScanNode {
 
     private boolean usePkIndex = false;
 
+    // the top-k by the distance to a query vector answered by the vector index of every segment
+    private TVectorSearchOptions vectorSearchOptions = null;
+
     // Constructs node to scan given data files of table 'tbl'.
     public OlapScanNode(PlanNodeId id, TupleDescriptor desc, String planNodeName) {
         super(id, desc, planNodeName);
@@ -722,6 +726,12 @@ public class OlapScanNode extends ScanNode {
             output.append(prefix).append("SORT COLUMN: ").append(sortColumn).append("\n");
         }
 
+        if (null != vectorSearchOptions) {
+            output.append(prefix).append(String.format("VECTOR SEARCH: column=%s, limit_k=%d, nprobe=%d\n",
+                    vectorSearchOptions.getVector_column_name(), vectorSearchOptions.getLimit_k(),
+                    vectorSearchOptions.getNprobe()));
+        }
+
         if (detailLevel != TExplainLevel.VERBOSE) {
             if (isPreAggregation) {
                 output.append(prefix).append("PREAGGREGATION: ON").append("\n");
@@ -979,6 +989,9 @@ public class OlapScanNode extends ScanNode {
             }
 
             msg.olap_scan_node.setUse_pk_index(usePkIndex);
+            if (vectorSearchOptions != null) {
+                msg.olap_scan_node.setVector_search_options(vectorSearchOptions);
+            }
         }
     }
 
@@ -1036,6 +1049,14 @@ public class OlapScanNode extends ScanNode {
         this.usePkIndex = usePkIndex;
     }
 
+    public void setVectorSearchOptions(TVectorSearchOptions vectorSearchOptions) {
+        this.vectorSearchOptions = vectorSearchOptions;
+    }
+
+    public TVectorSearchOptions getVectorSearchOptions() {
+        return vectorSearchOptions;
+    }
+
     @Override
     public boolean canDoReplicatedJoin() {
         // TODO(wyb): necessary to support?
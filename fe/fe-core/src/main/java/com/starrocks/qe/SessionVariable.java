@@ -283,6 +283,9 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     public static final String ENABLE_PRUNE_COLUMN_AFTER_INDEX_FILTER =
             "enable_prune_column_after_index_filter";
 
+    // whether to answer ORDER BY cosine_similarity(...) DESC LIMIT k by the vector index, whose result is approximate
+    public static final String ENABLE_VECTOR_INDEX_SEARCH = "enable_vector_index_search";
+
     // the maximum time, in seconds, waiting for an insert statement's transaction state
     // transfer from COMMITTED to VISIBLE.
     // If the time exceeded but the transaction state is not VISIBLE, the transaction will
@@ -1144,6 +1147,9 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = ENABLE_PRUNE_COLUMN_AFTER_INDEX_FILTER, flag = VariableMgr.INVISIBLE)
     private boolean enablePruneColumnAfterIndexFilter = true;
 
+    @VariableMgr.VarAttr(name = ENABLE_VECTOR_INDEX_SEARCH)
+    private boolean enableVectorIndexSearch = true;
+
     @VariableMgr.VarAttr(name = CBO_MAX_REORDER_NODE_USE_EXHAUSTIVE)
     private int cboMaxReorderNodeUseExhaustive = 4;
 
@@ -2549,6 +2555,14 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         return enablePruneColumnAfterIndexFilter;
     }
 
+    public boolean isEnableVectorIndexSearch() {
+        return enableVectorIndexSearch;
+    }
+
+    public void setEnableVectorIndexSearch(boolean enableVectorIndexSearch) {
+        this.enableVectorIndexSearch = enableVectorIndexSearch;
+    }
+
     public void disableTrimOnlyFilteredColumnsInScanStage() {
         this.enableFilterUnusedColumnsInScanStage = false;
     }
@@ -25,6 +25,7 @@ import com.starrocks.analysis.BrokerDesc;
 import com.starrocks.analysis.DescriptorTable;
 import com.starrocks.analysis.Expr;
 import com.starrocks.analysis.FunctionCallExpr;
+import com.starrocks.analysis.IndexDef;
 import com.starrocks.analysis.IntLiteral;
 import com.starrocks.analysis.JoinOperator;
 import com.starrocks.analysis.LiteralExpr;
@@ -35,12 +36,14 @@ import com.starrocks.analysis.SlotRef;
 import com.starrocks.analysis.SortInfo;
 import com.starrocks.analysis.TupleDescriptor;
 import com.starrocks.analysis.TupleId;
+import com.starrocks.analysis.VectorIndexUtil;
 import com.starrocks.catalog.AggregateFunction;
 import com.starrocks.catalog.ColocateTableIndex;
 import com.starrocks.catalog.Column;
 import com.starrocks.catalog.ColumnAccessPath;
 import com.starrocks.catalog.Function;
 import com.starrocks.catalog.FunctionSet;
+import com.starrocks.catalog.Index;
 import com.starrocks.catalog.JDBCTable;
 import com.starrocks.catalog.KeysType;
 import com.starrocks.catalog.MaterializedIndex;
@@ -63,6 +66,7 @@ import com.starrocks.common.DdlException;
 import com.starrocks.common.IdGenerator;
 import com.starrocks.common.Pair;
 import com.starrocks.common.UserException;
+import com.starrocks.common.VectorIndexParams.MetricType;
 import com.starrocks.load.BrokerFileGroup;
 import com.starrocks.planner.AggregationNode;
 import com.starrocks.planner.AnalyticEvalNode;
@@ -177,6 +181,7 @@ import com.starrocks.sql.optimizer.operator.physical.PhysicalTableFunctionTableS
 import com.starrocks.sql.optimizer.operator.physical.PhysicalTopNOperator;
 import com.starrocks.sql.optimizer.operator.physical.PhysicalValuesOperator;
 import com.starrocks.sql.optimizer.operator.physical.PhysicalWindowOperator;
+import com.starrocks.sql.optimizer.operator.scalar.ArrayOperator;
 import com.starrocks.sql.optimizer.operator.scalar.BinaryPredicateOperator;
 import com.starrocks.sql.optimizer.operator.scalar.CallOperator;
 import com.starrocks.sql.optimizer.operator.scalar.CastOperator;
@@ -195,6 +200,7 @@ import com.starrocks.sql.optimizer.transformer.LogicalPlan;
 import com.starrocks.thrift.TBrokerFileStatus;
 import com.starrocks.thrift.TPartitionType;
 import com.starrocks.thrift.TResultSinkType;
+import com.starrocks.thrift.TVectorSearchOptions;
 import org.apache.commons.collections4.CollectionUtils;
 import org.apache.commons.lang3.NotImplementedException;
 import org.apache.logging.log4j.LogManager;
@@ -2206,6 +2212,7 @@ public class PlanFragmentBuilder {
             PhysicalTopNOperator topN = (PhysicalTopNOperator) optExpr.getOp();
             Preconditions.checkState(topN.getOffset() >= 0);
             if (!topN.isSplit()) {
+                setVectorSearchOptions(optExpr, topN, inputFragment);
                 return buildPartialTopNFragment(optExpr, context, topN.getPartitionByColumns(),
                         topN.getPartitionLimit(), topN.getOrderSpec(),
                         topN.getTopNType(), topN.getLimit(), topN.getOffset(), inputFragment);
@@ -2215,6 +2222,96 @@ public class PlanFragmentBuilder {
             }
         }
 
+        // Answers the partial top-n of ORDER BY cosine_similarity(c, <constant vector>) DESC LIMIT k by the vector
+        // index of c, every segment only returns the k rows nearest to the vector by its index. The rows must reach
+        // the top-n as they are read from the segments: the scan filters none of them and the table doesn't merge them.
+        private void setVectorSearchOptions(OptExpression optExpr, PhysicalTopNOperator topN,
+                                            PlanFragment inputFragment) {
+            if (!ConnectContext.get().getSessionVariable().isEnableVectorIndexSearch() ||
+                    topN.getTopNType() != TopNType.ROW_NUMBER || topN.getLimit() == Operator.DEFAULT_LIMIT ||
+                    CollectionUtils.isNotEmpty(topN.getPartitionByColumns()) ||
+                    topN.getOrderSpec().getOrderDescs().size() != 1) {
+                return;
+            }
+            Ordering ordering = topN.getOrderSpec().getOrderDescs().get(0);
+            if (ordering.isAscending() || !(optExpr.inputAt(0).getOp() instanceof PhysicalOlapScanOperator)) {
+                return;
+            }
+            PhysicalOlapScanOperator scan = (PhysicalOlapScanOperator) optExpr.inputAt(0).getOp();
+            OlapTable table = (OlapTable) scan.getTable();
+            if (scan.getPredicate() != null || scan.getProjection() == null ||
+                    scan.getSelectedIndexId() != table.getBaseIndexId() ||
+                    (table.getKeysType() != KeysType.DUP_KEYS && table.getKeysType() != KeysType.PRIMARY_KEYS)) {
+                return;
+            }
+            ScalarOperator similarity = scan.getProjection().getColumnRefMap().get(ordering.getColumnRef());
+            if (!(similarity instanceof CallOperator) ||
+                    !FunctionSet.COSINE_SIMILARITY.equalsIgnoreCase(((CallOperator) similarity).getFnName())) {
+                return;
+            }
+            // cosine_similarity is symmetric
+            ScalarOperator vectorArg = similarity.getChild(0);
+            ScalarOperator queryArg = similarity.getChild(1);
+            if (!(vectorArg instanceof ColumnRefOperator)) {
+                vectorArg = similarity.getChild(1);
+                queryArg = similarity.getChild(0);
+            }
+            if (!(vectorArg instanceof ColumnRefOperator)) {
+                return;
+            }
+            Column column = scan.getColRefToColumnMetaMap().get((ColumnRefOperator) vectorArg);
+            List<Double> queryVector = getConstantVector(queryArg);
+            if (column == null || queryVector == null) {
+                return;
+            }
+            Optional<Index> index = table.getIndexes().stream()
+                    .filter(i -> i.getIndexType() == IndexDef.IndexType.VECTOR && i.getColumns().size() == 1 &&
+                            i.getColumns().get(0).equalsIgnoreCase(column.getName()) &&
+                            VectorIndexUtil.getMetricType(i.getProperties()) == MetricType.COSINE_SIMILARITY)
+                    .findFirst();
+            if (!index.isPresent()) {
+                return;
+            }
+            PlanNode root = inputFragment.getPlanRoot();
+            if (root instanceof ProjectNode) {
+                root = root.getChild(0);
+            }
+            if (!(root instanceof OlapScanNode) || !root.getConjuncts().isEmpty()) {
+                return;
+            }
+            TVectorSearchOptions options = new TVectorSearchOptions();
+            options.setVector_column_name(column.getName());
+            options.setQuery_vector(queryVector);
+            options.setLimit_k(topN.getLimit() + topN.getOffset());
+            options.setNprobe(VectorIndexUtil.getNprobe(index.get()));
+            ((OlapScanNode) root).setVectorSearchOptions(options);
+        }
+
+        // the elements of an array of constant numbers, or null if it's not
+        private static List<Double> getConstantVector(ScalarOperator operator) {
+            if (operator instanceof CastOperator) {
+                operator = operator.getChild(0);
+            }
+            if (!(operator instanceof ArrayOperator) || operator.getChildren().isEmpty()) {
+                return null;
+            }
+            List<Double> vector = new ArrayList<>();
+            for (ScalarOperator element : operator.getChildren()) {
+                if (element instanceof CastOperator) {
+                    element = element.getChild(0);
+                }
+                if (!(element instanceof ConstantOperator) || ((ConstantOperator) element).isNull()) {
+                    return null;
+                }
+                Optional<ConstantOperator> value = ((ConstantOperator) element).castTo(Type.DOUBLE);
+                if (!value.isPresent()) {
+                    return null;
+                }
+                vector.add(value.get().getDouble());
+            }
+            return vector;
+        }
+
         private PlanFragment buildFinalTopNFragment(ExecPlan context, TopNType topNType, long limit, long offset,
                                                     PlanFragment inputFragment,
                                                     OptExpression optExpr) {
@@ -451,4 +451,38 @@ public class AnalyzeCreateTableTest {
                 "AGGREGATE KEY(COL1, COL2) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
         analyzeSuccess(sql);
     }
+
+    @Test
+    public void testVectorIndex() throws Exception {
+        String sql = "CREATE TABLE TABLE1 (COL1 INT, COL2 ARRAY<DOUBLE>," +
+                "INDEX INDEX1(COL2) USING VECTOR ('DIM' = '3'))" +
+                "DUPLICATE KEY(COL1) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
+        analyzeFail(sql, "Invalid vector index column 'COL2': unsupported type ARRAY<DOUBLE>");
+
+        sql = "CREATE TABLE TABLE1 (COL1 INT, COL2 ARRAY<FLOAT> REPLACE," +
+                "INDEX INDEX1(COL2) USING VECTOR ('DIM' = '3'))" +
+                "AGGREGATE KEY(COL1) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
+        analyzeFail(sql, "Vector index only used in DUP_KEYS/PRIMARY_KEYS table");
+
+        sql = "CREATE TABLE TABLE1 (COL1 INT, COL2 ARRAY<FLOAT>," +
+                "INDEX INDEX1(COL2) USING VECTOR ('NLIST' = '3'))" +
+                "DUPLICATE KEY(COL1) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
+        analyzeFail(sql, "Vector index requires the property dim");
+
+        sql = "CREATE TABLE TABLE1 (COL1 INT, COL2 ARRAY<FLOAT>," +
+                "INDEX INDEX1(COL2) USING VECTOR ('DIM' = '0'))" +
+                "DUPLICATE KEY(COL1) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
+        analyzeFail(sql, "Vector index's dim should be in [1, 65535]");
+
+        sql = "CREATE TABLE TABLE1 (COL1 INT, COL2 ARRAY<FLOAT>," +
+                "INDEX INDEX1(COL2) USING VECTOR ('DIM' = '3', 'METRIC_TYPE' = 'inner_product'))" +
+                "DUPLICATE KEY(COL1) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
+        analyzeFail(sql, "Vector index's metric_type should be l2_distance or cosine_similarity");
+
+        sql = "CREATE TABLE TABLE1 (COL1 INT, COL2 ARRAY<FLOAT>," +
+                "INDEX INDEX1(COL2) USING VECTOR ('DIM' = '3', 'METRIC_TYPE' = 'cosine_similarity', " +
+                "'NLIST' = '16', 'NPROBE' = '4'))" +
+                "DUPLICATE KEY(COL1) DISTRIBUTED BY HASH(COL1) BUCKETS 10;";
+        analyzeSuccess(sql);
+    }
 }
@@ -0,0 +1,86 @@
+// Copyright 2021-present StarRocks, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package com.starrocks.sql.plan;
+
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+public class VectorIndexSearchTest extends PlanTestBase {
+    @BeforeClass
+    public static void beforeClass() throws Exception {
+        PlanTestBase.beforeClass();
+        starRocksAssert.withTable("CREATE TABLE vector_t (\n" +
+                "id BIGINT NOT NULL,\n" +
+                "vec ARRAY<FLOAT> NOT NULL,\n" +
+                "INDEX vec_idx (vec) USING VECTOR (\"dim\" = \"3\", \"metric_type\" = \"cosine_similarity\", " +
+                "\"nlist\" = \"16\", \"nprobe\" = \"4\")\n" +
+                ") ENGINE=OLAP\n" +
+                "DUPLICATE KEY(`id`)\n" +
+                "DISTRIBUTED BY HASH(`id`) BUCKETS 3\n" +
+                "PROPERTIES(\"replication_num\" = \"1\")");
+        starRocksAssert.withTable("CREATE TABLE vector_l2_t (\n" +
+                "id BIGINT NOT NULL,\n" +
+                "vec ARRAY<FLOAT> NOT NULL,\n" +
+                "INDEX vec_idx (vec) USING VECTOR (\"dim\" = \"3\")\n" +
+                ") ENGINE=OLAP\n" +
+                "DUPLICATE KEY(`id`)\n" +
+                "DISTRIBUTED BY HASH(`id`) BUCKETS 3\n" +
+                "PROPERTIES(\"replication_num\" = \"1\")");
+    }
+
+    @Test
+    public void testVectorSearch() throws Exception {
+        String sql = "select id from vector_t order by cosine_similarity(vec, [1.0, 2.0, 3.0]) desc limit 10";
+        String plan = getFragmentPlan(sql);
+        assertContains(plan, "VECTOR SEARCH: column=vec, limit_k=10, nprobe=4");
+        String thriftPlan = getThriftPlan(sql);
+        assertContains(thriftPlan, "vector_search_options:TVectorSearchOptions(vector_column_name:vec, " +
+                "query_vector:[1.0, 2.0, 3.0], limit_k:10, nprobe:4)");
+
+        // the offset rows are also kept by every segment
+        sql = "select id from vector_t order by cosine_similarity([1, 2, 3], vec) desc limit 5, 10";
+        plan = getFragmentPlan(sql);
+        assertContains(plan, "VECTOR SEARCH: column=vec, limit_k=15, nprobe=4");
+    }
+
+    @Test
+    public void testNoVectorSearch() throws Exception {
+        // the nearest vectors are of the largest similarity
+        String sql = "select id from vector_t order by cosine_similarity(vec, [1.0, 2.0, 3.0]) limit 10";
+        assertNotContains(getFragmentPlan(sql), "VECTOR SEARCH");
+
+        // the filtered rows could leave less than k rows in a segment
+        sql = "select id from vector_t where id > 10 order by cosine_similarity(vec, [1.0, 2.0, 3.0]) desc limit 10";
+        assertNotContains(getFragmentPlan(sql), "VECTOR SEARCH");
+
+        sql = "select id from vector_t order by cosine_similarity(vec, [1.0, 2.0, 3.0]) desc";
+        assertNotContains(getFragmentPlan(sql), "VECTOR SEARCH");
+
+        sql = "select id from vector_t order by cosine_similarity(vec, [id, 2.0, 3.0]) desc limit 10";
+        assertNotContains(getFragmentPlan(sql), "VECTOR SEARCH");
+
+        // the metric of the index is l2_distance
+        sql = "select id from vector_l2_t order by cosine_similarity(vec, [1.0, 2.0, 3.0]) desc limit 10";
+        assertNotContains(getFragmentPlan(sql), "VECTOR SEARCH");
+
+        connectContext.getSessionVariable().setEnableVectorIndexSearch(false);
+        try {
+            sql = "select id from vector_t order by cosine_similarity(vec, [1.0, 2.0, 3.0]) desc limit 10";
+            assertNotContains(getFragmentPlan(sql), "VECTOR SEARCH");
+        } finally {
+            connectContext.getSessionVariable().setEnableVectorIndexSearch(true);
+        }
+    }
+}
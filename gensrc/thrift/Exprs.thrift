@@ -90,6 +90,9 @@ enum TExprNodeType {
   JIT_EXPR,
 
   MATCH_EXPR,
+
+  // created by BE only
+  MULTI_LIKE_PRED,
 }
 
 struct TAggregateExpr {
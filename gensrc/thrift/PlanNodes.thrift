@@ -498,6 +498,16 @@ struct TColumnAccessPath {
     5: optional Types.TTypeDesc type_desc
 }
 
+// ORDER BY the distance between vector_column_name and query_vector LIMIT limit_k, which is
+// answered by the vector index of the column in every segment.
+struct TVectorSearchOptions {
+  1: optional string vector_column_name
+  2: optional list<double> query_vector
+  3: optional i64 limit_k
+  // number of the inverted lists of the index to probe
+  4: optional i32 nprobe
+}
+
 // If you find yourself changing this struct, see also TLakeScanNode
 struct TOlapScanNode {
   1: required Types.TTupleId tuple_id
@@ -526,6 +536,7 @@ struct TOlapScanNode {
   33: optional bool output_asc_hint
   34: optional bool partition_order_hint
   35: optional bool enable_prune_column_after_index_filter
+  36: optional TVectorSearchOptions vector_search_options
 }
 
 struct TJDBCScanNode {